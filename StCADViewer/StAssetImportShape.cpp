@@ -5,8 +5,11 @@
  */
 
 #include "StAssetImportShape.h"
+#include "StAssetMeshCache.h"
+#include "StPrimArrayOptimizer.h"
 
 #include <StStrings/StLogger.h>
+#include <StThreads/StTimer.h>
 
 #include <BRep_Builder.hxx>
 #include <BRepLProp_SLProps.hxx>
@@ -117,7 +120,8 @@ StAssetImportShape::FileFormat StAssetImportShape::probeFormatFromExtension(cons
 }
 
 StAssetImportShape::StAssetImportShape()
-: myXCAFApp(new TDocStd_Application()) {
+: myXCAFApp(new TDocStd_Application()),
+  myToOptimizeMeshes(false) {
     BinXCAFDrivers::DefineFormat(myXCAFApp);
     //StdLDrivers::DefineFormat(myXCAFApp);
     //BinLDrivers::DefineFormat(myXCAFApp);
@@ -169,6 +173,19 @@ void StAssetImportShape::clearSession(const Handle(XSControl_WorkSession)& theWo
 bool StAssetImportShape::load(const Handle(StDocNode)& theParentNode,
                               const StString& theFile,
                               const FileFormat theFormat) {
+    // meshing parameters are part of the cache key, so that changing them invalidates the cache
+    Handle(Prs3d_Drawer) aDrawer = new Prs3d_Drawer();
+    char aMeshParams[128];
+    stsprintf(aMeshParams, sizeof(aMeshParams), "coeff=%g|angle=%g|optimized=%d",
+              aDrawer->DeviationCoefficient(), aDrawer->HLRAngle(), myToOptimizeMeshes ? 1 : 0);
+    StAssetMeshCache aCache(myCacheFolder);
+    const StString aCachePath = aCache.getCachePath(theFile, aMeshParams);
+    if(!aCachePath.isEmpty()
+    &&  aCache.load(theParentNode, aCachePath)) {
+        ST_DEBUG_LOG("StAssetImportShape, model has been read from cache " + aCachePath);
+        return true;
+    }
+
     switch(theFormat) {
         case FileFormat_STEP: {
             if(!loadSTEP(theFile)) {
@@ -238,7 +255,6 @@ bool StAssetImportShape::load(const Handle(StDocNode)& theParentNode,
         }
     }
 
-    Handle(Prs3d_Drawer) aDrawer = new Prs3d_Drawer();
     Standard_Real aDeflection = Prs3d::GetDeflection(aCompound, aDrawer);
     if(!BRepTools::Triangulation(aCompound, aDeflection)) {
         BRepMesh_IncrementalMesh anAlgo;
@@ -257,6 +273,18 @@ bool StAssetImportShape::load(const Handle(StDocNode)& theParentNode,
         TopLoc_Location aTrsf = XCAFDoc_ShapeTool::GetLocation(aLabel);
         addNodeRecursive(theParentNode, *aColorTool, aLabel, aTrsf, aDefStyle);
     }
+
+    if(myToOptimizeMeshes) {
+        StTimer aTimer(true);
+        StPrimArrayOptimizer anOptimizer;
+        anOptimizer.perform(theParentNode);
+        ST_DEBUG_LOG(anOptimizer.formatStatistics() + "\n  done in " + aTimer.getElapsedTimeInMilliSec() + " ms");
+    }
+
+    if(!aCachePath.isEmpty()
+    && !aCache.save(theParentNode, aCachePath)) {
+        ST_DEBUG_LOG("StAssetImportShape, unable to write cache " + aCachePath);
+    }
     return true;
 }
 
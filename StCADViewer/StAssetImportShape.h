@@ -75,6 +75,17 @@ class StAssetImportShape {
                        const StString& theFile,
                        const FileFormat theFormat);
 
+    /**
+     * Set folder for caching triangulated models, cache is disabled when empty.
+     */
+    ST_LOCAL void setCacheFolder(const StString& theFolder) { myCacheFolder = theFolder; }
+
+    /**
+     * Set if primitive arrays should be optimized (see StPrimArrayOptimizer) before storing into cache;
+     * models read from cache are already optimized.
+     */
+    ST_LOCAL void setToOptimizeMeshes(const bool theToOptimize) { myToOptimizeMeshes = theToOptimize; }
+
         protected:
 
     /**
@@ -127,6 +138,8 @@ class StAssetImportShape {
 
     Handle(TDocStd_Application) myXCAFApp;
     Handle(TDocStd_Document)    myXCAFDoc;
+    StString                    myCacheFolder; //!< folder for caching triangulated models
+    bool                        myToOptimizeMeshes; //!< optimize primitive arrays after meshing
 
 };
 
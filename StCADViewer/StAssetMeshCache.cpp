@@ -0,0 +1,396 @@
+/**
+ * This source is a part of sView program.
+ *
+ * Copyright © Kirill Gavrilov, 2026
+ */
+
+#include "StAssetMeshCache.h"
+
+#include <StFile/StFileNode.h>
+#include <StFile/StFolder.h>
+#include <StFile/StRawFile.h>
+#include <StFile/StReadAheadFile.h>
+#include <StStrings/StLogger.h>
+
+#include <limits>
+
+namespace {
+
+    /**
+     * Cache file header, should be changed on any format modification.
+     */
+    static const char THE_CACHE_MAGIC[8] = { 'S', 'T', 'M', 'E', 'S', 'H', '0', '1' };
+
+    /**
+     * Marker at the end of completely written file.
+     */
+    static const uint32_t THE_CACHE_END = 0x21444E45; // "END!"
+
+    /**
+     * Size of file head and tail used for computing file hash.
+     */
+    static const size_t THE_HASH_BLOCK = 64 * 1024;
+
+    /**
+     * Maximum nesting level of nodes.
+     */
+    static const int THE_DEPTH_MAX = 1024;
+
+    /**
+     * Maximum size of cache folder in bytes.
+     */
+    static const int64_t THE_CACHE_SIZE_MAX = int64_t(1024) * 1024 * 1024;
+
+    /**
+     * Maximum age of cache file in seconds (90 days).
+     */
+    static const int64_t THE_CACHE_AGE_MAX = 90 * 24 * 3600;
+
+    /**
+     * Compute 64-bit FNV-1a hash.
+     */
+    static uint64_t hashFnv1a(const stUByte_t* theData,
+                              const size_t     theSize,
+                              uint64_t         theHash = 14695981039346656037ULL) {
+        for(size_t aByteIter = 0; aByteIter < theSize; ++aByteIter) {
+            theHash ^= theData[aByteIter];
+            theHash *= 1099511628211ULL;
+        }
+        return theHash;
+    }
+
+    /**
+     * Read exact number of bytes.
+     */
+    static bool readBytes(StReadAheadFile& theFile,
+                          void*            theData,
+                          const size_t     theSize) {
+        uint8_t* aData = (uint8_t* )theData;
+        size_t   aDone = 0;
+        while(aDone < theSize) {
+            const int aChunk = (int )stMin(theSize - aDone, size_t(std::numeric_limits<int>::max() / 2));
+            const int aRead  = theFile.read(aData + aDone, aChunk);
+            if(aRead <= 0) {
+                return false;
+            }
+            aDone += size_t(aRead);
+        }
+        return true;
+    }
+
+    template<typename Type>
+    static bool readValue(StReadAheadFile& theFile,
+                          Type&            theValue) {
+        return readBytes(theFile, &theValue, sizeof(Type));
+    }
+
+    /**
+     * Read array prefixed by the number of elements.
+     */
+    template<typename Type>
+    static bool readVector(StReadAheadFile&   theFile,
+                           std::vector<Type>& theVector) {
+        uint32_t aNbElems = 0;
+        if(!readValue(theFile, aNbElems)) {
+            return false;
+        }
+
+        // validate size before allocating memory
+        const int64_t aBytesLeft = theFile.getSize() - theFile.getPosition();
+        if(int64_t(aNbElems) * int64_t(sizeof(Type)) > aBytesLeft) {
+            return false;
+        }
+
+        theVector.resize(aNbElems);
+        return aNbElems == 0
+            || readBytes(theFile, &theVector[0], sizeof(Type) * aNbElems);
+    }
+
+    static bool readTrsf(StReadAheadFile& theFile,
+                         gp_Trsf&         theTrsf) {
+        double aValues[12];
+        if(!readBytes(theFile, aValues, sizeof(aValues))) {
+            return false;
+        }
+        theTrsf.SetValues(aValues[0], aValues[1], aValues[2],  aValues[3],
+                          aValues[4], aValues[5], aValues[6],  aValues[7],
+                          aValues[8], aValues[9], aValues[10], aValues[11]);
+        return true;
+    }
+
+    template<typename Type>
+    static void writeValue(StRawFile&  theFile,
+                           const Type& theValue) {
+        theFile.write((const char* )&theValue, sizeof(Type));
+    }
+
+    template<typename Type>
+    static void writeVector(StRawFile&               theFile,
+                            const std::vector<Type>& theVector) {
+        writeValue(theFile, (uint32_t )theVector.size());
+        if(!theVector.empty()) {
+            theFile.write((const char* )&theVector[0], sizeof(Type) * theVector.size());
+        }
+    }
+
+    static void writeTrsf(StRawFile&     theFile,
+                          const gp_Trsf& theTrsf) {
+        double aValues[12];
+        for(int aRowIter = 0; aRowIter < 3; ++aRowIter) {
+            for(int aColIter = 0; aColIter < 4; ++aColIter) {
+                aValues[aRowIter * 4 + aColIter] = theTrsf.Value(aRowIter + 1, aColIter + 1);
+            }
+        }
+        theFile.write((const char* )aValues, sizeof(aValues));
+    }
+
+}
+
+StAssetMeshCache::StAssetMeshCache(const StString& theCacheFolder)
+: myCacheFolder(theCacheFolder) {
+    if(!myCacheFolder.isEmpty()
+    && !myCacheFolder.isEndsWith(SYS_FS_SPLITTER)) {
+        myCacheFolder += StString(SYS_FS_SPLITTER);
+    }
+}
+
+StString StAssetMeshCache::getCachePath(const StString& theFile,
+                                        const StString& theMeshParams) const {
+    int64_t aSize = 0, aModifTime = 0;
+    if(myCacheFolder.isEmpty()
+    || StFileNode::isRemoteProtocolPath(theFile)
+    || !StFileNode::getFileInfo(theFile, aSize, aModifTime)) {
+        return StString();
+    }
+
+    const StString aKey = theFile + "|" + aSize + "|" + aModifTime + "|" + theMeshParams;
+    uint64_t aHash = hashFnv1a((const stUByte_t* )aKey.toCString(), aKey.getSize());
+
+    // hash the head and the tail of the file to detect modifications preserving size and time
+    StRawFile aFile;
+    if(!aFile.openFile(StRawFile::READ, theFile)) {
+        return StString();
+    }
+    std::vector<stUByte_t> aBuffer(THE_HASH_BLOCK);
+    size_t aRead = aFile.readRange(0, &aBuffer[0], aBuffer.size());
+    aHash = hashFnv1a(&aBuffer[0], aRead, aHash);
+    if(aSize > int64_t(THE_HASH_BLOCK)) {
+        aRead = aFile.readRange(stMax(aSize - int64_t(THE_HASH_BLOCK), int64_t(THE_HASH_BLOCK)), &aBuffer[0], aBuffer.size());
+        aHash = hashFnv1a(&aBuffer[0], aRead, aHash);
+    }
+    aFile.closeFile();
+
+    char aName[32];
+    stsprintf(aName, sizeof(aName), "%016llx.mesh", (unsigned long long )aHash);
+    return myCacheFolder + aName;
+}
+
+bool StAssetMeshCache::load(const Handle(StDocNode)& theParentNode,
+                            const StString&          theCachePath) const {
+    if(theCachePath.isEmpty()
+    || !StFileNode::isFileExists(theCachePath)) {
+        return false;
+    }
+
+    StReadAheadFile aFile;
+    if(!aFile.open(theCachePath, -1, true)) {
+        return false;
+    }
+
+    char     aMagic[sizeof(THE_CACHE_MAGIC)];
+    uint32_t aNbNodes = 0;
+    if(!readBytes(aFile, aMagic, sizeof(aMagic))
+    || ::memcmp(aMagic, THE_CACHE_MAGIC, sizeof(aMagic)) != 0
+    || !readValue(aFile, aNbNodes)) {
+        return false;
+    }
+
+    // read into temporary node to keep the document untouched on failure
+    Handle(StDocNode) aTmpParent = new StDocObjectNode();
+    for(uint32_t aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter) {
+        if(!readNode(aFile, aTmpParent, 0)) {
+            ST_ERROR_LOG("StAssetMeshCache, broken cache file '" + theCachePath + "'");
+            return false;
+        }
+    }
+
+    uint32_t anEnd = 0;
+    if(!readValue(aFile, anEnd)
+    || anEnd != THE_CACHE_END) {
+        ST_ERROR_LOG("StAssetMeshCache, incomplete cache file '" + theCachePath + "'");
+        return false;
+    }
+
+    theParentNode->ChangeChildren().Append(aTmpParent->ChangeChildren());
+    return true;
+}
+
+bool StAssetMeshCache::readNode(StReadAheadFile&         theFile,
+                                const Handle(StDocNode)& theParentNode,
+                                const int                theDepth) {
+    uint32_t aType = 0;
+    std::vector<char> aName;
+    if(theDepth > THE_DEPTH_MAX
+    || !readValue (theFile, aType)
+    || !readVector(theFile, aName)) {
+        return false;
+    }
+
+    Handle(StDocNode) aNode;
+    switch(aType) {
+        case StDocNodeType_Object: {
+            aNode = new StDocObjectNode();
+            break;
+        }
+        case StDocNodeType_Mesh: {
+            aNode = new StDocMeshNode();
+            break;
+        }
+        default: {
+            return false;
+        }
+    }
+
+    gp_Trsf aTrsf;
+    if(!readTrsf(theFile, aTrsf)) {
+        return false;
+    }
+    // length is passed in bytes, so terminate the UTF-8 string explicitly
+    aName.push_back('\0');
+    aNode->setNodeName(StString(&aName[0]));
+    aNode->setNodeTransformation(aTrsf);
+
+    if(aType == StDocNodeType_Mesh) {
+        Handle(StDocMeshNode) aMeshNode = Handle(StDocMeshNode)::DownCast(aNode);
+        uint32_t aNbArrays = 0;
+        if(!readValue(theFile, aNbArrays)) {
+            return false;
+        }
+        for(uint32_t anArrayIter = 0; anArrayIter < aNbArrays; ++anArrayIter) {
+            Handle(StPrimArray) anArray;
+            if(!readPrimArray(theFile, anArray)) {
+                return false;
+            }
+            aMeshNode->ChangePrimitiveArrays().Append(anArray);
+        }
+    }
+
+    uint32_t aNbChildren = 0;
+    if(!readValue(theFile, aNbChildren)) {
+        return false;
+    }
+    for(uint32_t aChildIter = 0; aChildIter < aNbChildren; ++aChildIter) {
+        if(!readNode(theFile, aNode, theDepth + 1)) {
+            return false;
+        }
+    }
+
+    theParentNode->ChangeChildren().Append(aNode);
+    return true;
+}
+
+bool StAssetMeshCache::readPrimArray(StReadAheadFile&     theFile,
+                                     Handle(StPrimArray)& theArray) {
+    theArray = new StPrimArray();
+    theArray->Material = new StGLMaterial();
+    StGLMaterial& aMat = *theArray->Material;
+    if(!readTrsf  (theFile, theArray->Trsf)
+    || !readValue (theFile, aMat.DiffuseColor)
+    || !readValue (theFile, aMat.AmbientColor)
+    || !readValue (theFile, aMat.SpecularColor)
+    || !readValue (theFile, aMat.EmissiveColor)
+    || !readValue (theFile, aMat.Params)
+    || !readVector(theFile, theArray->Positions)
+    || !readVector(theFile, theArray->Normals)
+    || !readVector(theFile, theArray->TexCoords0)
+    || !readVector(theFile, theArray->Indices)) {
+        return false;
+    }
+
+    // validate indices to avoid out of range access while rendering
+    const GLuint aNbNodes = (GLuint )theArray->Positions.size();
+    for(std::vector<GLuint>::const_iterator anIndexIter = theArray->Indices.begin(); anIndexIter != theArray->Indices.end(); ++anIndexIter) {
+        if(*anIndexIter >= aNbNodes) {
+            return false;
+        }
+    }
+    return theArray->Normals.size() == theArray->Positions.size();
+}
+
+bool StAssetMeshCache::save(const Handle(StDocNode)& theParentNode,
+                            const StString&          theCachePath) const {
+    if(theCachePath.isEmpty()
+    || theParentNode.IsNull()) {
+        return false;
+    }
+
+    if(!StFolder::isFolder(myCacheFolder)
+    && !StFolder::createFolder(myCacheFolder)) {
+        ST_ERROR_LOG("StAssetMeshCache, unable to create cache folder '" + myCacheFolder + "'");
+        return false;
+    }
+
+    // write into temporary file, so that interrupted writing does not leave broken cache
+    const StString aTmpPath = theCachePath + ".tmp";
+    StRawFile aFile(aTmpPath);
+    if(!aFile.openFile(StRawFile::WRITE)) {
+        ST_ERROR_LOG("StAssetMeshCache, unable to write '" + aTmpPath + "'");
+        return false;
+    }
+
+    aFile.write(THE_CACHE_MAGIC, sizeof(THE_CACHE_MAGIC));
+    writeValue(aFile, (uint32_t )theParentNode->Children().Size());
+    for(NCollection_Sequence<Handle(StDocNode)>::Iterator aChildIter(theParentNode->Children()); aChildIter.More(); aChildIter.Next()) {
+        writeNode(aFile, aChildIter.Value());
+    }
+    writeValue(aFile, THE_CACHE_END);
+    aFile.closeFile();
+
+    StFileNode::removeFile(theCachePath);
+    if(!StFileNode::moveFile(aTmpPath, theCachePath)) {
+        StFileNode::removeFile(aTmpPath);
+        return false;
+    }
+
+    // remove the oldest models to keep cache within limits
+    StFolder::trimFiles(myCacheFolder, "mesh", THE_CACHE_SIZE_MAX, THE_CACHE_AGE_MAX);
+    return true;
+}
+
+void StAssetMeshCache::writeNode(StRawFile&               theFile,
+                                 const Handle(StDocNode)& theNode) {
+    writeValue(theFile, (uint32_t )theNode->nodeType());
+    writeValue(theFile, (uint32_t )theNode->nodeName().getSize());
+    theFile.write(theNode->nodeName().toCString(), theNode->nodeName().getSize());
+    writeTrsf(theFile, theNode->nodeTransformation());
+
+    if(theNode->nodeType() == StDocNodeType_Mesh) {
+        Handle(StDocMeshNode) aMeshNode = Handle(StDocMeshNode)::DownCast(theNode);
+        writeValue(theFile, (uint32_t )aMeshNode->PrimitiveArrays().Size());
+        for(NCollection_Sequence<Handle(StPrimArray)>::Iterator anArrayIter(aMeshNode->PrimitiveArrays()); anArrayIter.More(); anArrayIter.Next()) {
+            writePrimArray(theFile, anArrayIter.Value());
+        }
+    }
+
+    writeValue(theFile, (uint32_t )theNode->Children().Size());
+    for(NCollection_Sequence<Handle(StDocNode)>::Iterator aChildIter(theNode->Children()); aChildIter.More(); aChildIter.Next()) {
+        writeNode(theFile, aChildIter.Value());
+    }
+}
+
+void StAssetMeshCache::writePrimArray(StRawFile&                 theFile,
+                                      const Handle(StPrimArray)& theArray) {
+    // textures are not stored - shapes imported from BRep have no textures
+    const StGLMaterial aDefMat;
+    const StGLMaterial& aMat = !theArray->Material.IsNull() ? *theArray->Material : aDefMat;
+    writeTrsf  (theFile, theArray->Trsf);
+    writeValue (theFile, aMat.DiffuseColor);
+    writeValue (theFile, aMat.AmbientColor);
+    writeValue (theFile, aMat.SpecularColor);
+    writeValue (theFile, aMat.EmissiveColor);
+    writeValue (theFile, aMat.Params);
+    writeVector(theFile, theArray->Positions);
+    writeVector(theFile, theArray->Normals);
+    writeVector(theFile, theArray->TexCoords0);
+    writeVector(theFile, theArray->Indices);
+}
@@ -0,0 +1,74 @@
+/**
+ * This source is a part of sView program.
+ *
+ * Copyright © Kirill Gavrilov, 2026
+ */
+
+#ifndef __StAssetMeshCache_h_
+#define __StAssetMeshCache_h_
+
+#include "StAssetDocument.h"
+
+class StRawFile;
+class StReadAheadFile;
+
+/**
+ * Persistent cache of triangulated models.
+ * Imported document (nodes hierarchy, transformations, materials and primitive arrays)
+ * is stored into binary file, so that re-opening the same model skips translation and meshing.
+ * The cache file is identified by the model file path, size, modification time,
+ * hash of the file head and tail and meshing parameters.
+ * The oldest files are removed when the cache folder exceeds size or age limits.
+ */
+class StAssetMeshCache {
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theCacheFolder folder to store cache files, cache is disabled when empty
+     */
+    ST_LOCAL StAssetMeshCache(const StString& theCacheFolder);
+
+    /**
+     * Return path to the cache file for specified model or empty string if cache can not be used.
+     * @param theFile       model file
+     * @param theMeshParams meshing parameters affecting the result
+     */
+    ST_LOCAL StString getCachePath(const StString& theFile,
+                                   const StString& theMeshParams) const;
+
+    /**
+     * Read cached document, the file is memory-mapped when possible.
+     * @param theParentNode node to append read nodes
+     * @param theCachePath  cache file path
+     * @return false if cache file is missing or broken
+     */
+    ST_LOCAL bool load(const Handle(StDocNode)& theParentNode,
+                       const StString&          theCachePath) const;
+
+    /**
+     * Store children of specified node into cache file.
+     */
+    ST_LOCAL bool save(const Handle(StDocNode)& theParentNode,
+                       const StString&          theCachePath) const;
+
+        private:
+
+    ST_LOCAL static bool readNode(StReadAheadFile&         theFile,
+                                  const Handle(StDocNode)& theParentNode,
+                                  const int                theDepth);
+    ST_LOCAL static bool readPrimArray(StReadAheadFile&     theFile,
+                                       Handle(StPrimArray)& theArray);
+    ST_LOCAL static void writeNode(StRawFile&               theFile,
+                                   const Handle(StDocNode)& theNode);
+    ST_LOCAL static void writePrimArray(StRawFile&                 theFile,
+                                        const Handle(StPrimArray)& theArray);
+
+        private:
+
+    StString myCacheFolder; //!< folder to store cache files
+
+};
+
+#endif // __StAssetMeshCache_h_
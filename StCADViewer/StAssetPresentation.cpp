@@ -5,6 +5,7 @@
  */
 
 #include "StAssetPresentation.h"
+#include "StPrimArrayOptimizer.h"
 
 #include <Graphic3d_ArrayOfTriangles.hxx>
 #include <NCollection_IndexedDataMap.hxx>
@@ -60,92 +61,121 @@ void StAssetPresentation::Compute (const Handle(PrsMgr_PresentationManager3d)& t
 
     for(NCollection_IndexedDataMap<Handle(StGLMaterial), StPrsPart, StGLMaterial>::Iterator aStyleIter(aStyleMap); aStyleIter.More(); aStyleIter.Next()) {
         const StPrsPart& aPrsPart = aStyleIter.Value();
-        Handle(Graphic3d_ArrayOfTriangles) aTris = new Graphic3d_ArrayOfTriangles(int(aPrsPart.NbNodes), int(aPrsPart.NbTris * 3), true, false, aPrsPart.HasTexCoord0);
+        if(!myToUse16BitIndices
+        || aPrsPart.NbNodes <= StPrimArrayOptimizer::THE_16BIT_NODES_MAX) {
+            addGroup(thePrs, aStyleIter.Key(), aPrsPart);
+            continue;
+        }
+
+        // split into batches small enough for 16-bit indices
+        StPrsPart aBatch;
+        aBatch.HasTexCoord0 = aPrsPart.HasTexCoord0;
         for(NCollection_Sequence<StLocatedPrimArray>::Iterator aPrimIter(aPrsPart.PrimArrays); aPrimIter.More(); aPrimIter.Next()) {
             const Handle(StPrimArray)& aPrims = aPrimIter.Value().PrimArray;
-            const gp_Trsf& aMeshTrsf = aPrimIter.Value().NodeTrsf;
-
-            const int aLowerVertex = aTris->VertexNumber() + 1;
-
-            const size_t aNbPrimNodes = aPrims->Positions.size();
-            const gp_Trsf aTrsf = aMeshTrsf * aPrims->Trsf;
-            if(aTrsf.Form() != gp_Identity) {
-                for(size_t aNodeIter = 0; aNodeIter < aNbPrimNodes; ++aNodeIter) {
-                    const StGLVec3& aPos = aPrims->Positions[aNodeIter];
-                    StGLVec3 aNorm = aPrims->Normals[aNodeIter];
-                    if(aNorm.modulus() != 0.0f) {
-                        gp_Dir aNormTrsf(aNorm.x(), aNorm.y(), aNorm.z());
-                        aNormTrsf.Transform(aTrsf);
-                        aNorm.x() = (float )aNormTrsf.X();
-                        aNorm.y() = (float )aNormTrsf.Y();
-                        aNorm.z() = (float )aNormTrsf.Z();
-                    }
-
-                    gp_Pnt aPosTrsf(aPos.x(),  aPos.y(),  aPos.z());
-                    aPosTrsf.Transform(aTrsf);
-                    aTris->AddVertex((float )aPosTrsf.X(), (float )aPosTrsf.Y(), (float )aPosTrsf.Z(),
-                                     aNorm.x(), aNorm.y(), aNorm.z());
-                }
-            } else {
-                for(size_t aNodeIter = 0; aNodeIter < aNbPrimNodes; ++aNodeIter) {
-                    const StGLVec3& aPos  = aPrims->Positions[aNodeIter];
-                    const StGLVec3& aNorm = aPrims->Normals  [aNodeIter];
-                    aTris->AddVertex(aPos.x(),  aPos.y(),  aPos.z(),
-                                     aNorm.x(), aNorm.y(), aNorm.z());
-                }
+            if(!aBatch.PrimArrays.IsEmpty()
+            &&  aBatch.NbNodes + aPrims->Positions.size() > StPrimArrayOptimizer::THE_16BIT_NODES_MAX) {
+                addGroup(thePrs, aStyleIter.Key(), aBatch);
+                aBatch.PrimArrays.Clear();
+                aBatch.NbNodes = 0;
+                aBatch.NbTris  = 0;
             }
+            aBatch.NbNodes += aPrims->Positions.size();
+            aBatch.NbTris  += aPrims->Indices.size() / 3;
+            aBatch.PrimArrays.Append(aPrimIter.Value());
+        }
+        if(!aBatch.PrimArrays.IsEmpty()) {
+            addGroup(thePrs, aStyleIter.Key(), aBatch);
+        }
+    }
+}
 
-            if(aPrsPart.HasTexCoord0
-            && aPrims->TexCoords0.size() == aPrims->Positions.size()) {
-                for(size_t aNodeIter = 0; aNodeIter < aNbPrimNodes; ++aNodeIter) {
-                    const StGLVec2& aTexCoord = aPrims->TexCoords0[aNodeIter];
-                    aTris->SetVertexTexel(aLowerVertex + int(aNodeIter), aTexCoord.x(), aTexCoord.y());
+void StAssetPresentation::addGroup(const Handle(Prs3d_Presentation)& thePrs,
+                                   const Handle(StGLMaterial)&       theMaterial,
+                                   const StPrsPart&                  thePart) {
+    Handle(Graphic3d_ArrayOfTriangles) aTris = new Graphic3d_ArrayOfTriangles(int(thePart.NbNodes), int(thePart.NbTris * 3), true, false, thePart.HasTexCoord0);
+    for(NCollection_Sequence<StLocatedPrimArray>::Iterator aPrimIter(thePart.PrimArrays); aPrimIter.More(); aPrimIter.Next()) {
+        const Handle(StPrimArray)& aPrims = aPrimIter.Value().PrimArray;
+        const gp_Trsf& aMeshTrsf = aPrimIter.Value().NodeTrsf;
+
+        const int aLowerVertex = aTris->VertexNumber() + 1;
+
+        const size_t aNbPrimNodes = aPrims->Positions.size();
+        const gp_Trsf aTrsf = aMeshTrsf * aPrims->Trsf;
+        if(aTrsf.Form() != gp_Identity) {
+            for(size_t aNodeIter = 0; aNodeIter < aNbPrimNodes; ++aNodeIter) {
+                const StGLVec3& aPos = aPrims->Positions[aNodeIter];
+                StGLVec3 aNorm = aPrims->Normals[aNodeIter];
+                if(aNorm.modulus() != 0.0f) {
+                    gp_Dir aNormTrsf(aNorm.x(), aNorm.y(), aNorm.z());
+                    aNormTrsf.Transform(aTrsf);
+                    aNorm.x() = (float )aNormTrsf.X();
+                    aNorm.y() = (float )aNormTrsf.Y();
+                    aNorm.z() = (float )aNormTrsf.Z();
                 }
-            }
 
-            const size_t aNbPrimIndices = aPrims->Indices.size();
-            for(size_t anIndexIter = 0; anIndexIter < aNbPrimIndices; ++anIndexIter) {
-                aTris->AddEdge(aLowerVertex + aPrims->Indices[anIndexIter]);
+                gp_Pnt aPosTrsf(aPos.x(),  aPos.y(),  aPos.z());
+                aPosTrsf.Transform(aTrsf);
+                aTris->AddVertex((float )aPosTrsf.X(), (float )aPosTrsf.Y(), (float )aPosTrsf.Z(),
+                                 aNorm.x(), aNorm.y(), aNorm.z());
+            }
+        } else {
+            for(size_t aNodeIter = 0; aNodeIter < aNbPrimNodes; ++aNodeIter) {
+                const StGLVec3& aPos  = aPrims->Positions[aNodeIter];
+                const StGLVec3& aNorm = aPrims->Normals  [aNodeIter];
+                aTris->AddVertex(aPos.x(),  aPos.y(),  aPos.z(),
+                                 aNorm.x(), aNorm.y(), aNorm.z());
             }
         }
 
-        const Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
-        Graphic3d_MaterialAspect aMat(Graphic3d_NOM_SILVER);
-        const Handle(StGLMaterial)& anStMat = aStyleIter.Key();
-        if(!anStMat.IsNull()) {
-            aMat = Graphic3d_MaterialAspect();
-            aMat.SetMaterialType(Graphic3d_MATERIAL_PHYSIC);
-            aMat.SetDiffuse (1.0f);
-            aMat.SetAmbient (1.0f);
-            aMat.SetSpecular(1.0f);
-            aMat.SetEmissive(1.0f);
-            if(anStMat->EmissiveColor.rgb() != StGLVec3(0.0f, 0.0f, 0.0f)) {
-                aMat.SetReflectionModeOn(Graphic3d_TOR_EMISSION);
+        if(thePart.HasTexCoord0
+        && aPrims->TexCoords0.size() == aPrims->Positions.size()) {
+            for(size_t aNodeIter = 0; aNodeIter < aNbPrimNodes; ++aNodeIter) {
+                const StGLVec2& aTexCoord = aPrims->TexCoords0[aNodeIter];
+                aTris->SetVertexTexel(aLowerVertex + int(aNodeIter), aTexCoord.x(), aTexCoord.y());
             }
-            aMat.SetDiffuseColor (Quantity_Color(anStMat->DiffuseColor.r(),  anStMat->DiffuseColor.g(),  anStMat->DiffuseColor.b(),  Quantity_TOC_RGB));
-            aMat.SetTransparency (float(1.0 - anStMat->DiffuseColor.a()));
-            aMat.SetAmbientColor (Quantity_Color(anStMat->AmbientColor.r(),  anStMat->AmbientColor.g(),  anStMat->AmbientColor.b(),  Quantity_TOC_RGB));
-            aMat.SetSpecularColor(Quantity_Color(anStMat->SpecularColor.r(), anStMat->SpecularColor.g(), anStMat->SpecularColor.b(), Quantity_TOC_RGB));
-            aMat.SetEmissiveColor(Quantity_Color(anStMat->EmissiveColor.r(), anStMat->EmissiveColor.g(), anStMat->EmissiveColor.b(), Quantity_TOC_RGB));
-            aMat.SetShininess(anStMat->Shine());
-            aMat.SetMaterialName(anStMat->Name.toCString());
         }
 
-        Handle(Graphic3d_AspectFillArea3d) anAspect = new Graphic3d_AspectFillArea3d(Aspect_IS_SOLID, aMat.Color(), aMat.Color(), Aspect_TOL_EMPTY, 1.0, aMat, aMat);
-        if(!anStMat.IsNull()) {
-            if(!anStMat->Texture.IsNull()) {
-                anAspect->SetTextureMap(anStMat->Texture);
-                anAspect->SetTextureMapOn();
-            }
-            anAspect->SetSuppressBackFaces(anStMat->ToCullBackFaces());
-            if(anStMat->ToCullBackFaces()) {
-                aGroup->SetClosed(true);
-            }
+        const size_t aNbPrimIndices = aPrims->Indices.size();
+        for(size_t anIndexIter = 0; anIndexIter < aNbPrimIndices; ++anIndexIter) {
+            aTris->AddEdge(aLowerVertex + aPrims->Indices[anIndexIter]);
         }
+    }
 
-        aGroup->SetGroupPrimitivesAspect(anAspect);
-        aGroup->AddPrimitiveArray(aTris);
+    const Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+    Graphic3d_MaterialAspect aMat(Graphic3d_NOM_SILVER);
+    if(!theMaterial.IsNull()) {
+        aMat = Graphic3d_MaterialAspect();
+        aMat.SetMaterialType(Graphic3d_MATERIAL_PHYSIC);
+        aMat.SetDiffuse (1.0f);
+        aMat.SetAmbient (1.0f);
+        aMat.SetSpecular(1.0f);
+        aMat.SetEmissive(1.0f);
+        if(theMaterial->EmissiveColor.rgb() != StGLVec3(0.0f, 0.0f, 0.0f)) {
+            aMat.SetReflectionModeOn(Graphic3d_TOR_EMISSION);
+        }
+        aMat.SetDiffuseColor (Quantity_Color(theMaterial->DiffuseColor.r(),  theMaterial->DiffuseColor.g(),  theMaterial->DiffuseColor.b(),  Quantity_TOC_RGB));
+        aMat.SetTransparency (float(1.0 - theMaterial->DiffuseColor.a()));
+        aMat.SetAmbientColor (Quantity_Color(theMaterial->AmbientColor.r(),  theMaterial->AmbientColor.g(),  theMaterial->AmbientColor.b(),  Quantity_TOC_RGB));
+        aMat.SetSpecularColor(Quantity_Color(theMaterial->SpecularColor.r(), theMaterial->SpecularColor.g(), theMaterial->SpecularColor.b(), Quantity_TOC_RGB));
+        aMat.SetEmissiveColor(Quantity_Color(theMaterial->EmissiveColor.r(), theMaterial->EmissiveColor.g(), theMaterial->EmissiveColor.b(), Quantity_TOC_RGB));
+        aMat.SetShininess(theMaterial->Shine());
+        aMat.SetMaterialName(theMaterial->Name.toCString());
     }
+
+    Handle(Graphic3d_AspectFillArea3d) anAspect = new Graphic3d_AspectFillArea3d(Aspect_IS_SOLID, aMat.Color(), aMat.Color(), Aspect_TOL_EMPTY, 1.0, aMat, aMat);
+    if(!theMaterial.IsNull()) {
+        if(!theMaterial->Texture.IsNull()) {
+            anAspect->SetTextureMap(theMaterial->Texture);
+            anAspect->SetTextureMapOn();
+        }
+        anAspect->SetSuppressBackFaces(theMaterial->ToCullBackFaces());
+        if(theMaterial->ToCullBackFaces()) {
+            aGroup->SetClosed(true);
+        }
+    }
+
+    aGroup->SetGroupPrimitivesAspect(anAspect);
+    aGroup->AddPrimitiveArray(aTris);
 }
 
 void StAssetPresentation::ComputeSelection (const Handle(SelectMgr_Selection)& ,
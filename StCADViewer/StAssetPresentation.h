@@ -11,6 +11,8 @@
 
 #include <AIS_InteractiveObject.hxx>
 
+struct StPrsPart;
+
 /**
  * Document node with cumulative transformation (including parent nodes).
  */
@@ -31,7 +33,7 @@ class StAssetPresentation : public AIS_InteractiveObject {
 
         public:
 
-    StAssetPresentation() {
+    StAssetPresentation() : myToUse16BitIndices(false) {
         SetDisplayMode(0);
     }
 
@@ -49,9 +51,20 @@ class StAssetPresentation : public AIS_InteractiveObject {
     void AddMeshNode(const Handle(StDocMeshNode)& theNode,
                      const gp_Trsf& theTrsf) { myDocNodes.Append(StDocLocatedMeshNode(theNode, theTrsf)); }
 
+    //! Split primitive arrays sharing the same material into batches small enough for 16-bit indices.
+    void SetToUse16BitIndices(const bool theToUse) { myToUse16BitIndices = theToUse; }
+
+        protected:
+
+    //! Add group for primitive arrays sharing the same material.
+    ST_LOCAL void addGroup(const Handle(Prs3d_Presentation)& thePrs,
+                           const Handle(StGLMaterial)&       theMaterial,
+                           const StPrsPart&                  thePart);
+
         protected:
 
     NCollection_Sequence<StDocLocatedMeshNode> myDocNodes;
+    bool myToUse16BitIndices; //!< split batches to use 16-bit indices
 
 };
 
@@ -14,10 +14,12 @@
 #include "StCADPluginInfo.h"
 #include "StAssetPresentation.h"
 #include "StAssetImportShape.h"
+#include "StPrimArrayOptimizer.h"
 #include "StAssetNodeIterator.h"
 
 #include <StStrings/StLangMap.h>
 #include <StFile/StRawFile.h>
+#include <StThreads/StTimer.h>
 
 const StString StCADLoader::ST_CAD_MIME_STRING(ST_CAD_PLUGIN_MIME_CHAR);
 const StMIMEList StCADLoader::ST_CAD_MIME_LIST(StCADLoader::ST_CAD_MIME_STRING);
@@ -25,13 +27,16 @@ const StArrayList<StString> StCADLoader::ST_CAD_EXTENSIONS_LIST(StCADLoader::ST_
 
 StCADLoader::StCADLoader(const StHandle<StLangMap>&  theLangMap,
                          const StHandle<StPlayList>& thePlayList,
+                         const StString&             theCacheFolder,
                          const bool                  theToStartThread)
 : myLangMap(theLangMap),
   myPlayList(thePlayList),
+  myCacheFolder(theCacheFolder),
   myEvLoadNext(false),
   myDefaultMat(Graphic3d_NOM_SILVER),
   myIsLoaded(false),
   myToQuit(false) {
+    params.ToOptimizeMeshes = new StBoolParamNamed(true, stCString("optimizeMeshes"));
     myPlayList->setExtensions(ST_CAD_EXTENSIONS_LIST);
     if(theToStartThread) {
         myThread = new StThread(threadFunction, (void* )this);
@@ -60,6 +65,7 @@ bool StCADLoader::loadModel(const StHandle<StFileNode>& theSource) {
       isGltf = StAssetImportGltf::probeFormatFromHeader((const char* )aRawFile.getBuffer(), anExt);
     }
 
+    const bool toOptimize = params.ToOptimizeMeshes->getValue();
     myDoc = new StAssetDocument();
     bool isRead = false;
     if(isGltf) {
@@ -67,14 +73,25 @@ bool StCADLoader::loadModel(const StHandle<StFileNode>& theSource) {
         aReader.signals.onError.connect(this, &StCADLoader::doOnErrorRedirect);
         isRead = aReader.load(myDoc, aFileToLoadPath);
     } else {
+        // shape importer optimizes meshes before caching them
         StAssetImportShape aReader;
         aReader.signals.onError.connect(this, &StCADLoader::doOnErrorRedirect);
+        aReader.setCacheFolder(myCacheFolder);
+        aReader.setToOptimizeMeshes(toOptimize);
         isRead = aReader.load(myDoc, aFileToLoadPath, aShapeFormat);
     }
 
+    if(isRead && toOptimize && isGltf) {
+        StTimer aTimer(true);
+        StPrimArrayOptimizer anOptimizer;
+        anOptimizer.perform(myDoc);
+        ST_DEBUG_LOG(anOptimizer.formatStatistics() + "\n  done in " + aTimer.getElapsedTimeInMilliSec() + " ms");
+    }
+
     NCollection_Sequence<Handle(AIS_InteractiveObject)> aPrsList;
     if(isRead) {
         Handle(StAssetPresentation) aShapePrs = new StAssetPresentation();
+        aShapePrs->SetToUse16BitIndices(toOptimize);
         for(StAssetNodeIterator aMeshNodeIter(myDoc, StDocNodeType_Mesh); aMeshNodeIter.more(); aMeshNodeIter.next()) {
             Handle(StDocMeshNode) aMeshNode = Handle(StDocMeshNode)::DownCast(aMeshNodeIter.value());
             aShapePrs->AddMeshNode(aMeshNode, aMeshNodeIter.location());
@@ -18,6 +18,7 @@
 #include <StFile/StMIMEList.h>
 #include <StGL/StPlayList.h>
 #include <StGLMesh/StGLMesh.h>
+#include <StSettings/StParam.h>
 #include <StSlots/StSignal.h>
 #include <StThreads/StThread.h>
 
@@ -34,8 +35,16 @@ class StCADLoader {
     static const StMIMEList ST_CAD_MIME_LIST;
     static const StArrayList<StString> ST_CAD_EXTENSIONS_LIST;
 
+    /**
+     * Main constructor.
+     * @param theLangMap       translations
+     * @param thePlayList      playlist
+     * @param theCacheFolder   folder for caching triangulated models, cache is disabled when empty
+     * @param theToStartThread start loading thread
+     */
     ST_LOCAL StCADLoader(const StHandle<StLangMap>&  theLangMap,
                          const StHandle<StPlayList>& thePlayList,
+                         const StString&             theCacheFolder,
                          const bool                  theToStartThread = true);
     ST_LOCAL virtual ~StCADLoader();
 
@@ -48,6 +57,14 @@ class StCADLoader {
     ST_LOCAL virtual bool getNextDoc(NCollection_Sequence<Handle(AIS_InteractiveObject)>& thePrsList,
                                      Handle(StAssetDocument)& theDoc);
 
+        public:  //!< Properties
+
+    struct {
+
+        StHandle<StBoolParamNamed> ToOptimizeMeshes; //!< optimize primitive arrays before uploading to GPU
+
+    } params;
+
         public:  //!< Signals
 
     struct {
@@ -80,6 +97,7 @@ class StCADLoader {
     StHandle<StThread>   myThread;
     StHandle<StLangMap>  myLangMap;
     StHandle<StPlayList> myPlayList;
+    StString             myCacheFolder; //!< folder for caching triangulated models
     StCondition          myEvLoadNext;
     Handle(StAssetDocument) myDoc;
     NCollection_Sequence<Handle(AIS_InteractiveObject)> myPrsList;
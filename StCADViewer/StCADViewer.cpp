@@ -48,6 +48,7 @@ void StCADViewer::updateStrings() {
     using namespace StCADViewerStrings;
     params.IsFullscreen->setName(tr(MENU_VIEW_FULLSCREEN));
     params.ToShowPlayList->setName(stCString("Show Playlist"));
+    params.ToOptimizeMeshes->setName(stCString("Optimize meshes"));
     params.ToShowFps->setName(tr(MENU_SHOW_FPS));
     params.ToShowTrihedron->setName(tr(MENU_VIEW_TRIHEDRON));
     params.ProjectMode->setName(tr(MENU_VIEW_PROJECTION));
@@ -78,6 +79,7 @@ StCADViewer::StCADViewer(const StHandle<StResourceManager>& theResMgr,
     params.ToShowPlayList  = new StBoolParamNamed(false, stCString("showPlaylist"));
     params.ToShowFps       = new StBoolParamNamed(false, stCString("toShowFps"));
     params.ToShowTrihedron = new StBoolParamNamed(true,  stCString("showTrihedron"));
+    params.ToOptimizeMeshes = new StBoolParamNamed(true, stCString("optimizeMeshes"));
     params.ProjectMode = new StEnumParam(ST_PROJ_STEREO, stCString("projMode"));
     params.ProjectMode->signals.onChanged.connect(this, &StCADViewer::doChangeProjection);
 
@@ -99,24 +101,25 @@ StCADViewer::StCADViewer(const StHandle<StResourceManager>& theResMgr,
     mySettings->loadInt32 (ST_SETTING_FPSTARGET,   params.TargetFps);
     mySettings->loadParam (params.ToShowFps);
     mySettings->loadParam (params.ToShowPlayList);
+    mySettings->loadParam (params.ToOptimizeMeshes);
 
     // workaround current limitations of OCCT - no support of viewport with offset
     const bool toForceFboUsage = true;
 #if defined(__ANDROID__)
-    addRenderer(new StOutInterlace  (myResMgr, theParentWin));
-    addRenderer(new StOutAnaglyph   (myResMgr, theParentWin));
+    addRenderer(stCString("StOutInterlace"),  &createRenderer<StOutInterlace>);
+    addRenderer(stCString("StOutAnaglyph"),   &createRenderer<StOutAnaglyph>);
     StOutDistorted* aDistOut = new StOutDistorted  (myResMgr, theParentWin);
     aDistOut->setForcedFboUsage(toForceFboUsage);
     addRenderer(aDistOut);
 #else
-    addRenderer(new StOutAnaglyph   (myResMgr, theParentWin));
-    addRenderer(new StOutDual       (myResMgr, theParentWin));
-    addRenderer(new StOutIZ3D       (myResMgr, theParentWin));
-    addRenderer(new StOutInterlace  (myResMgr, theParentWin));
+    addRenderer(stCString("StOutAnaglyph"),   &createRenderer<StOutAnaglyph>);
+    addRenderer(stCString("StOutDual"),       &createRenderer<StOutDual>);
+    addRenderer(stCString("StOutIZ3D"),       &createRenderer<StOutIZ3D>);
+    addRenderer(stCString("StOutInterlace"),  &createRenderer<StOutInterlace>);
     StOutDistorted* aDistOut = new StOutDistorted  (myResMgr, theParentWin);
     aDistOut->setForcedFboUsage(toForceFboUsage);
     addRenderer(aDistOut);
-    addRenderer(new StOutPageFlipExt(myResMgr, theParentWin));
+    addRenderer(stCString("StOutPageFlip"),   &createRenderer<StOutPageFlipExt>);
 #endif
 
     // need Depth buffer
@@ -125,10 +128,7 @@ StCADViewer::StCADViewer(const StHandle<StResourceManager>& theResMgr,
         StWinAttr_GlStencilSize, (StWinAttr )8,
         StWinAttr_NULL
     };
-    for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
-        StHandle<StWindow>& aRend = myRenderers[aRendIter];
-        aRend->setAttributes(anAttribs);
-    }
+    setRenderersAttributes(anAttribs);
 
     // create actions
     StHandle<StAction> anAction;
@@ -207,6 +207,7 @@ void StCADViewer::saveGuiParams() {
     mySettings->saveInt32(ST_SETTING_FPSTARGET, params.TargetFps);
     mySettings->saveParam(params.ToShowFps);
     mySettings->saveParam(params.ToShowPlayList);
+    mySettings->saveParam(params.ToOptimizeMeshes);
 }
 
 void StCADViewer::saveAllParams() {
@@ -432,8 +433,10 @@ bool StCADViewer::init() {
 
     // create working threads
     if(!isReset) {
-        myCADLoader = new StCADLoader(myLangMap, myPlayList);
+        const StString aCacheFolder = myResMgr->getCacheFolder();
+        myCADLoader = new StCADLoader(myLangMap, myPlayList, !aCacheFolder.isEmpty() ? aCacheFolder + "meshes" : StString());
         myCADLoader->signals.onError = stSlot(myMsgQueue.access(), &StMsgQueue::doPushError);
+        myCADLoader->params.ToOptimizeMeshes = params.ToOptimizeMeshes;
     }
 
     if(isReset) {
@@ -150,6 +150,7 @@ class StCADViewer : public StApplication {
         StHandle<StEnumParam>         ProjectMode;     //!< projection mode
         StHandle<StFloat32Param>      ZFocus;          //!< stereoscopic ZFocus value
         StHandle<StFloat32Param>      StereoIOD;       //!< stereoscopic IOD value
+        StHandle<StBoolParamNamed>    ToOptimizeMeshes;//!< optimize meshes before uploading to GPU
         StString                      LastFolder;      //!< laster folder used to open / save file
         int                           TargetFps;       //!< limit or not rendering FPS
 
@@ -0,0 +1,513 @@
+/**
+ * This source is a part of sView program.
+ *
+ * Copyright © Kirill Gavrilov, 2026
+ */
+
+#include "StPrimArrayOptimizer.h"
+#include "StAssetNodeIterator.h"
+
+#include <NCollection_Map.hxx>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+    /**
+     * Cache size within Forsyth's vertex scoring model.
+     */
+    static const int THE_FORSYTH_CACHE_SIZE = 32;
+
+    /**
+     * Size of simulated FIFO vertex cache for statistics.
+     */
+    static const size_t THE_FIFO_CACHE_SIZE = 16;
+
+    /**
+     * Arrays with lesser number of vertices are considered for merging.
+     */
+    static const size_t THE_MERGE_NODES_MAX = 4096;
+
+    /**
+     * Vertex key for welding.
+     */
+    struct StVertexKey {
+        uint32_t Pos[3];  //!< position bits
+        int32_t  Norm[3]; //!< quantized normal
+        uint32_t Uv[2];   //!< texture coordinates bits
+
+        bool isLess(const StVertexKey& theOther) const {
+            for(int anIter = 0; anIter < 3; ++anIter) {
+                if(Pos[anIter] != theOther.Pos[anIter]) {
+                    return Pos[anIter] < theOther.Pos[anIter];
+                }
+            }
+            for(int anIter = 0; anIter < 3; ++anIter) {
+                if(Norm[anIter] != theOther.Norm[anIter]) {
+                    return Norm[anIter] < theOther.Norm[anIter];
+                }
+            }
+            for(int anIter = 0; anIter < 2; ++anIter) {
+                if(Uv[anIter] != theOther.Uv[anIter]) {
+                    return Uv[anIter] < theOther.Uv[anIter];
+                }
+            }
+            return false;
+        }
+
+        bool isEqual(const StVertexKey& theOther) const {
+            return !isLess(theOther) && !theOther.isLess(*this);
+        }
+    };
+
+    /**
+     * Functor sorting vertex indices by their keys, the first vertex goes first within equal keys.
+     */
+    struct StVertexKeyLess {
+        const std::vector<StVertexKey>& Keys;
+
+        StVertexKeyLess(const std::vector<StVertexKey>& theKeys) : Keys(theKeys) {}
+
+        bool operator()(const GLuint theIndex1, const GLuint theIndex2) const {
+            if(Keys[theIndex1].isLess(Keys[theIndex2])) {
+                return true;
+            } else if(Keys[theIndex2].isLess(Keys[theIndex1])) {
+                return false;
+            }
+            return theIndex1 < theIndex2;
+        }
+    };
+
+    static uint32_t floatBits(const float theValue) {
+        // treat -0.0 as +0.0
+        const float aValue = theValue == 0.0f ? 0.0f : theValue;
+        uint32_t aBits = 0;
+        std::memcpy(&aBits, &aValue, sizeof(aBits));
+        return aBits;
+    }
+
+    static int32_t quantizeNormal(const float theValue) {
+        const float aValue = stMin(stMax(theValue, -1.0f), 1.0f);
+        return int32_t(std::floor(aValue * 32767.0f + 0.5f));
+    }
+
+    /**
+     * Vertex score within Forsyth's linear-speed vertex cache optimization.
+     */
+    static float computeVertexScore(const int theCachePos,
+                                    const int theNbTrisLeft) {
+        if(theNbTrisLeft == 0) {
+            return -1.0f;
+        }
+
+        float aScore = 0.0f;
+        if(theCachePos >= 0) {
+            if(theCachePos < 3) {
+                // the last triangle vertices get fixed score to avoid using them in the next triangle
+                aScore = 0.75f;
+            } else {
+                const float aScale = 1.0f / float(THE_FORSYTH_CACHE_SIZE - 3);
+                aScore = std::pow(1.0f - float(theCachePos - 3) * aScale, 1.5f);
+            }
+        }
+
+        // boost vertices with few triangles left to avoid leaving lonely triangles
+        aScore += 2.0f * std::pow(float(theNbTrisLeft), -0.5f);
+        return aScore;
+    }
+
+    static bool isEqualTrsf(const gp_Trsf& theTrsf1,
+                            const gp_Trsf& theTrsf2) {
+        if(theTrsf1.Form() != theTrsf2.Form()) {
+            return false;
+        }
+        for(int aRowIter = 1; aRowIter <= 3; ++aRowIter) {
+            for(int aColIter = 1; aColIter <= 4; ++aColIter) {
+                if(theTrsf1.Value(aRowIter, aColIter) != theTrsf2.Value(aRowIter, aColIter)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static bool hasTexCoords(const StPrimArray& theArray) {
+        return !theArray.TexCoords0.empty()
+             && theArray.TexCoords0.size() == theArray.Positions.size();
+    }
+
+    /**
+     * Return true if array can be modified safely.
+     */
+    static bool isValidArray(const StPrimArray& theArray) {
+        if(theArray.Normals.size() != theArray.Positions.size()
+        || (!theArray.TexCoords0.empty() && !hasTexCoords(theArray))
+        || theArray.Indices.size() % 3 != 0) {
+            return false;
+        }
+
+        const GLuint aNbNodes = (GLuint )theArray.Positions.size();
+        for(std::vector<GLuint>::const_iterator anIndexIter = theArray.Indices.begin(); anIndexIter != theArray.Indices.end(); ++anIndexIter) {
+            if(*anIndexIter >= aNbNodes) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
+
+StPrimArrayOptimizer::StPrimArrayOptimizer() {
+    //
+}
+
+void StPrimArrayOptimizer::addStatistics(Statistics&        theStats,
+                                         const StPrimArray& theArray,
+                                         const bool         theToUse16Bit) {
+    const size_t aNodeSize = sizeof(StGLVec3) * 2 + (hasTexCoords(theArray) ? sizeof(StGLVec2) : 0);
+    const size_t anIndexSize = theToUse16Bit && theArray.Positions.size() <= THE_16BIT_NODES_MAX ? 2 : 4;
+    ++theStats.NbArrays;
+    theStats.NbNodes  += theArray.Positions.size();
+    theStats.NbTris   += theArray.Indices.size() / 3;
+    theStats.NbBytes  += theArray.Positions.size() * aNodeSize + theArray.Indices.size() * anIndexSize;
+    theStats.NbMisses += double(computeCacheMisses(theArray));
+}
+
+void StPrimArrayOptimizer::perform(const Handle(StDocNode)& theRoot) {
+    myStatsBefore = Statistics();
+    myStatsAfter  = Statistics();
+
+    // the same mesh node or primitive array might be instanced several times within the document
+    NCollection_Map<Handle(Standard_Transient)> aVisitedNodes;
+    NCollection_Map<Handle(Standard_Transient)> aVisitedArrays;
+    for(StAssetNodeIterator aMeshNodeIter(theRoot, StDocNodeType_Mesh); aMeshNodeIter.more(); aMeshNodeIter.next()) {
+        Handle(StDocMeshNode) aMeshNode = Handle(StDocMeshNode)::DownCast(aMeshNodeIter.value());
+        if(aMeshNode.IsNull()
+        || !aVisitedNodes.Add(aMeshNode)) {
+            continue;
+        }
+
+        for(NCollection_Sequence<Handle(StPrimArray)>::Iterator aPrimIter(aMeshNode->PrimitiveArrays()); aPrimIter.More(); aPrimIter.Next()) {
+            if(aVisitedArrays.Contains(aPrimIter.Value())) {
+                continue;
+            }
+            // legacy upload merges all arrays of the same material into single array with 32-bit indices
+            addStatistics(myStatsBefore, *aPrimIter.Value(), false);
+        }
+
+        mergeArrays(aMeshNode);
+        for(NCollection_Sequence<Handle(StPrimArray)>::Iterator aPrimIter(aMeshNode->PrimitiveArrays()); aPrimIter.More(); aPrimIter.Next()) {
+            const Handle(StPrimArray)& anArray = aPrimIter.Value();
+            if(!aVisitedArrays.Add(anArray)) {
+                continue;
+            }
+
+            if(isValidArray(*anArray)) {
+                weldVertices(*anArray);
+                optimizeVertexCache(*anArray);
+                optimizeVertexFetch(*anArray);
+            }
+            addStatistics(myStatsAfter, *anArray, true);
+        }
+    }
+}
+
+void StPrimArrayOptimizer::mergeArrays(const Handle(StDocMeshNode)& theNode) {
+    NCollection_Sequence<Handle(StPrimArray)>& anArrays = theNode->ChangePrimitiveArrays();
+    if(anArrays.Size() < 2) {
+        return;
+    }
+
+    NCollection_Sequence<Handle(StPrimArray)> aResult;
+    std::vector<bool> anIsMerged;   // merged arrays are new objects which can be modified
+    std::vector<bool> anIsMergeable;
+    for(NCollection_Sequence<Handle(StPrimArray)>::Iterator aPrimIter(anArrays); aPrimIter.More(); aPrimIter.Next()) {
+        const Handle(StPrimArray)& anArray = aPrimIter.Value();
+        if(anArray->Positions.size() >= THE_MERGE_NODES_MAX
+        || !isValidArray(*anArray)) {
+            aResult.Append(anArray);
+            anIsMerged.push_back(false);
+            anIsMergeable.push_back(false);
+            continue;
+        }
+
+        int aTarget = 0;
+        for(int anIter = 1; anIter <= aResult.Size(); ++anIter) {
+            const Handle(StPrimArray)& aCandidate = aResult.Value(anIter);
+            if(anIsMergeable[anIter - 1]
+            && aCandidate->Positions.size() < THE_16BIT_NODES_MAX - anArray->Positions.size()
+            && hasTexCoords(*aCandidate) == hasTexCoords(*anArray)
+            && StGLMaterial::IsEqual(aCandidate->Material, anArray->Material)
+            && isEqualTrsf(aCandidate->Trsf, anArray->Trsf)) {
+                aTarget = anIter;
+                break;
+            }
+        }
+        if(aTarget == 0) {
+            aResult.Append(anArray);
+            anIsMerged.push_back(false);
+            anIsMergeable.push_back(true);
+            continue;
+        }
+
+        if(!anIsMerged[aTarget - 1]) {
+            const Handle(StPrimArray)& aSource = aResult.Value(aTarget);
+            Handle(StPrimArray) aCopy = new StPrimArray();
+            aCopy->Positions  = aSource->Positions;
+            aCopy->Normals    = aSource->Normals;
+            aCopy->TexCoords0 = aSource->TexCoords0;
+            aCopy->Indices    = aSource->Indices;
+            aCopy->Material   = aSource->Material;
+            aCopy->Trsf       = aSource->Trsf;
+            aResult.ChangeValue(aTarget) = aCopy;
+            anIsMerged[aTarget - 1] = true;
+        }
+
+        const Handle(StPrimArray)& aMerged = aResult.Value(aTarget);
+        const GLuint aLower = (GLuint )aMerged->Positions.size();
+        aMerged->Positions .insert(aMerged->Positions .end(), anArray->Positions .begin(), anArray->Positions .end());
+        aMerged->Normals   .insert(aMerged->Normals   .end(), anArray->Normals   .begin(), anArray->Normals   .end());
+        aMerged->TexCoords0.insert(aMerged->TexCoords0.end(), anArray->TexCoords0.begin(), anArray->TexCoords0.end());
+        aMerged->Indices.reserve(aMerged->Indices.size() + anArray->Indices.size());
+        for(std::vector<GLuint>::const_iterator anIndexIter = anArray->Indices.begin(); anIndexIter != anArray->Indices.end(); ++anIndexIter) {
+            aMerged->Indices.push_back(aLower + *anIndexIter);
+        }
+    }
+    anArrays.Assign(aResult);
+}
+
+void StPrimArrayOptimizer::weldVertices(StPrimArray& theArray) {
+    const size_t aNbNodes = theArray.Positions.size();
+    if(aNbNodes == 0) {
+        return;
+    }
+
+    const bool hasUV = hasTexCoords(theArray);
+    std::vector<StVertexKey> aKeys(aNbNodes);
+    std::vector<GLuint>      anOrder(aNbNodes);
+    for(size_t aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter) {
+        StVertexKey& aKey = aKeys[aNodeIter];
+        const StGLVec3& aPos  = theArray.Positions[aNodeIter];
+        const StGLVec3& aNorm = theArray.Normals[aNodeIter];
+        for(int anIter = 0; anIter < 3; ++anIter) {
+            aKey.Pos [anIter] = floatBits(aPos.getData()[anIter]);
+            aKey.Norm[anIter] = quantizeNormal(aNorm.getData()[anIter]);
+        }
+        aKey.Uv[0] = hasUV ? floatBits(theArray.TexCoords0[aNodeIter].x()) : 0;
+        aKey.Uv[1] = hasUV ? floatBits(theArray.TexCoords0[aNodeIter].y()) : 0;
+        anOrder[aNodeIter] = GLuint(aNodeIter);
+    }
+    std::sort(anOrder.begin(), anOrder.end(), StVertexKeyLess(aKeys));
+
+    // map each vertex to the first vertex with the same key
+    std::vector<GLuint> aRemap(aNbNodes);
+    GLuint aUnique = anOrder[0];
+    for(size_t anIter = 0; anIter < aNbNodes; ++anIter) {
+        const GLuint aNode = anOrder[anIter];
+        if(anIter != 0
+        && !aKeys[aNode].isEqual(aKeys[aUnique])) {
+            aUnique = aNode;
+        }
+        aRemap[aNode] = aUnique;
+    }
+
+    // remove degenerated triangles, unused vertices are removed by optimizeVertexFetch()
+    size_t aNbIndices = 0;
+    for(size_t anIndexIter = 0; anIndexIter + 2 < theArray.Indices.size(); anIndexIter += 3) {
+        const GLuint aNode0 = aRemap[theArray.Indices[anIndexIter + 0]];
+        const GLuint aNode1 = aRemap[theArray.Indices[anIndexIter + 1]];
+        const GLuint aNode2 = aRemap[theArray.Indices[anIndexIter + 2]];
+        if(aNode0 == aNode1
+        || aNode1 == aNode2
+        || aNode0 == aNode2) {
+            continue;
+        }
+        theArray.Indices[aNbIndices++] = aNode0;
+        theArray.Indices[aNbIndices++] = aNode1;
+        theArray.Indices[aNbIndices++] = aNode2;
+    }
+    theArray.Indices.resize(aNbIndices);
+}
+
+void StPrimArrayOptimizer::optimizeVertexCache(StPrimArray& theArray) {
+    const size_t aNbNodes = theArray.Positions.size();
+    const size_t aNbTris  = theArray.Indices.size() / 3;
+    if(aNbTris < 2) {
+        return;
+    }
+
+    // build vertex -> triangles adjacency
+    std::vector<int> aNbTrisLeft(aNbNodes, 0);
+    for(size_t anIndexIter = 0; anIndexIter < aNbTris * 3; ++anIndexIter) {
+        ++aNbTrisLeft[theArray.Indices[anIndexIter]];
+    }
+    std::vector<size_t> anAdjOffsets(aNbNodes + 1, 0);
+    for(size_t aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter) {
+        anAdjOffsets[aNodeIter + 1] = anAdjOffsets[aNodeIter] + size_t(aNbTrisLeft[aNodeIter]);
+    }
+    std::vector<GLuint> anAdjTris(aNbTris * 3);
+    {
+        std::vector<size_t> aFill(anAdjOffsets.begin(), anAdjOffsets.end() - 1);
+        for(size_t anIndexIter = 0; anIndexIter < aNbTris * 3; ++anIndexIter) {
+            anAdjTris[aFill[theArray.Indices[anIndexIter]]++] = GLuint(anIndexIter / 3);
+        }
+    }
+
+    std::vector<int>   aCachePos(aNbNodes, -1);
+    std::vector<float> aNodeScores(aNbNodes);
+    for(size_t aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter) {
+        aNodeScores[aNodeIter] = computeVertexScore(-1, aNbTrisLeft[aNodeIter]);
+    }
+
+    std::vector<float> aTriScores(aNbTris);
+    std::vector<bool>  anIsAdded (aNbTris, false);
+    int   aBestTri   = -1;
+    float aBestScore = -1.0f;
+    for(size_t aTriIter = 0; aTriIter < aNbTris; ++aTriIter) {
+        aTriScores[aTriIter] = aNodeScores[theArray.Indices[aTriIter * 3 + 0]]
+                             + aNodeScores[theArray.Indices[aTriIter * 3 + 1]]
+                             + aNodeScores[theArray.Indices[aTriIter * 3 + 2]];
+        if(aTriScores[aTriIter] > aBestScore) {
+            aBestScore = aTriScores[aTriIter];
+            aBestTri   = int(aTriIter);
+        }
+    }
+
+    std::vector<GLuint> aResult;
+    aResult.reserve(aNbTris * 3);
+    std::vector<GLuint> aCache, aNewCache;
+    aCache.reserve(THE_FORSYTH_CACHE_SIZE + 3);
+    aNewCache.reserve(THE_FORSYTH_CACHE_SIZE + 3);
+    size_t aScanCursor = 0;
+    while(aResult.size() < aNbTris * 3) {
+        if(aBestTri < 0) {
+            // no candidates within the cache - take the next remaining triangle
+            while(anIsAdded[aScanCursor]) {
+                ++aScanCursor;
+            }
+            aBestTri = int(aScanCursor);
+        }
+
+        const GLuint* aTriNodes = &theArray.Indices[size_t(aBestTri) * 3];
+        anIsAdded[aBestTri] = true;
+        aNewCache.clear();
+        for(int aNodeIter = 0; aNodeIter < 3; ++aNodeIter) {
+            const GLuint aNode = aTriNodes[aNodeIter];
+            aResult.push_back(aNode);
+            aNewCache.push_back(aNode);
+
+            // remove emitted triangle from the list of active vertex triangles
+            GLuint* anAdjFrom = &anAdjTris[anAdjOffsets[aNode]];
+            GLuint* anAdjTo   = anAdjFrom + aNbTrisLeft[aNode];
+            GLuint* aFound    = std::find(anAdjFrom, anAdjTo, GLuint(aBestTri));
+            if(aFound != anAdjTo) {
+                std::swap(*aFound, *(anAdjTo - 1));
+                --aNbTrisLeft[aNode];
+            }
+        }
+        for(std::vector<GLuint>::const_iterator aCacheIter = aCache.begin(); aCacheIter != aCache.end(); ++aCacheIter) {
+            if(*aCacheIter != aTriNodes[0]
+            && *aCacheIter != aTriNodes[1]
+            && *aCacheIter != aTriNodes[2]) {
+                aNewCache.push_back(*aCacheIter);
+            }
+        }
+
+        // update scores of vertices within the cache and evicted ones
+        for(size_t aCacheIter = 0; aCacheIter < aNewCache.size(); ++aCacheIter) {
+            const GLuint aNode = aNewCache[aCacheIter];
+            aCachePos  [aNode] = aCacheIter < size_t(THE_FORSYTH_CACHE_SIZE) ? int(aCacheIter) : -1;
+            aNodeScores[aNode] = computeVertexScore(aCachePos[aNode], aNbTrisLeft[aNode]);
+        }
+
+        aBestTri   = -1;
+        aBestScore = -1.0f;
+        for(size_t aCacheIter = 0; aCacheIter < aNewCache.size(); ++aCacheIter) {
+            const GLuint aNode = aNewCache[aCacheIter];
+            const GLuint* anAdjFrom = &anAdjTris[anAdjOffsets[aNode]];
+            for(int anAdjIter = 0; anAdjIter < aNbTrisLeft[aNode]; ++anAdjIter) {
+                const GLuint aTri = anAdjFrom[anAdjIter];
+                const float aScore = aNodeScores[theArray.Indices[aTri * 3 + 0]]
+                                   + aNodeScores[theArray.Indices[aTri * 3 + 1]]
+                                   + aNodeScores[theArray.Indices[aTri * 3 + 2]];
+                aTriScores[aTri] = aScore;
+                if(aScore > aBestScore) {
+                    aBestScore = aScore;
+                    aBestTri   = int(aTri);
+                }
+            }
+        }
+
+        if(aNewCache.size() > size_t(THE_FORSYTH_CACHE_SIZE)) {
+            aNewCache.resize(THE_FORSYTH_CACHE_SIZE);
+        }
+        aCache.swap(aNewCache);
+    }
+    theArray.Indices.swap(aResult);
+}
+
+void StPrimArrayOptimizer::optimizeVertexFetch(StPrimArray& theArray) {
+    const size_t aNbNodes = theArray.Positions.size();
+    const bool   hasUV    = hasTexCoords(theArray);
+    std::vector<GLuint> aRemap(aNbNodes, GLuint(-1));
+    std::vector<StGLVec3> aPositions, aNormals;
+    std::vector<StGLVec2> aTexCoords;
+    aPositions.reserve(aNbNodes);
+    aNormals  .reserve(aNbNodes);
+    if(hasUV) {
+        aTexCoords.reserve(aNbNodes);
+    }
+
+    for(std::vector<GLuint>::iterator anIndexIter = theArray.Indices.begin(); anIndexIter != theArray.Indices.end(); ++anIndexIter) {
+        const GLuint aNode = *anIndexIter;
+        if(aRemap[aNode] == GLuint(-1)) {
+            aRemap[aNode] = GLuint(aPositions.size());
+            aPositions.push_back(theArray.Positions[aNode]);
+            aNormals  .push_back(theArray.Normals  [aNode]);
+            if(hasUV) {
+                aTexCoords.push_back(theArray.TexCoords0[aNode]);
+            }
+        }
+        *anIndexIter = aRemap[aNode];
+    }
+
+    theArray.Positions .swap(aPositions);
+    theArray.Normals   .swap(aNormals);
+    theArray.TexCoords0.swap(aTexCoords);
+}
+
+size_t StPrimArrayOptimizer::computeCacheMisses(const StPrimArray& theArray) {
+    GLuint aCache[THE_FIFO_CACHE_SIZE];
+    size_t aCacheSize = 0;
+    size_t aCacheHead = 0;
+    size_t aNbMisses  = 0;
+    for(std::vector<GLuint>::const_iterator anIndexIter = theArray.Indices.begin(); anIndexIter != theArray.Indices.end(); ++anIndexIter) {
+        if(std::find(aCache, aCache + aCacheSize, *anIndexIter) != aCache + aCacheSize) {
+            continue;
+        }
+
+        ++aNbMisses;
+        aCache[aCacheHead] = *anIndexIter;
+        aCacheHead = (aCacheHead + 1) % THE_FIFO_CACHE_SIZE;
+        aCacheSize = stMin(aCacheSize + 1, THE_FIFO_CACHE_SIZE);
+    }
+    return aNbMisses;
+}
+
+StString StPrimArrayOptimizer::formatStatistics() const {
+    char aBuffer[512];
+    stsprintf(aBuffer, sizeof(aBuffer),
+              "Mesh optimization:\n"
+              "  arrays    %u -> %u\n"
+              "  vertices  %u -> %u\n"
+              "  triangles %u -> %u\n"
+              "  memory    %.1f -> %.1f KiB\n"
+              "  ACMR      %.3f -> %.3f",
+              (unsigned int )myStatsBefore.NbArrays, (unsigned int )myStatsAfter.NbArrays,
+              (unsigned int )myStatsBefore.NbNodes,  (unsigned int )myStatsAfter.NbNodes,
+              (unsigned int )myStatsBefore.NbTris,   (unsigned int )myStatsAfter.NbTris,
+              double(myStatsBefore.NbBytes) / 1024.0, double(myStatsAfter.NbBytes) / 1024.0,
+              myStatsBefore.getAcmr(), myStatsAfter.getAcmr());
+    return StString(aBuffer);
+}
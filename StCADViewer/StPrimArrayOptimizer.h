@@ -0,0 +1,119 @@
+/**
+ * This source is a part of sView program.
+ *
+ * Copyright © Kirill Gavrilov, 2026
+ */
+
+#ifndef __StPrimArrayOptimizer_h_
+#define __StPrimArrayOptimizer_h_
+
+#include "StAssetDocument.h"
+
+/**
+ * Optimization pass for imported primitive arrays before uploading them to GPU:
+ * - merging of small primitive arrays sharing the same material and transformation within mesh node;
+ * - welding of duplicated vertices (normals are compared with 16-bit precision);
+ * - removal of degenerated triangles;
+ * - reordering of triangles for the post-transform vertex cache (Forsyth's linear-speed algorithm);
+ * - reordering of vertices in order of their first use for better vertex fetch locality.
+ */
+class StPrimArrayOptimizer {
+
+        public:
+
+    /**
+     * Graphic3d_ArrayOfPrimitives uses 16-bit indices for arrays with lesser number of vertices.
+     */
+    static const size_t THE_16BIT_NODES_MAX = 65534;
+
+        public:
+
+    /**
+     * Statistics of primitive arrays.
+     */
+    struct Statistics {
+        size_t NbArrays;    //!< number of primitive arrays
+        size_t NbNodes;     //!< number of vertices
+        size_t NbTris;      //!< number of triangles
+        size_t NbBytes;     //!< estimated GPU memory for vertex and index buffers
+        double NbMisses;    //!< simulated number of vertex cache misses
+
+        Statistics() : NbArrays(0), NbNodes(0), NbTris(0), NbBytes(0), NbMisses(0.0) {}
+
+        /**
+         * Return average cache miss ratio (vertex shader invocations per triangle).
+         */
+        double getAcmr() const { return NbTris != 0 ? NbMisses / double(NbTris) : 0.0; }
+    };
+
+        public:
+
+    /**
+     * Empty constructor.
+     */
+    ST_LOCAL StPrimArrayOptimizer();
+
+    /**
+     * Optimize all mesh nodes within the document.
+     */
+    ST_LOCAL void perform(const Handle(StDocNode)& theRoot);
+
+    /**
+     * Return statistics before optimization.
+     */
+    ST_LOCAL const Statistics& getStatsBefore() const { return myStatsBefore; }
+
+    /**
+     * Return statistics after optimization.
+     */
+    ST_LOCAL const Statistics& getStatsAfter() const { return myStatsAfter; }
+
+    /**
+     * Format before/after statistics.
+     */
+    ST_LOCAL StString formatStatistics() const;
+
+        public:
+
+    /**
+     * Merge duplicated vertices and remove degenerated triangles.
+     */
+    ST_LOCAL static void weldVertices(StPrimArray& theArray);
+
+    /**
+     * Reorder triangles to reduce post-transform vertex cache misses.
+     */
+    ST_LOCAL static void optimizeVertexCache(StPrimArray& theArray);
+
+    /**
+     * Reorder vertices in order of their first use by triangles and drop unused vertices.
+     */
+    ST_LOCAL static void optimizeVertexFetch(StPrimArray& theArray);
+
+    /**
+     * Simulate FIFO vertex cache and return the number of misses.
+     */
+    ST_LOCAL static size_t computeCacheMisses(const StPrimArray& theArray);
+
+        private:
+
+    /**
+     * Merge small primitive arrays with the same material and transformation.
+     */
+    ST_LOCAL static void mergeArrays(const Handle(StDocMeshNode)& theNode);
+
+    /**
+     * Append primitive array to statistics.
+     */
+    ST_LOCAL static void addStatistics(Statistics&        theStats,
+                                       const StPrimArray& theArray,
+                                       const bool         theToUse16Bit);
+
+        private:
+
+    Statistics myStatsBefore; //!< statistics before optimization
+    Statistics myStatsAfter;  //!< statistics after optimization
+
+};
+
+#endif // __StPrimArrayOptimizer_h_
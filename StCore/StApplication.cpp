@@ -14,10 +14,14 @@
 #include <StGL/StGLContext.h>
 #include <StGLStereo/StFormatEnum.h>
 #include <StFile/StFileNode.h>
+#include <StFile/StRawFile.h>
+#include <StThreads/StStartupTrace.h>
 #include <StVersion.h>
 
 #include "StEventsBuffer.h"
 
+#include <cstring>
+
 namespace stAV
 {
   ST_CPPIMPORT bool init(int theLogLevel);
@@ -29,6 +33,7 @@ namespace {
     static const StCString ST_SETTING_RENDERER      = stCString("rendererPlugin");
     static const StCString ST_SETTING_AUTO_VALUE    = stCString("Auto");
     static const StCString ST_SETTING_DEF_DRAWER    = stCString("defaultDrawer");
+    static const StCString ST_SETTING_DEVICES_CACHE = stCString("devicesCache.");
 
     /**
      * Auxiliary parameter.
@@ -70,10 +75,10 @@ void StApplication::doChangeDevice(const int32_t theValue) {
     }
 
     mySwitchTo.nullify();
-    const StHandle<StOutDevice>& aDev = myDevices[theValue];
+    const StHandle<StOutDevice> aDev = myDevices[theValue];
     for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
-        StHandle<StWindow>& aRend = myRenderers[aRendIter];
-        if(aDev->PluginId == aRend->getRendererId()) {
+        if(aDev->PluginId == myRendererIds[aRendIter]) {
+            const StHandle<StWindow>& aRend = getRenderer(aRendIter);
             if(aRend->setDevice(aDev->DeviceId)
             || aRend != myWindow) {
                 mySwitchTo = aRend;
@@ -86,7 +91,8 @@ void StApplication::doChangeDevice(const int32_t theValue) {
 StApplication::StApplication(const StHandle<StResourceManager>& theResMgr,
                              const StNativeWin_t                theParentWin,
                              const StHandle<StOpenInfo>&        theOpenInfo)
-: myResMgr(theResMgr),
+: myToTraceStartup(false),
+  myResMgr(theResMgr),
   myMsgQueue(new StMsgQueue()),
   myEventsBuffer(new StEventsBuffer()),
   myWinParent(theParentWin),
@@ -106,6 +112,7 @@ void StApplication::stApplicationInit(const StHandle<StOpenInfo>& theOpenInfo) {
 #ifdef ST_DEBUG_GL
     myGlDebug = true;
 #endif
+    StStartupTrace::Phase aTracePhase("settings load");
     StSettings aGlobalSettings(myResMgr, "sview");
     params.ActiveDevice = new StEnumParam(0, stCString("activeDevice"), stCString("Change device"));
     params.ActiveDevice->signals.onChanged.connect(this, &StApplication::doChangeDevice);
@@ -139,9 +146,11 @@ void StApplication::stApplicationInit(const StHandle<StOpenInfo>& theOpenInfo) {
     const StString ARGUMENT_PLUGIN_OUT        = "out";
     const StString ARGUMENT_PLUGIN_OUT_DEVICE = "outDevice";
     const StString ARGUMENT_GLDEBUG           = "gldebug";
+    const StString ARGUMENT_STARTUP_TRACE     = "startupTrace";
     StArgument anArgRenderer = anArgs[ARGUMENT_PLUGIN_OUT];
     StArgument anArgDevice   = anArgs[ARGUMENT_PLUGIN_OUT_DEVICE];
     StArgument anArgGlDebug  = anArgs[ARGUMENT_GLDEBUG];
+    StArgument anArgTrace    = anArgs[ARGUMENT_STARTUP_TRACE];
     if(anArgRenderer.isValid()) {
         myRendId = anArgRenderer.getValue();
     }
@@ -151,6 +160,17 @@ void StApplication::stApplicationInit(const StHandle<StOpenInfo>& theOpenInfo) {
     if(anArgGlDebug.isValid()) {
         myGlDebug = true;
     }
+    if(anArgTrace.isValid()) {
+        // --startupTrace prints trace into log, --startupTrace=file writes it into the file
+        myToTraceStartup = true;
+        if(!anArgTrace.getValue().isEmpty()
+        && !anArgTrace.getValue().isEqualsIgnoreCase(stCString("on"))) {
+            myStartupTraceFile = anArgTrace.getValue();
+        }
+    } else {
+        // trace has not been requested - stop recording
+        StStartupTrace::finish();
+    }
 }
 
 StApplication::~StApplication() {
@@ -191,9 +211,8 @@ bool StApplication::open() {
             bool isAuto = myRendId.isEqualsIgnoreCase(ST_SETTING_AUTO_VALUE);
             if(!isAuto) {
                 for(size_t anIter = 0; anIter < myRenderers.size(); ++anIter) {
-                    StHandle<StWindow> aWin = myRenderers[anIter];
-                    if(myRendId == aWin->getRendererId()) {
-                        myWindow = aWin;
+                    if(myRendId == myRendererIds[anIter]) {
+                        myWindow = getRenderer(anIter);
                         aGlobalSettings.saveString(ST_SETTING_RENDERER,      myRendId);
                         aGlobalSettings.saveBool  (ST_SETTING_RENDERER_AUTO, isAuto);
                         break;
@@ -210,24 +229,13 @@ bool StApplication::open() {
                 // autodetection
                 aGlobalSettings.saveString(ST_SETTING_RENDERER,      ST_SETTING_AUTO_VALUE);
                 aGlobalSettings.saveBool  (ST_SETTING_RENDERER_AUTO, isAuto);
-                myWindow = myRenderers[0];
-                if(!myDevices.isEmpty()) {
-                    StHandle<StOutDevice> aBestDev = myDevices[0];
-                    for(size_t aDevIter = 0; aDevIter < myDevices.size(); ++aDevIter) {
-                        const StHandle<StOutDevice>& aDev = myDevices[aDevIter];
-                        if(aDev->Priority > aBestDev->Priority) {
-                            aBestDev = aDev;
-                        }
-                    }
-                    for(size_t anIter = 0; anIter < myRenderers.size(); ++anIter) {
-                        const StHandle<StWindow>& aWin = myRenderers[anIter];
-                        if(aBestDev->PluginId == aWin->getRendererId()) {
-                            myWindow = aWin;
-                            myWindow->setDevice(aBestDev->DeviceId);
-                            break;
-                        }
-                    }
-                }
+                selectBestRenderer();
+            }
+
+            // cached priorities depend on connected displays, which are known after creation of the first renderer
+            if(validateDevicesCache()
+            && isAuto) {
+                selectBestRenderer();
             }
         }
         myWindow->setTitle(myTitle);
@@ -252,7 +260,10 @@ bool StApplication::open() {
     };
     myWindow->setAttributes(anAttribs);
 
-    myIsOpened = myWindow->create();
+    {
+        StStartupTrace::Phase aTracePhase("window and GL context creation");
+        myIsOpened = myWindow->create();
+    }
     if(myIsOpened) {
         // connect slots
         myWindow->signals.onRedraw    = stSlot(this, &StApplication::doDrawProxy);
@@ -275,20 +286,278 @@ bool StApplication::open() {
     return myIsOpened;
 }
 
+void StApplication::selectBestRenderer() {
+    if(!myDevices.isEmpty()) {
+        StHandle<StOutDevice> aBestDev = myDevices[0];
+        for(size_t aDevIter = 0; aDevIter < myDevices.size(); ++aDevIter) {
+            const StHandle<StOutDevice>& aDev = myDevices[aDevIter];
+            if(aDev->Priority > aBestDev->Priority) {
+                aBestDev = aDev;
+            }
+        }
+        for(size_t anIter = 0; anIter < myRenderers.size(); ++anIter) {
+            if(aBestDev->PluginId == myRendererIds[anIter]) {
+                myWindow = getRenderer(anIter);
+                myWindow->setDevice(aBestDev->DeviceId);
+                return;
+            }
+        }
+    }
+    if(myWindow.isNull()) {
+        myWindow = getRenderer(0);
+    }
+}
+
+void StApplication::setupRenderer(const StHandle<StWindow>& theRenderer) {
+    theRenderer->params.VSyncMode = params.VSyncMode; // share VSync mode between renderers
+    theRenderer->setMessagesQueue(myMsgQueue);
+    if(!myRendererAttribs.empty()) {
+        theRenderer->setAttributes(&myRendererAttribs[0]);
+    }
+}
+
+void StApplication::registerDevices(const StHandle<StWindow>& theRenderer) {
+    StOutDevicesList aDevices;
+    theRenderer->getDevices(aDevices);
+    for(size_t aDevIter = 0; aDevIter < aDevices.size(); ++aDevIter) {
+        const StHandle<StOutDevice>& aDev = aDevices[aDevIter];
+        bool isCached = false;
+        for(size_t anOldIter = 0; anOldIter < myDevices.size(); ++anOldIter) {
+            StHandle<StOutDevice>& anOldDev = myDevices.changeValue(anOldIter);
+            if(anOldDev->PluginId == aDev->PluginId
+            && anOldDev->DeviceId == aDev->DeviceId) {
+                anOldDev = aDev;
+                params.ActiveDevice->defineOption((int32_t )anOldIter, aDev->Name);
+                isCached = true;
+                break;
+            }
+        }
+        if(!isCached) {
+            myDevices.add(aDev);
+            params.ActiveDevice->changeValues().add(aDev->Name);
+        }
+    }
+
+    // remove cached devices not reported by the renderer anymore;
+    // active device index is synchronized by its identifier after the next frame
+    const StString aRendererId = theRenderer->getRendererId();
+    for(size_t anOldIter = myDevices.size(); anOldIter > 0; --anOldIter) {
+        const StHandle<StOutDevice>& anOldDev = myDevices[anOldIter - 1];
+        if(anOldDev->PluginId != aRendererId) {
+            continue;
+        }
+
+        bool isFound = false;
+        for(size_t aDevIter = 0; aDevIter < aDevices.size(); ++aDevIter) {
+            if(aDevices[aDevIter]->DeviceId == anOldDev->DeviceId) {
+                isFound = true;
+                break;
+            }
+        }
+        if(!isFound) {
+            myDevices.remove(anOldIter - 1);
+            params.ActiveDevice->changeValues().remove(anOldIter - 1);
+        }
+    }
+}
+
 void StApplication::addRenderer(const StHandle<StWindow>& theRenderer) {
     if(theRenderer.isNull()) {
         return;
     }
 
-    StHandle<StWindow> aRenderer = theRenderer;
-    aRenderer->params.VSyncMode = params.VSyncMode; // share VSync mode between renderers
-    aRenderer->setMessagesQueue(myMsgQueue);
-    myRenderers.add(aRenderer);
-    size_t aDevIter = myDevices.size();
-    aRenderer->getDevices(myDevices);
-    for(; aDevIter < myDevices.size(); ++aDevIter) {
-        params.ActiveDevice->changeValues().add(myDevices[aDevIter]->Name);
+    setupRenderer(theRenderer);
+    myRenderers.add(theRenderer);
+    myRendererIds.add(theRenderer->getRendererId());
+    myRendererFactories.push_back(NULL);
+    myRendererMonitors.push_back(StString());
+    registerDevices(theRenderer);
+}
+
+void StApplication::addRenderer(const StString&         theRendererId,
+                                const RendererFactory_t theFactory) {
+    if(theFactory == NULL) {
+        return;
+    }
+
+    myRenderers.add(StHandle<StWindow>());
+    myRendererIds.add(theRendererId);
+    myRendererFactories.push_back(theFactory);
+    myRendererMonitors.push_back(StString());
+    if(!loadDevicesCache(theRendererId, myRendererMonitors.back())) {
+        getRenderer(myRenderers.size() - 1);
+    }
+}
+
+const StHandle<StWindow>& StApplication::getRenderer(const size_t theIndex) {
+    StHandle<StWindow>& aRenderer = myRenderers.changeValue(theIndex);
+    if(aRenderer.isNull()) {
+        StStartupTrace::Phase aTracePhase("renderer init ", myRendererIds[theIndex].toCString());
+        aRenderer = myRendererFactories[theIndex](myResMgr, myWinParent);
+        aRenderer->setTitle(myTitle);
+        setupRenderer(aRenderer);
+        registerDevices(aRenderer);
+        saveDevicesCache(aRenderer);
+    }
+    return aRenderer;
+}
+
+void StApplication::setRenderersAttributes(const StWinAttr* theAttributes) {
+    if(theAttributes == NULL) {
+        return;
+    }
+
+    // merge with previously defined attributes
+    for(const StWinAttr* anAttrib = theAttributes; *anAttrib != StWinAttr_NULL; anAttrib += 2) {
+        bool isFound = false;
+        for(size_t anOldIter = 0; anOldIter + 1 < myRendererAttribs.size(); anOldIter += 2) {
+            if(myRendererAttribs[anOldIter] == anAttrib[0]) {
+                myRendererAttribs[anOldIter + 1] = anAttrib[1];
+                isFound = true;
+                break;
+            }
+        }
+        if(!isFound) {
+            if(!myRendererAttribs.empty()) {
+                myRendererAttribs.pop_back(); // NULL-termination
+            }
+            myRendererAttribs.push_back(anAttrib[0]);
+            myRendererAttribs.push_back(anAttrib[1]);
+            myRendererAttribs.push_back(StWinAttr_NULL);
+        }
+    }
+
+    for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
+        const StHandle<StWindow>& aRend = myRenderers[aRendIter];
+        if(!aRend.isNull()) {
+            aRend->setAttributes(theAttributes);
+        }
+    }
+}
+
+const StString& StApplication::getDevicesCacheKey() {
+    if(myDevicesCacheKey.isEmpty()) {
+        // device names are translated
+        myDevicesCacheKey = StVersionInfo::getSDKVersionString();
+        if(!myLangMap.isNull()) {
+            myDevicesCacheKey += StString("|") + myLangMap->getLanguageCode();
+        }
+    }
+    return myDevicesCacheKey;
+}
+
+StString StApplication::getMonitorsCacheKey(const StHandle<StWindow>& theRenderer) {
+    // devices priorities depend on connected displays
+    const StSearchMonitors& aMonitors = theRenderer->getMonitors();
+    StString aKey;
+    for(size_t aMonIter = 0; aMonIter < aMonitors.size(); ++aMonIter) {
+        aKey += StString("|") + aMonitors[aMonIter].toString();
+    }
+    return aKey;
+}
+
+bool StApplication::validateDevicesCache() {
+    if(myWindow.isNull()) {
+        return false;
+    }
+
+    // displays list is scanned on renderer creation, so that validation does not require another scan
+    StStartupTrace::Phase aTracePhase("devices cache validation");
+    const StString aMonitorsKey = getMonitorsCacheKey(myWindow);
+    bool isOutdated = false;
+    for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
+        if(myRenderers[aRendIter].isNull()
+        && myRendererMonitors[aRendIter] != aMonitorsKey) {
+            getRenderer(aRendIter);
+            isOutdated = true;
+        }
+    }
+    return isOutdated;
+}
+
+bool StApplication::loadDevicesCache(const StString& theRendererId,
+                                     StString&       theMonitorsKey) {
+    StSettings aGlobalSettings(myResMgr, "sview");
+    const StString aPrefix = StString(ST_SETTING_DEVICES_CACHE) + theRendererId + ".";
+    StString aKey;
+    int32_t  aNbDevices = 0;
+    if(!aGlobalSettings.loadString(aPrefix + "key", aKey)
+    || !aGlobalSettings.loadString(aPrefix + "monitors", theMonitorsKey)
+    || !aGlobalSettings.loadInt32 (aPrefix + "count", aNbDevices)
+    ||  aKey != getDevicesCacheKey()) {
+        return false;
+    }
+
+    StOutDevicesList aDevices;
+    for(int32_t aDevIter = 0; aDevIter < aNbDevices; ++aDevIter) {
+        const StString aDevPrefix = aPrefix + aDevIter + ".";
+        StHandle<StOutDevice> aDev = new StOutDevice();
+        aDev->PluginId = theRendererId;
+        aDev->Priority = ST_DEVICE_SUPPORT_NONE;
+        if(!aGlobalSettings.loadString(aDevPrefix + "id",       aDev->DeviceId)
+        || !aGlobalSettings.loadString(aDevPrefix + "name",     aDev->Name)
+        || !aGlobalSettings.loadInt32 (aDevPrefix + "priority", aDev->Priority)) {
+            return false;
+        }
+        aGlobalSettings.loadString(aDevPrefix + "desc", aDev->Desc);
+        aDevices.add(aDev);
+    }
+
+    for(size_t aDevIter = 0; aDevIter < aDevices.size(); ++aDevIter) {
+        myDevices.add(aDevices[aDevIter]);
+        params.ActiveDevice->changeValues().add(aDevices[aDevIter]->Name);
+    }
+    return true;
+}
+
+void StApplication::saveDevicesCache(const StHandle<StWindow>& theRenderer) {
+    StOutDevicesList aDevices;
+    theRenderer->getDevices(aDevices);
+
+    StSettings aGlobalSettings(myResMgr, "sview");
+    const StString aPrefix = StString(ST_SETTING_DEVICES_CACHE) + theRenderer->getRendererId() + ".";
+    for(size_t aDevIter = 0; aDevIter < aDevices.size(); ++aDevIter) {
+        if(aDevices[aDevIter]->IsProbed) {
+            // priorities detected at runtime (connected HMD, quad-buffer support) might change without changing the key,
+            // so that such renderer should be always created for auto-selection
+            aGlobalSettings.saveString(aPrefix + "key", StString());
+            return;
+        }
+    }
+
+    aGlobalSettings.saveString(aPrefix + "key",      getDevicesCacheKey());
+    aGlobalSettings.saveString(aPrefix + "monitors", getMonitorsCacheKey(theRenderer));
+    aGlobalSettings.saveInt32 (aPrefix + "count",    (int32_t )aDevices.size());
+    for(size_t aDevIter = 0; aDevIter < aDevices.size(); ++aDevIter) {
+        const StHandle<StOutDevice>& aDev = aDevices[aDevIter];
+        const StString aDevPrefix = aPrefix + aDevIter + ".";
+        aGlobalSettings.saveString(aDevPrefix + "id",       aDev->DeviceId);
+        aGlobalSettings.saveString(aDevPrefix + "name",     aDev->Name);
+        aGlobalSettings.saveString(aDevPrefix + "desc",     aDev->Desc);
+        aGlobalSettings.saveInt32 (aDevPrefix + "priority", aDev->Priority);
+    }
+}
+
+void StApplication::finishStartupTrace() {
+    StStartupTrace::mark("first frame");
+    StStartupTrace::finish();
+    if(!myToTraceStartup) {
+        return;
+    }
+
+    const StString aTrace = StStartupTrace::format();
+    if(myStartupTraceFile.isEmpty()) {
+        StLogger::GetDefault().write(aTrace, StLogger::ST_INFO);
+        return;
+    }
+
+    StRawFile aFile(myStartupTraceFile);
+    if(!aFile.openFile(StRawFile::WRITE)) {
+        ST_ERROR_LOG("Unable to write startup trace into '" + myStartupTraceFile + "'");
+        return;
     }
+    aFile.write(aTrace);
+    aFile.closeFile();
 }
 
 void StApplication::beforeDraw() {
@@ -502,6 +771,9 @@ void StApplication::processEvents() {
     // draw iteration
     beforeDraw();
     myWindow->stglDraw();
+    if(!StStartupTrace::isFinished()) {
+        finishStartupTrace();
+    }
 
     const StString aDevice = myWindow->getDeviceId();
     const int32_t  aDevNum = params.ActiveDevice->getValue();
@@ -516,10 +788,11 @@ void StApplication::processEvents() {
             myToQuit = true;
         }
         mySwitchTo.nullify();
-    } else if(aDevNum >= 0
-           && size_t(aDevNum) < myDevices.size()
-           && aDevice != myDevices[aDevNum]->DeviceId) {
-        // device was changed by renderer itself - synchronize value
+    } else if(aDevNum < 0
+           || size_t(aDevNum) >= myDevices.size()
+           || aDevice != myDevices[aDevNum]->DeviceId
+           || ::strcmp(myDevices[aDevNum]->PluginId.toCString(), myWindow->getRendererId()) != 0) {
+        // device was changed by renderer itself or devices list has been changed - synchronize value
         const StString aPlugin = myWindow->getRendererId();
         for(size_t aDevIter = 0; aDevIter < myDevices.size(); ++aDevIter) {
             const StHandle<StOutDevice>& anOutDev = myDevices[aDevIter];
@@ -662,9 +935,12 @@ void StApplication::doChangeLanguage(const int32_t ) {
     myToRecreateMenu = true;
     myLangMap->resetReloaded();
 
+    // not yet created renderers keep cached device names until created
     for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
         StHandle<StWindow>& aRend = myRenderers[aRendIter];
-        aRend->doChangeLanguage();
+        if(!aRend.isNull()) {
+            aRend->doChangeLanguage();
+        }
     }
 
     for(size_t aDevIter = 0; aDevIter < myDevices.size(); ++aDevIter) {
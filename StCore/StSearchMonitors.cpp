@@ -10,6 +10,7 @@
 #include <StSettings/StSettings.h>
 #include <StStrings/StStringStream.h>
 #include <StThreads/StMutex.h>
+#include <StThreads/StStartupTrace.h>
 #include <StThreads/StTimer.h>
 
 #ifdef _WIN32
@@ -596,6 +597,7 @@ namespace {
 }
 
 void StSearchMonitors::initGlobal() {
+    StStartupTrace::Phase aTracePhase("monitors scan");
     clear();
     initFromSystem();
 #if !defined(__ANDROID__)
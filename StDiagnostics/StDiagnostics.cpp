@@ -44,16 +44,16 @@ StDiagnostics::StDiagnostics(const StHandle<StResourceManager>& theResMgr,
     myGUI = new StDiagnosticsGUI(this);
 
 #if defined(__ANDROID__)
-    addRenderer(new StOutInterlace  (myResMgr, theParentWin));
-    addRenderer(new StOutAnaglyph   (myResMgr, theParentWin));
-    addRenderer(new StOutDistorted  (myResMgr, theParentWin));
+    addRenderer(stCString("StOutInterlace"),  &createRenderer<StOutInterlace>);
+    addRenderer(stCString("StOutAnaglyph"),   &createRenderer<StOutAnaglyph>);
+    addRenderer(stCString("StOutDistorted"),  &createRenderer<StOutDistorted>);
 #else
-    addRenderer(new StOutAnaglyph   (myResMgr, theParentWin));
-    addRenderer(new StOutDual       (myResMgr, theParentWin));
-    addRenderer(new StOutIZ3D       (myResMgr, theParentWin));
-    addRenderer(new StOutInterlace  (myResMgr, theParentWin));
-    addRenderer(new StOutDistorted  (myResMgr, theParentWin));
-    addRenderer(new StOutPageFlipExt(myResMgr, theParentWin));
+    addRenderer(stCString("StOutAnaglyph"),   &createRenderer<StOutAnaglyph>);
+    addRenderer(stCString("StOutDual"),       &createRenderer<StOutDual>);
+    addRenderer(stCString("StOutIZ3D"),       &createRenderer<StOutIZ3D>);
+    addRenderer(stCString("StOutInterlace"),  &createRenderer<StOutInterlace>);
+    addRenderer(stCString("StOutDistorted"),  &createRenderer<StOutDistorted>);
+    addRenderer(stCString("StOutPageFlip"),   &createRenderer<StOutPageFlipExt>);
 #endif
 
     // create actions
@@ -1,6 +1,6 @@
 /**
  * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
- * Copyright © 2010-2019 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2010-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * This code is licensed under MIT license (see docs/license-mit.txt for details).
  */
@@ -11,7 +11,17 @@
 #include <StGLCore/StGLCore20.h>
 #include <StFile/StRawFile.h>
 
+#include <cmath>
+#include <vector>
+
+#ifndef GL_RGB16
+    #define GL_RGB16 0x8054
+#endif
+
 namespace {
+    //! Texture unit for 3D LUT, units 0-3 are occupied by image planes.
+    static const GLint THE_LUT_TEXTURE_UNIT = 4;
+
     const char F_DEF_2D_ALPHA[] =
         "#define stSampler sampler2D\n"
         "#define stTexture(theSampler, theCoords) texture2D(theSampler, theCoords.xy)\n"
@@ -41,8 +51,18 @@ void StGLImageProgram::regToRgb(const StGLContext& theCtx,
 
 StGLImageProgram::StGLImageProgram()
 : myColorScale(1.0f, 1.0f, 1.0f),
-  myIsRegistered(false) {
+  myIsRegistered(false),
+  myLutTexture(0),
+  myTimerIter(0),
+  myIsTimerInit(false),
+  myHasTimer(false) {
     myTitle = "StGLImageProgram";
+    stMemZero(myLutKey,       sizeof(myLutKey));
+    stMemZero(myTimerQueries, sizeof(myTimerQueries));
+    stMemZero(myGpuTimeMs,    sizeof(myGpuTimeMs));
+    for(int aTimerIter = 0; aTimerIter < THE_NB_TIMERS; ++aTimerIter) {
+        myTimerVariants[aTimerIter] = -1;
+    }
 
     params.gamma = new StFloat32Param(1.0f);
     params.gamma->setMinMaxValues(0.05f, 99.0f);
@@ -64,6 +84,8 @@ StGLImageProgram::StGLImageProgram()
     params.saturation->setDefValue(1.0f);
     params.saturation->setStep(0.05f);
     params.saturation->setTolerance(0.0001f);
+
+    params.toUseLut = new StBoolParamNamed(false, stCString("colorLut"), stCString("Color LUT"));
 }
 
 void StGLImageProgram::registerFragments(const StGLContext& theCtx) {
@@ -108,6 +130,13 @@ void StGLImageProgram::registerFragments(const StGLContext& theCtx) {
         "void applyCorrection(inout vec4 color) {\n"
         "    color = uColorProcessing * color;\n"
         "}\n\n");
+    registerFragmentShaderPart(FragSection_Correct, FragCorrect_Lut,
+        "uniform sampler3D uColorLut;\n"
+        "uniform vec2 uColorLutScale;\n" // scale and offset mapping [0, 1] range to the centers of boundary texels
+        "void applyCorrection(inout vec4 color) {\n"
+        "    vec3 aCoords = clamp(color.rgb, 0.0, 1.0) * uColorLutScale.x + uColorLutScale.y;\n"
+        "    color.rgb = texture3D(uColorLut, aCoords).rgb;\n"
+        "}\n\n");
 
     registerFragmentShaderPart(FragSection_Gamma, FragGamma_Off,
         "void applyGamma(inout vec4 color) {}\n\n");
@@ -446,6 +475,29 @@ StGLImageProgram::~StGLImageProgram() {
     //
 }
 
+void StGLImageProgram::release(StGLContext& theCtx) {
+    if(myLutTexture != 0) {
+        theCtx.core20fwd->glDeleteTextures(1, &myLutTexture);
+        myLutTexture = 0;
+    }
+    stMemZero(myLutKey, sizeof(myLutKey));
+
+#if !defined(GL_ES_VERSION_2_0)
+    if(myHasTimer) {
+        theCtx.extAll->glDeleteQueries(THE_NB_TIMERS * 2, myTimerQueries);
+    }
+#endif
+    stMemZero(myTimerQueries, sizeof(myTimerQueries));
+    for(int aTimerIter = 0; aTimerIter < THE_NB_TIMERS; ++aTimerIter) {
+        myTimerVariants[aTimerIter] = -1;
+    }
+    myTimerIter   = 0;
+    myIsTimerInit = false;
+    myHasTimer    = false;
+
+    StGLProgramMatrix<1, 6, StGLMeshProgram>::release(theCtx);
+}
+
 void StGLImageProgram::setTextureSizePx(StGLContext&    theCtx,
                                         const StGLVec2& theVec2) {
     theCtx.core20fwd->glUniform2fv(uniTexSizePxLoc, 1, theVec2);
@@ -473,7 +525,7 @@ void StGLImageProgram::setCubeTextureFlipZ(StGLContext& theCtx,
 }
 
 void StGLImageProgram::setupCorrection(StGLContext& theCtx) {
-    if(getFragmentShaderPart(FragSection_Correct) == FragCorrect_Off) {
+    if(getFragmentShaderPart(FragSection_Correct) != FragCorrect_On) {
         return;
     }
 
@@ -486,6 +538,183 @@ void StGLImageProgram::setupCorrection(StGLContext& theCtx) {
     theCtx.core20fwd->glUniformMatrix4fv(uniColorProcessingLoc, 1, GL_FALSE, aColorMat);
 }
 
+bool StGLImageProgram::hasLutSupport(StGLContext& theCtx) const {
+#if !defined(GL_ES_VERSION_2_0)
+    return theCtx.extAll->glTexImage3D != NULL;
+#else
+    (void )theCtx;
+    return false;
+#endif
+}
+
+bool StGLImageProgram::setupLut(StGLContext& theCtx) {
+#if !defined(GL_ES_VERSION_2_0)
+    const GLfloat aKey[6] = {
+        params.brightness->getValue(),
+        params.saturation->getValue(),
+        params.gamma->getValue(),
+        myColorScale.r(), myColorScale.g(), myColorScale.b()
+    };
+    if(myLutTexture != 0
+    && stAreEqual(aKey[0], myLutKey[0], 0.0001f)
+    && stAreEqual(aKey[1], myLutKey[1], 0.0001f)
+    && stAreEqual(aKey[2], myLutKey[2], 0.0001f)
+    && stAreEqual(aKey[3], myLutKey[3], 0.0001f)
+    && stAreEqual(aKey[4], myLutKey[4], 0.0001f)
+    && stAreEqual(aKey[5], myLutKey[5], 0.0001f)) {
+        return true;
+    }
+
+    // same matrix as in setupCorrection()
+    StGLBrightnessMatrix aBrightness;
+    StGLSaturationMatrix aSaturation;
+    aBrightness.setBrightness(params.brightness->getValue());
+    aSaturation.setSaturation(params.saturation->getValue());
+    StGLMatrix aColorMat = StGLMatrix::multiply(aSaturation, aBrightness);
+    aColorMat.scale(myColorScale.r(), myColorScale.g(), myColorScale.b());
+
+    const bool   hasGamma  = !stAreEqual(params.gamma->getValue(), 1.0f, 0.0001f);
+    const double aGammaRev = 1.0 / double(params.gamma->getValue());
+    const double aStep     = 1.0 / double(THE_LUT_SIZE - 1);
+    std::vector<GLushort> aData(size_t(THE_LUT_SIZE * THE_LUT_SIZE * THE_LUT_SIZE) * 3);
+    size_t anIndex = 0;
+    for(GLsizei aBlueIter = 0; aBlueIter < THE_LUT_SIZE; ++aBlueIter) {
+        for(GLsizei aGreenIter = 0; aGreenIter < THE_LUT_SIZE; ++aGreenIter) {
+            for(GLsizei aRedIter = 0; aRedIter < THE_LUT_SIZE; ++aRedIter) {
+                const double aColorIn[4] = { aStep * aRedIter, aStep * aGreenIter, aStep * aBlueIter, 1.0 };
+                for(size_t aCompIter = 0; aCompIter < 3; ++aCompIter) {
+                    double aValue = 0.0;
+                    for(size_t aColIter = 0; aColIter < 4; ++aColIter) {
+                        aValue += double(aColorMat.getValue(aCompIter, aColIter)) * aColorIn[aColIter];
+                    }
+                    aValue = stMax(aValue, 0.0);
+                    if(hasGamma) {
+                        aValue = std::pow(aValue, aGammaRev);
+                    }
+                    aData[anIndex++] = GLushort(stMin(aValue, 1.0) * 65535.0 + 0.5);
+                }
+            }
+        }
+    }
+
+    // drain errors left by preceding calls to check only the upload below
+    theCtx.stglResetErrors();
+    const bool isNew = myLutTexture == 0;
+    if(isNew) {
+        theCtx.core20fwd->glGenTextures(1, &myLutTexture);
+    }
+    theCtx.core20fwd->glBindTexture(GL_TEXTURE_3D, myLutTexture);
+    theCtx.core20fwd->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if(isNew) {
+        theCtx.core20fwd->glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        theCtx.core20fwd->glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        theCtx.core20fwd->glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        theCtx.core20fwd->glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        theCtx.core20fwd->glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    }
+    theCtx.extAll->glTexImage3D(GL_TEXTURE_3D, 0, GL_RGB16, THE_LUT_SIZE, THE_LUT_SIZE, THE_LUT_SIZE, 0,
+                                GL_RGB, GL_UNSIGNED_SHORT, &aData.front());
+    theCtx.core20fwd->glBindTexture(GL_TEXTURE_3D, 0);
+    if(theCtx.core20fwd->glGetError() != GL_NO_ERROR) {
+        theCtx.core20fwd->glDeleteTextures(1, &myLutTexture);
+        myLutTexture = 0;
+        return false;
+    }
+
+    stMemCpy(myLutKey, aKey, sizeof(myLutKey));
+    return true;
+#else
+    (void )theCtx;
+    return false;
+#endif
+}
+
+StGLImageProgram::ColorPipeline StGLImageProgram::getColorPipeline() const {
+    if(getFragmentShaderPart(FragSection_Correct) == FragCorrect_Lut) {
+        return ColorPipeline_Lut;
+    } else if(getFragmentShaderPart(FragSection_Correct) == FragCorrect_Off
+           && getFragmentShaderPart(FragSection_Gamma)   == FragGamma_Off) {
+        return ColorPipeline_Off;
+    }
+    return ColorPipeline_Shader;
+}
+
+void StGLImageProgram::stglBeginTimer(StGLContext& theCtx) {
+#if !defined(GL_ES_VERSION_2_0)
+    if(!myIsTimerInit) {
+        myIsTimerInit = true;
+        myHasTimer = theCtx.extAll->glQueryCounter != NULL
+                  && theCtx.extAll->glGetQueryObjectui64v != NULL
+                  && theCtx.extAll->glGenQueries != NULL;
+        if(myHasTimer) {
+            theCtx.extAll->glGenQueries(THE_NB_TIMERS * 2, myTimerQueries);
+        }
+    }
+    if(!myHasTimer) {
+        return;
+    }
+
+    // retrieve results of previously issued queries without waiting
+    for(int aTimerIter = 0; aTimerIter < THE_NB_TIMERS; ++aTimerIter) {
+        if(myTimerVariants[aTimerIter] < 0) {
+            continue;
+        }
+        GLuint isAvailable = GL_FALSE;
+        theCtx.extAll->glGetQueryObjectuiv(myTimerQueries[aTimerIter * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if(isAvailable == GL_FALSE) {
+            continue;
+        }
+
+        GLuint64 aTimeFrom = 0, aTimeTo = 0;
+        theCtx.extAll->glGetQueryObjectui64v(myTimerQueries[aTimerIter * 2 + 0], GL_QUERY_RESULT, &aTimeFrom);
+        theCtx.extAll->glGetQueryObjectui64v(myTimerQueries[aTimerIter * 2 + 1], GL_QUERY_RESULT, &aTimeTo);
+        const double aTimeMs = aTimeTo > aTimeFrom ? double(aTimeTo - aTimeFrom) * 0.000001 : 0.0;
+        double& aFiltered = myGpuTimeMs[myTimerVariants[aTimerIter]];
+        aFiltered = aFiltered > 0.0 ? (aFiltered * 0.9 + aTimeMs * 0.1) : aTimeMs;
+        myTimerVariants[aTimerIter] = -1;
+    }
+
+    if(myTimerVariants[myTimerIter] >= 0) {
+        return; // all queries are in flight - skip measurement of this frame
+    }
+    theCtx.extAll->glQueryCounter(myTimerQueries[myTimerIter * 2 + 0], GL_TIMESTAMP);
+    myTimerVariants[myTimerIter] = getColorPipeline();
+#else
+    (void )theCtx;
+#endif
+}
+
+void StGLImageProgram::stglEndTimer(StGLContext& theCtx) {
+#if !defined(GL_ES_VERSION_2_0)
+    if(!myHasTimer
+    || myTimerVariants[myTimerIter] < 0) {
+        return;
+    }
+    theCtx.extAll->glQueryCounter(myTimerQueries[myTimerIter * 2 + 1], GL_TIMESTAMP);
+    myTimerIter = (myTimerIter + 1) % THE_NB_TIMERS;
+#else
+    (void )theCtx;
+#endif
+}
+
+StString StGLImageProgram::formatGpuTimes() const {
+    static const char* THE_NAMES[ColorPipeline_NB] = { "off", "shader", "LUT" };
+    StString aText;
+    for(int aVarIter = 0; aVarIter < ColorPipeline_NB; ++aVarIter) {
+        if(myGpuTimeMs[aVarIter] <= 0.0) {
+            continue;
+        }
+
+        char aBuffer[64];
+        stsprintf(aBuffer, sizeof(aBuffer), "%s %.3f ms", THE_NAMES[aVarIter], myGpuTimeMs[aVarIter]);
+        if(!aText.isEmpty()) {
+            aText += ", ";
+        }
+        aText += aBuffer;
+    }
+    return aText;
+}
+
 /**
  * Return color conversion shader part from StImage definition.
  */
@@ -527,14 +756,23 @@ bool StGLImageProgram::init(StGLContext&                 theCtx,
     registerFragments(theCtx);
 
     // re-configure shader parts when required
+    const bool hasGamma      = !stAreEqual(params.gamma->getValue(), 1.0f, 0.0001f);
+    const bool hasCorrection = !params.brightness->isDefaultValue()
+                            || !params.saturation->isDefaultValue()
+                            || !hasNoColorScale();
+    const bool toUseLut = (hasGamma || hasCorrection)
+                       && params.toUseLut->getValue()
+                       && hasLutSupport(theCtx)
+                       && setupLut(theCtx);
+
     bool isChanged = myActiveProgram.isNull();
     isChanged = setFragmentShaderPart(theCtx, FragSection_Main,    0) || isChanged;
     isChanged = setFragmentShaderPart(theCtx, FragSection_Gamma,
-                                      stAreEqual(params.gamma->getValue(), 1.0f, 0.0001f) ? FragGamma_Off : FragGamma_On) || isChanged;
+                                      hasGamma && !toUseLut ? FragGamma_On : FragGamma_Off) || isChanged;
     isChanged = setFragmentShaderPart(theCtx, FragSection_Correct,
-                                      params.brightness->isDefaultValue()
-                                   && params.saturation->isDefaultValue()
-                                   && hasNoColorScale() ? FragCorrect_Off : FragCorrect_On) || isChanged;
+                                      toUseLut      ? FragCorrect_Lut
+                                    : hasCorrection ? FragCorrect_On
+                                                    : FragCorrect_Off) || isChanged;
     int aToRgb = getColorShader(theColorModel, theColorScale);
     if(aToRgb >= FragToRgb_FromYuvFull
     && theFilter == FragGetColor_Cubemap) {
@@ -560,6 +798,7 @@ bool StGLImageProgram::init(StGLContext&                 theCtx,
         uniTexCubeFlipZLoc    = myActiveProgram->getUniformLocation(theCtx, "uTexCubeFlipZ");
         uniColorProcessingLoc = myActiveProgram->getUniformLocation(theCtx, "uColorProcessing");
         uniGammaLoc           = myActiveProgram->getUniformLocation(theCtx, "uGamma");
+        uniColorLutScaleLoc   = myActiveProgram->getUniformLocation(theCtx, "uColorLutScale");
         myActiveProgram->atrVVertexLoc  = myActiveProgram->getAttribLocation(theCtx, "vVertex");
         myActiveProgram->atrVTCoordLoc  = myActiveProgram->getAttribLocation(theCtx, "vTexCoord");
         myActiveProgram->atrVNormalLoc  = myActiveProgram->getAttribLocation(theCtx, "vNormal");
@@ -569,11 +808,13 @@ bool StGLImageProgram::init(StGLContext&                 theCtx,
         StGLVarLocation uniTextureULoc = myActiveProgram->getUniformLocation(theCtx, "uTextureU");
         StGLVarLocation uniTextureVLoc = myActiveProgram->getUniformLocation(theCtx, "uTextureV");
         StGLVarLocation uniTextureALoc = myActiveProgram->getUniformLocation(theCtx, "uTextureA");
+        StGLVarLocation uniColorLutLoc = myActiveProgram->getUniformLocation(theCtx, "uColorLut");
         myActiveProgram->use(theCtx);
         theCtx.core20fwd->glUniform1i(uniTextureLoc,  StGLProgram::TEXTURE_SAMPLE_0);
         theCtx.core20fwd->glUniform1i(uniTextureULoc, StGLProgram::TEXTURE_SAMPLE_1);
         theCtx.core20fwd->glUniform1i(uniTextureVLoc, StGLProgram::TEXTURE_SAMPLE_2);
         theCtx.core20fwd->glUniform1i(uniTextureALoc, StGLProgram::TEXTURE_SAMPLE_3);
+        theCtx.core20fwd->glUniform1i(uniColorLutLoc, THE_LUT_TEXTURE_UNIT);
         myActiveProgram->unuse(theCtx);
 
         /*if (!uniModelMatLoc.isValid()
@@ -599,6 +840,15 @@ bool StGLImageProgram::init(StGLContext&                 theCtx,
         theCtx.core20fwd->glUniform4fv(uniGammaLoc, 1, aVec);
     }
     setupCorrection(theCtx);
+    if(toUseLut) {
+        const GLfloat aLutSize = GLfloat(THE_LUT_SIZE);
+        theCtx.core20fwd->glUniform2f(uniColorLutScaleLoc, (aLutSize - 1.0f) / aLutSize, 0.5f / aLutSize);
+
+        // LUT remains bound to its own texture unit, which is not used by image planes
+        theCtx.core20fwd->glActiveTexture(GL_TEXTURE0 + THE_LUT_TEXTURE_UNIT);
+        theCtx.core20fwd->glBindTexture(GL_TEXTURE_3D, myLutTexture);
+        theCtx.core20fwd->glActiveTexture(GL_TEXTURE0);
+    }
     myActiveProgram->unuse(theCtx);
 
     const StGLResources aShaders("StGLWidgets");
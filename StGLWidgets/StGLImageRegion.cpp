@@ -1,6 +1,6 @@
 /**
  * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
- * Copyright © 2010-2020 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2010-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * This code is licensed under MIT license (see docs/license-mit.txt for details).
  */
@@ -251,6 +251,7 @@ StGLImageRegion::StGLImageRegion(StGLWidget* theParent,
     params.Gamma         = myProgram.params.gamma;
     params.Brightness    = myProgram.params.brightness;
     params.Saturation    = myProgram.params.saturation;
+    params.ToUseColorLut = myProgram.params.toUseLut;
     params.SwapLR        = new StSwapLRParam(this);
     params.ViewMode      = new StViewModeParam(this);
     params.SeparationDX  = new StFloat32StereoParam(this, StFloat32StereoParam::StereoParamId_SepDX,  stCString("sepDX"));
@@ -713,6 +714,7 @@ void StGLImageRegion::stglDraw(unsigned int theView) {
     aParams->setSeparationDy(int(params.SeparationDY->getValue()));
     aParams->setSepRotation(params.SeparationRot->getValue());
 
+    myProgram.stglBeginTimer(getContext());
     switch(params.DisplayMode->getValue()) {
         case MODE_PARALLEL:
         case MODE_CROSSYED:
@@ -729,6 +731,7 @@ void StGLImageRegion::stglDraw(unsigned int theView) {
             stglDrawView(theView);
             break;
     }
+    myProgram.stglEndTimer(getContext());
     StGLWidget::stglDraw(theView);
 }
 
@@ -816,7 +819,9 @@ void StGLImageRegion::stglDrawView(unsigned int theView) {
         aClampA.z() = aTextures.getPlane(3).getDataSize().x();
         aClampA.w() = aTextures.getPlane(3).getDataSize().y();
     } else {
-        if(params.TextureFilter->getValue() == StGLImageProgram::FILTER_TRILINEAR) {
+        // mip-map levels of packed stereo pair would blend views along the seam
+        if(params.TextureFilter->getValue() == StGLImageProgram::FILTER_TRILINEAR
+        && !aTextures.isPackedPair()) {
             myTextureQueue->getQTexture().setMinMagFilter(aCtx, GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR);
         } else {
             myTextureQueue->getQTexture().setMinMagFilter(aCtx, GL_LINEAR);
@@ -860,6 +865,16 @@ void StGLImageRegion::stglDrawView(unsigned int theView) {
             }
         }
     }
+    if(aTextures.isPackedPair()) {
+        // both views share the same textures, sample the half of packed stereo pair
+        const bool isRightView = toShowRight && !aParams->isMono();
+        aClampVec.x() += aTextures.getPlane(0).getDataOffset(isRightView).x();
+        aClampVec.y() += aTextures.getPlane(0).getDataOffset(isRightView).y();
+        aClampUV .x() += aTextures.getPlane(1).getDataOffset(isRightView).x();
+        aClampUV .y() += aTextures.getPlane(1).getDataOffset(isRightView).y();
+        aClampA  .x() += aTextures.getPlane(3).getDataOffset(isRightView).x();
+        aClampA  .y() += aTextures.getPlane(3).getDataOffset(isRightView).y();
+    }
     aTextures.bind(aCtx);
 
     // select (de)anaglyph color filter
@@ -14,6 +14,8 @@
 #include <StGLWidgets/StGLScrollArea.h>
 #include <StGLWidgets/StGLTextureButton.h>
 
+#include <StImage/StThumbnailService.h>
+#include <StThreads/StResourceManager.h>
 #include <StThreads/StThread.h>
 
 #include <fstream>
@@ -294,6 +296,9 @@ StGLOpenFile::StGLOpenFile(StGLWidget*     theParent,
     //}
 
     addSystemDrives();
+
+    const StString& aCacheFolder = myRoot->getResourceManager()->getCacheFolder();
+    myThumbnails = new StThumbnailService(!aCacheFolder.isEmpty() ? (aCacheFolder + "thumbnails") : StString(), myIconSizeX);
 }
 
 void StGLOpenFile::addSystemDrives() {
@@ -377,6 +382,7 @@ void StGLOpenFile::addSystemDrives() {
 }
 
 StGLOpenFile::~StGLOpenFile() {
+    myThumbnails.nullify();
     StGLContext& aCtx = getContext();
     if(!myTextureFolder.isNull()) {
         for(size_t aTexIter = 0; aTexIter < myTextureFolder->size(); ++aTexIter) {
@@ -600,6 +606,45 @@ void StGLOpenFile::openFolder(const StString& theFolder) {
         anItem->setUserData(anItemIter);
         anItem->signals.onItemClick = stSlot(this, &StGLOpenFile::doFileItemClick);
     }
+
+    // requests are processed in reverse order, so that the first items appear first
+    myThumbnails->clearRequests();
+    for(size_t anItemIter = aNbItems; anItemIter > 0; --anItemIter) {
+        const StFileNode* aNode = myFolder->getValue(anItemIter - 1);
+        if(!aNode->isFolder()) {
+            myThumbnails->request(aNode->getPath());
+        }
+    }
+
     myList->stglInit();
     stglInit();
 }
+
+void StGLOpenFile::stglUpdate(const StPointD_t& theCursorZo,
+                              bool theIsPreciseInput) {
+    StThumbnailService::Result aThumb;
+    while(myThumbnails->popResult(aThumb)) {
+        if(aThumb.Image.isNull()
+        || myFolder.isNull()) {
+            continue;
+        }
+
+        for(StGLWidget* aChild = myList->getChildren()->getStart(); aChild != NULL; aChild = aChild->getNext()) {
+            StGLMenuItem* anItem = dynamic_cast<StGLMenuItem*>(aChild);
+            if(anItem == NULL
+            || anItem->getIcon() == NULL
+            || anItem->getUserData() >= myFolder->size()
+            || myFolder->getValue(anItem->getUserData())->getPath() != aThumb.Path) {
+                continue;
+            }
+
+            StGLIcon* anIcon = new StGLIcon(anItem, myMarginX, 0, StGLCorner(ST_VCORNER_CENTER, ST_HCORNER_LEFT), 0);
+            anIcon->setColor(StGLVec4(1.0f, 1.0f, 1.0f, 1.0f));
+            anIcon->setImage(aThumb.Image);
+            anItem->setIcon(anIcon);
+            anIcon->stglInit();
+            break;
+        }
+    }
+    StGLMessageBox::stglUpdate(theCursorZo, theIsPreciseInput);
+}
@@ -10,10 +10,29 @@
 #include <StGLWidgets/StGLMenuItem.h>
 #include <StGLWidgets/StGLMenuProgram.h>
 #include <StGLWidgets/StGLRootWidget.h>
+#include <StGLWidgets/StGLTextureButton.h>
 
 #include <StCore/StEvent.h>
 #include <StGL/StGLContext.h>
 #include <StGLCore/StGLCore20.h>
+#include <StImage/StThumbnailService.h>
+#include <StThreads/StResourceManager.h>
+
+#include <algorithm>
+
+namespace {
+
+    /**
+     * Maximum number of thumbnails kept in memory.
+     */
+    static const size_t THE_THUMBS_MAX = 512;
+
+    /**
+     * Maximum size of thumbnails kept in memory (in bytes).
+     */
+    static const size_t THE_THUMBS_BYTES_MAX = 16 * 1024 * 1024;
+
+}
 
 StGLPlayList::StGLPlayList(StGLWidget*                 theParent,
                            const StHandle<StPlayList>& theList)
@@ -21,6 +40,9 @@ StGLPlayList::StGLPlayList(StGLWidget*                 theParent,
   myMenu(NULL),
   myBarColor(getRoot()->getColorForElement(StGLRootWidget::Color_ScrollBar)),
   myList(theList),
+  myThumbSize(0),
+  myThumbsStamp(0),
+  myThumbsBytes(0),
   myFromId(0),
   myItemsNb(0),
   myToResetList(false),
@@ -34,6 +56,10 @@ StGLPlayList::StGLPlayList(StGLWidget*                 theParent,
     myMenu->setItemWidth(myRoot->scale(250));
     myMenu->setColor(StGLVec4(0.2f, 0.2f, 0.2f, 0.5f));
 
+    myThumbSize = myMenu->getItemHeight() - myRoot->scale(4);
+    const StString& aCacheFolder = myRoot->getResourceManager()->getCacheFolder();
+    myThumbnails = new StThumbnailService(!aCacheFolder.isEmpty() ? (aCacheFolder + "thumbnails") : StString(), myThumbSize);
+
     StGLWidget::signals.onMouseUnclick = stSlot(this, &StGLPlayList::doMouseUnclick);
     myList->signals.onPlaylistChange  += stSlot(this, &StGLPlayList::doResetList);
     myList->signals.onTitleChange     += stSlot(this, &StGLPlayList::doChangeItem);
@@ -43,6 +69,7 @@ StGLPlayList::StGLPlayList(StGLWidget*                 theParent,
 }
 
 StGLPlayList::~StGLPlayList() {
+    myThumbnails.nullify();
     myBarVertBuf.release(getContext());
     myList->signals.onPlaylistChange  -= stSlot(this, &StGLPlayList::doResetList);
     myList->signals.onTitleChange     -= stSlot(this, &StGLPlayList::doChangeItem);
@@ -60,22 +87,60 @@ void StGLPlayList::doItemClick(const size_t theItem) {
 }
 
 void StGLPlayList::updateList() {
-    StArrayList<StString> aList;
-    myList->getSubList(aList, myFromId, myFromId + myItemsNb);
+    StArrayList<StString> aList, aPaths;
+    myList->getSubList(aList, aPaths, myFromId, myFromId + myItemsNb);
     const size_t aCurrent     = myList->getCurrentId() - myFromId;
     const size_t anUpperLimit = aList.size();
 
+    // requests are processed in reverse order, so that the top items appear first
+    myThumbnails->clearRequests();
+    ++myThumbsStamp;
+    for(size_t aPathIter = aPaths.size(); aPathIter > 0; --aPathIter) {
+        const StString& aPath = aPaths.getValue(aPathIter - 1);
+        std::map<StString, StThumbEntry>::iterator aThumbIter = myThumbs.find(aPath);
+        if(aThumbIter != myThumbs.end()) {
+            aThumbIter->second.Stamp = myThumbsStamp;
+        } else {
+            myThumbnails->request(aPath);
+        }
+    }
+    trimThumbs();
+
+    const int anItemMargin = myRoot->scale(2);
+    myIconPaths.resize(stMax(myItemsNb, 0));
     int anIter = 0;
     for(StGLWidget* aChild = myMenu->getChildren()->getStart();
         aChild != NULL && anIter < myItemsNb; ++anIter, aChild = aChild->getNext()) {
         StGLMenuItem* anItem = dynamic_cast<StGLMenuItem*>(aChild);
         anItem->setClicked(ST_MOUSE_LEFT, false);
         if(size_t(anIter) < anUpperLimit) {
+            const StString& aPath = aPaths.getValue(anIter);
+            std::map<StString, StThumbEntry>::const_iterator aThumbIter = myThumbs.find(aPath);
+            if(aThumbIter != myThumbs.end()
+            && !aThumbIter->second.Image.isNull()) {
+                if(anItem->getIcon() == NULL
+                || myIconPaths[anIter] != aPath) {
+                    // texture is uploaded only for new icon, unchanged items keep existing one
+                    StGLIcon* anIcon = new StGLIcon(anItem, anItemMargin, 0, StGLCorner(ST_VCORNER_CENTER, ST_HCORNER_LEFT), 0);
+                    anIcon->setColor(StGLVec4(1.0f, 1.0f, 1.0f, 1.0f));
+                    anIcon->setImage(aThumbIter->second.Image);
+                    anItem->setIcon(anIcon);
+                    myIconPaths[anIter] = aPath;
+                }
+                anItem->changeMargins().left = anItemMargin + myThumbSize + anItemMargin * 2;
+            } else {
+                anItem->setIcon(NULL);
+                myIconPaths[anIter].clear();
+                anItem->changeMargins().left = anItemMargin;
+            }
             anItem->setText(aList.getValue(anIter));
             anItem->setOpacity(1.0f, false);
             anItem->setFocus(size_t(anIter) == aCurrent);
             anItem->changeRectPx().right() = anItem->getRectPx().left() + myMenu->getItemWidth();
         } else {
+            anItem->setIcon(NULL);
+            myIconPaths[anIter].clear();
+            anItem->changeMargins().left = anItemMargin;
             anItem->setText("");
             anItem->setOpacity(0.0f, false);
             //anItem->changeRectPx().right() = anItem->getRectPx().left();
@@ -84,6 +149,31 @@ void StGLPlayList::updateList() {
     stglInitMenu();
 }
 
+void StGLPlayList::trimThumbs() {
+    if(myThumbs.size() <= THE_THUMBS_MAX
+    && myThumbsBytes   <= THE_THUMBS_BYTES_MAX) {
+        return;
+    }
+
+    // remove least recently displayed thumbnails
+    std::vector< std::pair<size_t, StString> > aStamps;
+    aStamps.reserve(myThumbs.size());
+    for(std::map<StString, StThumbEntry>::const_iterator aThumbIter = myThumbs.begin(); aThumbIter != myThumbs.end(); ++aThumbIter) {
+        aStamps.push_back(std::make_pair(aThumbIter->second.Stamp, aThumbIter->first));
+    }
+    std::sort(aStamps.begin(), aStamps.end());
+    for(size_t anIter = 0; anIter < aStamps.size()
+     && (myThumbs.size() > THE_THUMBS_MAX
+      || myThumbsBytes   > THE_THUMBS_BYTES_MAX); ++anIter) {
+        if(aStamps[anIter].first == myThumbsStamp) {
+            break; // never remove visible items
+        }
+        std::map<StString, StThumbEntry>::iterator aThumbIter = myThumbs.find(aStamps[anIter].second);
+        myThumbsBytes -= aThumbIter->second.Bytes;
+        myThumbs.erase(aThumbIter);
+    }
+}
+
 void StGLPlayList::doResetList() {
     myToResetList = true;
 }
@@ -352,6 +442,17 @@ void StGLPlayList::stglDraw(unsigned int theView) {
         return;
     }
 
+    StThumbnailService::Result aThumb;
+    while(myThumbnails->popResult(aThumb)) {
+        StThumbEntry& anEntry = myThumbs[aThumb.Path];
+        myThumbsBytes -= anEntry.Bytes;
+        anEntry.Image = aThumb.Image;
+        anEntry.Stamp = myThumbsStamp;
+        anEntry.Bytes = !aThumb.Image.isNull() ? aThumb.Image->getPlane().getSizeBytes() : 0;
+        myThumbsBytes += anEntry.Bytes;
+        myToUpdateList = myToUpdateList || !aThumb.Image.isNull();
+    }
+
     if((myToUpdateList || myToResetList)
     && theView != ST_DRAW_RIGHT) {
         if(myToResetList) {
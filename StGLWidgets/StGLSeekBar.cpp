@@ -11,6 +11,7 @@
 #include <StGL/StGLContext.h>
 #include <StGLCore/StGLCore20.h>
 #include <StGLWidgets/StGLRootWidget.h>
+#include <StGLWidgets/StGLTextureButton.h>
 #include <StCore/StEvent.h>
 
 class StGLSeekBar::StProgramSB : public StGLProgram {
@@ -104,7 +105,10 @@ StGLSeekBar::StGLSeekBar(StGLWidget* theParent,
   myProgress(0.0f),
   myProgressPx(0),
   myClickPos(-1),
-  myMoveTolerPx(0) {
+  myMoveTolerPx(0),
+  myHoverPx(-1),
+  myPreview(NULL),
+  myIsPreviewShown(false) {
     StGLWidget::signals.onMouseClick  .connect(this, &StGLSeekBar::doMouseClick);
     StGLWidget::signals.onMouseUnclick.connect(this, &StGLSeekBar::doMouseUnclick);
     myMargins.top    = theMargin;
@@ -227,7 +231,16 @@ void StGLSeekBar::stglDraw(unsigned int theView) {
 void StGLSeekBar::stglUpdate(const StPointD_t& theCursor,
                              bool theIsPreciseInput) {
     StGLWidget::stglUpdate(theCursor, theIsPreciseInput);
+    updateHover(theCursor);
     if(!isClicked(ST_MOUSE_LEFT)) {
+        if(myClickPos >= 0) {
+            // dragging has been finished outside of the bar (onMouseUnclick is not emitted),
+            // perform precise seek at the last dragged position
+            const int aMaxPosPx = stMax(getRectPx().width(), 1);
+            const double aPos = stMin(double(myClickPos) / double(aMaxPosPx), 1.0);
+            myClickPos = -1;
+            signals.onSeekClick(ST_MOUSE_LEFT, aPos);
+        }
         return;
     }
 
@@ -244,20 +257,91 @@ void StGLSeekBar::stglUpdate(const StPointD_t& theCursor,
         aPosPx = aMaxPosPx;
     }
 
-    if(myClickPos >= 0) {
-        if(myClickPos == aPosPx) {
-            return;
+    if(myClickPos < 0) {
+        // plain click is handled by single seek on release;
+        // fast seeking starts only when pointer is dragged beyond tolerance
+        myClickPos = aPosPx;
+        return;
+    } else if(myClickPos == aPosPx) {
+        return;
+    } else if(aPosPx != 0
+           && aPosPx != aMaxPosPx
+           && std::abs(aPosPx - myClickPos) < aMoveTolerPx) {
+        return;
+    }
+
+    myClickPos = aPosPx;
+    signals.onSeekClick(ST_MOUSE_LEFT, aPos);
+}
+
+void StGLSeekBar::updateHover(const StPointD_t& theCursor) {
+    if(!isClicked(ST_MOUSE_LEFT)
+    && (!isVisibleAndPointIn(theCursor) || myOpacity <= 0.0f)) {
+        if(myHoverPx >= 0) {
+            myHoverPx = -1;
+            setPreview(StHandle<StImage>());
+            signals.onSeekHover(-1.0);
         }
+        return;
+    }
+
+    const int    aMaxPosPx = getRectPx().width();
+    const double aPos      = stMin(stMax(getPointInEx(theCursor), 0.0), 1.0);
+    const int    aPosPx    = int(aPos * double(aMaxPosPx));
+    if(myHoverPx >= 0
+    && std::abs(aPosPx - myHoverPx) < myRoot->scale(2)) {
+        return;
+    }
+
+    myHoverPx = aPosPx;
+    updatePreviewPosition();
+    signals.onSeekHover(aPos);
+}
 
-        if(aPosPx != 0
-        && aPosPx != aMaxPosPx
-        && std::abs(aPosPx - myClickPos) < aMoveTolerPx) {
-            return;
+void StGLSeekBar::setPreview(const StHandle<StImage>& theImage) {
+    if(theImage.isNull()
+    || myHoverPx < 0) {
+        myIsPreviewShown = false;
+        if(myPreview != NULL) {
+            myPreview->setOpacity(0.0f, false);
         }
+        return;
     }
 
-    myClickPos = aPosPx;
-    signals.onSeekClick(ST_MOUSE_LEFT, aPos);
+    // the same widget and texture are reused by all previews to avoid re-allocation while scrubbing
+    if(myPreview == NULL) {
+        myPreview = new StGLIcon(this, 0, 0, StGLCorner(ST_VCORNER_TOP, ST_HCORNER_LEFT), 0);
+        myPreview->setColor(StGLVec4(1.0f, 1.0f, 1.0f, 1.0f));
+    }
+    myPreview->setImage(theImage);
+    myPreview->stglInit();
+    myPreview->setOpacity(myOpacity, false);
+    myIsPreviewShown = true;
+    updatePreviewPosition();
+}
+
+void StGLSeekBar::setOpacity(const float theOpacity, bool theToSetChildren) {
+    StGLWidget::setOpacity(theOpacity, theToSetChildren);
+    if(myPreview != NULL
+    && !myIsPreviewShown) {
+        myPreview->setOpacity(0.0f, false);
+    }
+}
+
+void StGLSeekBar::updatePreviewPosition() {
+    if(myPreview == NULL) {
+        return;
+    }
+
+    // center preview above hovered position, but keep it within seek bar bounds
+    const int aSizeX = myPreview->getRectPx().width();
+    const int aSizeY = myPreview->getRectPx().height();
+    const int aLeft  = stClamp(myHoverPx - aSizeX / 2, 0, stMax(getRectPx().width() - aSizeX, 0));
+    myPreview->changeRectPx().left()   = aLeft;
+    myPreview->changeRectPx().right()  = aLeft + aSizeX;
+    myPreview->changeRectPx().top()    = myMargins.top - aSizeY - myRoot->scale(4);
+    myPreview->changeRectPx().bottom() = myMargins.top - myRoot->scale(4);
+    myPreview->stglResize();
 }
 
 double StGLSeekBar::getPointInEx(const StPointD_t& thePointZo) const {
@@ -286,12 +370,8 @@ void StGLSeekBar::doMouseUnclick(const int mouseBtn) {
         aPosPx = aMaxPosPx;
     }
 
-    if(myClickPos >= 0
-    && std::abs(aPosPx - myClickPos) < aTolerance) {
-        myClickPos = -1;
-        return;
-    }
-
+    // seeking while dragging might be imprecise (jumping between key frames),
+    // so that final seek is always performed on release
     myClickPos = -1;
     signals.onSeekClick(mouseBtn, aPos);
 }
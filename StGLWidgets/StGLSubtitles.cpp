@@ -1,6 +1,6 @@
 /**
  * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
- * Copyright © 2010-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2010-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * This code is licensed under MIT license (see docs/license-mit.txt for details).
  */
@@ -15,6 +15,20 @@
 namespace {
     static const size_t SHARE_IMAGE_PROGRAM_ID = StGLRootWidget::generateShareId();
     static StGLVCorner parseCorner(int theVal) { return (StGLVCorner )theVal; }
+
+    static const GLsizei THE_ATLAS_SIZE    = 2048; //!< maximum dimensions of subtitles atlas
+    static const int     THE_ATLAS_PADDING = 2;    //!< cleared gap between atlas regions to avoid filtering artifacts
+    static const size_t  THE_LAYOUTS_MAX   = 16;   //!< maximum number of cached text layouts
+    static const size_t  THE_UPCOMING_MAX  = 8;    //!< maximum number of upcoming items to look at
+    static const double  THE_LOOKAHEAD_SEC = 2.0;  //!< interval to prepare upcoming items in advance
+
+    static bool isEqualKey(const StGLVec4& theKey1,
+                           const StGLVec4& theKey2) {
+        return theKey1.x() == theKey2.x()
+            && theKey1.y() == theKey2.y()
+            && theKey1.z() == theKey2.z()
+            && theKey1.w() == theKey2.w();
+    }
 }
 
 class StGLSubtitles::StImgProgram : public StGLProgram {
@@ -87,7 +101,7 @@ class StGLSubtitles::StImgProgram : public StGLProgram {
 };
 
 StGLSubtitles::StSubShowItems::StSubShowItems()
-: StArrayList<StHandle <StSubItem> >(8), Scale (1.0f) {
+: StArrayList<StHandle <StSubItem> >(8) {
     //
 }
 
@@ -105,7 +119,7 @@ bool StGLSubtitles::StSubShowItems::pop(const double thePTS) {
         return false;
     } else if(isEmpty()) {
         Text.clear();
-        Image.nullify();
+        ImageItem.nullify();
         return true;
     }
 
@@ -117,14 +131,10 @@ bool StGLSubtitles::StSubShowItems::pop(const double thePTS) {
         Text += anItem->Text;
     }
 
-    // update active image
-    const StImagePlane& anImage = getFirst()->Image;
-    if(!anImage.isNull()) {
-        Image.initCopy(anImage, false);
-        Scale = getFirst()->Scale;
-    } else {
-        Image.nullify();
-        Scale = 1.0f;
+    // update active image, the image itself is shared with the item
+    ImageItem.nullify();
+    if(!getFirst()->Image.isNull()) {
+        ImageItem = getFirst();
     }
 
     return isChanged;
@@ -136,10 +146,8 @@ void StGLSubtitles::StSubShowItems::add(const StHandle<StSubItem>& theItem) {
     }
     Text += theItem->Text;
 
-    const StImagePlane& anImage = theItem->Image;
-    if(!anImage.isNull()) {
-        Image.initCopy(anImage, false);
-        Scale = theItem->Scale;
+    if(!theItem->Image.isNull()) {
+        ImageItem = theItem;
     }
 
     StArrayList<StHandle <StSubItem> >::add(theItem);
@@ -153,6 +161,11 @@ StGLSubtitles::StGLSubtitles(StGLImageRegion* theParent,
                0, 0,
                StGLCorner(parseCorner(thePlace->getValue()), ST_HCORNER_CENTER),
                theParent->getRoot()->scale(800), theParent->getRoot()->scale(160)),
+  myAtlasShelfX(0),
+  myAtlasShelfY(0),
+  myAtlasShelfSizeY(0),
+  myLayoutKey(0.0f, 0.0f, 0.0f, 0.0f),
+  myUpcoming(THE_UPCOMING_MAX),
   myQueue(theSubQueue),
   myPTS(0.0),
   myImgProgram(getRoot()->getShare(SHARE_IMAGE_PROGRAM_ID)) {
@@ -208,7 +221,9 @@ StGLSubtitles::~StGLSubtitles() {
     StGLContext& aCtx = getContext();
     myFont->release(aCtx);
     myFont.nullify();
+    clearLayouts(aCtx);
     myTexture.release(aCtx);
+    myAtlas.release(aCtx);
     myVertBuf.release(aCtx);
     myTCrdBuf.release(aCtx);
 }
@@ -279,10 +294,17 @@ void StGLSubtitles::stglUpdate(const StPointD_t& ,
     if(isChanged) {
         setText(myShowItems.Text);
 
-        if(!myShowItems.Image.isNull()) {
-            myTexture.init(aCtx, myShowItems.Image);
-        } else {
+        // upcoming images are normally already uploaded into the atlas by prepareUpcoming()
+        const StHandle<StSubItem>& anImageItem = myShowItems.ImageItem;
+        if(anImageItem.isNull()
+        || findAtlasSlot(anImageItem) != NULL
+        || uploadToAtlas(aCtx, anImageItem, true) != NULL) {
             myTexture.release(aCtx);
+            myTextureItem.nullify();
+        } else if(myTextureItem != anImageItem) {
+            // too large image
+            myTexture.init(aCtx, anImageItem->Image);
+            myTextureItem = anImageItem;
         }
 
         StString aLog;
@@ -300,6 +322,251 @@ void StGLSubtitles::stglUpdate(const StPointD_t& ,
 
         myFont->stglInit(aCtx, getFontSize(), myRoot->getResolution());
     }
+
+    pruneAtlas();
+    if(!isChanged) {
+        prepareUpcoming(aCtx);
+    }
+}
+
+const StGLSubtitles::AtlasSlot* StGLSubtitles::findAtlasSlot(const StHandle<StSubItem>& theItem) const {
+    for(size_t aSlotIter = 0; aSlotIter < myAtlasSlots.size(); ++aSlotIter) {
+        if(myAtlasSlots[aSlotIter].Item == theItem) {
+            return &myAtlasSlots[aSlotIter];
+        }
+    }
+    return NULL;
+}
+
+const StGLSubtitles::AtlasSlot* StGLSubtitles::uploadToAtlas(StGLContext&               theCtx,
+                                                             const StHandle<StSubItem>& theItem,
+                                                             const bool                 theToReset) {
+    const StImagePlane& anImage = theItem->Image;
+    if(anImage.isNull()
+    || anImage.getFormat() != StImagePlane::ImgRGBA) {
+        return NULL;
+    }
+
+    if(!myAtlas.isValid()) {
+        const GLsizei anAtlasSize = stMin(THE_ATLAS_SIZE, GLsizei(theCtx.getMaxTextureSize()));
+        if(!myAtlas.initBlack(theCtx, anAtlasSize, anAtlasSize)) {
+            return NULL;
+        }
+        myAtlasSlots.clear();
+        myAtlasShelfX = myAtlasShelfY = myAtlasShelfSizeY = 0;
+    }
+
+    const int aSizeX = int(anImage.getSizeX());
+    const int aSizeY = int(anImage.getSizeY());
+    if(aSizeX + THE_ATLAS_PADDING > myAtlas.getSizeX()
+    || aSizeY + THE_ATLAS_PADDING > myAtlas.getSizeY()) {
+        return NULL;
+    }
+
+    // simple shelf packing - atlas is reset as whole when there is no more space
+    for(int anAttempt = 0;; ++anAttempt) {
+        if(myAtlasShelfX + aSizeX + THE_ATLAS_PADDING > myAtlas.getSizeX()) {
+            myAtlasShelfY    += myAtlasShelfSizeY;
+            myAtlasShelfX     = 0;
+            myAtlasShelfSizeY = 0;
+        }
+        if(myAtlasShelfY + aSizeY + THE_ATLAS_PADDING <= myAtlas.getSizeY()) {
+            break;
+        } else if(!theToReset
+               || anAttempt != 0) {
+            return NULL;
+        }
+        myAtlasSlots.clear();
+        myAtlasShelfX = myAtlasShelfY = myAtlasShelfSizeY = 0;
+    }
+
+    // image is placed in the middle of its cell, surrounded by the padding
+    const int aBorder = THE_ATLAS_PADDING / 2;
+    AtlasSlot aSlot;
+    aSlot.Item  = theItem;
+    aSlot.Left  = myAtlasShelfX + aBorder;
+    aSlot.Top   = myAtlasShelfY + aBorder;
+    aSlot.SizeX = aSizeX;
+    aSlot.SizeY = aSizeY;
+
+    myAtlas.bind(theCtx);
+    theCtx.core20fwd->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    // clear the padding, which might keep pixels of images packed before atlas reset,
+    // so that texture filtering does not bleed them into this image
+    if(aBorder > 0) {
+        const std::vector<GLubyte> aZeros(size_t(stMax(aSizeX, aSizeY) + THE_ATLAS_PADDING) * size_t(aBorder) * 4, 0);
+        theCtx.core20fwd->glTexSubImage2D(GL_TEXTURE_2D, 0, myAtlasShelfX, myAtlasShelfY,
+                                          aSizeX + THE_ATLAS_PADDING, aBorder, GL_RGBA, GL_UNSIGNED_BYTE, &aZeros[0]);
+        theCtx.core20fwd->glTexSubImage2D(GL_TEXTURE_2D, 0, myAtlasShelfX, aSlot.Top + aSizeY,
+                                          aSizeX + THE_ATLAS_PADDING, aBorder, GL_RGBA, GL_UNSIGNED_BYTE, &aZeros[0]);
+        theCtx.core20fwd->glTexSubImage2D(GL_TEXTURE_2D, 0, myAtlasShelfX, aSlot.Top,
+                                          aBorder, aSizeY, GL_RGBA, GL_UNSIGNED_BYTE, &aZeros[0]);
+        theCtx.core20fwd->glTexSubImage2D(GL_TEXTURE_2D, 0, aSlot.Left + aSizeX, aSlot.Top,
+                                          aBorder, aSizeY, GL_RGBA, GL_UNSIGNED_BYTE, &aZeros[0]);
+    }
+    if(anImage.getRowExtraBytes() == 0) {
+        theCtx.core20fwd->glTexSubImage2D(GL_TEXTURE_2D, 0, aSlot.Left, aSlot.Top, aSizeX, aSizeY,
+                                          GL_RGBA, GL_UNSIGNED_BYTE, anImage.getData());
+    } else {
+        for(int aRow = 0; aRow < aSizeY; ++aRow) {
+            theCtx.core20fwd->glTexSubImage2D(GL_TEXTURE_2D, 0, aSlot.Left, aSlot.Top + aRow, aSizeX, 1,
+                                              GL_RGBA, GL_UNSIGNED_BYTE, anImage.getData(size_t(aRow), 0));
+        }
+    }
+    myAtlas.unbind(theCtx);
+
+    myAtlasShelfX    += aSizeX + THE_ATLAS_PADDING;
+    myAtlasShelfSizeY = stMax(myAtlasShelfSizeY, aSizeY + THE_ATLAS_PADDING);
+    myAtlasSlots.push_back(aSlot);
+    return &myAtlasSlots.back();
+}
+
+void StGLSubtitles::pruneAtlas() {
+    for(size_t aSlotIter = myAtlasSlots.size() - 1; aSlotIter < size_t(-1); --aSlotIter) {
+        const StHandle<StSubItem>& anItem = myAtlasSlots[aSlotIter].Item;
+        if(anItem->TimeEnd < myPTS
+        && anItem != myShowItems.ImageItem) {
+            myAtlasSlots.erase(myAtlasSlots.begin() + aSlotIter);
+        }
+    }
+    if(myAtlasSlots.empty()) {
+        myAtlasShelfX = myAtlasShelfY = myAtlasShelfSizeY = 0;
+    }
+}
+
+void StGLSubtitles::showLayout(StGLContext& theCtx) {
+    if(myText == myLayoutText) {
+        myToRecompute = false;
+        return;
+    }
+
+    size_t aSlotIter = 0;
+    for(; aSlotIter < myLayouts.size(); ++aSlotIter) {
+        if(myLayouts[aSlotIter].Text == myText) {
+            break;
+        }
+    }
+    if(aSlotIter == myLayouts.size()) {
+        myLayouts.push_back(LayoutSlot());
+        formatLayout(theCtx, myText, myLayouts.back().Layout);
+    }
+
+    // active layout is swapped into the cache slot
+    LayoutSlot aSlot = myLayouts[aSlotIter];
+    myLayouts.erase(myLayouts.begin() + aSlotIter);
+    const StString aText = myText;
+    swapLayout(theCtx, aText, aSlot.Layout);
+    aSlot.Text   = myLayoutText;
+    myLayoutText = aText;
+    if(aSlot.Text.isEmpty()) {
+        aSlot.Layout.release(theCtx);
+    } else {
+        myLayouts.push_back(aSlot);
+    }
+
+    while(myLayouts.size() > THE_LAYOUTS_MAX) {
+        myLayouts.front().Layout.release(theCtx);
+        myLayouts.erase(myLayouts.begin());
+    }
+}
+
+void StGLSubtitles::clearLayouts(StGLContext& theCtx) {
+    for(size_t aSlotIter = 0; aSlotIter < myLayouts.size(); ++aSlotIter) {
+        myLayouts[aSlotIter].Layout.release(theCtx);
+    }
+    myLayouts.clear();
+    myLayoutText.clear();
+}
+
+StString StGLSubtitles::predictText(const double thePts) const {
+    // emulate StSubShowItems::pop() followed by StSubShowItems::add() for items popped from the queue
+    StString aText;
+    bool isRemoved = false;
+    size_t aNbKept = 0;
+    for(size_t anItemIter = 0; anItemIter < myShowItems.size(); ++anItemIter) {
+        const StHandle<StSubItem>& anItem = myShowItems.getValue(anItemIter);
+        if(anItem->TimeEnd < thePts || anItem->TimeStart > thePts) {
+            isRemoved = true;
+            continue;
+        }
+        if(aNbKept++ != 0) {
+            aText += StString('\n');
+        }
+        aText += anItem->Text;
+    }
+    if(!isRemoved) {
+        aText = myShowItems.Text;
+    }
+
+    for(size_t anItemIter = 0; anItemIter < myUpcoming.size(); ++anItemIter) {
+        const StHandle<StSubItem>& anItem = myUpcoming.getValue(anItemIter);
+        if(anItem->TimeEnd < thePts) {
+            continue;
+        } else if(anItem->TimeStart > thePts) {
+            break;
+        }
+        if(!aText.isEmpty()) {
+            aText += StString('\n');
+        }
+        aText += anItem->Text;
+    }
+    return aText;
+}
+
+bool StGLSubtitles::prepareLayout(StGLContext&    theCtx,
+                                  const StString& theText) {
+    if(theText.isEmpty()
+    || theText == myLayoutText) {
+        return false;
+    }
+    for(size_t aSlotIter = 0; aSlotIter < myLayouts.size(); ++aSlotIter) {
+        if(myLayouts[aSlotIter].Text == theText) {
+            return false;
+        }
+    }
+
+    LayoutSlot aSlot;
+    aSlot.Text = theText;
+    formatLayout(theCtx, aSlot.Text, aSlot.Layout);
+    myLayouts.push_back(aSlot);
+    while(myLayouts.size() > THE_LAYOUTS_MAX) {
+        myLayouts.front().Layout.release(theCtx);
+        myLayouts.erase(myLayouts.begin());
+    }
+    return true;
+}
+
+void StGLSubtitles::prepareUpcoming(StGLContext& theCtx) {
+    myUpcoming.clear();
+    myQueue->peek(myPTS + THE_LOOKAHEAD_SEC, myUpcoming, THE_UPCOMING_MAX);
+
+    // prepare at most one item per frame to spread the load
+    for(size_t anItemIter = 0; anItemIter < myUpcoming.size(); ++anItemIter) {
+        const StHandle<StSubItem>& anItem = myUpcoming[anItemIter];
+        if(!anItem->Image.isNull()
+        && findAtlasSlot(anItem) == NULL
+        && uploadToAtlas(theCtx, anItem, false) != NULL) {
+            myUpcoming.clear();
+            return;
+        }
+    }
+
+    // layouts can be prepared only after the first formatting defining the layout parameters;
+    // displayed text combines all active items, so that it is predicted at each moment it changes
+    if(myLayoutKey.x() > 0.0f) {
+        bool isPrepared = false;
+        for(size_t anItemIter = 0; anItemIter < myUpcoming.size() && !isPrepared; ++anItemIter) {
+            isPrepared = prepareLayout(theCtx, predictText(myUpcoming[anItemIter]->TimeStart));
+        }
+        for(size_t anItemIter = 0; anItemIter < myShowItems.size() && !isPrepared; ++anItemIter) {
+            const double anEnd = myShowItems.getValue(anItemIter)->TimeEnd + 0.001;
+            if(anEnd <= myPTS + THE_LOOKAHEAD_SEC) {
+                isPrepared = prepareLayout(theCtx, predictText(anEnd));
+            }
+        }
+    }
+    myUpcoming.clear();
 }
 
 void StGLSubtitles::stglDraw(unsigned int theView) {
@@ -312,7 +579,19 @@ void StGLSubtitles::stglDraw(unsigned int theView) {
         myFormatter.setupParser((StGLTextFormatter::Parser )params.Parser->getValue());
         myToRecompute = true;
     }
+
+    // cached layouts become invalid on changing formatting parameters
+    const StGLVec4 aLayoutKey(myTextWidth, GLfloat(getRectPx().height()), GLfloat(mySize),
+                              GLfloat(int(myFormatter.getParser()) * 4 + int(myCorner.v)));
+    if(!isEqualKey(aLayoutKey, myLayoutKey)) {
+        clearLayouts(aCtx);
+        myLayoutKey   = aLayoutKey;
+        myToRecompute = true;
+    }
     if(!myText.isEmpty()) {
+        if(myToRecompute) {
+            showLayout(aCtx);
+        }
         formatText(aCtx);
 
         switch(theView) {
@@ -330,10 +609,22 @@ void StGLSubtitles::stglDraw(unsigned int theView) {
         StGLTextArea::stglDraw(theView);
     }
 
-    if(!myTexture.isValid()
+    const StHandle<StSubItem>& anImageItem = myShowItems.ImageItem;
+    const AtlasSlot* anAtlasSlot = !anImageItem.isNull() ? findAtlasSlot(anImageItem) : NULL;
+    StGLTexture* aTexture = NULL;
+    if(anAtlasSlot != NULL) {
+        aTexture = &myAtlas;
+    } else if(!anImageItem.isNull()
+           && myTextureItem == anImageItem
+           && myTexture.isValid()) {
+        aTexture = &myTexture;
+    }
+    if(aTexture == NULL
     || !myImgProgram->isValid()) {
         return;
     }
+    const int aSrcSizeX = int(anImageItem->Image.getSizeX());
+    const int aSrcSizeY = int(anImageItem->Image.getSizeY());
 
     StHandle<StStereoParams> aParams;
     StFormat aStFormat = StFormat_Mono;
@@ -383,7 +674,7 @@ void StGLSubtitles::stglDraw(unsigned int theView) {
     }
 
     // update vertices
-    StVec2<int> anImgSize (myTexture.getSizeX(), myTexture.getSizeY()), anOffset (0, 0);
+    StVec2<int> anImgSize (aSrcSizeX, aSrcSizeY), anOffset (0, 0);
     StArray<StGLVec2> aVertices(4), aTexCoords(4);
     aTexCoords[0] = StGLVec2(1.0f, 0.0f);
     aTexCoords[1] = StGLVec2(1.0f, 1.0f);
@@ -394,14 +685,14 @@ void StGLSubtitles::stglDraw(unsigned int theView) {
     } else {
         anImgSize.y() = int(double(anImgSize.y()) / aSampleRatio);
     }
-    const double aFontScale = double(getRoot()->getScale()) * myShowItems.Scale * params.FontSize->getValue() / params.FontSize->getDefValue();
+    const double aFontScale = double(getRoot()->getScale()) * anImageItem->Scale * params.FontSize->getValue() / params.FontSize->getDefValue();
     anImgSize.x() = int(double(anImgSize.x()) * aFontScale);
     anImgSize.y() = int(double(anImgSize.y()) * aFontScale);
 
     switch(aStFormat) {
         case StFormat_SideBySide_LR: {
             anImgSize.x() /= 2;
-            const int anOffsetX = int(aFontScale * ((aFrameDims.x() * 2 - myTexture.getSizeX()) / 2));
+            const int anOffsetX = int(aFontScale * ((aFrameDims.x() * 2 - aSrcSizeX) / 2));
             if(aView == ST_DRAW_LEFT) {
                 aTexCoords[0].x() = aTexCoords[1].x() = 0.5f;
                 aTexCoords[2].x() = aTexCoords[3].x() = 0.0f;
@@ -415,7 +706,7 @@ void StGLSubtitles::stglDraw(unsigned int theView) {
         }
         case StFormat_TopBottom_LR: {
             anImgSize.y() /= 2;
-            const int anOffsetY = int(aFontScale * ((aFrameDims.y() * 2 - myTexture.getSizeY()) / 2));
+            const int anOffsetY = int(aFontScale * ((aFrameDims.y() * 2 - aSrcSizeY) / 2));
             if(aView == ST_DRAW_LEFT) {
                 aTexCoords[0].y() = aTexCoords[2].y() = 0.0f;
                 aTexCoords[1].y() = aTexCoords[3].y() = 0.5f;
@@ -443,12 +734,21 @@ void StGLSubtitles::stglDraw(unsigned int theView) {
     aRect.left()  = aRect.left() + aRect.width() / 2 - anImgSize.x() / 2 + anOffset.x();
     aRect.right() = aRect.left() + anImgSize.x();
     myRoot->getRectGl(aRect, aVertices);
+    if(anAtlasSlot != NULL) {
+        // map image texture coordinates to the atlas region
+        const GLfloat anAtlasSizeX = GLfloat(myAtlas.getSizeX());
+        const GLfloat anAtlasSizeY = GLfloat(myAtlas.getSizeY());
+        for(size_t aNodeIter = 0; aNodeIter < 4; ++aNodeIter) {
+            aTexCoords[aNodeIter].x() = (GLfloat(anAtlasSlot->Left) + aTexCoords[aNodeIter].x() * GLfloat(anAtlasSlot->SizeX)) / anAtlasSizeX;
+            aTexCoords[aNodeIter].y() = (GLfloat(anAtlasSlot->Top)  + aTexCoords[aNodeIter].y() * GLfloat(anAtlasSlot->SizeY)) / anAtlasSizeY;
+        }
+    }
     myVertBuf.init(aCtx, aVertices);
     myTCrdBuf.init(aCtx, aTexCoords);
 
     aCtx.core20fwd->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     aCtx.core20fwd->glEnable(GL_BLEND);
-    myTexture.bind(aCtx);
+    aTexture->bind(aCtx);
     myImgProgram->use(aCtx);
 
     myVertBuf.bindVertexAttrib(aCtx, myImgProgram->getVVertexLoc());
@@ -460,7 +760,7 @@ void StGLSubtitles::stglDraw(unsigned int theView) {
     myVertBuf.unBindVertexAttrib(aCtx, myImgProgram->getVVertexLoc());
 
     myImgProgram->unuse(aCtx);
-    myTexture.unbind(aCtx);
+    aTexture->unbind(aCtx);
     aCtx.core20fwd->glDisable(GL_BLEND);
 }
 
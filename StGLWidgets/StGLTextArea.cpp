@@ -1,6 +1,6 @@
 /**
  * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
- * Copyright © 2009-2020 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * This code is licensed under MIT license (see docs/license-mit.txt for details).
  */
@@ -231,6 +231,45 @@ void StGLTextArea::formatText(StGLContext& theCtx) {
     }
 }
 
+void StGLTextArea::TextLayout::release(StGLContext& theCtx) {
+    for(size_t anIter = 0; anIter < VertBuf.size(); ++anIter) {
+        VertBuf[anIter]->release(theCtx);
+        TCrdBuf[anIter]->release(theCtx);
+    }
+    VertBuf.clear();
+    TCrdBuf.clear();
+    Textures.clear();
+}
+
+void StGLTextArea::formatLayout(StGLContext&    theCtx,
+                                const StString& theText,
+                                TextLayout&     theLayout) {
+    myFormatter.reset();
+    myFormatter.append(theCtx, theText, *myFont);
+    myFormatter.format(myTextWidth, GLfloat(getRectPx().height()));
+    myFormatter.getResult(theCtx, theLayout.Textures, theLayout.VertBuf, theLayout.TCrdBuf);
+    myFormatter.getBndBox(theLayout.BndBox);
+}
+
+void StGLTextArea::swapLayout(StGLContext&    theCtx,
+                              const StString& theText,
+                              TextLayout&     theLayout) {
+    std::swap(myTexturesList, theLayout.Textures);
+    std::swap(myTextBndBox,   theLayout.BndBox);
+    StArrayList< StHandle<StGLVertexBuffer> > aVertBuf = myTextVertBuf;
+    StArrayList< StHandle<StGLVertexBuffer> > aTCrdBuf = myTextTCrdBuf;
+    myTextVertBuf     = theLayout.VertBuf;
+    myTextTCrdBuf     = theLayout.TCrdBuf;
+    theLayout.VertBuf = aVertBuf;
+    theLayout.TCrdBuf = aTCrdBuf;
+
+    myText = theText;
+    if(myToShowBorder) {
+        recomputeBorder(theCtx);
+    }
+    myToRecompute = false;
+}
+
 void StGLTextArea::drawText(StGLContext& theCtx) {
     theCtx.core20fwd->glActiveTexture(GL_TEXTURE0);
     StGLTextProgram& aProgram = myRoot->getTextProgram();
@@ -585,6 +585,32 @@ StGLIcon::~StGLIcon() {
     }
 }
 
+void StGLIcon::setImage(const StHandle<StImage>& theImage) {
+    myImage = theImage;
+    if(myIsExternalTexture
+    || myTextures.isNull()) {
+        myTextures = new StGLTextureArray(1);
+        myIsExternalTexture = false;
+    }
+    myFaceId = 0;
+}
+
+bool StGLIcon::stglInit() {
+    if(!myImage.isNull()) {
+        StGLContext& aCtx = getContext();
+        StGLNamedTexture& aTexture = myTextures->changeValue(0);
+        GLint anInternalFormat = GL_RGB;
+        if(StGLTexture::getInternalFormat(aCtx, myImage->getPlane().getFormat(), anInternalFormat)) {
+            aTexture.setTextureFormat(anInternalFormat);
+            aTexture.init(aCtx, myImage->getPlane());
+        } else {
+            ST_ERROR_LOG("StGLIcon, image has unsupported format!");
+        }
+        myImage.nullify();
+    }
+    return StGLTextureButton::stglInit();
+}
+
 bool StGLIcon::tryClick(const StClickEvent& , bool& ) {
     return false;
 }
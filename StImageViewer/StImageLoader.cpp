@@ -1,5 +1,5 @@
 /**
- * Copyright © 2007-2019 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2007-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StImageViewer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -74,6 +74,9 @@ StImageLoader::StImageLoader(const StImageFile::ImageClass      theImageLib,
   myToFlipCubeZ3x2(false),
   myToSwapJps(false) {
       myPlayList->setExtensions(myMimeList.getExtensionsList());
+      myExportQueue = new StImageExportQueue(theImageLib);
+      myExportQueue->signals.onError.connect(this, &StImageLoader::doOnExportError);
+      myDecodePool = StThreadPool::getShared();
       myThread = new StThread(threadFunction, (void* )this, "StImageLoader");
 }
 
@@ -82,6 +85,7 @@ StImageLoader::~StImageLoader() {
     myLoadNextEvent.set(); // stop the thread
     myThread->wait();
     myThread.nullify();
+    myDecodePool.nullify();
 }
 
 void StImageLoader::setCompressMemory(const bool theToCompress) {
@@ -245,6 +249,128 @@ inline StHandle<StImage> scaledImage(StHandle<StImageFile>& theRef,
     return anImage;
 }
 
+/**
+ * Decoding job for the worker pool.
+ * Job keeps its own references to input buffers, so that it can be safely abandoned by loader thread.
+ */
+class StImageDecodeJob : public StThreadPool::Job {
+
+        public:
+
+    StHandle<StImageFile>  Image;    //!< image to decode
+    StHandle<StImageFile>  ImageAlt; //!< image of another library to decode on failure (optional)
+    StHandle<StJpegParser> Parser;   //!< parser holding file content (optional)
+    StHandle<StRawFile>    RawFile;  //!< file content (optional)
+    StString               Path;     //!< file path
+    StImageFile::ImageType Type;     //!< image type
+    uint8_t*               Data;     //!< data to decode (within Parser or RawFile), or NULL to read the file
+    int                    DataSize; //!< data size
+    uint8_t*               DataAlt;  //!< alternative data to decode on failure (e.g. whole JPEG file)
+    int                    DataAltSize;
+    bool                   IsLoaded; //!< decoding result
+
+    StImageDecodeJob(const StHandle<StImageFile>& theImage,
+                     const StString&              thePath,
+                     const StImageFile::ImageType theType)
+    : Image(theImage), Path(thePath), Type(theType),
+      Data(NULL), DataSize(0), DataAlt(NULL), DataAltSize(0), IsLoaded(false) {}
+
+    /**
+     * Read the file content in advance when it is accessible only through resource manager.
+     */
+    void readContentProtocol(const StResourceManager& theResMgr) {
+        if(!StFileNode::isContentProtocolPath(Path)) {
+            return;
+        }
+
+        int aFileDescriptor = theResMgr.openFileDescriptor(Path);
+        RawFile = new StRawFile();
+        RawFile->readFile(Path, aFileDescriptor);
+        Data     = (uint8_t* )RawFile->getBuffer();
+        DataSize = (int )RawFile->getSize();
+    }
+
+    virtual void perform() ST_ATTR_OVERRIDE {
+        IsLoaded = decode(*Image);
+        if(!IsLoaded
+        && !ImageAlt.isNull()
+        && !isCancelled()
+        && decode(*ImageAlt)) {
+            IsLoaded = true;
+            Image    = ImageAlt;
+        }
+        ImageAlt.nullify();
+        // release file content as soon as possible
+        Parser.nullify();
+        RawFile.nullify();
+    }
+
+        private:
+
+    bool decode(StImageFile& theImage) {
+        if(theImage.load(Path, Type, Data, DataSize)) {
+            return true;
+        }
+        return DataAlt != NULL
+            && !isCancelled()
+            && theImage.load(Path, Type, DataAlt, DataAltSize);
+    }
+
+};
+
+/**
+ * Scaling job for the worker pool.
+ */
+class StImageScaleJob : public StThreadPool::Job {
+
+        public:
+
+    StHandle<StImageFile> Source;     //!< decoded image
+    StHandle<StImage>     Result;     //!< scaled image (or Source itself)
+    StGLDeviceCaps        Caps;
+    size_t                MaxSizeX;
+    size_t                MaxSizeY;
+    StCubemap             Cubemap;
+    size_t                CubeCoeffs[2];
+    StPairRatio           PairRatio;
+
+    StImageScaleJob(const StHandle<StImageFile>& theSource,
+                    const StGLDeviceCaps&        theCaps,
+                    const size_t                 theMaxSizeX,
+                    const size_t                 theMaxSizeY,
+                    const StCubemap              theCubemap,
+                    const size_t*                theCubeCoeffs,
+                    const StPairRatio            thePairRatio)
+    : Source(theSource), Caps(theCaps),
+      MaxSizeX(theMaxSizeX), MaxSizeY(theMaxSizeY),
+      Cubemap(theCubemap), PairRatio(thePairRatio) {
+        CubeCoeffs[0] = theCubeCoeffs[0];
+        CubeCoeffs[1] = theCubeCoeffs[1];
+    }
+
+    virtual void perform() ST_ATTR_OVERRIDE {
+        Result = scaledImage(Source, Caps, MaxSizeX, MaxSizeY, Cubemap, CubeCoeffs, PairRatio);
+    }
+
+};
+
+ST_DEFINE_HANDLE(StImageDecodeJob, StThreadPool::Job);
+ST_DEFINE_HANDLE(StImageScaleJob,  StThreadPool::Job);
+
+bool StImageLoader::waitDecodeJobs(const StHandle<StThreadPool::Job>& theJob1,
+                                   const StHandle<StThreadPool::Job>& theJob2) {
+    while(!myDecodePool->wait(theJob1, 10)
+       || !myDecodePool->wait(theJob2, 10)) {
+        if(isLoadSkipped()) {
+            // running decoder can not be interrupted - its result is just abandoned
+            myDecodePool->cancel(theJob1);
+            myDecodePool->cancel(theJob2);
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * Auxiliary method to format image dimensions.
  */
@@ -265,8 +391,17 @@ bool StImageLoader::loadImage(const StHandle<StFileNode>& theSource,
     const StString               aFilePath = theSource->getPath();
     const StImageFile::ImageType anImgType = StImageFile::guessImageType(aFilePath, theSource->getMIME());
 
-    StHandle<StImageFile> anImageFileL = StImageFile::create(myImageLib, anImgType);
-    StHandle<StImageFile> anImageFileR = StImageFile::create(myImageLib, anImgType);
+    const bool isJpeg = anImgType == StImageFile::ST_TYPE_MPO
+                     || anImgType == StImageFile::ST_TYPE_JPEG
+                     || anImgType == StImageFile::ST_TYPE_JPS;
+
+    // JPEG is decoded by libav keeping native YCbCr planes (4:2:0, 4:2:2 or 4:4:4),
+    // so that color conversion is done by GPU and texture upload takes less bandwidth;
+    // other libraries convert JPEG into packed RGB on CPU, and the configured one is used as fallback
+    const StImageFile::ImageClass anImageLib  = (StImageFile::ImageClass )myImageLib;
+    const bool                    toTryLibAV  = isJpeg && anImageLib != StImageFile::ST_LIBAV;
+    StHandle<StImageFile> anImageFileL = StImageFile::create(toTryLibAV ? StImageFile::ST_LIBAV : anImageLib, anImgType);
+    StHandle<StImageFile> anImageFileR = StImageFile::create(toTryLibAV ? StImageFile::ST_LIBAV : anImageLib, anImgType);
     if(anImageFileL.isNull()
     || anImageFileR.isNull()) {
         processLoadFail("No any image library was found!");
@@ -298,30 +433,36 @@ bool StImageLoader::loadImage(const StHandle<StFileNode>& theSource,
     StTimer aLoadTimer(true);
     StFormat  aSrcFormatCurr = myStFormatByUser;
     StPanorama aSrcPanorama = StPanorama_OFF;
-    if(anImgType == StImageFile::ST_TYPE_MPO
-    || anImgType == StImageFile::ST_TYPE_JPEG
-    || anImgType == StImageFile::ST_TYPE_JPS) {
+    if(isJpeg) {
         int aFileDescriptor = -1;
         if(StFileNode::isContentProtocolPath(aFilePath)) {
             aFileDescriptor = myResMgr->openFileDescriptor(aFilePath);
         }
 
-        // special procedure to divide MPO (Multi Picture Object)
-        StJpegParser aParser;
+        // special procedure to divide MPO (Multi Picture Object);
+        // single-image files are decoded directly from the file, so that only headers are read for metadata;
+        // MPO is always scanned entirely, since it might lack MPF index entries
+        StHandle<StJpegParser> aParser = new StJpegParser();
         double anHParallax = 0.0; // parallax in percents
-        const bool isParsed = aParser.readFile(aFilePath, aFileDescriptor);
+        bool isParsed = aFileDescriptor == -1
+                     && anImgType != StImageFile::ST_TYPE_MPO
+                     && aParser->readHeaders(aFilePath)
+                     && aParser->getNbImages() == 1;
+        if(!isParsed) {
+            isParsed = aParser->readFile(aFilePath, aFileDescriptor);
+        }
 
         StHandle<StJpegParser::Image> anImg1, anImg2;
         size_t aMaxSizeX = 0;
         size_t aMaxSizeY = 0;
-        for(StHandle<StJpegParser::Image> anImgIter = aParser.getImage(0); !anImgIter.isNull();
+        for(StHandle<StJpegParser::Image> anImgIter = aParser->getImage(0); !anImgIter.isNull();
             anImgIter = anImgIter->Next) {
             aMaxSizeX = stMax(aMaxSizeX, anImgIter->SizeX);
             aMaxSizeY = stMax(aMaxSizeY, anImgIter->SizeY);
         }
 
         int anImgCounter = 1;
-        for(StHandle<StJpegParser::Image> anImgIter = aParser.getImage(0); !anImgIter.isNull();
+        for(StHandle<StJpegParser::Image> anImgIter = aParser->getImage(0); !anImgIter.isNull();
             anImgIter = anImgIter->Next, ++anImgCounter) {
             if(anImgIter->SizeX == aMaxSizeX
             && anImgIter->SizeY == aMaxSizeY) {
@@ -339,7 +480,7 @@ bool StImageLoader::loadImage(const StHandle<StFileNode>& theSource,
         if (anImg1.isNull()) {
             // handle broken or unknown JPEG files / issues in JPEG parser
             ST_DEBUG_LOG("Warning, StJpegParser returned inconclusive list of sub-images");
-            anImg1 = aParser.getImage(0);
+            anImg1 = aParser->getImage(0);
         }
         if (anImg1.isNull()) {
             processLoadFail(StString("StJpegParser failed on \"") + aFilePath + '\"');
@@ -347,17 +488,17 @@ bool StImageLoader::loadImage(const StHandle<StFileNode>& theSource,
         }
 
         // copy metadata
-        if(!aParser.getComment().isEmpty()) {
+        if(!aParser->getComment().isEmpty()) {
             StDictEntry& anEntry  = anImgInfo->Info.addChange("Jpeg.Comment");
-            anEntry.changeValue() = aParser.getComment();
+            anEntry.changeValue() = aParser->getComment();
         }
-        if(!aParser.getJpsComment().isEmpty()) {
+        if(!aParser->getJpsComment().isEmpty()) {
             StDictEntry& anEntry  = anImgInfo->Info.addChange("Jpeg.JpsComment");
-            anEntry.changeValue() = aParser.getJpsComment();
+            anEntry.changeValue() = aParser->getJpsComment();
         }
-        if(!aParser.getXMP().isEmpty()) {
+        if(!aParser->getXMP().isEmpty()) {
             StDictEntry& anEntry  = anImgInfo->Info.addChange("Jpeg.XMP");
-            anEntry.changeValue() = aParser.getXMP();
+            anEntry.changeValue() = aParser->getXMP();
         }
         if(!anImg1.isNull()) {
             for(size_t anExifId = 0; anExifId < anImg1->Exif.size(); ++anExifId) {
@@ -370,36 +511,68 @@ bool StImageLoader::loadImage(const StHandle<StFileNode>& theSource,
             }
         }
         if(myStFormatByUser == StFormat_AUTO) {
-            if(aParser.getSrcFormat() != StFormat_AUTO) {
-                aSrcFormatCurr = aParser.getSrcFormat();
+            if(aParser->getSrcFormat() != StFormat_AUTO) {
+                aSrcFormatCurr = aParser->getSrcFormat();
             } else if(!anImg1.isNull() && anImg2.isNull()
                     && anImg1->getQooCamMakerNote(aSrcFormatCurr)) {
                 //
             }
         }
-        aSrcPanorama = aParser.getPanorama();
+        aSrcPanorama = aParser->getPanorama();
 
-        //aParser.fillDictionary(anImgInfo->Info, true);
+        //aParser->fillDictionary(anImgInfo->Info, true);
         if(!isParsed) {
             processLoadFail(StString("Can not read the file \"") + aFilePath + '\"');
             return false;
         }
 
         anImgInfo->IsSavable = anImg2.isNull();
-        anImgInfo->StInfoStream = aParser.getSrcFormat();
+        anImgInfo->StInfoStream = aParser->getSrcFormat();
         if(anImgInfo->StInfoStream != StFormat_AUTO) {
             StDictEntry& anEntry  = anImgInfo->Info.addChange("Jpeg.JpsStereo");
             anEntry.changeValue() = tr(StImageViewerGUI::trSrcFormatId(anImgInfo->StInfoStream));
         }
 
-        // read image from memory
+        // read image (from memory when whole file has been read)
         const StJpegParser::Orient anOrient = anImg1->getOrientation();
         theParams->setZRotateZero((GLfloat )StJpegParser::getRotationAngle(anOrient));
         anImg1->getParallax(anHParallax);
-        if(!anImageFileL->load(aFilePath, StImageFile::ST_TYPE_JPEG,
-                               (uint8_t* )anImg1->Data, (int )anImg1->Length)
-        && !anImageFileL->load(aFilePath, StImageFile::ST_TYPE_JPEG,
-                               (uint8_t* )aParser.getBuffer(), (int )aParser.getSize())) {
+        StHandle<StImageDecodeJob> aJobL = new StImageDecodeJob(anImageFileL, aFilePath, StImageFile::ST_TYPE_JPEG);
+        if(toTryLibAV) {
+            aJobL->ImageAlt = StImageFile::create(anImageLib, anImgType);
+        }
+        if(!aParser->isHeadersOnly()) {
+            aJobL->Parser      = aParser;
+            aJobL->Data        = (uint8_t* )anImg1->Data;
+            aJobL->DataSize    = (int )anImg1->Length;
+            aJobL->DataAlt     = (uint8_t* )aParser->getBuffer();
+            aJobL->DataAltSize = (int )aParser->getSize();
+        }
+
+        // decode views of MPO in parallel
+        StHandle<StImageDecodeJob> aJobR;
+        if(!anImg2.isNull()) {
+            aJobR = new StImageDecodeJob(anImageFileR, aFilePath, StImageFile::ST_TYPE_JPEG);
+            if(toTryLibAV) {
+                aJobR->ImageAlt = StImageFile::create(anImageLib, anImgType);
+            }
+            aJobR->Parser   = aParser;
+            aJobR->Data     = (uint8_t* )anImg2->Data;
+            aJobR->DataSize = (int )anImg2->Length;
+        }
+        aParser.nullify();
+        myDecodePool->push(aJobL);
+        myDecodePool->push(aJobR);
+        if(!waitDecodeJobs(aJobL, aJobR)) {
+            return false;
+        }
+
+        // take images decoded by fallback library
+        anImageFileL = aJobL->Image;
+        if(!aJobR.isNull()) {
+            anImageFileR = aJobR->Image;
+        }
+        if(!aJobL->IsLoaded) {
             processLoadFail(formatError(aFilePath, anImageFileL->getState()));
             return false;
         }
@@ -407,8 +580,7 @@ bool StImageLoader::loadImage(const StHandle<StFileNode>& theSource,
         if(!anImg2.isNull()) {
             // read image from memory
             anImg2->getParallax(anHParallax); // in MPO parallax generally stored ONLY in second frame
-            if(!anImageFileR->load(aFilePath, StImageFile::ST_TYPE_JPEG,
-                                   (uint8_t* )anImg2->Data, (int )anImg2->Length)) {
+            if(!aJobR->IsLoaded) {
                 processLoadFail(formatError(aFilePath, anImageFileR->getState()));
                 return false;
             }
@@ -427,35 +599,35 @@ bool StImageLoader::loadImage(const StHandle<StFileNode>& theSource,
         const StString aFilePathLeft  = theSource->getValue(0)->getPath();
         const StString aFilePathRight = theSource->getValue(1)->getPath();
 
-        // loading image with format autodetection
-        StRawFile aRawFileL;
-        if(StFileNode::isContentProtocolPath(aFilePathLeft)) {
-            int aFileDescriptor = myResMgr->openFileDescriptor(aFilePathLeft);
-            aRawFileL.readFile(aFilePathLeft, aFileDescriptor);
+        // loading images with format autodetection, both views are decoded in parallel
+        StHandle<StImageDecodeJob> aJobL = new StImageDecodeJob(anImageFileL, aFilePathLeft,  anImgType);
+        StHandle<StImageDecodeJob> aJobR = new StImageDecodeJob(anImageFileR, aFilePathRight, anImgType);
+        StHandle<StImageDecodeJob> aJobs[2] = { aJobL, aJobR };
+        for(int aViewIter = 0; aViewIter < 2; ++aViewIter) {
+            aJobs[aViewIter]->readContentProtocol(*myResMgr);
+            myDecodePool->push(aJobs[aViewIter]);
+        }
+        if(!waitDecodeJobs(aJobL, aJobR)) {
+            return false;
         }
-        if(!anImageFileL->load(aFilePathLeft, anImgType, (uint8_t* )aRawFileL.getBuffer(), (int )aRawFileL.getSize())) {
+        if(!aJobL->IsLoaded) {
             processLoadFail(formatError(aFilePathLeft, anImageFileL->getState()));
             return false;
         }
-        aRawFileL.freeBuffer();
         aSrcPanorama = anImageFileL->getPanoramaFormat();
-
-        StRawFile aRawFileR;
-        if(StFileNode::isContentProtocolPath(aFilePathRight)) {
-            int aFileDescriptor = myResMgr->openFileDescriptor(aFilePathRight);
-            aRawFileR.readFile(aFilePathRight, aFileDescriptor);
-        }
-        if(!anImageFileR->load(aFilePathRight, anImgType, (uint8_t* )aRawFileR.getBuffer(), (int )aRawFileR.getSize())) {
+        if(!aJobR->IsLoaded) {
             processLoadFail(formatError(aFilePathRight, anImageFileR->getState()));
             return false;
         }
     } else {
-        StRawFile aRawFile;
-        if(StFileNode::isContentProtocolPath(aFilePath)) {
-            int aFileDescriptor = myResMgr->openFileDescriptor(aFilePath);
-            aRawFile.readFile(aFilePath, aFileDescriptor);
+        // single file is decoded by worker pool as well, so that loading can be skipped
+        StHandle<StImageDecodeJob> aJobL = new StImageDecodeJob(anImageFileL, aFilePath, anImgType);
+        aJobL->readContentProtocol(*myResMgr);
+        myDecodePool->push(aJobL);
+        if(!waitDecodeJobs(aJobL, StHandle<StThreadPool::Job>())) {
+            return false;
         }
-        if(!anImageFileL->load(aFilePath, anImgType, (uint8_t* )aRawFile.getBuffer(), (int )aRawFile.getSize())) {
+        if(!aJobL->IsLoaded) {
             processLoadFail(formatError(aFilePath, anImageFileL->getState()));
             return false;
         }
@@ -578,10 +750,22 @@ bool StImageLoader::loadImage(const StHandle<StFileNode>& theSource,
         }
     }
 
-    StHandle<StImage> anImageL = scaledImage(anImageFileL, myTextureQueue->getDeviceCaps(), aSizeXLim, aSizeYLim,
-                                             aSrcCubemap, aCubeCoeffs, aPairRatio);
-    StHandle<StImage> anImageR = scaledImage(anImageFileR, myTextureQueue->getDeviceCaps(), aSizeXLim, aSizeYLim,
-                                             aSrcCubemap, aCubeCoeffs, aPairRatio);
+    // scale views in parallel
+    StHandle<StImageScaleJob> aScaleJobL = new StImageScaleJob(anImageFileL, myTextureQueue->getDeviceCaps(), aSizeXLim, aSizeYLim,
+                                                               aSrcCubemap, aCubeCoeffs, aPairRatio);
+    StHandle<StImageScaleJob> aScaleJobR;
+    if(!anImageFileR->isNull()) {
+        aScaleJobR = new StImageScaleJob(anImageFileR, myTextureQueue->getDeviceCaps(), aSizeXLim, aSizeYLim,
+                                         aSrcCubemap, aCubeCoeffs, aPairRatio);
+    }
+    myDecodePool->push(aScaleJobL);
+    myDecodePool->push(aScaleJobR);
+    if(!waitDecodeJobs(aScaleJobL, aScaleJobR)) {
+        return false;
+    }
+
+    StHandle<StImage> anImageL = aScaleJobL->Result;
+    StHandle<StImage> anImageR = !aScaleJobR.isNull() ? aScaleJobR->Result : StHandle<StImage>(anImageFileR);
 #ifdef ST_DEBUG
     const double aScaleTimeMSec = aLoadTimer.getElapsedTimeInMilliSec() - aLoadTimeMSec;
     if(anImageL != anImageFileL) {
@@ -666,35 +850,23 @@ bool StImageLoader::saveImage(const StHandle<StFileNode>&     theSource,
         return false;
     }
 
+    // decoded buffers are referenced rather than copied, encoding is done by export queue
     int aResult = StGLTextureQueue::SNAPSHOT_NO_NEW;
-    StImage aDataLeft, aDataRight;
+    StHandle<StImage> aDataLeft  = new StImage();
+    StHandle<StImage> aDataRight = new StImage();
     if(!theParams->ToSwapLR) {
-        aResult = getSnapshot(&aDataLeft, &aDataRight, true);
+        aResult = getSnapshot(aDataLeft.access(), aDataRight.access(), true);
     } else {
-        aResult = getSnapshot(&aDataRight, &aDataLeft, true);
+        aResult = getSnapshot(aDataRight.access(), aDataLeft.access(), true);
     }
 
     if(aResult == StGLTextureQueue::SNAPSHOT_NO_NEW
-    || aDataLeft.isNull()) {
+    || aDataLeft->isNull()) {
         myMsgQueue->pushInfo(tr(DIALOG_NO_SNAPSHOT));
         return false;
     }
-    StHandle<StImageFile> aDataResult = StImageFile::create(myImageLib);
-    if(aDataResult.isNull()) {
-        myMsgQueue->pushError(stCString("No any image library was found!"));
-        return false;
-    }
 
-    const bool toSaveStereo = !aDataRight.isNull();
-    if(toSaveStereo
-    && aDataResult->initSideBySide(aDataLeft, aDataRight,
-                                   theParams->getSeparationDx(),
-                                   theParams->getSeparationDy())) {
-        aDataLeft.nullify();
-        aDataRight.nullify();
-    } else {
-        aDataResult->initWrapper(aDataLeft);
-    }
+    const bool toSaveStereo = !aDataRight->isNull();
 
     StOpenFileName anOpenInfo;
     anOpenInfo.Title = myLangMap->getValue(StImageViewerStrings::DIALOG_SAVE_SNAPSHOT);
@@ -749,19 +921,15 @@ bool StImageLoader::saveImage(const StHandle<StFileNode>&     theSource,
         }
 
         if(toSave) {
-            ST_DEBUG_LOG("Save snapshot to the path '" + aFileToSave + '\'');
-            StString strSaveState;
-            StImageFile::SaveImageParams aSaveParams;
-            aSaveParams.SaveImageType = theImgType;
-            aSaveParams.StereoFormat = toSaveStereo ? StFormat_SideBySide_RL : StFormat_AUTO;
-            if(!aDataResult->save(aFileToSave, aSaveParams)) {
-                // TODO (Kirill Gavrilov#7)
-                myMsgQueue->pushError(aDataResult->getState());
-                return false;
-            }
-            if(!aDataResult->getState().isEmpty()) {
-                ST_DEBUG_LOG(aDataResult->getState());
-            }
+            StImageExportQueue::Job aJob;
+            aJob.Left  = aDataLeft;
+            aJob.Right = toSaveStereo ? aDataRight : StHandle<StImage>();
+            aJob.Path  = aFileToSave;
+            aJob.SaveParams.SaveImageType = theImgType;
+            aJob.SaveParams.StereoFormat  = toSaveStereo ? StFormat_SideBySide_RL : StFormat_AUTO;
+            aJob.SeparationDx = theParams->getSeparationDx();
+            aJob.SeparationDy = theParams->getSeparationDy();
+            myExportQueue->push(aJob);
             // TODO (Kirill Gavrilov#8) - update playlist (append new file)
         }
     }
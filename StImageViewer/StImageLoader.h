@@ -1,5 +1,5 @@
 /**
- * Copyright © 2007-2019 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2007-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StImageViewer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -23,12 +23,14 @@
 #include <StFile/StMIMEList.h>
 #include <StGL/StPlayList.h>
 #include <StGLStereo/StGLTextureQueue.h>
+#include <StImage/StImageExportQueue.h>
 #include <StImage/StImageFile.h>
 #include <StImage/StJpegParser.h>
 #include <StSlots/StSignal.h>
 #include <StStrings/StLangMap.h>
 #include <StThreads/StProcess.h>
 #include <StThreads/StResourceManager.h>
+#include <StThreads/StThreadPool.h>
 
 class StThread;
 
@@ -128,6 +130,7 @@ class StImageLoader {
 
     ST_LOCAL void setImageLib(const StImageFile::ImageClass theImageLib) {
         myImageLib = theImageLib;
+        myExportQueue->setImageLib(theImageLib);
     }
 
     /**
@@ -189,7 +192,14 @@ class StImageLoader {
     ST_LOCAL bool saveImageInfo(const StHandle<StImageInfo>& theInfo);
 
     ST_LOCAL int getSnapshot(StImage* outDataLeft, StImage* outDataRight, bool isForce = false) {
-        return myTextureQueue->getSnapshot(outDataLeft, outDataRight, isForce);
+        return myTextureQueue->getSnapshot(outDataLeft, outDataRight, isForce, true);
+    }
+
+    /**
+     * Redirect export queue errors to messages queue.
+     */
+    ST_LOCAL void doOnExportError(const StCString& theMsgText) {
+        myMsgQueue->pushError(theMsgText);
     }
 
     /**
@@ -197,6 +207,22 @@ class StImageLoader {
      */
     ST_LOCAL void processLoadFail(const StString& theErrorDesc);
 
+    /**
+     * Return true if loading of current image should be abandoned in favor of another request.
+     */
+    ST_LOCAL bool isLoadSkipped() const {
+        return myAction == Action_Quit
+           || (myAction == Action_NONE && myLoadNextEvent.check());
+    }
+
+    /**
+     * Wait for decoding jobs (one or two) executed by worker pool.
+     * Jobs are cancelled and abandoned when another file has been requested meanwhile.
+     * @return false if loading has been skipped
+     */
+    ST_LOCAL bool waitDecodeJobs(const StHandle<StThreadPool::Job>& theJob1,
+                                 const StHandle<StThreadPool::Job>& theJob2);
+
     /**
      * Fill metadata map from EXIF.
      */
@@ -216,13 +242,15 @@ class StImageLoader {
     StHandle<StLangMap>         myLangMap;       //!< translations dictionary
     StHandle<StPlayList>        myPlayList;      //!< play list
     mutable StMutex             myLock;          //!< lock to access not thread-safe properties
-    StCondition                 myLoadNextEvent;
+    mutable StCondition         myLoadNextEvent;
     StFormat                    myStFormatByUser;//!< target source format (auto-detect by default)
     GLint                       myMaxTexDim;     //!< value for GL_MAX_TEXTURE_SIZE
     StHandle<StGLTextureQueue>  myTextureQueue;  //!< decoded frames queue
     StHandle<StImageInfo>       myImgInfo;       //!< info about currently loaded image
     StHandle<StImageInfo>       myInfoToSave;    //!< modified info to be saved
     StHandle<StMsgQueue>        myMsgQueue;      //!< messages queue
+    StHandle<StImageExportQueue> myExportQueue;  //!< queue encoding saved images
+    StHandle<StThreadPool>      myDecodePool;    //!< shared worker pool decoding and scaling stereo pair views in parallel
 
     volatile StImageFile::ImageClass myImageLib;
     volatile Action            myAction;
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2007-2022 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2007-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StImageViewer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -240,16 +240,16 @@ StImageViewer::StImageViewer(const StHandle<StResourceManager>& theResMgr,
     mySettings->loadParam (params.ToShowAdjustImage);
 
 #if defined(__ANDROID__)
-    addRenderer(new StOutInterlace  (myResMgr, theParentWin));
-    addRenderer(new StOutAnaglyph   (myResMgr, theParentWin));
-    addRenderer(new StOutDistorted  (myResMgr, theParentWin));
+    addRenderer(stCString("StOutInterlace"),  &createRenderer<StOutInterlace>);
+    addRenderer(stCString("StOutAnaglyph"),   &createRenderer<StOutAnaglyph>);
+    addRenderer(stCString("StOutDistorted"),  &createRenderer<StOutDistorted>);
 #else
-    addRenderer(new StOutAnaglyph   (myResMgr, theParentWin));
-    addRenderer(new StOutDual       (myResMgr, theParentWin));
-    addRenderer(new StOutIZ3D       (myResMgr, theParentWin));
-    addRenderer(new StOutInterlace  (myResMgr, theParentWin));
-    addRenderer(new StOutDistorted  (myResMgr, theParentWin));
-    addRenderer(new StOutPageFlipExt(myResMgr, theParentWin));
+    addRenderer(stCString("StOutAnaglyph"),   &createRenderer<StOutAnaglyph>);
+    addRenderer(stCString("StOutDual"),       &createRenderer<StOutDual>);
+    addRenderer(stCString("StOutIZ3D"),       &createRenderer<StOutIZ3D>);
+    addRenderer(stCString("StOutInterlace"),  &createRenderer<StOutInterlace>);
+    addRenderer(stCString("StOutDistorted"),  &createRenderer<StOutDistorted>);
+    addRenderer(stCString("StOutPageFlip"),   &createRenderer<StOutPageFlipExt>);
 #endif
 
     // no need in Depth buffer
@@ -259,10 +259,7 @@ StImageViewer::StImageViewer(const StHandle<StResourceManager>& theResMgr,
         StWinAttr_GlStencilSize, (StWinAttr )0,
         StWinAttr_NULL
     };
-    for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
-        StHandle<StWindow>& aRend = myRenderers[aRendIter];
-        aRend->setAttributes(anAttribs);
-    }
+    setRenderersAttributes(anAttribs);
 
     // create actions
     StHandle<StAction> anAction;
@@ -378,6 +375,7 @@ void StImageViewer::saveGuiParams() {
                         ? myGUI->myImage->params.DisplayRatio->getValue()
                         : StGLImageRegion::RATIO_AUTO);
     mySettings->saveParam(myGUI->myImage->params.TextureFilter);
+    mySettings->saveParam(myGUI->myImage->params.ToUseColorLut);
 }
 
 void StImageViewer::saveAllParams() {
@@ -482,6 +480,7 @@ bool StImageViewer::createGui() {
     mySettings->loadParam (myGUI->myImage->params.TextureFilter);
     mySettings->loadParam (myGUI->myImage->params.DisplayRatio);
     mySettings->loadParam (myGUI->myImage->params.ToHealAnamorphicRatio);
+    mySettings->loadParam (myGUI->myImage->params.ToUseColorLut);
     params.ToRestoreRatio->setValue(myGUI->myImage->params.DisplayRatio->getValue() != StGLImageRegion::RATIO_AUTO);
 
     int32_t loadedGamma = 100; // 1.0f
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StImageViewer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -469,6 +469,8 @@ StGLMenu* StImageViewerGUI::createImageAdjustMenu() {
     aRange->setColor(StGLRangeFieldFloat32::FieldColor_Default,  aBlack);
     aRange->setColor(StGLRangeFieldFloat32::FieldColor_Positive, aGreen);
     aRange->setColor(StGLRangeFieldFloat32::FieldColor_Negative, aRed);
+
+    aMenu->addItem(tr(MENU_VIEW_ADJUST_COLOR_LUT), myImage->params.ToUseColorLut);
     return aMenu;
 }
 
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2013-2022 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2013-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StImageViewer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -113,6 +113,8 @@ void loadDefaults(StLangMap& theStrings) {
                "Saturation");
     theStrings(MENU_VIEW_ADJUST_GAMMA,
                "Gamma");
+    theStrings(MENU_VIEW_ADJUST_COLOR_LUT,
+               "Bake into color LUT");
     theStrings(MENU_VIEW_PANORAMA,
                "Panorama");
     theStrings(MENU_VIEW_SURFACE_PLANE,
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2022 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StImageViewer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -90,6 +90,7 @@ namespace StImageViewerStrings {
         MENU_VIEW_ADJUST_BRIGHTNESS = 1271,
         MENU_VIEW_ADJUST_SATURATION = 1272,
         MENU_VIEW_ADJUST_GAMMA      = 1273,
+        MENU_VIEW_ADJUST_COLOR_LUT  = 1274,
 
         MENU_VIEW_SURFACE_PLANE     = 1280,
         MENU_VIEW_SURFACE_SPHERE    = 1281,
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2007-2023 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2007-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -87,6 +87,105 @@ namespace {
     static const char ST_ARGUMENT_WINWIDTH[]   = "windowWidth";
     static const char ST_ARGUMENT_WINHEIGHT[]  = "windowHeight";
 
+#ifdef ST_HAVE_MONGOOSE
+    /**
+     * Maximum number of simultaneously opened event streams (each one occupies Web UI server thread).
+     */
+    static const int THE_WEB_EVENTS_MAX = 4;
+
+    /**
+     * Default and maximum number of playlist items within single page.
+     */
+    static const size_t THE_WEB_PAGE_DEFAULT = 100;
+    static const size_t THE_WEB_PAGE_MAX     = 1000;
+
+    /**
+     * Escape the string to be put into JSON.
+     */
+    static StString jsonEscape(const StString& theText) {
+        std::string aBuffer;
+        aBuffer.reserve(theText.getSize() + 2);
+        aBuffer += '"';
+        for(const char* aChar = theText.toCString(); *aChar != '\0'; ++aChar) {
+            switch(*aChar) {
+                case '"':  aBuffer += "\\\""; break;
+                case '\\': aBuffer += "\\\\"; break;
+                case '\n': aBuffer += "\\n";  break;
+                case '\r': aBuffer += "\\r";  break;
+                case '\t': aBuffer += "\\t";  break;
+                default: {
+                    if((unsigned char )*aChar < 0x20) {
+                        char aCode[8];
+                        stsprintf(aCode, sizeof(aCode), "\\u%04x", (unsigned int )*aChar);
+                        aBuffer += aCode;
+                    } else {
+                        aBuffer += *aChar;
+                    }
+                    break;
+                }
+            }
+        }
+        aBuffer += '"';
+        return StString(aBuffer.c_str());
+    }
+
+    /**
+     * Return non-negative integer argument from query string or default value.
+     */
+    static size_t getQueryNumber(const StString& theQuery,
+                                 const char*     theName,
+                                 const size_t    theDefault) {
+        char aBuffer[32];
+        if(mg_get_var(theQuery.toCString(), theQuery.getSize(), theName, aBuffer, sizeof(aBuffer)) <= 0) {
+            return theDefault;
+        }
+
+        StCLocale aCLocale;
+        const long aValue = stStringToLong(aBuffer, 10, aCLocale);
+        return aValue >= 0 ? size_t(aValue) : theDefault;
+    }
+
+    /**
+     * Compute entity tag from the content.
+     */
+    static StString computeETag(const StString& theContent) {
+        // FNV-1a hash
+        uint32_t aHash = 2166136261U;
+        for(const char* aChar = theContent.toCString(); *aChar != '\0'; ++aChar) {
+            aHash = (aHash ^ (unsigned char )*aChar) * 16777619U;
+        }
+        char aBuffer[16];
+        stsprintf(aBuffer, sizeof(aBuffer), "%08x", aHash);
+        return StString("\"") + aBuffer + "\"";
+    }
+
+    /**
+     * Send JSON reply, or empty 304 reply if the client already has the content with specified entity tag.
+     */
+    static void sendJson(mg_connection*  theConnection,
+                         const StString& theContent,
+                         const StString& theETag) {
+        const char* aClientTag = mg_get_header(theConnection, "If-None-Match");
+        if(aClientTag != NULL
+        && theETag.isEquals(StString(aClientTag))) {
+            const StString anAnswer = StString("HTTP/1.1 304 Not Modified\r\n"
+                                               "ETag: ") + theETag + "\r\n"
+                                               "Content-Length: 0\r\n"
+                                               "\r\n";
+            mg_write(theConnection, anAnswer.toCString(), anAnswer.getSize());
+            return;
+        }
+
+        const StString anAnswer = StString("HTTP/1.1 200 OK\r\n"
+                                           "Content-Type: application/json; charset=utf-8\r\n"
+                                           "Cache-Control: no-cache\r\n"
+                                           "ETag: ") + theETag + "\r\n"
+                                           "Content-Length: " + theContent.getSize() + "\r\n"
+                                           "\r\n" + theContent;
+        mg_write(theConnection, anAnswer.toCString(), anAnswer.getSize());
+    }
+#endif
+
 }
 
 void StMoviePlayer::doChangeDevice(const int32_t theValue) {
@@ -185,6 +284,8 @@ void StMoviePlayer::updateStrings() {
     params.ToShowAdjustImage->setName(tr(MENU_VIEW_IMAGE_ADJUST));
     params.ToSwapJPS->setName(tr(OPTION_SWAP_JPS));
     params.ToStickPanorama->setName(tr(MENU_VIEW_STICK_PANORAMA360));
+    params.ExportFrameStep->setName(tr(MENU_MEDIA_EXPORT_FRAMES_STEP));
+    params.ToExportSideBySide->setName(tr(MENU_MEDIA_EXPORT_FRAMES_SBS));
     params.ToTrackHead->setName(tr(MENU_VIEW_TRACK_HEAD));
     params.ToTrackHeadAudio->setName(tr(MENU_VIEW_TRACK_HEAD_AUDIO));
     params.ToForceBFormat->setName(stCString("Force B-Format"));
@@ -194,6 +295,9 @@ void StMoviePlayer::updateStrings() {
     params.ToShowBottom->setName(stCString("Show seekbar"));
     params.ToMixImagesVideos->setName(stCString("Mix images & videos"));
     params.SlideShowDelay->setName(stCString("Slideshow delay"));
+    params.ReadAheadSec->setName(stCString("Read-ahead"));
+    params.ReadAheadMaxMB->setName(stCString("Read-ahead limit"));
+    params.AudioDecodeAhead->setName(stCString("Audio decode-ahead"));
     params.IsMobileUI->setName(stCString("Mobile UI"));
     params.IsExclusiveFullScreen->setName(tr(MENU_EXCLUSIVE_FULLSCREEN));
     params.IsVSyncOn->setName(tr(MENU_FPS_VSYNC));
@@ -245,8 +349,10 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
   mySubsOnLoad(-1),
   //
   myWebCtx(NULL),
+  myWebEventsStop(false),
   //
   myToUpdateALList(false),
+  myIsFrameDrawn(false),
   myToCheckUpdates(true),
   myToCheckPoorOrient(true) {
     mySettings = new StSettings(myResMgr, ST_DRAWER_PLUGIN_NAME);
@@ -318,6 +424,9 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     params.AudioMute->signals.onChanged = stSlot(this, &StMoviePlayer::doSetAudioMute);
     params.AudioDelay   = new StFloat32Param(0.0f, -5.0f, 5.0f, 0.0f, 0.100f);
     params.AudioDelay->signals.onChanged = stSlot(this, &StMoviePlayer::doSetAudioDelay);
+    params.PlaybackRate = new StFloat32Param(1.0f, 0.5f, 4.0f, 1.0f, 0.25f);
+    params.PlaybackRate->setFormat(stCString("x%01.2f"));
+    params.PlaybackRate->signals.onChanged = stSlot(this, &StMoviePlayer::doSetPlaybackRate);
 
     params.IsFullscreen     = new StBoolParamNamed(false, stCString("fullscreen"));
     params.IsFullscreen->signals.onChanged = stSlot(this, &StMoviePlayer::doFullscreen);
@@ -353,6 +462,25 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     params.SlideShowDelay->setStep(1.0f);
     params.SlideShowDelay->setTolerance(0.1f);
     params.SlideShowDelay->setFormat(stCString("%01.1f s"));
+    params.ReadAheadSec = new StFloat32Param(4.0f, stCString("readAheadSec"));
+    params.ReadAheadSec->setMinMaxValues(0.0f, 30.0f);
+    params.ReadAheadSec->setDefValue(4.0f);
+    params.ReadAheadSec->setStep(1.0f);
+    params.ReadAheadSec->setTolerance(0.1f);
+    params.ReadAheadSec->setFormat(stCString("%01.0f s"));
+    params.ReadAheadMaxMB = new StFloat32Param(64.0f, stCString("readAheadMaxMB"));
+    params.ReadAheadMaxMB->setMinMaxValues(4.0f, 512.0f);
+    params.ReadAheadMaxMB->setDefValue(64.0f);
+    params.ReadAheadMaxMB->setStep(4.0f);
+    params.ReadAheadMaxMB->setTolerance(0.1f);
+    params.ReadAheadMaxMB->setFormat(stCString("%01.0f MiB"));
+    params.AudioDecodeAhead = new StFloat32Param(500.0f, stCString("audioDecodeAheadMs"));
+    params.AudioDecodeAhead->setMinMaxValues(0.0f, 4000.0f);
+    params.AudioDecodeAhead->setDefValue(500.0f);
+    params.AudioDecodeAhead->setStep(100.0f);
+    params.AudioDecodeAhead->setTolerance(1.0f);
+    params.AudioDecodeAhead->setFormat(stCString("%01.0f ms"));
+    params.AudioDecodeAhead->signals.onChanged = stSlot(this, &StMoviePlayer::doSetAudioDecodeAhead);
     params.IsMobileUI  = new StBoolParamNamed(StWindow::isMobile(), stCString("isMobileUI"));
     params.IsMobileUI->signals.onChanged = stSlot(this, &StMoviePlayer::doChangeMobileUI);
     params.IsMobileUISwitch = new StBoolParam(params.IsMobileUI->getValue());
@@ -390,6 +518,8 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     // OpenJPEG seems to be faster then built-in jpeg2000 decoder
     params.UseOpenJpeg = new StBoolParamNamed(true, stCString("openJpeg"));
     params.SnapshotImgType = new StInt32ParamNamed(StImageFile::ST_TYPE_JPEG, stCString("snapImgType"));
+    params.ExportFrameStep = new StInt32ParamNamed(1, stCString("exportFrameStep"));
+    params.ToExportSideBySide = new StBoolParamNamed(true, stCString("exportSideBySide"));
     params.Benchmark = new StBoolParamNamed(false, stCString("benchmark"));
     params.Benchmark->signals.onChanged = stSlot(this, &StMoviePlayer::doSetBenchmark);
 
@@ -434,6 +564,9 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     mySettings->loadParam (params.AudioAlHrtf);
     mySettings->loadParam (params.ToShowFps);
     mySettings->loadParam (params.SlideShowDelay);
+    mySettings->loadParam (params.ReadAheadSec);
+    mySettings->loadParam (params.ReadAheadMaxMB);
+    mySettings->loadParam (params.AudioDecodeAhead);
     mySettings->loadParam (params.ToMixImagesVideos);
     mySettings->loadParam (params.IsMobileUI);
     mySettings->loadParam (params.IsExclusiveFullScreen);
@@ -448,6 +581,8 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     mySettings->loadParam (params.WebUIPort);
     mySettings->loadParam (params.ToPrintWebErrors);
     mySettings->loadParam (params.SnapshotImgType);
+    mySettings->loadParam (params.ExportFrameStep);
+    mySettings->loadParam (params.ToExportSideBySide);
     mySettings->loadParam (params.BlockSleeping);
     mySettings->loadParam (params.ToHideStatusBar);
     mySettings->loadParam (params.ToHideNavBar);
@@ -469,16 +604,16 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     params.ToForceBFormat->signals.onChanged = stSlot(this, &StMoviePlayer::doSetForceBFormat);
 
 #if defined(__ANDROID__)
-    addRenderer(new StOutInterlace  (myResMgr, theParentWin));
-    addRenderer(new StOutAnaglyph   (myResMgr, theParentWin));
-    addRenderer(new StOutDistorted  (myResMgr, theParentWin));
+    addRenderer(stCString("StOutInterlace"),  &createRenderer<StOutInterlace>);
+    addRenderer(stCString("StOutAnaglyph"),   &createRenderer<StOutAnaglyph>);
+    addRenderer(stCString("StOutDistorted"),  &createRenderer<StOutDistorted>);
 #else
-    addRenderer(new StOutAnaglyph   (myResMgr, theParentWin));
-    addRenderer(new StOutDual       (myResMgr, theParentWin));
-    addRenderer(new StOutIZ3D       (myResMgr, theParentWin));
-    addRenderer(new StOutInterlace  (myResMgr, theParentWin));
-    addRenderer(new StOutDistorted  (myResMgr, theParentWin));
-    addRenderer(new StOutPageFlipExt(myResMgr, theParentWin));
+    addRenderer(stCString("StOutAnaglyph"),   &createRenderer<StOutAnaglyph>);
+    addRenderer(stCString("StOutDual"),       &createRenderer<StOutDual>);
+    addRenderer(stCString("StOutIZ3D"),       &createRenderer<StOutIZ3D>);
+    addRenderer(stCString("StOutInterlace"),  &createRenderer<StOutInterlace>);
+    addRenderer(stCString("StOutDistorted"),  &createRenderer<StOutDistorted>);
+    addRenderer(stCString("StOutPageFlip"),   &createRenderer<StOutPageFlipExt>);
 #endif
 
     // no need in Depth buffer
@@ -488,10 +623,7 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
         StWinAttr_GlStencilSize, (StWinAttr )0,
         StWinAttr_NULL
     };
-    for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
-        StHandle<StWindow>& aRend = myRenderers[aRendIter];
-        aRend->setAttributes(anAttribs);
-    }
+    setRenderersAttributes(anAttribs);
 
     // create actions
     StHandle<StAction> anAction;
@@ -585,6 +717,12 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     anAction = new StActionIntSlot(stCString("DoAudioPrev"), stSlot(this, &StMoviePlayer::doAudioNext), (size_t )-1);
     addAction(Action_AudioPrev, anAction, ST_VK_H | ST_VF_SHIFT, ST_VK_L | ST_VF_SHIFT);
 
+    anAction = new StActionIntSlot(stCString("DoPlaybackSlower"), stSlot(this, &StMoviePlayer::doPlaybackRate), (size_t )-1);
+    addAction(Action_PlaybackSlower, anAction, ST_VK_COMMA | ST_VF_SHIFT);
+
+    anAction = new StActionIntSlot(stCString("DoPlaybackFaster"), stSlot(this, &StMoviePlayer::doPlaybackRate), 1);
+    addAction(Action_PlaybackFaster, anAction, ST_VK_PERIOD | ST_VF_SHIFT);
+
     anAction = new StActionIntSlot(stCString("DoSubtitlesNext"), stSlot(this, &StMoviePlayer::doSubtitlesNext), 1);
     addAction(Action_SubsNext, anAction, ST_VK_U, ST_VK_T);
 
@@ -665,6 +803,7 @@ void StMoviePlayer::saveGuiParams() {
                         ? myGUI->myImage->params.DisplayRatio->getValue()
                         : StGLImageRegion::RATIO_AUTO);
     mySettings->saveParam (myGUI->myImage->params.TextureFilter);
+    mySettings->saveParam (myGUI->myImage->params.ToUseColorLut);
 }
 
 void StMoviePlayer::saveAllParams() {
@@ -706,6 +845,9 @@ void StMoviePlayer::saveAllParams() {
         mySettings->saveParam (params.ToForceBFormat);
         mySettings->saveParam (params.ToShowFps);
         mySettings->saveParam (params.SlideShowDelay);
+        mySettings->saveParam (params.ReadAheadSec);
+        mySettings->saveParam (params.ReadAheadMaxMB);
+        mySettings->saveParam (params.AudioDecodeAhead);
         mySettings->saveParam (params.ToMixImagesVideos);
         mySettings->saveParam (params.IsMobileUI);
         mySettings->saveParam (params.IsExclusiveFullScreen);
@@ -721,6 +863,8 @@ void StMoviePlayer::saveAllParams() {
         }
         mySettings->saveParam (params.ToPrintWebErrors);
         mySettings->saveParam (params.SnapshotImgType);
+        mySettings->saveParam (params.ExportFrameStep);
+        mySettings->saveParam (params.ToExportSideBySide);
         mySettings->saveParam (params.BlockSleeping);
         mySettings->saveParam (params.ToHideStatusBar);
         mySettings->saveParam (params.ToHideNavBar);
@@ -791,6 +935,7 @@ bool StMoviePlayer::createGui(StHandle<StGLTextureQueue>& theTextureQueue,
     mySettings->loadParam (myGUI->myImage->params.TextureFilter);
     mySettings->loadParam (myGUI->myImage->params.DisplayRatio);
     mySettings->loadParam (myGUI->myImage->params.ToHealAnamorphicRatio);
+    mySettings->loadParam (myGUI->myImage->params.ToUseColorLut);
     params.ToRestoreRatio->setValue(myGUI->myImage->params.DisplayRatio->getValue() != StGLImageRegion::RATIO_AUTO);
 
     int32_t loadedGamma = 100; // 1.0f
@@ -895,6 +1040,8 @@ void StMoviePlayer::doDeleteFileEnd(const size_t ) {
 void StMoviePlayer::doStopWebUI() {
 #ifdef ST_HAVE_MONGOOSE
     if(myWebCtx != NULL) {
+        // release server threads occupied by event streams
+        myWebEventsStop.set();
         mg_stop(myWebCtx);
         myWebCtx = NULL;
     }
@@ -920,6 +1067,7 @@ void StMoviePlayer::doStartWebUI() {
     const char* anOptions[] = { "listening_ports",     aPort.toCString(),
                                 "access_control_list", aControlList.toCString(),
                                 NULL };
+    myWebEventsStop.reset();
     myWebCtx = mg_start(&aCallbacks, this, anOptions);
     if(myWebCtx == NULL
     && params.ToPrintWebErrors->getValue()) {
@@ -1011,6 +1159,9 @@ bool StMoviePlayer::init() {
         myVideo->params.ToSearchSubs = params.ToSearchSubs;
         myVideo->params.ToTrackHeadAudio = params.ToTrackHeadAudio;
         myVideo->params.SlideShowDelay = params.SlideShowDelay;
+        myVideo->params.ReadAheadSec   = params.ReadAheadSec;
+        myVideo->params.ReadAheadMaxMB = params.ReadAheadMaxMB;
+        myVideo->params.AudioDecodeAhead = params.AudioDecodeAhead;
         myVideo->setSwapJPS(params.ToSwapJPS->getValue());
         myVideo->setStickPano360(params.ToStickPanorama->getValue());
         myVideo->setForceBFormat(params.ToForceBFormat->getValue());
@@ -1431,6 +1582,14 @@ void StMoviePlayer::doAudioNext(size_t theDirection) {
     params.AudioStream->setValue(aValue);
 }
 
+void StMoviePlayer::doPlaybackRate(size_t theDirection) {
+    if(theDirection == 1) {
+        params.PlaybackRate->increment();
+    } else {
+        params.PlaybackRate->decrement();
+    }
+}
+
 void StMoviePlayer::doSubtitlesNext(size_t theDirection) {
     if(myVideo.isNull()) {
         return;
@@ -1625,6 +1784,12 @@ void StMoviePlayer::beforeDraw() {
         return;
     }
 
+    if(myIsFrameDrawn) {
+        // frame rendered within previous loop has been presented (buffers swapped)
+        myVideo->getTextureQueue()->onFramePresented();
+        myIsFrameDrawn = false;
+    }
+
     if(myVideo->isDisconnected() || myToUpdateALList) {
         const StString aPrevDev = params.AudioAlDevice->getUtfTitle();
         params.AudioAlDevice->initList();
@@ -1729,6 +1894,10 @@ void StMoviePlayer::beforeDraw() {
     }
     if(myGUI->mySeekBar != NULL) {
         myGUI->mySeekBar->setProgress(GLfloat(aPosition));
+        StVideoPreview::Result aPreview;
+        if(myVideo->getPreview()->popResult(aPreview)) {
+            myGUI->mySeekBar->setPreview(aPreview.Image);
+        }
     }
     myGUI->stglUpdate(myWindow->getMousePos(), myWindow->isPreciseCursor());
 
@@ -1879,6 +2048,7 @@ void StMoviePlayer::stglDraw(unsigned int theView) {
 
     myGUI->changeCamera()->setView(theView);
     myGUI->stglDraw(theView);
+    myIsFrameDrawn = true;
 }
 
 void StMoviePlayer::doShowPlayList(const bool theToShow) {
@@ -1973,6 +2143,18 @@ void StMoviePlayer::doSetAudioDelay(const float theDelaySec) {
     }
 }
 
+void StMoviePlayer::doSetAudioDecodeAhead(const float theMilliseconds) {
+    if(!myVideo.isNull()) {
+        myVideo->setAudioDecodeAhead(theMilliseconds);
+    }
+}
+
+void StMoviePlayer::doSetPlaybackRate(const float theRate) {
+    if(!myVideo.isNull()) {
+        myVideo->setPlaybackRate(theRate);
+    }
+}
+
 void StMoviePlayer::doUpdateStateLoading() {
     const StString aFileToLoad = myPlayList->getCurrentTitle();
     if(aFileToLoad.isEmpty()) {
@@ -2259,9 +2441,24 @@ void StMoviePlayer::doSeek(const int theMouseBnt, const double theSeekX) {
     if(aSeekPts < 0.0) {
         aSeekPts = 0.0;
     }
+    if(myGUI->mySeekBar != NULL
+    && myGUI->mySeekBar->isDragging()) {
+        // jump between key frames while scrubbing, precise seek is performed on release
+        myVideo->pushFastSeek(aSeekPts);
+        return;
+    }
     myVideo->pushPlayEvent(ST_PLAYEVENT_SEEK, aSeekPts);
 }
 
+void StMoviePlayer::doSeekHover(const double thePosition) {
+    const double aDuration = myVideo->getDuration();
+    if(thePosition < 0.0
+    || aDuration <= 0.0) {
+        return;
+    }
+    myVideo->getPreview()->request(aDuration * thePosition);
+}
+
 void StMoviePlayer::doPlayPause(const size_t ) {
     myVideo->pushPlayEvent(myVideo->isPlaying() ? ST_PLAYEVENT_PAUSE : ST_PLAYEVENT_RESUME);
 }
@@ -2308,6 +2505,12 @@ void StMoviePlayer::doSnapshot(const size_t theImgType) {
     myVideo->doSaveSnapshotAs(aType);
 }
 
+void StMoviePlayer::doExportFrames(const size_t theImgType) {
+    myVideo->doExportFrames(theImgType,
+                            params.ExportFrameStep->getValue(),
+                            params.ToExportSideBySide->getValue());
+}
+
 void StMoviePlayer::doHideSystemBars(const bool ) {
     if(myWindow.isNull()) {
         return;
@@ -2365,6 +2568,12 @@ int StMoviePlayer::beginRequest(mg_connection*         theConnection,
         return 1;
     }
 
+    // process versioned JSON API requests
+    if(anURI.isStartsWith(stCString("/api/v1/"))) {
+        beginApiRequest(theConnection, theRequestInfo, anURI.subString(8, size_t(-1)), aQuery);
+        return 1;
+    }
+
     // process AJAX requests
     StString aContent;
     if(anURI.isEquals(stCString("/prev"))) {
@@ -2458,6 +2667,136 @@ int StMoviePlayer::beginRequest(mg_connection*         theConnection,
     return 1;
 }
 
+#ifdef ST_HAVE_MONGOOSE
+StString StMoviePlayer::formatWebState() {
+    double aDuration = 0.0;
+    double aPts      = 0.0;
+    bool isVideoPlayed = false, isAudioPlayed = false;
+    const bool isPlaying = myVideo->getPlaybackState(aDuration, aPts, isVideoPlayed, isAudioPlayed);
+
+    // position is reported with 1 second precision to avoid flooding event streams
+    return StString("{\"serial\":") + myPlayList->getSerial()
+         + ",\"revision\":"  + myPlayList->getRevision()
+         + ",\"current\":"   + myPlayList->getCurrentId()
+         + ",\"title\":"     + jsonEscape(myPlayList->getCurrentTitle())
+         + ",\"position\":"  + int(aPts)
+         + ",\"duration\":"  + int(aDuration)
+         + ",\"playing\":"   + (isPlaying ? "true" : "false")
+         + ",\"volume\":"    + int(gainToVolume(params.AudioGain) * 100.0f)
+         + ",\"mute\":"      + (params.AudioMute->getValue() ? "true" : "false")
+         + "}";
+}
+
+void StMoviePlayer::beginApiRequest(mg_connection*         theConnection,
+                                    const mg_request_info& theRequestInfo,
+                                    const StString&        theMethod,
+                                    const StString&        theQuery) {
+    (void )theRequestInfo;
+    if(theMethod.isEquals(stCString("state"))) {
+        const StString aContent = formatWebState();
+        sendJson(theConnection, aContent, computeETag(aContent));
+        return;
+    } else if(theMethod.isEquals(stCString("events"))) {
+        streamWebEvents(theConnection);
+        return;
+    } else if(theMethod.isEquals(stCString("playlist"))) {
+        const size_t anOffset = getQueryNumber(theQuery, "offset", 0);
+        const size_t aLimit   = stMin(getQueryNumber(theQuery, "limit", THE_WEB_PAGE_DEFAULT), THE_WEB_PAGE_MAX);
+
+        // compare revision before walking through the playlist
+        const int32_t aSerial   = myPlayList->getSerial();
+        const int32_t aRevision = myPlayList->getRevision();
+        const size_t  aCurrent  = myPlayList->getCurrentId();
+        const StString anETag = StString("\"") + aSerial + "." + aRevision + "." + aCurrent
+                              + "." + anOffset + "." + aLimit + "\"";
+        const char* aClientTag = mg_get_header(theConnection, "If-None-Match");
+        if(aClientTag != NULL
+        && anETag.isEquals(StString(aClientTag))) {
+            sendJson(theConnection, StString(), anETag);
+            return;
+        }
+
+        const size_t aTotal = myPlayList->getItemsCount();
+        const size_t aStart = stMin(anOffset, aTotal);
+        const size_t anEnd  = stMin(aStart + aLimit, aTotal);
+        StArrayList<StString> aList(anEnd - aStart + 1);
+        if(anEnd > aStart) {
+            myPlayList->getSubList(aList, aStart, anEnd);
+        }
+
+        StString aContent = StString("{\"serial\":") + aSerial
+                          + ",\"revision\":" + aRevision
+                          + ",\"total\":"    + aTotal
+                          + ",\"offset\":"   + aStart
+                          + ",\"current\":"  + aCurrent
+                          + ",\"items\":[";
+        for(size_t anIter = 0; anIter < aList.size(); ++anIter) {
+            if(anIter != 0) {
+                aContent += ",";
+            }
+            aContent += jsonEscape(aList[anIter]);
+        }
+        aContent += "]}";
+        sendJson(theConnection, aContent, anETag);
+        return;
+    }
+
+    const StString anAnswer = StString("HTTP/1.1 404 Not Found\r\n"
+                                       "Content-Type: application/json; charset=utf-8\r\n"
+                                       "Content-Length: 26\r\n"
+                                       "\r\n"
+                                       "{\"error\":\"unknown method\"}");
+    mg_write(theConnection, anAnswer.toCString(), anAnswer.getSize());
+}
+
+void StMoviePlayer::streamWebEvents(mg_connection* theConnection) {
+    if(myWebEventsNb.increment() > THE_WEB_EVENTS_MAX) {
+        myWebEventsNb.decrement();
+        static const char THE_BUSY[] = "HTTP/1.1 503 Service Unavailable\r\n"
+                                       "Retry-After: 10\r\n"
+                                       "Content-Length: 0\r\n"
+                                       "\r\n";
+        mg_write(theConnection, THE_BUSY, sizeof(THE_BUSY) - 1);
+        return;
+    }
+
+    static const char THE_HEADER[] = "HTTP/1.1 200 OK\r\n"
+                                     "Content-Type: text/event-stream\r\n"
+                                     "Cache-Control: no-cache\r\n"
+                                     "\r\n"
+                                     "retry: 2000\n\n";
+    if(mg_write(theConnection, THE_HEADER, sizeof(THE_HEADER) - 1) > 0) {
+        // state is cheap to format, so it is compared periodically instead of tracking every parameter;
+        // the client receives only changes
+        StString aStatePrev;
+        StTimer  anIdleTimer(true);
+        for(;;) {
+            const StString aState = formatWebState();
+            if(!aState.isEquals(aStatePrev)) {
+                const StString anEvent = StString("event: state\ndata: ") + aState + "\n\n";
+                if(mg_write(theConnection, anEvent.toCString(), anEvent.getSize()) <= 0) {
+                    break;
+                }
+                aStatePrev = aState;
+                anIdleTimer.restart();
+            } else if(anIdleTimer.getElapsedTimeInSec() > 15.0) {
+                // comment line keeps connection alive through proxies and detects closed connections
+                static const char THE_PING[] = ": ping\n\n";
+                if(mg_write(theConnection, THE_PING, sizeof(THE_PING) - 1) <= 0) {
+                    break;
+                }
+                anIdleTimer.restart();
+            }
+
+            if(myWebEventsStop.wait(250)) {
+                break;
+            }
+        }
+    }
+    myWebEventsNb.decrement();
+}
+#endif
+
 int StMoviePlayer::beginRequestHandler(mg_connection* theConnection) {
 #ifdef ST_HAVE_MONGOOSE
     const mg_request_info* aRequestInfo = mg_get_request_info(theConnection);
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2007-2023 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2007-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -121,6 +121,7 @@ class StMoviePlayer : public StApplication {
     ST_LOCAL void doDeleteFileEnd  (const size_t dummy = 0);
     ST_LOCAL void doAudioVolume(size_t theDirection);
     ST_LOCAL void doAudioNext(size_t theDirection);
+    ST_LOCAL void doPlaybackRate(size_t theDirection);
     ST_LOCAL void doSubtitlesNext(size_t theDirection);
     ST_LOCAL void doSubtitlesCopy(size_t dummy = 0);
     ST_LOCAL void doFromClipboard(size_t dummy = 0);
@@ -143,10 +144,12 @@ class StMoviePlayer : public StApplication {
     ST_LOCAL void doSeekLeft(const size_t dummy = 0);
     ST_LOCAL void doSeekRight(const size_t dummy = 0);
     ST_LOCAL void doSeek(const int mouseBtn, const double seekX);
+    ST_LOCAL void doSeekHover(const double thePosition);
     ST_LOCAL void doPlayPause(const size_t dummy = 0);
     ST_LOCAL void doStop(const size_t dummy = 0);
 
     ST_LOCAL void doSnapshot(const size_t theImgType);
+    ST_LOCAL void doExportFrames(const size_t theImgType);
     ST_LOCAL void doAboutFile(const size_t dummy = 0);
 
         public: //! @name Properties
@@ -206,6 +209,7 @@ class StMoviePlayer : public StApplication {
         StHandle<StFloat32Param>      AudioGain;         //!< volume factor
         StHandle<StBoolParamNamed>    AudioMute;         //!< volume mute flag
         StHandle<StFloat32Param>      AudioDelay;        //!< audio/video synchronization delay
+        StHandle<StFloat32Param>      PlaybackRate;      //!< playback rate (speed)
         StHandle<StBoolParamNamed>    IsFullscreen;      //!< fullscreen state
         StHandle<StEnumParam>         ExitOnEscape;     //!< exit action on escape
         StHandle<StBoolParamNamed>    ToRestoreRatio;    //!< restore ratio on restart
@@ -228,6 +232,9 @@ class StMoviePlayer : public StApplication {
         StHandle<StBoolParamNamed>    ToShowBottom;      //!< show bottom (seekbar)
         StHandle<StBoolParamNamed>    ToMixImagesVideos; //!< mix videos and images
         StHandle<StFloat32Param>      SlideShowDelay;    //!< slideshow delay
+        StHandle<StFloat32Param>      ReadAheadSec;      //!< duration of video data to read in advance, 0 to disable read-ahead
+        StHandle<StFloat32Param>      ReadAheadMaxMB;    //!< read-ahead limit in megabytes
+        StHandle<StFloat32Param>      AudioDecodeAhead;  //!< duration of audio decoded in advance, in milliseconds
         StHandle<StBoolParamNamed>    IsMobileUI;        //!< display mobile interface (user option)
         StHandle<StBoolParam>         IsMobileUISwitch;  //!< display mobile interface (actual value)
         StHandle<StBoolParamNamed>    IsExclusiveFullScreen; //!< exclusive fullscreen mode
@@ -248,6 +255,8 @@ class StMoviePlayer : public StApplication {
         StHandle<StBoolParamNamed>    ToOpenLast;        //!< option to open last file from recent list by default
         StHandle<StBoolParamNamed>    ToShowExtra;       //!< show experimental menu items
         StHandle<StInt32ParamNamed>   SnapshotImgType;   //!< default snapshot image type
+        StHandle<StInt32ParamNamed>   ExportFrameStep;   //!< export every N-th frame
+        StHandle<StBoolParamNamed>    ToExportSideBySide;//!< pack exported stereo pairs into side-by-side images
         StString                      lastFolder;        //!< laster folder used to open / save file
         StHandle<StInt32ParamNamed>   TargetFps;         //!< rendering FPS limit (0 - max FPS with less CPU, 1,2,3 - adjust to video FPS)
         StHandle<StBoolParamNamed>    UseGpu;            //!< use video decoding on GPU when available
@@ -318,6 +327,8 @@ class StMoviePlayer : public StApplication {
     ST_LOCAL void doSetAudioVolume(const float theGain);
     ST_LOCAL void doSetAudioMute(const bool theToMute);
     ST_LOCAL void doSetAudioDelay(const float theDelaySec);
+    ST_LOCAL void doSetAudioDecodeAhead(const float theMilliseconds);
+    ST_LOCAL void doSetPlaybackRate(const float theRate);
     ST_LOCAL void doSwitchShuffle(const bool theShuffleOn);
     ST_LOCAL void doSwitchLoopSingle(const bool theValue);
     ST_LOCAL void doFullscreen(const bool theIsFullscreen);
@@ -385,6 +396,8 @@ class StMoviePlayer : public StApplication {
         Action_OutStereoRightView,
         Action_OutStereoParallelPair,
         Action_OutStereoCrossEyed,
+        Action_PlaybackSlower,
+        Action_PlaybackFaster,
     };
 
         private: //! @name Web UI methods
@@ -394,6 +407,24 @@ class StMoviePlayer : public StApplication {
     ST_LOCAL int beginRequest(mg_connection*         theConnection,
                               const mg_request_info& theRequestInfo);
 
+    /**
+     * Process request to versioned JSON API (/api/v1/...).
+     */
+    ST_LOCAL void beginApiRequest(mg_connection*         theConnection,
+                                  const mg_request_info& theRequestInfo,
+                                  const StString&        theMethod,
+                                  const StString&        theQuery);
+
+    /**
+     * Format current playback state as JSON object.
+     */
+    ST_LOCAL StString formatWebState();
+
+    /**
+     * Stream playback state changes to the client as server-sent events until connection is closed or Web UI is stopped.
+     */
+    ST_LOCAL void streamWebEvents(mg_connection* theConnection);
+
     ST_LOCAL void doStopWebUI();
     ST_LOCAL void doStartWebUI();
     ST_LOCAL void doSwitchWebUI(const int32_t theValue);
@@ -417,8 +448,11 @@ class StMoviePlayer : public StApplication {
     int32_t                     mySubsOnLoad;      //!< subtitles track on load
 
     mg_context*                 myWebCtx;          //!< web UI context
+    StCondition                 myWebEventsStop;   //!< signals server-sent event streams to finish
+    StAtomic<int32_t>           myWebEventsNb;     //!< number of opened server-sent event streams
 
     bool                        myToUpdateALList;
+    bool                        myIsFrameDrawn;    //!< frame has been rendered within last redraw loop
     bool                        myToCheckUpdates;
     bool                        myToCheckPoorOrient; //!< switch off orientation sensor with poor quality
 
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -80,6 +80,7 @@ void StMoviePlayerGUI::createDesktopUI(const StHandle<StPlayList>& thePlayList)
     mySeekBar = new StGLSeekBar(myPanelBottom, 0, scale(18));
     mySeekBar->setMoveTolerance(scale(isMobile() ? 16 : 8));
     mySeekBar->signals.onSeekClick.connect(myPlugin, &StMoviePlayer::doSeek);
+    mySeekBar->signals.onSeekHover.connect(myPlugin, &StMoviePlayer::doSeekHover);
 
     myTimeBox = new StTimeBox(myPanelBottom, myBottomBarNbLeft * myIconStep, 0,
                               StGLCorner(ST_VCORNER_TOP, ST_HCORNER_RIGHT));
@@ -383,6 +384,17 @@ StGLMenu* StMoviePlayerGUI::createMediaMenu() {
         aMenuMedia->addItem(myPlugin->params.Benchmark->getName(), myPlugin->params.Benchmark);
     }
 
+    StGLMenuItem* aSpeedItem = aMenuMedia->addItem(tr(MENU_MEDIA_PLAYBACK_SPEED));
+    aSpeedItem->changeMargins().right = scale(100 + 16);
+    StGLRangeFieldFloat32* aSpeedRange = new StGLRangeFieldFloat32(aSpeedItem, myPlugin->params.PlaybackRate,
+                                                                   -scale(16), 0, StGLCorner(ST_VCORNER_CENTER, ST_HCORNER_RIGHT));
+    aSpeedRange->changeRectPx().bottom() = aSpeedRange->getRectPx().top() + aMenuMedia->getItemHeight();
+    aSpeedRange->setFormat(stCString("x%01.2f"));
+    aSpeedRange->setColor(StGLRangeFieldFloat32::FieldColor_Default,  aBlack);
+    aSpeedRange->setColor(StGLRangeFieldFloat32::FieldColor_Positive, aBlack);
+    aSpeedRange->setColor(StGLRangeFieldFloat32::FieldColor_Negative, aBlack);
+    aSpeedItem->signals.onItemClick.connect(aSpeedRange, &StGLRangeFieldFloat32::doResetValue); // click restores normal speed
+
     aMenuMedia->addItem(tr(MENU_MEDIA_QUIT), myPlugin->getAction(StMoviePlayer::Action_Quit));
     return aMenuMedia;
 }
@@ -407,6 +419,22 @@ StGLMenu* StMoviePlayerGUI::createSaveImageMenu() {
          ->signals.onItemClick.connect(myPlugin, &StMoviePlayer::doSnapshot);
     aMenu->addItem("PNG stereo (*.pns)",  size_t(StImageFile::ST_TYPE_PNG))
          ->signals.onItemClick.connect(myPlugin, &StMoviePlayer::doSnapshot);
+
+    StGLMenu* aMenuExport = new StGLMenu(this, 0, 0, StGLMenu::MENU_VERTICAL);
+    aMenuExport->addItem("JPEG sequence (*.jpg)", size_t(StImageFile::ST_TYPE_JPEG))
+               ->signals.onItemClick.connect(myPlugin, &StMoviePlayer::doExportFrames);
+    aMenuExport->addItem("PNG sequence (*.png)",  size_t(StImageFile::ST_TYPE_PNG))
+               ->signals.onItemClick.connect(myPlugin, &StMoviePlayer::doExportFrames);
+
+    StGLMenu* aMenuStep = new StGLMenu(this, 0, 0, StGLMenu::MENU_VERTICAL);
+    aMenuStep->addItem("1",   myPlugin->params.ExportFrameStep, 1);
+    aMenuStep->addItem("5",   myPlugin->params.ExportFrameStep, 5);
+    aMenuStep->addItem("25",  myPlugin->params.ExportFrameStep, 25);
+    aMenuStep->addItem("100", myPlugin->params.ExportFrameStep, 100);
+    aMenuExport->addItem(tr(MENU_MEDIA_EXPORT_FRAMES_STEP), aMenuStep);
+    aMenuExport->addItem(myPlugin->params.ToExportSideBySide);
+
+    aMenu->addItem(tr(MENU_MEDIA_EXPORT_FRAMES), aMenuExport);
     return aMenu;
 }
 
@@ -711,6 +739,8 @@ StGLMenu* StMoviePlayerGUI::createImageAdjustMenu() {
     aRange->setColor(StGLRangeFieldFloat32::FieldColor_Default,  aBlack);
     aRange->setColor(StGLRangeFieldFloat32::FieldColor_Positive, aGreen);
     aRange->setColor(StGLRangeFieldFloat32::FieldColor_Negative, aRed);
+
+    aMenu->addItem(tr(MENU_VIEW_ADJUST_COLOR_LUT), myImage->params.ToUseColorLut);
     return aMenu;
 }
 
@@ -1021,6 +1051,12 @@ void StMoviePlayerGUI::doAboutFile(const size_t ) {
         return;
     }
 
+    // GPU time of image drawing, measured separately for each color processing variant
+    const StString aColorGpuTimes = myImage->getColorGpuTimes();
+    if(!aColorGpuTimes.isEmpty()) {
+        anExtraInfo->Codecs.add(StArgument("colorGpuTime", StString("Color processing GPU time: ") + aColorGpuTimes));
+    }
+
     const int THE_MIN_WIDTH = scale(512);
     const StString aTitle  = tr(DIALOG_FILE_INFO);
     const int      aWidth  = stMax(int(double(getRectPx().width()) * 0.6), THE_MIN_WIDTH);
@@ -1370,6 +1406,7 @@ void StMoviePlayerGUI::createMobileBottomToolbar() {
     mySeekBar = new StGLSeekBar(myPanelBottom, 0, scale(18));
     mySeekBar->setMoveTolerance(scale(isMobile() ? 16 : 8));
     mySeekBar->signals.onSeekClick.connect(myPlugin, &StMoviePlayer::doSeek);
+    mySeekBar->signals.onSeekHover.connect(myPlugin, &StMoviePlayer::doSeekHover);
 
     myTimeBox = new StTimeBox(myPanelBottom, myBottomBarNbRight * (-myIconStep), 0, aRightCorner, StGLTextArea::SIZE_SMALL);
     myTimeBox->setSwitchOnClick(true);
@@ -2326,9 +2363,22 @@ void StMoviePlayerGUI::stglDraw(unsigned int theView) {
         myImage->getTextureQueue()->getQueueInfo(myFpsWidget->changePlayQueued(),
                                                  myFpsWidget->changePlayQueueLength(),
                                                  myFpsWidget->changePlayFps());
+        StString anExtraInfo = myPlugin->getMainWindow()->getStatistics();
+        const StFrameScheduler::Statistics aPacing = myImage->getTextureQueue()->getFrameScheduler().getStatistics();
+        if(aPacing.RefreshPeriodMs > 0.0
+        && aPacing.NbFrames > 0) {
+            char aBuffer[256];
+            stsprintf(aBuffer, 256, "VSync %4.2f ms, cadence %d:%d, judder %4.2f ms\nlate %u, skipped %u, max late %4.1f ms",
+                      aPacing.RefreshPeriodMs, aPacing.CadenceLong, aPacing.CadenceShort, aPacing.JudderMs,
+                      (unsigned int )aPacing.NbLate, (unsigned int )aPacing.NbSkipped, aPacing.MaxLateMs);
+            if(!anExtraInfo.isEmpty()) {
+                anExtraInfo += "\n";
+            }
+            anExtraInfo += aBuffer;
+        }
         myFpsWidget->update(myPlugin->getMainWindow()->isStereoOutput(),
                             myPlugin->getMainWindow()->getTargetFps(),
-                            myPlugin->getMainWindow()->getStatistics());
+                            anExtraInfo);
     }
     StGLRootWidget::stglDraw(theView);
 }
@@ -2495,6 +2545,9 @@ void StMoviePlayerGUI::doMobileSettings(const size_t ) {
     aParams.add(myLangMap->params.language);
     aParams.add(myPlugin->params.ToMixImagesVideos);
     aParams.add(myPlugin->params.SlideShowDelay);
+    aParams.add(myPlugin->params.ReadAheadSec);
+    aParams.add(myPlugin->params.ReadAheadMaxMB);
+    aParams.add(myPlugin->params.AudioDecodeAhead);
     aParams.add(myPlugin->params.IsMobileUI);
 #if defined(_WIN32) || defined(__APPLE__) // implemented only on Windows and macOS
     aParams.add(myPlugin->params.IsExclusiveFullScreen);
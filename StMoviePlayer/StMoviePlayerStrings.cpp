@@ -1,5 +1,5 @@
 /**
- * Copyright © 2013-2022 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2013-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -101,6 +101,12 @@ void loadDefaults(StLangMap& theStrings) {
                "Open Movie...");
     theStrings(MENU_MEDIA_SAVE_SNAPSHOT_AS,
                "Save Snapshot As...");
+    theStrings(MENU_MEDIA_EXPORT_FRAMES,
+               "Export frames...");
+    theStrings(MENU_MEDIA_EXPORT_FRAMES_STEP,
+               "Export every N-th frame");
+    theStrings(MENU_MEDIA_EXPORT_FRAMES_SBS,
+               "Pack stereo pair side-by-side");
     theStrings(MENU_MEDIA_SRC_FORMAT,
                "Source stereo format");
     theStrings(MENU_MEDIA_AL_DEVICE,
@@ -127,6 +133,8 @@ void loadDefaults(StLangMap& theStrings) {
                "Quit");
     theStrings(MENU_MEDIA_FILE_INFO,
                "File info");
+    theStrings(MENU_MEDIA_PLAYBACK_SPEED,
+               "Playback speed");
     theStrings(MENU_MEDIA_OPEN_MOVIE_1,
                "From One file");
     theStrings(MENU_MEDIA_OPEN_MOVIE_2,
@@ -181,6 +189,8 @@ void loadDefaults(StLangMap& theStrings) {
                "Saturation");
     theStrings(MENU_VIEW_ADJUST_GAMMA,
                "Gamma");
+    theStrings(MENU_VIEW_ADJUST_COLOR_LUT,
+               "Bake into color LUT");
     theStrings(MENU_VIEW_PANORAMA,
                "Panorama");
     theStrings(MENU_VIEW_SURFACE_PLANE,
@@ -371,6 +381,8 @@ void loadDefaults(StLangMap& theStrings) {
                "Assign new Hot Key for action\n<i>{0}</i>");
     theStrings(DIALOG_CONFLICTS_WITH,
                "Conflicts with: <i>{0}</i>");
+    theStrings(DIALOG_EXPORT_FRAMES,
+               "Choose location and name of exported frames");
 
     theStrings(INFO_LEFT,
                "[left]");
@@ -666,6 +678,12 @@ void loadDefaults(StLangMap& theStrings) {
     addAction(theStrings, StMoviePlayer::Action_ShowGUI,
               "DoShowGUI",
               "Show/hide GUI");
+    addAction(theStrings, StMoviePlayer::Action_PlaybackSlower,
+              "DoPlaybackSlower",
+              "Decrease playback speed");
+    addAction(theStrings, StMoviePlayer::Action_PlaybackFaster,
+              "DoPlaybackFaster",
+              "Increase playback speed");
 
     theStrings.addAlias("DoOutStereoNormal",       MENU_VIEW_DISPLAY_MODE_STEREO);
     theStrings.addAlias("DoOutStereoLeftView",     MENU_VIEW_DISPLAY_MODE_LEFT);
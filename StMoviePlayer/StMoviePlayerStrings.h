@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2022 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -49,6 +49,7 @@ namespace StMoviePlayerStrings {
         MENU_MEDIA_WEBUI        = 1108,
         MENU_MEDIA_QUIT = 1109,
         MENU_MEDIA_FILE_INFO    = 1170,
+        MENU_MEDIA_PLAYBACK_SPEED = 1171,
 
         // Root -> Media menu -> Open File menu
         MENU_MEDIA_OPEN_MOVIE_1 = 1110,
@@ -69,6 +70,11 @@ namespace StMoviePlayerStrings {
         MENU_SRC_FORMAT_TILED_4X = 1141,
         MENU_SRC_FORMAT_SEPARATE = 1142,
 
+        // Root -> Media menu -> Save Snapshot menu
+        MENU_MEDIA_EXPORT_FRAMES      = 1150,
+        MENU_MEDIA_EXPORT_FRAMES_STEP = 1151,
+        MENU_MEDIA_EXPORT_FRAMES_SBS  = 1152,
+
         // Root -> Media menu -> Recent files menu
         MENU_MEDIA_RECENT_CLEAR = 1160,
 
@@ -109,6 +115,7 @@ namespace StMoviePlayerStrings {
         MENU_VIEW_ADJUST_BRIGHTNESS = 1271,
         MENU_VIEW_ADJUST_SATURATION = 1272,
         MENU_VIEW_ADJUST_GAMMA      = 1273,
+        MENU_VIEW_ADJUST_COLOR_LUT  = 1274,
 
         MENU_VIEW_SURFACE_PLANE     = 1280,
         MENU_VIEW_SURFACE_SPHERE    = 1281,
@@ -221,6 +228,7 @@ namespace StMoviePlayerStrings {
 
         DIALOG_ASSIGN_HOT_KEY  = 2013,
         DIALOG_CONFLICTS_WITH  = 2014,
+        DIALOG_EXPORT_FRAMES   = 2015,
 
         // About dialog
         ABOUT_DPLUGIN_NAME     = 3000,
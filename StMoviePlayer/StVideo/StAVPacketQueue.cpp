@@ -64,6 +64,8 @@ StAVPacketQueue::StAVPacketQueue(const size_t theSizeLimit)
   myBack(NULL),
   mySize(0),
   mySizeLimit(theSizeLimit),
+  mySizeBytes(0),
+  mySizeBytesLimit(size_t(-1)),
   mySizeSeconds(0.0),
   myMutex() {
     //
@@ -107,6 +109,16 @@ bool StAVPacketQueue::init(AVFormatContext*   theFormatCtx,
     myPtsStartBase   = detectPtsStartBase(theFormatCtx);
     myPtsStartStream = unitsToSeconds(myStream->start_time);
     myIsAttachedPic  = stAV::isAttachedPicture(myStream);
+
+    // allow twice the nominal bitrate to tolerate peaks of variable bitrate streams
+    const int64_t aBitRate = myStream->codecpar->bit_rate > 0
+                           ? myStream->codecpar->bit_rate
+                           : myFormatCtx->bit_rate;
+    myMutex.lock();
+    mySizeBytesLimit = aBitRate > 0
+                     ? stMax(size_t(double(aBitRate) / 8.0 * 5.0 * 2.0), size_t(4 * 1024 * 1024))
+                     : size_t(-1);
+    myMutex.unlock();
     if(stAV::getCodecType(myStream) != getCodecType()) {
         signals.onError(stCString("Internal error: unsupported codec type"));
         deinit();
@@ -169,6 +181,9 @@ void StAVPacketQueue::deinit() {
     myGetBuffInit = NULL;
     myStreamId    = -1;
     myIsAttachedPic = false;
+    myMutex.lock();
+    mySizeBytesLimit = size_t(-1);
+    myMutex.unlock();
 }
 
 void StAVPacketQueue::fillCodecInfo(const AVCodec*  theCodec,
@@ -210,7 +225,9 @@ StHandle<StAVPacket> StAVPacketQueue::pop() {
         delete anItem;
         --mySize;
         mySizeSeconds -= aPacket->getDurationSeconds();
+        mySizeBytes   -= size_t(aPacket->getSize());
     myMutex.unlock();
+    StMemoryBudget::add(StMemoryBudget::Consumer_Packets, -int64_t(aPacket->getSize()));
     return aPacket;
 }
 
@@ -225,7 +242,9 @@ void StAVPacketQueue::push(const StAVPacket& thePacket) {
         }
         ++mySize;
         mySizeSeconds += thePacket.getDurationSeconds();
+        mySizeBytes   += size_t(thePacket.getSize());
     myMutex.unlock();
+    StMemoryBudget::add(StMemoryBudget::Consumer_Packets, int64_t(thePacket.getSize()));
 }
 
 void StAVPacketQueue::pushStart() {
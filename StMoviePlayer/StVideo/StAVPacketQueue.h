@@ -19,6 +19,7 @@
 #ifndef __StAVPacketQueue_h_
 #define __StAVPacketQueue_h_
 
+#include <StThreads/StMemoryBudget.h>
 #include <StThreads/StMutex.h>
 #include <StTemplates/StHandle.h>
 #include <StSlots/StSignal.h>
@@ -98,8 +99,11 @@ class StAVPacketQueue {
      * Returns true if queue is full.
      */
     ST_LOCAL bool isFull() const {
+        const size_t aBudget = StMemoryBudget::getAvailable(StMemoryBudget::Consumer_Packets);
         myMutex.lock();
-            bool aResult = (mySize >= mySizeLimit) || (mySizeSeconds >= 5.0);
+            // limit the memory only when at least one second has been buffered to avoid starving the decoder
+            bool aResult = (mySize >= mySizeLimit) || (mySizeSeconds >= 5.0)
+                        || (mySizeSeconds >= 1.0 && mySizeBytes >= stMin(mySizeBytesLimit, aBudget));
             //if(mySize >= mySizeLimit) { ST_DEBUG_LOG("stream" + streamId + " sizeSeconds= " + sizeSeconds + "; mySize= " + mySize); }
         myMutex.unlock();
         return aResult;
@@ -280,6 +284,8 @@ class StAVPacketQueue {
     QueueItem*       myBack;           //!< queue back  packet (last  to pop)
     size_t           mySize;           //!< packets number in queue
     size_t           mySizeLimit;      //!< packets limit
+    size_t           mySizeBytes;      //!< cumulative packets size in bytes
+    size_t           mySizeBytesLimit; //!< packets size limit in bytes computed from stream bitrate
     double           mySizeSeconds;    //!< cumulative packets length in seconds
     mutable StMutex  myMutex;          //!< lock for thread-safety
 
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -308,9 +308,18 @@ ALenum StAudioQueue::stalGetSourceState() {
 }
 
 /**
- * Simple thread function which just call decodeLoop().
+ * Simple thread function which just call feedLoop().
  */
 static SV_THREAD_FUNCTION threadFunction(void* audioQueue) {
+    StAudioQueue* stAudioQueue = (StAudioQueue* )audioQueue;
+    stAudioQueue->feedLoop();
+    return SV_THREAD_RETURN 0;
+}
+
+/**
+ * Simple thread function which just call decodeLoop().
+ */
+static SV_THREAD_FUNCTION decodeThreadFunction(void* audioQueue) {
     StAudioQueue* stAudioQueue = (StAudioQueue* )audioQueue;
     stAudioQueue->decodeLoop();
     return SV_THREAD_RETURN 0;
@@ -332,6 +341,19 @@ StAudioQueue::StAudioQueue(const std::string& theAlDeviceName,
   myIsDisconnected(false),
   myToOrientListener(false),
   myToForceBFormat(false),
+  myPcmRingHead(0),
+  myPcmRingTail(0),
+  myPcmRingNb(0),
+  myPcmGeneration(0),
+  myPcmPushedUs(0),
+  myPcmPoppedUs(0),
+  myPcmDepthUs(500000),
+  myPcmReinitEvent(false),
+  myPcmReinitNb(0),
+  myToReinitBuffers(false),
+  myNbUnderruns(0),
+  myAlIsFed(false),
+  myRate(1.0f),
   myAlDeviceName(theAlDeviceName),
   myAlFormat(AL_FORMAT_STEREO16),
   myPrevFormat(AL_FORMAT_STEREO16),
@@ -350,14 +372,17 @@ StAudioQueue::StAudioQueue(const std::string& theAlDeviceName,
   myDbgPrevSrcState(-1) {
     stMemSet(myAlSources, 0, sizeof(myAlSources));
 
-    // launch thread parse incoming packets from queue
-    myThread = new StThread(threadFunction, (void* )this, "StAudioQueue");
+    // launch thread feeding OpenAL and thread parse incoming packets from queue
+    myThread       = new StThread(threadFunction,       (void* )this, "StAudioQueue");
+    myDecodeThread = new StThread(decodeThreadFunction, (void* )this, "StAudioDecoder");
 }
 
 StAudioQueue::~StAudioQueue() {
     myToQuit = true;
     pushQuit();
 
+    myDecodeThread->wait();
+    myDecodeThread.nullify();
     myThread->wait();
     myThread.nullify();
 
@@ -799,6 +824,22 @@ bool StAudioQueue::initBuffers() {
     return true;
 }
 
+void StAudioQueue::getAlInfo(StDictionary& theInfo) {
+    {
+        StMutexAuto aLock(myAlInfoMutex);
+        for(size_t aPairIter = 0; aPairIter < myAlInfo.size(); ++aPairIter) {
+            theInfo.add(myAlInfo.getFromIndex(aPairIter));
+        }
+    }
+    theInfo.add(StDictEntry("Audio decode-ahead", StString() + int(getDecodeAheadFill()) + " / " + int(myPcmDepthUs / 1000) + " ms"));
+    theInfo.add(StDictEntry("Audio underruns",    StString() + getUnderrunsNb()));
+    if(myStretch.getRate() != 1.0) {
+        char aBuff[64];
+        stsprintf(aBuff, sizeof(aBuff), "x%.2f, CPU %.2f%%", myStretch.getRate(), myStretch.getCpuLoad());
+        theInfo.add(StDictEntry("Audio time-stretch", aBuff));
+    }
+}
+
 void StAudioQueue::deinit() {
     myBufferSrc.clear();
     myBufferOut.clear();
@@ -840,9 +881,8 @@ bool StAudioQueue::parseEvents() {
     }
 
     if(toResetBuffers) {
-        myBufferSrc.clear();
-        myBufferOut.clear();
-        initBuffers();
+        // buffers are owned by decoding thread
+        myToReinitBuffers = true;
         return true;
     }
 
@@ -878,8 +918,7 @@ bool StAudioQueue::parseEvents() {
             stalEmpty();
             playTimerStart(aPtsSeek);
             playTimerPause();
-            myBufferSrc.setDataSize(0);
-            myBufferOut.setDataSize(0);
+            myAlIsFed = false;
             // return special flag to skip "resume playback from" in loop
             return true;
         }
@@ -889,7 +928,9 @@ bool StAudioQueue::parseEvents() {
     }
 }
 
-bool StAudioQueue::stalQueue(const double thePts) {
+bool StAudioQueue::stalQueue(const PcmChunk& theChunk) {
+    const StPCMBuffer& aBuffer = theChunk.Buffer;
+    const double       thePts  = theChunk.Pts;
     ALint aQueued = 0;
     ALint aProcessed = 0;
     ALenum aState = stalGetSourceState();
@@ -909,18 +950,28 @@ bool StAudioQueue::stalQueue(const double thePts) {
 
     if((aState == AL_PLAYING
      || aState == AL_PAUSED)
-    && (myPrevFormat    != myAlFormat
-     || myPrevFrequency != myBufferOut.getFreq()))
+    && (myPrevFormat    != theChunk.AlFormat
+     || myPrevFrequency != aBuffer.getFreq()))
     {
         return false; // wait until tail of previous stream played
     }
 
-    if(myPrevFormat    != myAlFormat
-    || myPrevFrequency != myBufferOut.getFreq()
+    if(aState  == AL_STOPPED
+    && aQueued == THE_NUM_AL_BUFFERS
+    && myAlIsFed
+    && myPrevFormat    == theChunk.AlFormat
+    && myPrevFrequency == aBuffer.getFreq()) {
+        // all queued buffers have been played out before the next chunk was ready
+        ++myNbUnderruns;
+        ST_DEBUG_LOG(StString("OpenAL buffers underrun #") + int(myNbUnderruns) + ", decode-ahead fill " + getDecodeAheadFill() + " ms");
+    }
+
+    if(myPrevFormat   != theChunk.AlFormat
+    || myPrevFrequency != aBuffer.getFreq()
     || (aState  == AL_STOPPED
      && aQueued == THE_NUM_AL_BUFFERS)) {
-        ST_DEBUG_LOG("AL, reinitialize buffers per source , plane size= " + myBufferOut.getPlaneSize()
-                            + "; freq= " + myBufferOut.getFreq());
+        ST_DEBUG_LOG("AL, reinitialize buffers per source , plane size= " + aBuffer.getPlaneSize()
+                            + "; freq= " + aBuffer.getFreq());
         stalEmpty();
         stalCheckErrors("reset state");
         aProcessed = 0;
@@ -930,19 +981,19 @@ bool StAudioQueue::stalQueue(const double thePts) {
     bool toTryToPlay = false;
     bool isQueued = false;
     if(aProcessed == 0 && aQueued < THE_NUM_AL_BUFFERS) {
-        if(myBufferOut.isEmpty()) {
+        if(aBuffer.isEmpty()) {
             ST_DEBUG_LOG(" EMPTY BUFFER ");
             return true;
         }
 
         stalCheckErrors("reset state");
         ///ST_DEBUG_LOG("AL, queue more buffers " + aQueued + " / " + NUM_AL_BUFFERS);
-        myPrevFormat    = myAlFormat;
-        myPrevFrequency = myBufferOut.getFreq();
-        for(size_t aSrcId = 0; aSrcId < myBufferOut.getPlanesNb(); ++aSrcId) {
-            alBufferData(myAlBuffers[aSrcId][aQueued], myAlFormat,
-                         myBufferOut.getPlane(aSrcId), (ALsizei )myBufferOut.getPlaneSize(),
-                         myBufferOut.getFreq());
+        myPrevFormat    = theChunk.AlFormat;
+        myPrevFrequency = aBuffer.getFreq();
+        for(size_t aSrcId = 0; aSrcId < aBuffer.getPlanesNb(); ++aSrcId) {
+            alBufferData(myAlBuffers[aSrcId][aQueued], theChunk.AlFormat,
+                         aBuffer.getPlane(aSrcId), (ALsizei )aBuffer.getPlaneSize(),
+                         aBuffer.getFreq());
             stalCheckErrors("alBufferData1");
             alSourceQueueBuffers(myAlSources[aSrcId], 1, &myAlBuffers[aSrcId][aQueued]);
             stalCheckErrors("alSourceQueueBuffers");
@@ -954,14 +1005,14 @@ bool StAudioQueue::stalQueue(const double thePts) {
             || aState == AL_PAUSED)) {
         ALuint alBuffIdToFill = 0;
         ///ST_DEBUG_LOG("queue buffer " + thePts + "; state= " + stalGetSourceState());
-        if(myBufferOut.isEmpty()) {
+        if(aBuffer.isEmpty()) {
             ST_DEBUG_LOG(" EMPTY BUFFER ");
             return true;
         }
 
-        myPrevFormat    = myAlFormat;
-        myPrevFrequency = myBufferOut.getFreq();
-        for(size_t aSrcId = 0; aSrcId < myBufferOut.getPlanesNb(); ++aSrcId) {
+        myPrevFormat    = theChunk.AlFormat;
+        myPrevFrequency = aBuffer.getFreq();
+        for(size_t aSrcId = 0; aSrcId < aBuffer.getPlanesNb(); ++aSrcId) {
 
             // wait other sources for processed buffers
             if(aSrcId != 0) {
@@ -982,9 +1033,9 @@ bool StAudioQueue::stalQueue(const double thePts) {
             alSourceUnqueueBuffers(myAlSources[aSrcId], 1, &alBuffIdToFill);
             stalCheckErrors("alSourceUnqueueBuffers");
             if(alBuffIdToFill != 0) {
-                alBufferData(alBuffIdToFill, myAlFormat,
-                             myBufferOut.getPlane(aSrcId), (ALsizei )myBufferOut.getPlaneSize(),
-                             myBufferOut.getFreq());
+                alBufferData(alBuffIdToFill, theChunk.AlFormat,
+                             aBuffer.getPlane(aSrcId), (ALsizei )aBuffer.getPlaneSize(),
+                             aBuffer.getFreq());
                 stalCheckErrors("alBufferData2");
                 alSourceQueueBuffers(myAlSources[aSrcId], 1, &alBuffIdToFill);
                 stalCheckErrors("alSourceQueueBuffers");
@@ -998,7 +1049,7 @@ bool StAudioQueue::stalQueue(const double thePts) {
 
     if(aState == AL_STOPPED
     && toTryToPlay) {
-        double diffSecs = double(myAlDataLoop.summ() + myBufferOut.getDataSizeWhole()) / double(myBufferOut.getSecondSize());
+        double diffSecs = double(myAlDataLoop.summ() + aBuffer.getDataSizeWhole()) / double(aBuffer.getSecondSize()) * theChunk.Rate;
         if((thePts - diffSecs) < 100000.0) {
             playTimerStart(thePts - diffSecs);
         } else {
@@ -1034,27 +1085,31 @@ bool StAudioQueue::stalCheckConnected() {
     return false;
 }
 
-void StAudioQueue::stalFillBuffers(const double thePts,
-                                   const bool   toIgnoreEvents) {
+void StAudioQueue::stalFillBuffers(const PcmChunk& theChunk,
+                                   const bool      toIgnoreEvents) {
+    const StPCMBuffer& aBuffer = theChunk.Buffer;
+    const double       thePts  = theChunk.Pts;
     if(!toIgnoreEvents) {
         parseEvents();
     }
 
     bool toSkipPlaybackFrom = false;
-    while(!stalQueue(thePts)) {
-        // AL queue is full
+    while(!stalQueue(theChunk)) {
+        // AL queue is full - decoding thread might wait for buffers re-initialization meanwhile
+        feedReinitBuffers();
         if(!toIgnoreEvents) {
             toSkipPlaybackFrom = parseEvents();
         }
-        if(myToQuit) {
-            return;
+        if(myToQuit
+        || theChunk.Generation != myPcmGeneration) {
+            return; // the chunk became obsolete
         }
 
         if(!toSkipPlaybackFrom && !stalIsAudioPlaying() && isPlaying()) {
             // this position means:
             // 1) buffers were empty and playback was stopped
             //    now we have all buffers full and could play them
-            double diffSecs = double(myAlDataLoop.summ() + myBufferOut.getDataSizeWhole()) / double(myBufferOut.getSecondSize());
+            double diffSecs = double(myAlDataLoop.summ() + aBuffer.getDataSizeWhole()) / double(aBuffer.getSecondSize()) * theChunk.Rate;
             if((thePts - diffSecs) < 100000.0) {
                 playTimerStart(thePts - diffSecs);
             } else {
@@ -1069,8 +1124,9 @@ void StAudioQueue::stalFillBuffers(const double thePts,
             // on files with broken audio/video PTS
             ALfloat aPos = 0.0f;
             alGetSourcef(myAlSources[0], AL_SEC_OFFSET, &aPos);
-            double diffSecs = double(myAlDataLoop.summ() + myBufferOut.getDataSizeWhole()) / double(myBufferOut.getSecondSize());
+            double diffSecs = double(myAlDataLoop.summ() + aBuffer.getDataSizeWhole()) / double(aBuffer.getSecondSize());
             diffSecs -= aPos;
+            diffSecs *= theChunk.Rate; // queued data duration in media time
             if((thePts - diffSecs) < 100000.0) {
                  static double oldPts = 0.0;
                  if(thePts != oldPts) {
@@ -1120,9 +1176,7 @@ void StAudioQueue::decodePacket(const StHandle<StAVPacket>& thePacket,
                 ST_DEBUG_LOG("Parameters of the Audio stream has been changed,"
                            + " Nb. channels: " + stAV::audio::getNbChannels(myCodecCtx)    + " (was " + myAvNbChannels + ")"
                            + " Sample Rate: "  + myCodecCtx->sample_rate + " (was " + myAvSampleRate + ")");
-                myBufferSrc.clear();
-                myBufferOut.clear();
-                initBuffers();
+                decodeReinitBuffers();
                 checkMoreFrames = true;
                 break;
             }
@@ -1160,14 +1214,8 @@ void StAudioQueue::decodePacket(const StHandle<StAVPacket>& thePacket,
                     thePts = aNewPts;
                 }
 
-                // now fill OpenAL buffers
-                stalFillBuffers(thePts, false);
-                if(myToQuit) {
-                    return;
-                }
-
-                // save the history for filled AL buffers sizes
-                myAlDataLoop.push(myBufferOut.getDataSizeWhole());
+                // pass the chunk to playback thread
+                pcmRingPushData(thePts, PcmChunk_Data);
             }
 
             myBufferOut.setDataSize(0);                         // clear 'big' buffer
@@ -1185,16 +1233,97 @@ void StAudioQueue::decodePacket(const StHandle<StAVPacket>& thePacket,
     }
 }
 
-void StAudioQueue::decodeLoop() {
-    myIsAlValid = (stalInit() ? ST_AL_INIT_OK : ST_AL_INIT_KO);
+StAudioQueue::PcmChunk& StAudioQueue::pcmRingAcquire(const bool theToLimit) {
+    for(;;) {
+        const int32_t aNbChunks = StAtomicOp::Load(myPcmRingNb);
+        if(aNbChunks == 0
+        || (aNbChunks < THE_NUM_PCM_CHUNKS
+         && (!theToLimit || uint32_t(myPcmPushedUs - myPcmPoppedUs) < myPcmDepthUs))) {
+            return myPcmRing[myPcmRingHead];
+        }
+        StThread::sleep(5);
+    }
+}
+
+void StAudioQueue::pcmRingPush(const uint32_t theDurationUs) {
+    PcmChunk& aChunk = myPcmRing[myPcmRingHead];
+    aChunk.DurationUs = theDurationUs;
+    aChunk.Generation = myPcmGeneration;
+    myPcmPushedUs += theDurationUs;
+    myPcmRingHead = (myPcmRingHead + 1) % THE_NUM_PCM_CHUNKS;
+    StAtomicOp::Increment(myPcmRingNb); // publish the chunk
+}
+
+void StAudioQueue::pcmRingPushMarker(const int    theType,
+                                     const double thePts) {
+    PcmChunk& aChunk = pcmRingAcquire(false);
+    aChunk.Buffer.setDataSize(0);
+    aChunk.Type = theType;
+    aChunk.Pts  = thePts;
+    pcmRingPush(0);
+}
 
+void StAudioQueue::pcmRingPushData(const double thePts,
+                                   const int    theType) {
+    myStretch.setRate(myRate);
+    PcmChunk& aChunk = pcmRingAcquire(theType == PcmChunk_Data);
+    if(myStretch.isBypass()) {
+        aChunk.Buffer.copyFrom(myBufferOut);
+        aChunk.Pts = thePts;
+    } else {
+        // stretched data lags behind decoded one
+        myStretch.process(myBufferOut, aChunk.Buffer);
+        if(aChunk.Buffer.isEmpty()
+        && theType == PcmChunk_Data) {
+            return; // not enough data accumulated
+        }
+        aChunk.Pts = thePts - myStretch.getLatency();
+    }
+    aChunk.Type     = theType;
+    aChunk.AlFormat = myAlFormat;
+    aChunk.Rate     = myStretch.getRate();
+    pcmRingPush(!aChunk.Buffer.isEmpty()
+              ? uint32_t(double(aChunk.Buffer.getDataSizeWhole()) * 1000000.0 / double(aChunk.Buffer.getSecondSize()))
+              : 0);
+}
+
+void StAudioQueue::pcmRingPop() {
+    myPcmPoppedUs += myPcmRing[myPcmRingTail].DurationUs;
+    myPcmRingTail = (myPcmRingTail + 1) % THE_NUM_PCM_CHUNKS;
+    StAtomicOp::Decrement(myPcmRingNb); // release the chunk
+}
+
+void StAudioQueue::decodeReinitBuffers() {
+    myBufferSrc.clear();
+    myBufferOut.clear();
+    myStretch.reset();
+
+    // OpenAL sources are re-configured within playback thread;
+    // the request is not queued into the ring to be handled even when AL queue is full (e.g. on pause)
+    myPcmReinitEvent.reset();
+    StAtomicOp::Increment(myPcmReinitNb);
+    while(!myPcmReinitEvent.wait(10)) {
+        if(myToQuit) {
+            break;
+        }
+    }
+    myToReinitBuffers = false;
+}
+
+void StAudioQueue::decodeLoop() {
     double aPts = 0.0;
     StHandle<StAVPacket> aPacket;
     for(;;) {
+        if(myToReinitBuffers
+        && isInitialized()) {
+            decodeReinitBuffers();
+        }
+
         // wait for upcoming packets
         if(isEmpty()) {
-            myDowntimeEvent.set();
-            parseEvents();
+            if(StAtomicOp::Load(myPcmRingNb) == 0) {
+                myDowntimeEvent.set();
+            }
             StThread::sleep(10);
             ///ST_DEBUG_LOG_AT("AQ is empty");
             continue;
@@ -1214,11 +1343,14 @@ void StAudioQueue::decodeLoop() {
                 // at this moment we clear current data from our buffers too
                 myBufferOut.setDataSize(0);
                 myBufferSrc.setDataSize(0);
-                stalEmpty();
+                myStretch.reset();
+                // chunks decoded before flush should not be played
+                StAtomicOp::Increment(myPcmGeneration);
+                pcmRingPushMarker(PcmChunk_Flush);
                 continue;
             }
             case StAVPacket::START_PACKET: {
-                playTimerStart(myPtsStartStream - myPtsStartBase);
+                pcmRingPushMarker(PcmChunk_Start, myPtsStartStream - myPtsStartBase);
                 aPts = 0.0;
                 continue;
             }
@@ -1229,21 +1361,19 @@ void StAudioQueue::decodeLoop() {
                 break; // redirect NULL packet to avcodec_send_packet()
             }
             case StAVPacket::END_PACKET: {
-                pushPlayEvent(ST_PLAYEVENT_NONE);
-                // TODO (Kirill Gavrilov#3#) improve file-by-file playback
-                if(!myBufferOut.isEmpty()) {
-                    stalFillBuffers(aPts, true);
-                }
+                // remaining data is passed along with the end marker
+                pcmRingPushData(aPts, PcmChunk_End);
                 myBufferOut.setDataSize(0);
                 myBufferSrc.setDataSize(0);
+                myStretch.reset();
                 if(myToQuit) {
-                    stalDeinit(); // release OpenAL context
+                    pcmRingPushMarker(PcmChunk_Quit);
                     return;
                 }
                 continue;
             }
             case StAVPacket::QUIT_PACKET: {
-                stalDeinit(); // release OpenAL context
+                pcmRingPushMarker(PcmChunk_Quit);
                 return;
             }
         }
@@ -1254,6 +1384,83 @@ void StAudioQueue::decodeLoop() {
     }
 }
 
+bool StAudioQueue::feedChunk(const PcmChunk& theChunk) {
+    switch(theChunk.Type) {
+        case PcmChunk_Data: {
+            if(theChunk.Generation != myPcmGeneration) {
+                return true; // obsolete data, decoded before flush
+            }
+
+            // playback clock follows the rate of queued data
+            playTimerSetSpeed(theChunk.Rate);
+
+            // now fill OpenAL buffers
+            stalFillBuffers(theChunk, false);
+            myAlIsFed = true;
+
+            // save the history for filled AL buffers sizes
+            myAlDataLoop.push(theChunk.Buffer.getDataSizeWhole());
+            return true;
+        }
+        case PcmChunk_End: {
+            pushPlayEvent(ST_PLAYEVENT_NONE);
+            // TODO (Kirill Gavrilov#3#) improve file-by-file playback
+            if(!theChunk.Buffer.isEmpty()
+            &&  theChunk.Generation == myPcmGeneration) {
+                playTimerSetSpeed(theChunk.Rate);
+                stalFillBuffers(theChunk, true);
+            }
+            myAlIsFed = false;
+            return true;
+        }
+        case PcmChunk_Flush: {
+            stalEmpty();
+            myAlIsFed = false;
+            return true;
+        }
+        case PcmChunk_Start: {
+            playTimerStart(theChunk.Pts);
+            return true;
+        }
+        case PcmChunk_Quit: {
+            stalDeinit(); // release OpenAL context
+            return false;
+        }
+    }
+    return true;
+}
+
+void StAudioQueue::feedReinitBuffers() {
+    if(StAtomicOp::Load(myPcmReinitNb) == 0) {
+        return;
+    }
+
+    initBuffers();
+    StAtomicOp::Decrement(myPcmReinitNb);
+    myPcmReinitEvent.set();
+}
+
+void StAudioQueue::feedLoop() {
+    myIsAlValid = (stalInit() ? ST_AL_INIT_OK : ST_AL_INIT_KO);
+
+    for(;;) {
+        feedReinitBuffers();
+
+        // wait for decoded data
+        if(StAtomicOp::Load(myPcmRingNb) == 0) {
+            parseEvents();
+            StThread::sleep(5);
+            continue;
+        }
+
+        const bool toContinue = feedChunk(myPcmRing[myPcmRingTail]);
+        pcmRingPop();
+        if(!toContinue) {
+            return;
+        }
+    }
+}
+
 void StAudioQueue::pushPlayEvent(const StPlayEvent_t theEventId,
                                  const double        theSeekParam) {
     myEventMutex.lock();
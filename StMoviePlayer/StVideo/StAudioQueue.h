@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -21,6 +21,7 @@
 
 #include <StStrings/StString.h>
 #include <StSettings/StFloat32Param.h>
+#include <StThreads/StAtomicOp.h>
 #include <StThreads/StCondition.h>
 #include <StThreads/StTimer.h>
 
@@ -28,6 +29,7 @@
 
 #include "StAVPacketQueue.h"// StAVPacketQueue class
 #include "StPCMBuffer.h"    // audio PCM buffer class
+#include "StPCMStretch.h"   // audio time-stretching
 #include "StALContext.h"
 
 // forward declarations
@@ -41,6 +43,10 @@ ST_DEFINE_HANDLE(StAudioQueue, StAVPacketQueue);
  * This is Audio playback class (OpenAL is used)
  * which feed with packets (StAVPacket),
  * so it also implements StAVPacketQueue.
+ *
+ * Packets are decoded by dedicated thread into the ring of PCM chunks,
+ * so that slow decoding does not delay refilling of OpenAL buffers;
+ * another thread owns OpenAL context and only moves ready PCM data into OpenAL.
  */
 class StAudioQueue : public StAVPacketQueue {
 
@@ -97,12 +103,17 @@ class StAudioQueue : public StAVPacketQueue {
     ST_LOCAL virtual void deinit() ST_ATTR_OVERRIDE;
 
     /**
-     * Main decoding and playback loop.
-     * Give packets from queue, decode them and fill OpenAL buffers
-     * for playback.
+     * Main decoding loop.
+     * Give packets from queue, decode them and put PCM chunks into the ring.
      */
     ST_LOCAL void decodeLoop();
 
+    /**
+     * Main playback loop.
+     * Give PCM chunks from the ring and fill OpenAL buffers for playback.
+     */
+    ST_LOCAL void feedLoop();
+
     /**
      * @return true if audio is played.
      */
@@ -196,11 +207,35 @@ class StAudioQueue : public StAVPacketQueue {
     /**
      * Return OpenAL info.
      */
-    ST_LOCAL void getAlInfo(StDictionary& theInfo) {
-        StMutexAuto aLock(myAlInfoMutex);
-        for(size_t aPairIter = 0; aPairIter < myAlInfo.size(); ++aPairIter) {
-            theInfo.add(myAlInfo.getFromIndex(aPairIter));
-        }
+    ST_LOCAL void getAlInfo(StDictionary& theInfo);
+
+    /**
+     * Set duration of decoded audio to be kept in the ring in advance.
+     * @param theMilliseconds decode-ahead depth; at least one chunk is decoded in advance
+     */
+    ST_LOCAL void setDecodeAhead(const float theMilliseconds) {
+        myPcmDepthUs = uint32_t(stMax(theMilliseconds, 0.0f) * 1000.0f);
+    }
+
+    /**
+     * Return duration of decoded audio currently waiting in the ring, in milliseconds.
+     */
+    ST_LOCAL double getDecodeAheadFill() const {
+        return double(uint32_t(myPcmPushedUs - myPcmPoppedUs)) * 0.001;
+    }
+
+    /**
+     * Return the number of OpenAL buffer underruns (playback stopped due to lack of decoded data).
+     */
+    ST_LOCAL int getUnderrunsNb() const { return myNbUnderruns; }
+
+    /**
+     * Set playback rate; audio is time-stretched with pitch preserved.
+     * Applied to newly decoded data, so that queue should be flushed to apply the rate immediately.
+     * @param theRate playback rate, 1.0 for normal speed
+     */
+    ST_LOCAL void setPlaybackRate(const float theRate) {
+        myRate = theRate;
     }
 
         private: //! @name private methods
@@ -221,14 +256,19 @@ class StAudioQueue : public StAVPacketQueue {
     ST_LOCAL void stalConfigureSources5_1();
     ST_LOCAL void stalConfigureSources7_1();
 
-    ST_LOCAL bool stalQueue(const double thePts);
+    /**
+     * Chunk of PCM data or control marker passed from decoding thread to playback thread.
+     */
+    struct PcmChunk;
+
+    ST_LOCAL bool stalQueue(const PcmChunk& theChunk);
 
     /**
      * This function do fill OpenAL buffers.
-     * @param thePts PTS for last decoded frame
+     * @param theChunk PCM data with PTS for last decoded frame
      */
-    ST_LOCAL void stalFillBuffers(const double thePts,
-                                  const bool   toIgnoreEvents);
+    ST_LOCAL void stalFillBuffers(const PcmChunk& theChunk,
+                                  const bool      toIgnoreEvents);
 
     ST_LOCAL void stalEmpty();
 
@@ -239,6 +279,51 @@ class StAudioQueue : public StAVPacketQueue {
     ST_LOCAL void decodePacket(const StHandle<StAVPacket>& thePacket,
                                double& thePts);
 
+    /**
+     * Wait for a free chunk in the ring (called by decoding thread).
+     * @param theToLimit when TRUE, also waits while the ring already holds decode-ahead depth
+     */
+    ST_LOCAL PcmChunk& pcmRingAcquire(const bool theToLimit);
+
+    /**
+     * Pass acquired chunk to the playback thread.
+     */
+    ST_LOCAL void pcmRingPush(const uint32_t theDurationUs);
+
+    /**
+     * Push control marker into the ring.
+     */
+    ST_LOCAL void pcmRingPushMarker(const int    theType,
+                                    const double thePts = 0.0);
+
+    /**
+     * Release the first chunk in the ring (called by playback thread).
+     */
+    ST_LOCAL void pcmRingPop();
+
+    /**
+     * Put current output buffer into the ring.
+     */
+    ST_LOCAL void pcmRingPushData(const double thePts,
+                                  const int    theType);
+
+    /**
+     * Re-initialize buffers for new stream parameters (called by decoding thread).
+     * OpenAL sources are configured by playback thread, so that this call waits for its completion.
+     */
+    ST_LOCAL void decodeReinitBuffers();
+
+    /**
+     * Process chunk in the ring by playback thread.
+     * @return false if playback thread should be stopped
+     */
+    ST_LOCAL bool feedChunk(const PcmChunk& theChunk);
+
+    /**
+     * Re-initialize buffers on pending request from decoding thread (called by playback thread).
+     */
+    ST_LOCAL void feedReinitBuffers();
+
         private:
 
     //! Setup output format for mono source.
@@ -292,6 +377,15 @@ class StAudioQueue : public StAVPacketQueue {
         myEventMutex.unlock();
     }
 
+    ST_LOCAL void playTimerSetSpeed(const double theSpeed) {
+        if(myPlaybackTimer.getSpeed() == theSpeed) {
+            return;
+        }
+        myEventMutex.lock();
+            myPlaybackTimer.setSpeed(theSpeed);
+        myEventMutex.unlock();
+    }
+
     ST_LOCAL void playTimerPause() {
         myEventMutex.lock();
             myPlaybackTimer.pause();
@@ -353,13 +447,46 @@ class StAudioQueue : public StAVPacketQueue {
 
     } myAlDataLoop;
 
+    // This constant sets maximum count of PCM chunks decoded in advance
+    #define THE_NUM_PCM_CHUNKS 16
+
+    enum {
+        PcmChunk_Data,   //!< PCM data
+        PcmChunk_End,    //!< end of stream with remaining PCM data
+        PcmChunk_Flush,  //!< decoder has been flushed (seek)
+        PcmChunk_Start,  //!< start of new stream
+        PcmChunk_Quit,   //!< decoding thread has been stopped
+    };
+
+    struct PcmChunk {
+
+        StPCMBuffer Buffer;     //!< PCM data in output format
+        double      Pts;        //!< PTS for last decoded frame
+        uint32_t    DurationUs; //!< duration of PCM data in microseconds
+        ALenum      AlFormat;   //!< OpenAL format of PCM data
+        int32_t     Generation; //!< flush generation of PCM data
+        double      Rate;       //!< playback rate of PCM data
+        int         Type;       //!< chunk type
+
+        ST_LOCAL PcmChunk()
+        : Buffer(StPcmFormat_Int16),
+          Pts(0.0),
+          DurationUs(0),
+          AlFormat(AL_FORMAT_STEREO16),
+          Generation(0),
+          Rate(1.0),
+          Type(PcmChunk_Data) {}
+
+    };
+
     typedef enum {
         ST_AL_INIT_NA,
         ST_AL_INIT_OK,
         ST_AL_INIT_KO,
     } IState_t;
 
-    StHandle<StThread> myThread;        //!< decoding loop thread
+    StHandle<StThread> myThread;        //!< playback loop thread (owns OpenAL context)
+    StHandle<StThread> myDecodeThread;  //!< decoding loop thread
     mutable StTimer    myPlaybackTimer; //!< timer used for current PTS calculation
     StCondition        myDowntimeEvent;
     StAVFrame          myFrame;         //!< decoded audio frame
@@ -377,6 +504,24 @@ class StAudioQueue : public StAVPacketQueue {
     volatile bool      myToForceBFormat;//!< force using B-Format for any 4-channels input
     StGLQuaternion     myHeadOrient;    //!< head orientation
 
+        private: //! @name PCM ring (single producer - decoding thread, single consumer - playback thread)
+
+    PcmChunk           myPcmRing[THE_NUM_PCM_CHUNKS]; //!< ring of decoded PCM chunks
+    size_t             myPcmRingHead;   //!< index of the next chunk to fill, modified only by decoding thread
+    size_t             myPcmRingTail;   //!< index of the next chunk to play,  modified only by playback thread
+    volatile int32_t   myPcmRingNb;     //!< number of chunks in the ring, modified atomically
+    volatile int32_t   myPcmGeneration; //!< flush generation, incremented by decoding thread on flush
+    volatile uint32_t  myPcmPushedUs;   //!< overall duration of pushed   chunks in microseconds (wraps around)
+    volatile uint32_t  myPcmPoppedUs;   //!< overall duration of consumed chunks in microseconds (wraps around)
+    volatile uint32_t  myPcmDepthUs;    //!< decode-ahead depth in microseconds
+    StCondition        myPcmReinitEvent;//!< event signaling that playback thread has re-initialized buffers
+    volatile int32_t   myPcmReinitNb;   //!< pending buffers re-initialization request, modified atomically
+    volatile bool      myToReinitBuffers; //!< flag requesting decoding thread to re-initialize buffers
+    volatile int       myNbUnderruns;   //!< number of OpenAL buffer underruns
+    bool               myAlIsFed;       //!< flag indicating that OpenAL sources have been fed with data since last reset
+    StPCMStretch       myStretch;       //!< time-stretching filter, used by decoding thread
+    volatile float     myRate;          //!< requested playback rate
+
         private: //! @name OpenAL items
 
     std::string        myAlDeviceName;  //!< Output audio device name for OpenAL context initialization
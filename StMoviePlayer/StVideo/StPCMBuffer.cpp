@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2014 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -191,6 +191,27 @@ void StPCMBuffer::resize(const size_t theSizeMin,
     setupChannels(myChMap, myPlanesNb);
 }
 
+void StPCMBuffer::copyFrom(const StPCMBuffer& theCopy) {
+    setFormat(theCopy.myPCMFormat);
+    myPCMFreq  = theCopy.myPCMFreq;
+    myChMap    = theCopy.myChMap;
+    myPlanesNb = theCopy.myPlanesNb;
+    resize(theCopy.getDataSizeWhole(), false);
+    setupChannels(theCopy.myChMap, theCopy.myPlanesNb);
+    for(size_t aPlaneIter = 0; aPlaneIter < myPlanesNb; ++aPlaneIter) {
+        stMemCpy(myPlanes[aPlaneIter], theCopy.myPlanes[aPlaneIter], theCopy.myPlaneSize);
+    }
+    myPlaneSize = theCopy.myPlaneSize;
+}
+
+void StPCMBuffer::setupFrom(const StPCMBuffer& theOther,
+                            const StPcmFormat  theFormat,
+                            const size_t       thePlanesNb) {
+    setFormat(theFormat);
+    myPCMFreq = theOther.myPCMFreq;
+    setupChannels(theOther.myChMap, thePlanesNb);
+}
+
 bool StPCMBuffer::setDataSize(const size_t theDataSize) {
     const size_t aPlaneSize    = theDataSize / myPlanesNb;
     const size_t aPlaneSizeMax = mySizeBytes / myPlanesNb;
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2014 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -283,6 +283,22 @@ class StPCMBuffer {
      */
     ST_LOCAL bool addData(const StPCMBuffer& theBuffer);
 
+    /**
+     * Copy data and configuration (format, frequency, channels) from another buffer.
+     * Allocated memory is reused when it is big enough.
+     */
+    ST_LOCAL void copyFrom(const StPCMBuffer& theCopy);
+
+    /**
+     * Setup configuration (frequency, channels) from another buffer with specified format; data size is set to zero.
+     * @param theOther    buffer to copy configuration from
+     * @param theFormat   sample format
+     * @param thePlanesNb planes number (1 for interleaved data, channels number for planar data)
+     */
+    ST_LOCAL void setupFrom(const StPCMBuffer& theOther,
+                            const StPcmFormat  theFormat,
+                            const size_t       thePlanesNb);
+
     /**
      * This parameter measures how many samples/channel are played each second.
      * Frequency is measured in samples/second (Hz).
@@ -303,6 +319,13 @@ class StPCMBuffer {
 
     ST_LOCAL void setFormat(const StPcmFormat thePCMFormat);
 
+    /**
+     * @return channels number
+     */
+    ST_LOCAL size_t getChannelsNb() const {
+        return myChMap.count;
+    }
+
     /**
      * @return planes number (1 for interleaved data)
      */
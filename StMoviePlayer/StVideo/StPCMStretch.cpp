@@ -0,0 +1,318 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StPCMStretch.h"
+
+#include <StThreads/StTimer.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define ST_STRETCH_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define ST_STRETCH_NEON
+#endif
+
+namespace {
+
+    static const double ST_STRETCH_FRAME_SEC = 0.030; //!< frame length
+    static const double ST_STRETCH_SEEK_SEC  = 0.010; //!< frame position tolerance
+
+    /**
+     * Compute dot product of two arrays.
+     */
+    inline float stDotProduct(const float* theA,
+                              const float* theB,
+                              const size_t theNb) {
+        size_t anIter = 0;
+        float  aSum   = 0.0f;
+    #if defined(ST_STRETCH_SSE)
+        __m128 aSum4 = _mm_setzero_ps();
+        for(; anIter + 4 <= theNb; anIter += 4) {
+            aSum4 = _mm_add_ps(aSum4, _mm_mul_ps(_mm_loadu_ps(theA + anIter), _mm_loadu_ps(theB + anIter)));
+        }
+        float aSums[4];
+        _mm_storeu_ps(aSums, aSum4);
+        aSum = (aSums[0] + aSums[1]) + (aSums[2] + aSums[3]);
+    #elif defined(ST_STRETCH_NEON)
+        float32x4_t aSum4 = vdupq_n_f32(0.0f);
+        for(; anIter + 4 <= theNb; anIter += 4) {
+            aSum4 = vmlaq_f32(aSum4, vld1q_f32(theA + anIter), vld1q_f32(theB + anIter));
+        }
+        aSum = (vgetq_lane_f32(aSum4, 0) + vgetq_lane_f32(aSum4, 1))
+             + (vgetq_lane_f32(aSum4, 2) + vgetq_lane_f32(aSum4, 3));
+    #endif
+        for(; anIter < theNb; ++anIter) {
+            aSum += theA[anIter] * theB[anIter];
+        }
+        return aSum;
+    }
+
+    /**
+     * Compute theOut[i] = theAdd[i] + theA[i] * theB[i].
+     */
+    inline void stMulAdd(float*       theOut,
+                         const float* theAdd,
+                         const float* theA,
+                         const float* theB,
+                         const size_t theNb) {
+        size_t anIter = 0;
+    #if defined(ST_STRETCH_SSE)
+        for(; anIter + 4 <= theNb; anIter += 4) {
+            _mm_storeu_ps(theOut + anIter, _mm_add_ps(_mm_loadu_ps(theAdd + anIter),
+                                                      _mm_mul_ps(_mm_loadu_ps(theA + anIter), _mm_loadu_ps(theB + anIter))));
+        }
+    #elif defined(ST_STRETCH_NEON)
+        for(; anIter + 4 <= theNb; anIter += 4) {
+            vst1q_f32(theOut + anIter, vmlaq_f32(vld1q_f32(theAdd + anIter), vld1q_f32(theA + anIter), vld1q_f32(theB + anIter)));
+        }
+    #endif
+        for(; anIter < theNb; ++anIter) {
+            theOut[anIter] = theAdd[anIter] + theA[anIter] * theB[anIter];
+        }
+    }
+
+    /**
+     * Compute theOut[i] = theA[i] * theB[i].
+     */
+    inline void stMul(float*       theOut,
+                      const float* theA,
+                      const float* theB,
+                      const size_t theNb) {
+        size_t anIter = 0;
+    #if defined(ST_STRETCH_SSE)
+        for(; anIter + 4 <= theNb; anIter += 4) {
+            _mm_storeu_ps(theOut + anIter, _mm_mul_ps(_mm_loadu_ps(theA + anIter), _mm_loadu_ps(theB + anIter)));
+        }
+    #elif defined(ST_STRETCH_NEON)
+        for(; anIter + 4 <= theNb; anIter += 4) {
+            vst1q_f32(theOut + anIter, vmulq_f32(vld1q_f32(theA + anIter), vld1q_f32(theB + anIter)));
+        }
+    #endif
+        for(; anIter < theNb; ++anIter) {
+            theOut[anIter] = theA[anIter] * theB[anIter];
+        }
+    }
+
+}
+
+StPCMStretch::StPCMStretch()
+: myFloatIn(StPcmFormat_Float32),
+  myFloatOut(StPcmFormat_Float32),
+  myRate(1.0),
+  myAnaPos(0.0),
+  myPrevPos(0),
+  myInNb(0),
+  myHasPrev(false),
+  myFreq(0),
+  myChannelsNb(0),
+  myFrameLen(0),
+  myHopLen(0),
+  mySeekLen(0),
+  myCpuTimeUs(0.0),
+  myOutTimeUs(0.0) {
+    //
+}
+
+StPCMStretch::~StPCMStretch() {
+    //
+}
+
+void StPCMStretch::setRate(const double theRate) {
+    const double aRate = stMin(stMax(theRate, 0.25), 8.0);
+    if(myRate == aRate) {
+        return;
+    }
+
+    myRate      = aRate;
+    myCpuTimeUs = 0.0;
+    myOutTimeUs = 0.0;
+    reset();
+}
+
+void StPCMStretch::reset() {
+    for(size_t aChIter = 0; aChIter < ST_AUDIO_CHANNELS_MAX; ++aChIter) {
+        myIn[aChIter].clear();
+        std::fill(myOverlap[aChIter].begin(), myOverlap[aChIter].end(), 0.0f);
+    }
+    myMix.clear();
+    myAnaPos  = 0.0;
+    myPrevPos = 0;
+    myInNb    = 0;
+    myHasPrev = false;
+}
+
+void StPCMStretch::init(const int    theFreq,
+                        const size_t theChannelsNb) {
+    myFreq       = theFreq;
+    myChannelsNb = theChannelsNb;
+    myFrameLen   = stMax(size_t(double(theFreq) * ST_STRETCH_FRAME_SEC), size_t(64)) & ~size_t(1);
+    myHopLen     = myFrameLen / 2;
+    mySeekLen    = size_t(double(theFreq) * ST_STRETCH_SEEK_SEC);
+
+    // periodic Hann window, so that overlapped halves sum to 1
+    myWindow.resize(myFrameLen);
+    for(size_t anIter = 0; anIter < myFrameLen; ++anIter) {
+        myWindow[anIter] = float(0.5 - 0.5 * std::cos(2.0 * M_PI * double(anIter) / double(myFrameLen)));
+    }
+    for(size_t aChIter = 0; aChIter < ST_AUDIO_CHANNELS_MAX; ++aChIter) {
+        myOverlap[aChIter].assign(aChIter < myChannelsNb ? myHopLen : 0, 0.0f);
+    }
+    reset();
+}
+
+size_t StPCMStretch::findBestFrame(const size_t theNominal) const {
+    // natural continuation of the last frame
+    const float* aRef  = &myMix[myPrevPos + myHopLen];
+    const size_t aFrom = theNominal > mySeekLen ? (theNominal - mySeekLen) : 0;
+    const size_t aTo   = theNominal + mySeekLen;
+
+    double anEnergy = 0.0;
+    for(size_t anIter = 0; anIter < myHopLen; ++anIter) {
+        anEnergy += double(myMix[aFrom + anIter]) * double(myMix[aFrom + anIter]);
+    }
+
+    size_t aBestPos   = theNominal;
+    double aBestScore = -1.0e30;
+    for(size_t aPos = aFrom; aPos <= aTo; ++aPos) {
+        // normalized cross-correlation (reference energy is constant)
+        const double aCorr  = double(stDotProduct(aRef, &myMix[aPos], myHopLen));
+        const double aScore = aCorr / std::sqrt(stMax(anEnergy, 0.0) + 1.0e-9);
+        if(aScore > aBestScore) {
+            aBestScore = aScore;
+            aBestPos   = aPos;
+        }
+
+        // slide the energy window
+        const double aHead = myMix[aPos];
+        const double aTail = myMix[aPos + myHopLen];
+        anEnergy += aTail * aTail - aHead * aHead;
+    }
+    return aBestPos;
+}
+
+void StPCMStretch::trimInput() {
+    const size_t aNominal = size_t(myAnaPos);
+    size_t aDrop = aNominal > mySeekLen ? (aNominal - mySeekLen) : 0;
+    if(myHasPrev) {
+        aDrop = stMin(aDrop, myPrevPos);
+    }
+    if(aDrop == 0) {
+        return;
+    }
+
+    for(size_t aChIter = 0; aChIter < myChannelsNb; ++aChIter) {
+        myIn[aChIter].erase(myIn[aChIter].begin(), myIn[aChIter].begin() + aDrop);
+    }
+    myMix.erase(myMix.begin(), myMix.begin() + aDrop);
+    myInNb    -= aDrop;
+    myAnaPos  -= double(aDrop);
+    myPrevPos -= myHasPrev ? aDrop : 0;
+}
+
+bool StPCMStretch::process(const StPCMBuffer& theSrc,
+                           StPCMBuffer&       theOut) {
+    theOut.setupFrom(theSrc, theSrc.getFormat(), theSrc.getPlanesNb());
+    if(theSrc.isEmpty()) {
+        return true;
+    }
+
+    StTimer aTimer(true);
+    const size_t aNbCh = theSrc.getChannelsNb();
+    if(aNbCh == 0 || aNbCh > ST_AUDIO_CHANNELS_MAX) {
+        return false;
+    } else if(myFreq       != theSrc.getFreq()
+           || myChannelsNb != aNbCh) {
+        init(theSrc.getFreq(), aNbCh);
+    }
+
+    // convert input into planar float
+    const size_t aSrcSampleSize = theSrc.getSecondSize() / size_t(theSrc.getFreq()) / aNbCh;
+    const size_t aNbSrcSamples  = theSrc.getDataSizeWhole() / (aSrcSampleSize * aNbCh);
+    myFloatIn.setupFrom(theSrc, StPcmFormat_Float32, aNbCh);
+    myFloatIn.resize(aNbSrcSamples * sizeof(float) * aNbCh, false);
+    if(!myFloatIn.addData(theSrc)) {
+        return false;
+    }
+
+    myMix.resize(myInNb + aNbSrcSamples, 0.0f);
+    const float aMixScale = 1.0f / float(aNbCh);
+    for(size_t aChIter = 0; aChIter < aNbCh; ++aChIter) {
+        float* aData = NULL;
+        myFloatIn.getChannelDataStart(aChIter, aData);
+        myIn[aChIter].insert(myIn[aChIter].end(), aData, aData + aNbSrcSamples);
+        float* aMix = &myMix[myInNb];
+        for(size_t aSmplIter = 0; aSmplIter < aNbSrcSamples; ++aSmplIter) {
+            aMix[aSmplIter] += aData[aSmplIter] * aMixScale;
+        }
+    }
+    myInNb += aNbSrcSamples;
+
+    // count frames which can be produced with available input
+    const double anAnaHop = double(myHopLen) * myRate;
+    size_t aNbFrames = 0;
+    for(double aPos = myAnaPos;; aPos += anAnaHop, ++aNbFrames) {
+        const size_t aNeeded = size_t(aPos) + myFrameLen + ((myHasPrev || aNbFrames != 0) ? mySeekLen : 0);
+        if(aNeeded > myInNb) {
+            break;
+        }
+    }
+
+    myFloatOut.setupFrom(theSrc, StPcmFormat_Float32, aNbCh);
+    myFloatOut.resize(aNbFrames * myHopLen * sizeof(float) * aNbCh, false);
+    float* anOut[ST_AUDIO_CHANNELS_MAX];
+    for(size_t aChIter = 0; aChIter < aNbCh; ++aChIter) {
+        myFloatOut.getChannelDataStart(aChIter, anOut[aChIter]);
+    }
+
+    for(size_t aFrameIter = 0; aFrameIter < aNbFrames; ++aFrameIter) {
+        const size_t aNominal = size_t(myAnaPos);
+        const size_t aPos     = myHasPrev ? findBestFrame(aNominal) : aNominal;
+        for(size_t aChIter = 0; aChIter < aNbCh; ++aChIter) {
+            const float* anIn      = &myIn[aChIter][aPos];
+            float*       anOverlap = &myOverlap[aChIter][0];
+            float*       aDst      = anOut[aChIter] + aFrameIter * myHopLen;
+            if(myHasPrev) {
+                stMulAdd(aDst, anOverlap, &myWindow[0], anIn, myHopLen);
+            } else {
+                stMemCpy(aDst, anIn, myHopLen * sizeof(float)); // avoid fading in the very first frame
+            }
+            stMul(anOverlap, &myWindow[myHopLen], anIn + myHopLen, myHopLen);
+        }
+        myPrevPos = aPos;
+        myHasPrev = true;
+        myAnaPos += anAnaHop;
+    }
+    myFloatOut.setPlaneSize(aNbFrames * myHopLen * sizeof(float));
+    trimInput();
+
+    // convert output back into original format
+    if(aNbFrames != 0) {
+        theOut.resize(aNbFrames * myHopLen * aSrcSampleSize * aNbCh, false);
+        if(!theOut.addData(myFloatOut)) {
+            return false;
+        }
+    }
+
+    myCpuTimeUs += aTimer.getElapsedTimeInMicroSec();
+    myOutTimeUs += double(aNbFrames * myHopLen) * 1000000.0 / double(myFreq);
+    return true;
+}
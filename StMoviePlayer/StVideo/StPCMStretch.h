@@ -0,0 +1,140 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StPCMStretch_h_
+#define __StPCMStretch_h_
+
+#include "StPCMBuffer.h"
+
+#include <vector>
+
+/**
+ * Audio time-stretching preserving the pitch.
+ * WSOLA (Waveform Similarity Overlap-Add) is used - signal is cut into overlapping Hann-windowed frames,
+ * which are taken from the input with analysis hop (scaled by playback rate)
+ * and put into the output with constant synthesis hop.
+ * Position of each frame is adjusted within small tolerance range to maximize
+ * cross-correlation with natural continuation of previous frame (on mono mix),
+ * so that output does not contain phase jumps.
+ * Correlation and overlap-add kernels are vectorized (SSE / NEON).
+ */
+class StPCMStretch {
+
+        public:
+
+    /**
+     * Empty constructor.
+     */
+    ST_LOCAL StPCMStretch();
+
+    /**
+     * Destructor.
+     */
+    ST_LOCAL ~StPCMStretch();
+
+    /**
+     * @return playback rate
+     */
+    ST_LOCAL double getRate() const {
+        return myRate;
+    }
+
+    /**
+     * Setup playback rate, resets the state on change.
+     * @param theRate playback rate (0.25 .. 8.0), 1.0 for normal speed
+     */
+    ST_LOCAL void setRate(const double theRate);
+
+    /**
+     * @return true if input can be passed as is (normal speed and no pending data)
+     */
+    ST_LOCAL bool isBypass() const {
+        return myRate == 1.0 && myInNb == 0;
+    }
+
+    /**
+     * Drop pending data (e.g. after seeking).
+     */
+    ST_LOCAL void reset();
+
+    /**
+     * Process the next portion of input data.
+     * Output might be empty if not enough data has been accumulated.
+     * @param theSrc input data in any format
+     * @param theOut output buffer to fill, receives the same format and layout as input
+     * @return false on error
+     */
+    ST_LOCAL bool process(const StPCMBuffer& theSrc,
+                          StPCMBuffer&       theOut);
+
+    /**
+     * @return duration of input data (in seconds) accumulated but not yet put into the output
+     */
+    ST_LOCAL double getLatency() const {
+        return myFreq > 0 ? (double(myInNb) - myAnaPos) / double(myFreq) : 0.0;
+    }
+
+    /**
+     * @return processing time relative to duration of produced output in percents
+     */
+    ST_LOCAL double getCpuLoad() const {
+        return myOutTimeUs > 0.0 ? (100.0 * myCpuTimeUs / myOutTimeUs) : 0.0;
+    }
+
+        private:
+
+    /**
+     * Setup frame parameters for new stream.
+     */
+    ST_LOCAL void init(const int    theFreq,
+                       const size_t theChannelsNb);
+
+    /**
+     * Find the frame position around nominal one with best similarity to continuation of previous frame.
+     */
+    ST_LOCAL size_t findBestFrame(const size_t theNominal) const;
+
+    /**
+     * Remove consumed samples from the beginning of input.
+     */
+    ST_LOCAL void trimInput();
+
+        private:
+
+    std::vector<float> myIn[ST_AUDIO_CHANNELS_MAX];      //!< input samples per channel
+    std::vector<float> myOverlap[ST_AUDIO_CHANNELS_MAX]; //!< second half of the last windowed frame per channel
+    std::vector<float> myMix;        //!< mono mix of input samples used for frames matching
+    std::vector<float> myWindow;     //!< Hann window
+    StPCMBuffer        myFloatIn;    //!< temporary buffer for input  conversion
+    StPCMBuffer        myFloatOut;   //!< temporary buffer for output conversion
+    double             myRate;       //!< playback rate
+    double             myAnaPos;     //!< nominal position of the next frame within input
+    size_t             myPrevPos;    //!< position of the last frame within input
+    size_t             myInNb;       //!< number of samples in input
+    bool               myHasPrev;    //!< flag indicating that the last frame has been defined
+    int                myFreq;       //!< sample rate
+    size_t             myChannelsNb; //!< number of channels
+    size_t             myFrameLen;   //!< frame length
+    size_t             myHopLen;     //!< synthesis hop, half of the frame
+    size_t             mySeekLen;    //!< frame position tolerance
+    double             myCpuTimeUs;  //!< overall processing time
+    double             myOutTimeUs;  //!< overall duration of produced output
+
+};
+
+#endif // __StPCMStretch_h_
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2011-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2011-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -42,6 +42,7 @@ StSubtitleQueue::StSubtitleQueue(const StHandle<StSubQueue>& theSubtitlesQueue)
   myOutQueue(theSubtitlesQueue),
   myThread(NULL),
   evDowntime(true),
+  myScaleCtx(NULL),
   myImageScale(1.0f),
   toQuit(false) {
     myThread = new StThread(threadFunction, (void* )this, "StSubtitleQueue");
@@ -55,6 +56,10 @@ StSubtitleQueue::~StSubtitleQueue() {
     delete myThread;
 
     deinit();
+    if(myScaleCtx != NULL) {
+        sws_freeContext(myScaleCtx);
+        myScaleCtx = NULL;
+    }
 }
 
 bool StSubtitleQueue::init(AVFormatContext*   theFormatCtx,
@@ -168,10 +173,12 @@ void StSubtitleQueue::decodeLoop() {
                             uint8_t** anImgData = aRect->data;
                             int* anImgLineSizes = aRect->linesize;
 
-                            SwsContext* aCtxToRgb = sws_getContext(aRect->w, aRect->h, stAV::PIX_FMT::PAL8,
-                                                                   aRect->w, aRect->h, stAV::PIX_FMT::RGBA32,
-                                                                   SWS_BICUBIC, NULL, NULL, NULL);
-                            if(aCtxToRgb == NULL) {
+                            // context is reused while bitmap dimensions remain the same
+                            myScaleCtx = sws_getCachedContext(myScaleCtx,
+                                                              aRect->w, aRect->h, stAV::PIX_FMT::PAL8,
+                                                              aRect->w, aRect->h, stAV::PIX_FMT::RGBA32,
+                                                              SWS_BICUBIC, NULL, NULL, NULL);
+                            if(myScaleCtx == NULL) {
                                 break;
                             }
 
@@ -182,11 +189,10 @@ void StSubtitleQueue::decodeLoop() {
                                 (int )aNewSubItem->Image.getSizeRowBytes(), 0, 0, 0
                             };
 
-                            sws_scale(aCtxToRgb,
+                            sws_scale(myScaleCtx,
                                       anImgData, anImgLineSizes,
                                       0, aRect->h,
                                       aDstData, aDstLinesize);
-                            sws_freeContext(aCtxToRgb);
 
                             /*ST_DEBUG_LOG("  |" + aRectId + "/" + aSubtitle.num_rects + "| " //+ aRect->x + "x" + aRect->y + " WH= "
                                             + aRect->w + "x" + aRect->h + " c= " + aRect->nb_colors
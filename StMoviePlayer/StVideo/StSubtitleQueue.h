@@ -1,5 +1,5 @@
 /**
- * Copyright © 2011-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2011-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -81,6 +81,7 @@ class StSubtitleQueue : public StAVPacketQueue {
     StThread*            myThread;   //!< decoding loop thread
     StSubtitlesASS       myASS;      //!< ASS subtitles parser
     StCondition          evDowntime;
+    SwsContext*          myScaleCtx; //!< cached conversion context for bitmap subtitles, used only by decoding thread
     float                myImageScale;
     volatile bool        toQuit;
 
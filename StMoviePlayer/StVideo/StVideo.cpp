@@ -1,5 +1,5 @@
 /**
- * Copyright © 2007-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2007-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -24,6 +24,7 @@
 
 #include <StStrings/StFormatTime.h>
 #include <StAV/StAVIOJniHttpContext.h>
+#include <StThreads/StMemoryBudget.h>
 
 using namespace StMoviePlayerStrings;
 
@@ -31,6 +32,16 @@ namespace {
     static const char ST_AUDIOS_MIME_STRING[] = ST_VIDEO_PLUGIN_AUDIO_MIME_CHAR;
     static const char ST_SUBTIT_MIME_STRING[] = ST_VIDEO_PLUGIN_SUBTIT_MIME_CHAR;
 
+    /**
+     * Size of AVIO buffer for files read in advance - demuxer requests are served from memory.
+     */
+    static const int THE_READ_AHEAD_IO_SIZE = 256 * 1024;
+
+    /**
+     * Maximum dimension of scrubbing preview.
+     */
+    static const int THE_PREVIEW_SIZE = 240;
+
     static SV_THREAD_FUNCTION threadFunction(void* theStVideo) {
         StVideo* aStVideo  = (StVideo* )theStVideo;
         aStVideo->mainLoop();
@@ -128,16 +139,30 @@ StVideo::StVideo(const std::string&                 theALDeviceName,
   myToSeekBack(false),
   myPlayEvent(ST_PLAYEVENT_NONE),
   myTargetFps(0.0),
+  myFastSeekPts(-1.0),
+  myOpenTimeSec(0.0),
+  myFirstFrameSec(-1.0),
+  myIsFastOpen(false),
   //
   myAudioDelayMSec(0),
+  myPlaybackRate(1.0f),
   myIsBenchmark(false),
   toSave(StImageFile::ST_TYPE_NONE),
+  toExport(StImageFile::ST_TYPE_NONE),
+  myExportStep(1),
+  myToExportSideBySide(true),
   toQuit(false),
   myQuitEvent(false) {
     // initialize FFmpeg library if not yet performed
     stAV::init();
 
     myPlayList->setExtensions(myMimesVideo.getExtensionsList());
+    myProbeCache = new StVideoProbeCache(myResMgr->getCacheFolder());
+    myKeyframes  = new StVideoKeyframeIndex();
+    myPreview    = new StVideoPreview(THE_PREVIEW_SIZE);
+    myExportQueue   = new StImageExportQueue();
+    myExportQueue->signals.onError.connect(this, &StVideo::doOnErrorRedirect);
+    myFrameExporter = new StVideoFrameExporter(myExportQueue);
     myTracksExt = myMimesSubs.getExtensionsList();
     StArrayList<StString> anAudioExt = myMimesAudio.getExtensionsList();
     for(size_t anExtIter = 0; anExtIter < anAudioExt.size(); ++anExtIter) {
@@ -241,6 +266,7 @@ void StVideo::startDestruction() {
 
     toQuit = true;
     toSave = StImageFile::ST_TYPE_NONE;
+    toExport = StImageFile::ST_TYPE_NONE;
     pushPlayEvent(ST_PLAYEVENT_NEXT);
     myTextureQueue->clear();
     myQuitEvent.wait(1000);
@@ -277,6 +303,10 @@ StVideo::~StVideo() {
     myVideoMaster.nullify();
     aHangKiller.setDone();
     close(); // we must quit or flush video/audio threads before close()!
+
+    // pending snapshots are still written
+    myFrameExporter.nullify();
+    myExportQueue.nullify();
 }
 
 void StVideo::close() {
@@ -295,6 +325,14 @@ void StVideo::close() {
     myCtxList.clear();
     myFileIOList.clear();
     myPlayCtxList.clear();
+    myEventMutex.lock();
+        myReadAheadList.clear();
+    myEventMutex.unlock();
+    myKeyframes->clear();
+    myPreview->setSource(StString());
+    if(!myProbeCache.isNull()) {
+        myProbeCache->flush();
+    }
     mySlaveCtx    = NULL;
     mySlaveStream = -1;
 
@@ -319,6 +357,21 @@ void StVideo::setAudioDelay(const float theDelaySec) {
     myVideoMaster->setAudioDelay(myAudioDelayMSec);
 }
 
+void StVideo::setPlaybackRate(const float theRate) {
+    if(myPlaybackRate == theRate) {
+        return;
+    }
+
+    myPlaybackRate = theRate;
+    myAudio->setPlaybackRate(theRate);
+    myVideoMaster->setPlaybackRate(theRate);
+    if(myAudio->getId() >= 0
+    && getDuration() > 0.0) {
+        // audio decoded in advance has been stretched with previous rate
+        pushPlayEvent(ST_PLAYEVENT_SEEK, getPts());
+    }
+}
+
 bool StVideo::addFile(const StString& theFileToLoad,
                       const StHandle<StStereoParams>& theNewParams,
                       StStreamsInfo&  theInfo) {
@@ -326,12 +379,16 @@ bool StVideo::addFile(const StString& theFileToLoad,
     StString aFileName, aDummy;
     StFileNode::getFolderAndFile(theFileToLoad, aDummy, aFileName);
 
-    StHandle<StAVIOContext> anIOContext;
+    StHandle<StAVIOContext>     anIOContext;
+    StHandle<StAVIOFileContext> aReadAheadCtx;
+    const bool toReadAhead = params.ReadAheadSec->getValue() > 0.0f;
     if(StFileNode::isContentProtocolPath(theFileToLoad)) {
         int aFileDescriptor = myResMgr->openFileDescriptor(theFileToLoad);
         if(aFileDescriptor != -1) {
-            StHandle<StAVIOFileContext> aFileCtx = new StAVIOFileContext();
-            if(aFileCtx->openFromDescriptor(aFileDescriptor, "rb")) {
+            StHandle<StAVIOFileContext> aFileCtx = new StAVIOFileContext(toReadAhead ? THE_READ_AHEAD_IO_SIZE : 32768);
+            if(toReadAhead
+             ? aFileCtx->openReadAhead(theFileToLoad, aFileDescriptor)
+             : aFileCtx->openFromDescriptor(aFileDescriptor, "rb")) {
                 anIOContext = aFileCtx;
             }
         }
@@ -347,31 +404,98 @@ bool StVideo::addFile(const StString& theFileToLoad,
         }
     }
 #endif
-    AVFormatContext* aFormatCtx = NULL;
+    else if(toReadAhead
+        && !StFileNode::isRemoteProtocolPath(theFileToLoad)
+        &&  StFileNode::isFileExists(theFileToLoad)) {
+        // read local files in large blocks by dedicated thread, so that demuxer is not blocked by disk
+        StHandle<StAVIOFileContext> aFileCtx = new StAVIOFileContext(THE_READ_AHEAD_IO_SIZE);
+        if(aFileCtx->openReadAhead(theFileToLoad)) {
+            anIOContext = aFileCtx;
+        }
+    }
     if(!anIOContext.isNull()) {
-        aFormatCtx = avformat_alloc_context();
-        aFormatCtx->pb = anIOContext->getAvioContext();
+        aReadAheadCtx = StHandle<StAVIOFileContext>::downcast(anIOContext);
     }
+    AVFormatContext* aFormatCtx = NULL;
 
-    int avErrCode = avformat_open_input(&aFormatCtx, theFileToLoad.toCString(), NULL, NULL);
-    if(avErrCode != 0) {
-        signals.onError(StString("FFmpeg: Couldn't open video file '") + theFileToLoad
-                      + "'\nError: " + stAV::getAVErrorDescription(avErrCode));
-        if(aFormatCtx != NULL) {
-            avformat_close_input(&aFormatCtx);
+    // file has been already probed - skip demuxer detection and limit streams analysis
+    StVideoProbeCache::Entry aProbeEntry;
+    const StString aProbeKey = StVideoProbeCache::getFileKey(theFileToLoad);
+    bool isProbed = false;
+    if(myProbeCache->find(aProbeKey, aProbeEntry)) {
+        AVInputFormat* anInFormat = (AVInputFormat* )av_find_input_format(aProbeEntry.Format.toCString());
+        AVDictionary*  anOpts     = NULL;
+        av_dict_set(&anOpts, "probesize",       "131072", 0);
+        av_dict_set(&anOpts, "analyzeduration", "200000", 0);
+        if(anInFormat != NULL
+        && !anIOContext.isNull()) {
+            aFormatCtx = avformat_alloc_context();
+            aFormatCtx->pb = anIOContext->getAvioContext();
+        }
+        if(anInFormat != NULL
+        && avformat_open_input(&aFormatCtx, theFileToLoad.toCString(), anInFormat, &anOpts) == 0) {
+            if(avformat_find_stream_info(aFormatCtx, NULL) >= 0
+            && StVideoProbeCache::isComplete(aProbeEntry, aFormatCtx)) {
+                isProbed = true;
+                if(aProbeEntry.Duration != stAV::NOPTS_VALUE) {
+                    // duration estimated from bitrate is less precise with reduced probing
+                    aFormatCtx->duration = aProbeEntry.Duration;
+                }
+            } else {
+                ST_DEBUG_LOG("StVideo, reduced probing is insufficient for '" + theFileToLoad + "'");
+                avformat_close_input(&aFormatCtx);
+            }
+        }
+        av_dict_free(&anOpts);
+        if(!isProbed) {
+            myProbeCache->remove(aProbeKey);
         }
-        return false;
     }
+    myIsFastOpen = myIsFastOpen && isProbed;
 
-    // retrieve stream information
-    if(avformat_find_stream_info(aFormatCtx, NULL) < 0) {
-        signals.onError(StString("FFmpeg: Couldn't find stream information in '") + theFileToLoad + "'");
-        if(aFormatCtx != NULL) {
-            avformat_close_input(&aFormatCtx);
+    if(!isProbed) {
+        if(!anIOContext.isNull()) {
+            // rewind custom I/O after failed attempt
+            avio_seek(anIOContext->getAvioContext(), 0, SEEK_SET);
+            aFormatCtx = avformat_alloc_context();
+            aFormatCtx->pb = anIOContext->getAvioContext();
         }
-        return false;
+
+        int avErrCode = avformat_open_input(&aFormatCtx, theFileToLoad.toCString(), NULL, NULL);
+        if(avErrCode != 0) {
+            signals.onError(StString("FFmpeg: Couldn't open video file '") + theFileToLoad
+                          + "'\nError: " + stAV::getAVErrorDescription(avErrCode));
+            if(aFormatCtx != NULL) {
+                avformat_close_input(&aFormatCtx);
+            }
+            return false;
+        }
+
+        // retrieve stream information
+        if(avformat_find_stream_info(aFormatCtx, NULL) < 0) {
+            signals.onError(StString("FFmpeg: Couldn't find stream information in '") + theFileToLoad + "'");
+            if(aFormatCtx != NULL) {
+                avformat_close_input(&aFormatCtx);
+            }
+            return false;
+        }
+        myProbeCache->add(aProbeKey, aFormatCtx);
     }
 
+    if(!aReadAheadCtx.isNull()
+    && !aReadAheadCtx->getReadAhead().isNull()) {
+        // read in advance the specified duration of the stream, estimated from overall bitrate
+        const double aBytesMax = double(params.ReadAheadMaxMB->getValue()) * 1024.0 * 1024.0;
+        const double aBytes    = aFormatCtx->bit_rate > 0
+                               ? double(params.ReadAheadSec->getValue()) * double(aFormatCtx->bit_rate) / 8.0
+                               : aBytesMax;
+        aReadAheadCtx->getReadAhead()->setReadAhead(size_t(stMin(aBytes, aBytesMax)));
+        myEventMutex.lock();
+            myReadAheadList.add(aReadAheadCtx->getReadAhead());
+        myEventMutex.unlock();
+    }
+    myAudio->setDecodeAhead(params.AudioDecodeAhead->getValue());
+
 #ifdef ST_DEBUG
     av_dump_format(aFormatCtx, 0, theFileToLoad.toCString(), false);
 #endif
@@ -440,6 +564,9 @@ bool StVideo::addFile(const StString& theFileToLoad,
                 }
             } else if(!myVideoSlave->isInitialized()
                    && !stAV::isAttachedPicture(aStream)) {
+                // split decoding threads between Master and Slave only when stereo pair is actually decoded by two decoders
+                const bool toDecodeSlave = myVideoMaster->getStereoFormatByUser() == StFormat_AUTO;
+                myVideoMaster->getThreadBudget()->setNbDecoders(toDecodeSlave ? 2 : 1);
                 myVideoSlave->init(aFormatCtx, aStreamId, aTitleString, theNewParams);
                 if(myVideoSlave->isInitialized()) {
                     mySlaveCtx    = aFormatCtx;
@@ -460,12 +587,24 @@ bool StVideo::addFile(const StString& theFileToLoad,
                     aDimInfo.changeValue() += "\n";
                     aDimInfo.changeValue() += aDimsStr;
 
-                    if(myVideoMaster->getStereoFormatByUser() == StFormat_AUTO) {
+                    if(toDecodeSlave) {
+                        // Master codec has been opened with all threads - reopen it with its share,
+                        // since threads cannot be changed within opened codec (nothing has been decoded yet)
+                        if(myVideoMaster->getNbThreads() > 1) {
+                            AVFormatContext* aCtxMaster      = myVideoMaster->getContext();
+                            const signed int aStreamIdMaster = myVideoMaster->getId();
+                            const StString   aFileNameMaster = myVideoMaster->getFileName();
+                            myVideoMaster->deinit();
+                            myVideoMaster->init(aCtxMaster, aStreamIdMaster, aFileNameMaster, theNewParams);
+                        }
                         myVideoMaster->setSlave(myVideoSlave);
                     } else {
                         myVideoSlave->deinit();
                     }
                 }
+                if(!myVideoSlave->isInitialized()) {
+                    myVideoMaster->getThreadBudget()->setNbDecoders(1);
+                }
             }
         } else if(aCodecType == AVMEDIA_TYPE_AUDIO) {
             // audio track
@@ -584,6 +723,9 @@ bool StVideo::openSource(const StHandle<StFileNode>&     theNewSource,
                          const StHandle<StFileNode>&     theNewPlsFile) {
     // just for safe - close previously opened video
     close();
+    myOpenTimer.restart();
+    myFirstFrameSec = -1.0;
+    myIsFastOpen    = true;
 
     const bool toUseGpu      = params.UseGpu->getValue();
     const bool toUseOpenJpeg = params.UseOpenJpeg->getValue();
@@ -593,6 +735,9 @@ bool StVideo::openSource(const StHandle<StFileNode>&     theNewSource,
     myVideoSlave ->setUseOpenJpeg(toUseOpenJpeg);
     myAudio->setTrackHeadOrientation(false);
 
+    // decoding threads are split between Master and Slave by addFile() when Slave decoder is opened
+    myVideoMaster->getThreadBudget()->setNbDecoders(1);
+
     myFileInfoTmp = new StMovieInfo();
 
     StStreamsInfo aStreamsInfo;
@@ -730,6 +875,22 @@ bool StVideo::openSource(const StHandle<StFileNode>&     theNewSource,
     params.activeSubtitles1->setList(aStreamsInfo.SubtitleList, aStreamsInfo.LoadedSubtitles1);
     params.activeSubtitles2->setList(aStreamsInfo.SubtitleList, aStreamsInfo.LoadedSubtitles2);
 
+    // previews and key frames index are collected for the Master video stream
+    if(myVideoMaster->isInitialized()
+    && !myVideoMaster->isAttachedPicture()) {
+        myKeyframes->fillFromStream(myVideoMaster->getStream());
+        for(size_t aCtxIter = 0; aCtxIter < myCtxList.size(); ++aCtxIter) {
+            if(myVideoMaster->isInContext(myCtxList[aCtxIter])) {
+                myPreview->setSource(myFileList[aCtxIter]);
+                break;
+            }
+        }
+    }
+
+    myOpenTimeSec = myOpenTimer.getElapsedTimeInSec();
+    ST_DEBUG_LOG("StVideo, source opened in " + (myOpenTimeSec * 1000.0) + " ms"
+               + (myIsFastOpen ? " (cached probing)" : ""));
+
     myEventMutex.lock();
         myDuration = aStreamsInfo.Duration;
         myFileInfo = myFileInfoTmp;
@@ -793,6 +954,8 @@ void StVideo::doSeekContext(AVFormatContext* theFormatCtx,
     bool isSeekDone = false;
     if(myVideoMaster->isInContext(theFormatCtx)) {
         isSeekDone = doSeekStream(theFormatCtx, myVideoMaster->getId(), theSeekPts, toSeekBack);
+        // some demuxers (e.g. Matroska) load the index on first seek
+        myKeyframes->fillFromStream(myVideoMaster->getStream());
     } else if(myVideoSlave->isInContext(theFormatCtx)) {
         isSeekDone = doSeekStream(theFormatCtx, myVideoSlave->getId(), theSeekPts, toSeekBack);
     } else if(myAudio->isInContext(theFormatCtx)) {
@@ -830,6 +993,29 @@ void StVideo::doSeekContext(AVFormatContext* theFormatCtx,
     }
 }
 
+void StVideo::pushFastSeek(const double theSeekPts) {
+    double aKeyPts = 0.0;
+    if(!myKeyframes->findNearest(theSeekPts, aKeyPts)) {
+        pushPlayEvent(ST_PLAYEVENT_SEEK, theSeekPts);
+        return;
+    }
+
+    myEventMutex.lock();
+    const bool isSameKey = myFastSeekPts >= 0.0
+                        && std::abs(myFastSeekPts - aKeyPts) < 0.001;
+    myEventMutex.unlock();
+    if(isSameKey) {
+        // the same key frame has been already requested - skip redundant flush / seek cycle
+        return;
+    }
+
+    // seeking exactly to the key frame does not require decoding following frames
+    pushPlayEvent(ST_PLAYEVENT_SEEK, aKeyPts);
+    myEventMutex.lock();
+        myFastSeekPts = aKeyPts;
+    myEventMutex.unlock();
+}
+
 bool StVideo::doSeekStream(AVFormatContext* theFormatCtx,
                            const signed int theStreamId,
                            const double     theSeekPts,
@@ -907,6 +1093,7 @@ void StVideo::checkInitVideoStreams() {
 
             myVideoMaster->setUseGpu(toUseGpu, isGpuFailed);
             myVideoSlave ->setUseGpu(toUseGpu, isGpuFailed);
+            myVideoMaster->getThreadBudget()->setNbDecoders(toDecodeSlave ? 2 : 1);
             myVideoMaster->init(aCtxMaster, aStreamIdMaster, aFileNameMaster, myCurrParams);
             myVideoMaster->setSlave(NULL);
             if(toDecodeSlave) {
@@ -1133,6 +1320,9 @@ void StVideo::packetsLoop() {
 
             // push packet to appropriate queue
             if(myVideoMaster->isInContext(aFormatCtx, aPacket.getStreamId())) {
+                if(aPacket.isKeyFrame()) {
+                    myKeyframes->addPacket(myVideoMaster->getStream(), aPacket.getAVpkt());
+                }
                 aQueueIsFull[aCtxId] = !pushPacket(myVideoMaster, aPacket);
                 if(aQueueIsFull[aCtxId]) { continue; }
                 const double aTagerFpsNew = myVideoTimer->getAverFps();
@@ -1162,6 +1352,7 @@ void StVideo::packetsLoop() {
 
         if(!myVideoTimer.isNull()) {
             myVideoTimer->setAudioDelay(myAudioDelayMSec);
+            myVideoTimer->setPlaybackRate(myPlaybackRate);
             myVideoTimer->setBenchmark(myIsBenchmark);
         }
 
@@ -1172,6 +1363,11 @@ void StVideo::packetsLoop() {
                 StImageFile::ImageType anImgType = toSave;
                 toSave = StImageFile::ST_TYPE_NONE;
                 saveSnapshotAs(anImgType);
+            } else if(toExport != StImageFile::ST_TYPE_NONE) {
+                // start frames export
+                StImageFile::ImageType anImgType = toExport;
+                toExport = StImageFile::ST_TYPE_NONE;
+                exportFramesAs(anImgType);
             } else {
                 // load next file
                 const double aPts = getPts();
@@ -1211,6 +1407,12 @@ void StVideo::packetsLoop() {
             }
         }
 
+        if(myFirstFrameSec < 0.0
+        && myVideoMaster->hasFirstFrame()) {
+            myFirstFrameSec = myOpenTimer.getElapsedTimeInSec();
+            ST_DEBUG_LOG("StVideo, time to first frame " + (myFirstFrameSec * 1000.0) + " ms");
+        }
+
         ///
         if(aQueueIsFull[0]) {
             StThread::sleep(2);
@@ -1318,35 +1520,22 @@ bool StVideo::saveSnapshotAs(StImageFile::ImageType theImgType) {
 
     pushPlayEvent(ST_PLAYEVENT_PAUSE);
 
-    StImage dataLeft;
-    StImage dataRight;
+    // reference decoded buffers instead of copying them, encoding is done by export queue
+    StHandle<StImage> dataLeft  = new StImage();
+    StHandle<StImage> dataRight = new StImage();
     int result = StGLTextureQueue::SNAPSHOT_NO_NEW;
     if(!myCurrParams->ToSwapLR) {
-        result = myTextureQueue->getSnapshot(&dataLeft, &dataRight, true);
+        result = myTextureQueue->getSnapshot(dataLeft.access(), dataRight.access(), true, true);
     } else {
-        result = myTextureQueue->getSnapshot(&dataRight, &dataLeft, true);
+        result = myTextureQueue->getSnapshot(dataRight.access(), dataLeft.access(), true, true);
     }
 
-    if(result == StGLTextureQueue::SNAPSHOT_NO_NEW || dataLeft.isNull()) {
+    if(result == StGLTextureQueue::SNAPSHOT_NO_NEW || dataLeft->isNull()) {
         stInfo(myLangMap->getValue(StMoviePlayerStrings::DIALOG_NO_SNAPSHOT));
         return false;
     }
-    StHandle<StImageFile> dataResult = StImageFile::create();
-    if(dataResult.isNull()) {
-        signals.onError(stCString("No any image library was found!"));
-        return false;
-    }
-
-    bool toSaveStereo = !dataRight.isNull();
-    if(toSaveStereo && dataResult->initSideBySide(dataLeft, dataRight,
-                                                  myCurrParams->getSeparationDx(),
-                                                  myCurrParams->getSeparationDy())) {
-        dataLeft.nullify();
-        dataRight.nullify();
-    } else {
-        dataResult->initWrapper(dataLeft);
-    }
 
+    const bool toSaveStereo = !dataRight->isNull();
     StOpenFileName anOpenInfo;
     anOpenInfo.Title = myLangMap->getValue(StMoviePlayerStrings::DIALOG_SAVE_SNAPSHOT);
     StString saveExt;
@@ -1389,22 +1578,71 @@ bool StVideo::saveSnapshotAs(StImageFile::ImageType theImgType) {
         if(StFileNode::getExtension(fileToSave) != saveExt) {
             fileToSave += StString('.') + saveExt;
         }
-        ST_DEBUG_LOG("Save snapshot to the path '" + fileToSave + '\'');
-        StImageFile::SaveImageParams aSaveParams;
-        aSaveParams.SaveImageType = theImgType;
-        aSaveParams.StereoFormat = toSaveStereo ? StFormat_SideBySide_RL : StFormat_AUTO;
-        if(!dataResult->save(fileToSave, aSaveParams)) {
-            // TODO (Kirill Gavrilov#7)
-            signals.onError(dataResult->getState());
-            return false;
-        } else if(!dataResult->getState().isEmpty()) {
-            ST_DEBUG_LOG(dataResult->getState());
-        }
+        StImageExportQueue::Job aJob;
+        aJob.Left  = dataLeft;
+        aJob.Right = toSaveStereo ? dataRight : StHandle<StImage>();
+        aJob.Path  = fileToSave;
+        aJob.SaveParams.SaveImageType = theImgType;
+        aJob.SaveParams.StereoFormat  = toSaveStereo ? StFormat_SideBySide_RL : StFormat_AUTO;
+        aJob.SeparationDx = myCurrParams->getSeparationDx();
+        aJob.SeparationDy = myCurrParams->getSeparationDy();
+        myExportQueue->push(aJob);
         // TODO (Kirill Gavrilov#8) - update playlist
     }
     return true;
 }
 
+bool StVideo::exportFramesAs(StImageFile::ImageType theImgType) {
+    if(myCurrParams.isNull() || myCurrNode.isNull() || myFileList.isEmpty()) {
+        stInfo(myLangMap->getValue(StMoviePlayerStrings::DIALOG_NOTHING_TO_SAVE));
+        return false;
+    }
+
+    pushPlayEvent(ST_PLAYEVENT_PAUSE);
+
+    StOpenFileName anOpenInfo;
+    anOpenInfo.Title = myLangMap->getValue(StMoviePlayerStrings::DIALOG_EXPORT_FRAMES);
+    switch(theImgType) {
+        case StImageFile::ST_TYPE_PNG:
+            anOpenInfo.Filter.add(StMIME("image/png", "png", "PNG image sequence, lossless"));
+            break;
+        case StImageFile::ST_TYPE_JPEG:
+            anOpenInfo.Filter.add(StMIME("image/jpg", "jpg", "JPEG image sequence, lossy"));
+            break;
+        default:
+            return false;
+    }
+    anOpenInfo.Folder = myCurrNode->size() >= 2 ? myCurrNode->getValue(0)->getFolderPath() : myCurrNode->getFolderPath();
+
+    StString aFileToSave;
+    if(!StFileNode::openFileDialog(aFileToSave, anOpenInfo, true)) {
+        return false;
+    }
+
+    // frame number and extension are appended by exporter
+    StString aName, anExt;
+    StFileNode::getNameAndExtension(aFileToSave, aName, anExt);
+    if(!anExt.isEqualsIgnoreCase(stCString("png"))
+    && !anExt.isEqualsIgnoreCase(stCString("jpg"))
+    && !anExt.isEqualsIgnoreCase(stCString("jpeg"))) {
+        aName = aFileToSave;
+    }
+
+    StVideoFrameExporter::Params aParams;
+    aParams.Left         = myFileList[0];
+    aParams.Right        = myFileList.size() >= 2 ? myFileList[1] : StString();
+    aParams.OutputBase   = aName;
+    aParams.ImageType    = theImgType;
+    aParams.From         = getPts();
+    aParams.Step         = myExportStep;
+    aParams.ToSideBySide = myToExportSideBySide;
+    aParams.ToSwapLR     = myCurrParams->ToSwapLR;
+    aParams.SeparationDx = myCurrParams->getSeparationDx();
+    aParams.SeparationDy = myCurrParams->getSeparationDy();
+    myFrameExporter->start(aParams);
+    return true;
+}
+
 StHandle<StMovieInfo> StVideo::getFileInfo(const StHandle<StStereoParams>& theParams) const {
     myEventMutex.lock();
     StHandle<StMovieInfo> anInfo = myFileInfo;
@@ -1417,6 +1655,8 @@ StHandle<StMovieInfo> StVideo::getFileInfo(const StHandle<StStereoParams>& thePa
     anInfo->StInfoStream   = myVideoMaster->getStereoFormatFromStream();
     anInfo->StInfoFileName = myVideoMaster->getStereoFormatFromName();
     anInfo->HasVideo  = myVideoMaster->isInitialized();
+    anInfo->NbThreadsMaster = myVideoMaster->isInitialized() ? myVideoMaster->getNbThreads() : 0;
+    anInfo->NbThreadsSlave  = myVideoSlave ->isInitialized() ? myVideoSlave ->getNbThreads() : 0;
 
     anInfo->Codecs.clear();
     anInfo->Codecs.add(StArgument("vcodec1",    myVideoMaster->getCodecInfo()));
@@ -1425,6 +1665,41 @@ StHandle<StMovieInfo> StVideo::getFileInfo(const StHandle<StStereoParams>& thePa
     anInfo->Codecs.add(StArgument("subtitles",  mySubtitles1 ->getCodecInfo()));
     anInfo->Codecs.add(StArgument("subtitles2", mySubtitles2 ->getCodecInfo()));
 
+    if(myFirstFrameSec >= 0.0) {
+        anInfo->Codecs.add(StArgument("timing", StString("Opened in ") + int(myOpenTimeSec * 1000.0) + " ms"
+                                              + (myIsFastOpen ? " (cached probing)" : "")
+                                              + ", first frame in " + int(myFirstFrameSec * 1000.0) + " ms"));
+    }
+
+    myEventMutex.lock();
+    if(!myReadAheadList.isEmpty()) {
+        StReadAheadFile::Counters aCounters;
+        for(size_t aFileIter = 0; aFileIter < myReadAheadList.size(); ++aFileIter) {
+            const StReadAheadFile::Counters aFileCounters = myReadAheadList.getValue(aFileIter)->getCounters();
+            aCounters.BytesRead   += aFileCounters.BytesRead;
+            aCounters.BytesServed += aFileCounters.BytesServed;
+            aCounters.NbHits      += aFileCounters.NbHits;
+            aCounters.NbMisses    += aFileCounters.NbMisses;
+            aCounters.StallTime   += aFileCounters.StallTime;
+        }
+        anInfo->Codecs.add(StArgument("io", StString("Read ") + int(aCounters.BytesRead / (1024 * 1024)) + " MiB"
+                                          + ", hit rate " + int(aCounters.getHitRate() * 100.0) + "%"
+                                          + ", stalled " + int(aCounters.StallTime * 1000.0) + " ms"));
+    }
+    myEventMutex.unlock();
+    anInfo->Codecs.add(StArgument("memory", StString("Memory ") + StMemoryBudget::format()));
+
+    const StVideoFrameExporter::Progress anExport = myFrameExporter->getProgress();
+    const StString anExportStats = myExportQueue->formatStatistics();
+    if(anExport.IsRunning
+    || !anExportStats.isEmpty()) {
+        StString anExportText = StString("Export ") + anExportStats;
+        if(anExport.IsRunning) {
+            anExportText += StString(", extracting ") + int(anExport.Ratio * 100.0) + "%";
+        }
+        anInfo->Codecs.add(StArgument("export", anExportText));
+    }
+
     return anInfo;
 }
 
@@ -1479,11 +1754,13 @@ void StVideo::mainLoop() {
             myVideoTimer = new StVideoTimer(myVideoMaster, myAudio,
                 1000.0 * av_q2d(myVideoMaster->getCodecContext()->time_base));
             myVideoTimer->setAudioDelay(myAudioDelayMSec);
+            myVideoTimer->setPlaybackRate(myPlaybackRate);
             myVideoTimer->setBenchmark(myIsBenchmark);
         } else if(myCtxList.size() > 1 && myVideoMaster->isInContext(myCtxList[1])) {
             myVideoTimer = new StVideoTimer(myVideoMaster, myAudio,
                 1000.0 * av_q2d(myVideoMaster->getCodecContext()->time_base));
             myVideoTimer->setAudioDelay(myAudioDelayMSec);
+            myVideoTimer->setPlaybackRate(myPlaybackRate);
             myVideoTimer->setBenchmark(myIsBenchmark);
         } else {
             myVideoTimer.nullify();
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2007-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2007-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -24,6 +24,10 @@
 #include "StSubtitleQueue.h"// subtitles queue class
 #include "StVideoTimer.h"   // video refresher class
 #include "StParamActiveStream.h"
+#include "StVideoFrameExporter.h"
+#include "StVideoKeyframeIndex.h"
+#include "StVideoPreview.h"
+#include "StVideoProbeCache.h"
 
 #include <StAV/StAVIOFileContext.h>
 #include <StFile/StMIMEList.h>
@@ -46,10 +50,13 @@ struct StMovieInfo {
     StString                 Path;           //!< file path
     StFormat                 StInfoStream;   //!< source format as stored in file metadata
     StFormat                 StInfoFileName; //!< source format detected from file name
+    int                      NbThreadsMaster;//!< number of decoding threads of Master video stream
+    int                      NbThreadsSlave; //!< number of decoding threads of Slave  video stream (0 if not decoded)
     bool                     HasVideo;       //!< true if file contains video
     bool                     IsSavable;      //!< indicate that file can be saved without re-encoding
 
-    StMovieInfo() : StInfoStream(StFormat_AUTO), StInfoFileName(StFormat_AUTO), HasVideo(false), IsSavable(false) {}
+    StMovieInfo() : StInfoStream(StFormat_AUTO), StInfoFileName(StFormat_AUTO),
+                    NbThreadsMaster(0), NbThreadsSlave(0), HasVideo(false), IsSavable(false) {}
 
 };
 
@@ -205,6 +212,21 @@ class StVideo {
         pushPlayEvent(ST_PLAYEVENT_NEXT);
     }
 
+    /**
+     * Export frames of active file starting from current position into image sequence.
+     * @param theImgType      output image format
+     * @param theStep         export every N-th frame
+     * @param theToSideBySide pack stereo pair into single side-by-side image
+     */
+    ST_LOCAL void doExportFrames(const size_t theImgType,
+                                 const int    theStep,
+                                 const bool   theToSideBySide) {
+        myExportStep         = theStep;
+        myToExportSideBySide = theToSideBySide;
+        toExport = StImageFile::ImageType(theImgType);
+        pushPlayEvent(ST_PLAYEVENT_NEXT);
+    }
+
     /**
      * Switch audio device.
      */
@@ -254,6 +276,18 @@ class StVideo {
 
     ST_LOCAL void setAudioDelay(const float theDelaySec);
 
+    /**
+     * Set duration of audio to be decoded in advance.
+     */
+    ST_LOCAL void setAudioDecodeAhead(const float theMilliseconds) { myAudio->setDecodeAhead(theMilliseconds); }
+
+    /**
+     * Set playback rate (audio is time-stretched with pitch preserved).
+     * Audio decoded in advance is discarded by seeking to current position.
+     * @param theRate playback rate, 1.0 for normal speed
+     */
+    ST_LOCAL void setPlaybackRate(const float theRate);
+
     /**
      * Return OpenAL info.
      */
@@ -269,6 +303,9 @@ class StVideo {
         StHandle<StBoolParam>         ToSearchSubs;    //!< automatically search for additional subtitles/audio track files nearby video file
         StHandle<StBoolParamNamed>    ToTrackHeadAudio;//!< enable/disable head-tracking for audio listener
         StHandle<StFloat32Param>      SlideShowDelay;  //!< slideshow delay
+        StHandle<StFloat32Param>      ReadAheadSec;    //!< duration of video data to read in advance, 0 to disable read-ahead
+        StHandle<StFloat32Param>      ReadAheadMaxMB;  //!< read-ahead limit in megabytes
+        StHandle<StFloat32Param>      AudioDecodeAhead;//!< duration of audio decoded in advance, in milliseconds
         StHandle<StParamActiveStream> activeAudio;     //!< active Audio stream
         StHandle<StParamActiveStream> activeSubtitles1;//!< active Subtitles stream (first)
         StHandle<StParamActiveStream> activeSubtitles2;//!< active Subtitles stream (secondary)
@@ -341,10 +378,22 @@ class StVideo {
                 myPlayEvent  = theEventId;
                 myPtsSeek    = theSeekParam;
                 myToSeekBack = myPtsSeek < aPrevPts;
+                myFastSeekPts = -1.0;
             myEventMutex.unlock();
         }
     }
 
+    /**
+     * Seek to the key frame nearest to specified position, for fast scrubbing.
+     * Falls back to regular seeking if key frames around the position are unknown.
+     */
+    ST_LOCAL void pushFastSeek(const double theSeekPts);
+
+    /**
+     * Return preview decoder for the current file.
+     */
+    ST_LOCAL const StHandle<StVideoPreview>& getPreview() const { return myPreview; }
+
         private: //! @name auxiliary methods
 
     ST_LOCAL const StString& tr(const size_t theId) const {
@@ -424,6 +473,11 @@ class StVideo {
      */
     ST_LOCAL bool saveSnapshotAs(StImageFile::ImageType theImgType);
 
+    /**
+     * Ask for output path and start frames export.
+     */
+    ST_LOCAL bool exportFramesAs(StImageFile::ImageType theImgType);
+
     /**
      * @return event (StPlayEvent_t ) - event in wait state.
      */
@@ -463,6 +517,8 @@ class StVideo {
     StArrayList<AVFormatContext*> myCtxList;     //!< format context for each file
     StArrayList< StHandle<StAVIOContext> >
                                   myFileIOList;  //!< associated IO context
+    StArrayList< StHandle<StReadAheadFile> >
+                                  myReadAheadList; //!< read-ahead readers of opened files, guarded by myEventMutex
     StArrayList<AVFormatContext*> myPlayCtxList; //!< currently played contexts
 
     StHandle<StVideoQueue>        myVideoMaster;  //!< Master video decoding thread
@@ -487,6 +543,16 @@ class StVideo {
                                   myFilesToDelete;//!< file nodes for removal
 
     StHandle<StVideoTimer>        myVideoTimer;   //!< video refresh timer (Audio -> Video sync)
+    StHandle<StVideoProbeCache>   myProbeCache;   //!< cache of stream probing results
+    StHandle<StVideoKeyframeIndex> myKeyframes;   //!< key frames index of the Master video stream
+    StHandle<StVideoPreview>      myPreview;      //!< preview decoder for scrubbing
+    StHandle<StImageExportQueue>  myExportQueue;  //!< queue encoding snapshots and exported frames
+    StHandle<StVideoFrameExporter> myFrameExporter;//!< batch frames exporter
+    double                        myFastSeekPts;  //!< key frame position of the last fast seek, negative if none
+    StTimer                       myOpenTimer;    //!< timer started on opening new source
+    double                        myOpenTimeSec;  //!< time spent on opening the source
+    volatile double               myFirstFrameSec;//!< time to the first decoded frame, negative until pushed
+    bool                          myIsFastOpen;   //!< all files of the source have been opened using cached probing results
     mutable StMutex               myEventMutex;   //!< lock for thread-safety
     double                        myDuration;     //!< active file duration in seconds
     double                        myPtsSeek;      //!< seeking target
@@ -494,8 +560,12 @@ class StVideo {
     StPlayEvent_t                 myPlayEvent;    //!< playback event
     double                        myTargetFps;
     volatile int                  myAudioDelayMSec;//!< audio/video sync delay
+    volatile float                myPlaybackRate; //!< playback rate
     volatile bool                 myIsBenchmark;
     volatile StImageFile::ImageType toSave;
+    volatile StImageFile::ImageType toExport;     //!< requested frames export
+    volatile int                  myExportStep;   //!< frames export step
+    volatile bool                 myToExportSideBySide; //!< pack exported stereo pairs into side-by-side images
     volatile bool                 toQuit;         //!< flag indicating that all working threads should be closed
     StCondition                   myQuitEvent;    //!< condition indicating that working thread has saved playback state to playlist
 
@@ -0,0 +1,362 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "StVideoFrameExporter.h"
+
+#include <StAV/StAVPacket.h>
+#include <StStrings/StLogger.h>
+
+namespace {
+
+    /**
+     * Format the path to the output image.
+     */
+    static StString formatOutputPath(const StString& theBase,
+                                     const size_t    theIndex,
+                                     const char*     theSuffix,
+                                     const char*     theExt) {
+        char aBuffer[32];
+        stsprintf(aBuffer, sizeof(aBuffer), "_%06u", (unsigned int )theIndex);
+        return theBase + aBuffer + theSuffix + "." + theExt;
+    }
+
+}
+
+StVideoFrameExporter::StVideoFrameExporter(const StHandle<StImageExportQueue>& theQueue)
+: myQueue(theQueue),
+  myToAbort(false) {
+    //
+}
+
+StVideoFrameExporter::~StVideoFrameExporter() {
+    abort();
+}
+
+void StVideoFrameExporter::abort() {
+    myToAbort = true;
+    if(!myThread.isNull()) {
+        myThread->wait();
+        myThread.nullify();
+    }
+    myToAbort = false;
+}
+
+void StVideoFrameExporter::start(const Params& theParams) {
+    abort();
+
+    StMutexAuto aLock(myMutex);
+    myParams = theParams;
+    myParams.Step = stMax(myParams.Step, 1);
+    myProgress = Progress();
+    myProgress.IsRunning = true;
+    myThread = new StThread(threadFunction, (void* )this, "StVideoFrameExporter");
+}
+
+StVideoFrameExporter::Progress StVideoFrameExporter::getProgress() const {
+    StMutexAuto aLock(myMutex);
+    return myProgress;
+}
+
+SV_THREAD_FUNCTION StVideoFrameExporter::threadFunction(void* theExporter) {
+    StVideoFrameExporter* anExporter = (StVideoFrameExporter* )theExporter;
+    anExporter->mainLoop();
+    return SV_THREAD_RETURN 0;
+}
+
+void StVideoFrameExporter::mainLoop() {
+    Params aParams;
+    {
+        StMutexAuto aLock(myMutex);
+        aParams = myParams;
+    }
+
+    Source aLeft, aRight;
+    const bool isStereo = !aParams.Right.isEmpty();
+    if(!openSource(aLeft, aParams.Left, aParams.From)
+    || (isStereo && !openSource(aRight, aParams.Right, aParams.From))) {
+        closeSource(aLeft);
+        closeSource(aRight);
+        myQueue->signals.onError(StString("Unable to open video for frames export"));
+        StMutexAuto aLock(myMutex);
+        myProgress.IsRunning = false;
+        return;
+    }
+
+    double aTo = aParams.To;
+    if(aTo <= aParams.From) {
+        aTo = aLeft.FormatCtx->duration != stAV::NOPTS_VALUE
+            ? stAV::unitsToSeconds(aLeft.FormatCtx->duration)
+            : 0.0;
+    }
+
+    const bool toPack = isStereo && aParams.ToSideBySide;
+    const char* anExt = aParams.ImageType == StImageFile::ST_TYPE_JPEG
+                      ? (toPack ? "jps" : "jpg")
+                      : (toPack ? "pns" : "png");
+    size_t aFrameIter = 0;
+    size_t aNbQueued  = 0;
+
+    // each source has been seeked to its own key frame, so drop preceding frames separately
+    double aPtsL = 0.0, aPtsR = 0.0;
+    bool hasFrame = decodeFrom(aLeft, aParams.From, aPtsL)
+                && (!isStereo || decodeFrom(aRight, aParams.From, aPtsR));
+    const double aTolerance = isStereo ? getHalfFrameDuration(aRight) : 0.0;
+    for(; hasFrame && !myToAbort; hasFrame = decodeNext(aLeft, aPtsL)) {
+        if(aTo > aParams.From
+        && aPtsL > aTo) {
+            break;
+        }
+
+        if(isStereo) {
+            // pair views by presentation time rather than by decoding order
+            while(hasFrame && aPtsR < aPtsL - aTolerance) {
+                hasFrame = decodeNext(aRight, aPtsR);
+            }
+            if(!hasFrame) {
+                break;
+            } else if(aPtsR > aPtsL + aTolerance) {
+                // no matching frame in the right view
+                continue;
+            }
+        }
+
+        const size_t aFrameIndex = aFrameIter++;
+        if(aFrameIndex % size_t(aParams.Step) != 0) {
+            continue;
+        }
+
+        StImageExportQueue::Job aJob;
+        aJob.SaveParams.SaveImageType = aParams.ImageType;
+        aJob.SeparationDx = aParams.SeparationDx;
+        aJob.SeparationDy = aParams.SeparationDy;
+        aJob.Left = convertFrame(aLeft);
+        if(isStereo) {
+            aJob.Right = convertFrame(aRight);
+            if(aParams.ToSwapLR) {
+                std::swap(aJob.Left, aJob.Right);
+            }
+        }
+        if(aJob.Left.isNull()
+        || (isStereo && aJob.Right.isNull())) {
+            continue;
+        }
+
+        if(toPack) {
+            aJob.SaveParams.StereoFormat = StFormat_SideBySide_RL;
+            aJob.Path = formatOutputPath(aParams.OutputBase, aFrameIndex, "", anExt);
+            myQueue->push(aJob);
+        } else if(isStereo) {
+            StImageExportQueue::Job aJobR = aJob;
+            aJobR.Left = aJob.Right;
+            aJobR.Right.nullify();
+            aJobR.Path = formatOutputPath(aParams.OutputBase, aFrameIndex, "-R", anExt);
+            aJob.Right.nullify();
+            aJob.Path = formatOutputPath(aParams.OutputBase, aFrameIndex, "-L", anExt);
+            myQueue->push(aJob);
+            myQueue->push(aJobR);
+        } else {
+            aJob.Path = formatOutputPath(aParams.OutputBase, aFrameIndex, "", anExt);
+            myQueue->push(aJob);
+        }
+
+        ++aNbQueued;
+        StMutexAuto aLock(myMutex);
+        myProgress.NbFrames = aNbQueued;
+        myProgress.Ratio    = aTo > aParams.From ? stMin((aPtsL - aParams.From) / (aTo - aParams.From), 1.0) : 0.0;
+    }
+
+    closeSource(aLeft);
+    closeSource(aRight);
+    ST_DEBUG_LOG(StString("StVideoFrameExporter, ") + int(aNbQueued) + " frames queued for export");
+
+    StMutexAuto aLock(myMutex);
+    myProgress.IsRunning = false;
+    if(!myToAbort) {
+        myProgress.Ratio = 1.0;
+    }
+}
+
+bool StVideoFrameExporter::openSource(Source&         theSource,
+                                      const StString& thePath,
+                                      const double    theFrom) {
+    closeSource(theSource);
+    if(thePath.isEmpty()
+    || avformat_open_input(&theSource.FormatCtx, thePath.toCString(), NULL, NULL) != 0) {
+        return false;
+    }
+    if(avformat_find_stream_info(theSource.FormatCtx, NULL) < 0) {
+        closeSource(theSource);
+        return false;
+    }
+
+    for(unsigned int aStreamIter = 0; aStreamIter < theSource.FormatCtx->nb_streams; ++aStreamIter) {
+        AVStream* aStream = theSource.FormatCtx->streams[aStreamIter];
+        if(theSource.StreamId == -1
+        && stAV::getCodecType(aStream) == AVMEDIA_TYPE_VIDEO
+        && !stAV::isAttachedPicture(aStream)) {
+            theSource.StreamId = (int )aStreamIter;
+        } else {
+            // do not demux other streams
+            aStream->discard = AVDISCARD_ALL;
+        }
+    }
+    if(theSource.StreamId == -1) {
+        closeSource(theSource);
+        return false;
+    }
+
+    const AVCodecParameters* aCodecPar = theSource.FormatCtx->streams[theSource.StreamId]->codecpar;
+    const AVCodec* aCodec = avcodec_find_decoder(aCodecPar->codec_id);
+    if(aCodec == NULL) {
+        closeSource(theSource);
+        return false;
+    }
+
+    theSource.CodecCtx = avcodec_alloc_context3(aCodec);
+    if(theSource.CodecCtx == NULL
+    || avcodec_parameters_to_context(theSource.CodecCtx, aCodecPar) < 0) {
+        closeSource(theSource);
+        return false;
+    }
+
+    // leave some CPU cores to the playback and encoding threads
+    theSource.CodecCtx->thread_count = stMax(1, StThread::countLogicalProcessors() / 2);
+    if(avcodec_open2(theSource.CodecCtx, aCodec, NULL) < 0) {
+        closeSource(theSource);
+        return false;
+    }
+
+    if(theFrom > 0.0) {
+        AVStream* aStream = theSource.FormatCtx->streams[theSource.StreamId];
+        const double aStartPts = aStream->start_time != stAV::NOPTS_VALUE
+                               ? stAV::unitsToSeconds(aStream, aStream->start_time)
+                               : 0.0;
+        av_seek_frame(theSource.FormatCtx, theSource.StreamId,
+                      stAV::secondsToUnits(aStream, theFrom + aStartPts), AVSEEK_FLAG_BACKWARD);
+    }
+    return true;
+}
+
+void StVideoFrameExporter::closeSource(Source& theSource) {
+    theSource.Frame.reset();
+    if(theSource.CodecCtx != NULL) {
+        avcodec_free_context(&theSource.CodecCtx);
+    }
+    if(theSource.FormatCtx != NULL) {
+        avformat_close_input(&theSource.FormatCtx);
+    }
+    if(theSource.ScaleCtx != NULL) {
+        sws_freeContext(theSource.ScaleCtx);
+        theSource.ScaleCtx = NULL;
+    }
+    theSource.StreamId = -1;
+    theSource.IsEof    = false;
+}
+
+bool StVideoFrameExporter::decodeFrom(Source&      theSource,
+                                      const double theFrom,
+                                      double&      thePts) {
+    do {
+        if(!decodeNext(theSource, thePts)) {
+            return false;
+        }
+    } while(thePts < theFrom);
+    return true;
+}
+
+double StVideoFrameExporter::getHalfFrameDuration(const Source& theSource) {
+    const AVRational aRate = theSource.FormatCtx->streams[theSource.StreamId]->avg_frame_rate;
+    return aRate.num > 0 && aRate.den > 0
+         ? 0.5 * double(aRate.den) / double(aRate.num)
+         : 0.02;
+}
+
+bool StVideoFrameExporter::decodeNext(Source& theSource,
+                                      double& thePts) {
+    theSource.Frame.reset();
+    StAVPacket aPacket;
+    for(;;) {
+        if(myToAbort) {
+            return false;
+        }
+
+        const int aResult = avcodec_receive_frame(theSource.CodecCtx, theSource.Frame.Frame);
+        if(aResult == 0) {
+            break;
+        } else if(aResult != AVERROR(EAGAIN)
+               || theSource.IsEof) {
+            return false;
+        }
+
+        if(av_read_frame(theSource.FormatCtx, aPacket.getAVpkt()) < 0) {
+            // flush decoder to retrieve delayed frames
+            theSource.IsEof = true;
+            avcodec_send_packet(theSource.CodecCtx, NULL);
+            continue;
+        }
+        if(aPacket.getStreamId() == theSource.StreamId) {
+            avcodec_send_packet(theSource.CodecCtx, aPacket.getAVpkt());
+        }
+        aPacket.free();
+    }
+
+    AVStream* aStream = theSource.FormatCtx->streams[theSource.StreamId];
+    const int64_t aPts = theSource.Frame.getBestEffortTimestamp();
+    const double aStartPts = aStream->start_time != stAV::NOPTS_VALUE
+                           ? stAV::unitsToSeconds(aStream, aStream->start_time)
+                           : 0.0;
+    thePts = aPts != stAV::NOPTS_VALUE
+           ? stAV::unitsToSeconds(aStream, aPts) - aStartPts
+           : 0.0;
+    return true;
+}
+
+StHandle<StImage> StVideoFrameExporter::convertFrame(Source& theSource) {
+    const int aSizeX = theSource.Frame.Frame->width;
+    const int aSizeY = theSource.Frame.Frame->height;
+    if(aSizeX < 1
+    || aSizeY < 1) {
+        return StHandle<StImage>();
+    }
+
+    StHandle<StImage> anImage = new StImage();
+    anImage->setColorModelPacked(StImagePlane::ImgRGB);
+    theSource.ScaleCtx = sws_getCachedContext(theSource.ScaleCtx,
+                                              aSizeX, aSizeY, (AVPixelFormat )theSource.Frame.Frame->format,
+                                              aSizeX, aSizeY, stAV::PIX_FMT::RGB24,
+                                              SWS_BICUBIC, NULL, NULL, NULL);
+    if(theSource.ScaleCtx == NULL
+    || !anImage->changePlane(0).initTrash(StImagePlane::ImgRGB, size_t(aSizeX), size_t(aSizeY))) {
+        return StHandle<StImage>();
+    }
+
+    const AVRational aSAR = theSource.Frame.Frame->sample_aspect_ratio;
+    if(aSAR.num > 0
+    && aSAR.den > 0) {
+        anImage->setPixelRatio(float(aSAR.num) / float(aSAR.den));
+    }
+
+    uint8_t* aDstData[4]     = { anImage->changePlane(0).changeData(), NULL, NULL, NULL };
+    int      aDstLineSize[4] = { (int )anImage->getPlane(0).getSizeRowBytes(), 0, 0, 0 };
+    sws_scale(theSource.ScaleCtx,
+              theSource.Frame.Frame->data, theSource.Frame.Frame->linesize,
+              0, aSizeY,
+              aDstData, aDstLineSize);
+    return anImage;
+}
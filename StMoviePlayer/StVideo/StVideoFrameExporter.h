@@ -0,0 +1,184 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __StVideoFrameExporter_h_
+#define __StVideoFrameExporter_h_
+
+#include <StAV/StAVFrame.h>
+#include <StImage/StImageExportQueue.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThread.h>
+
+/**
+ * Batch extraction of video frames into an image sequence.
+ * Uses its own demuxer and decoder working at full resolution so that playback is not disturbed,
+ * while encoding is delegated to StImageExportQueue.
+ * Stereo pair stored in two files is paired by presentation time and written either as side-by-side images
+ * or as separate images with -L / -R suffixes.
+ */
+class StVideoFrameExporter {
+
+        public:
+
+    /**
+     * Export parameters.
+     */
+    struct Params {
+        StString               Left;           //!< video file (or the left view)
+        StString               Right;          //!< optional video file with the right view
+        StString               OutputBase;     //!< output path without extension, frame number is appended
+        StImageFile::ImageType ImageType;      //!< output image format
+        double                 From;           //!< first position in seconds
+        double                 To;             //!< last position in seconds, 0 or negative means end of file
+        int                    Step;           //!< export every N-th frame
+        bool                   ToSideBySide;   //!< pack stereo pair into single side-by-side image
+        bool                   ToSwapLR;       //!< swap views
+        int                    SeparationDx;   //!< horizontal separation for side-by-side packing
+        int                    SeparationDy;   //!< vertical   separation for side-by-side packing
+
+        Params()
+        : ImageType(StImageFile::ST_TYPE_PNG),
+          From(0.0),
+          To(0.0),
+          Step(1),
+          ToSideBySide(true),
+          ToSwapLR(false),
+          SeparationDx(0),
+          SeparationDy(0) {}
+    };
+
+    /**
+     * Export progress.
+     */
+    struct Progress {
+        double Ratio;       //!< processed part of the range within 0..1
+        size_t NbFrames;    //!< number of queued frames
+        bool   IsRunning;   //!< export is in progress
+
+        Progress() : Ratio(0.0), NbFrames(0), IsRunning(false) {}
+    };
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theQueue export queue encoding extracted frames
+     */
+    ST_LOCAL StVideoFrameExporter(const StHandle<StImageExportQueue>& theQueue);
+
+    /**
+     * Destructor, aborts export.
+     */
+    ST_LOCAL ~StVideoFrameExporter();
+
+    /**
+     * Start export, aborting the previous one.
+     */
+    ST_LOCAL void start(const Params& theParams);
+
+    /**
+     * Abort export.
+     */
+    ST_LOCAL void abort();
+
+    /**
+     * Return export progress.
+     */
+    ST_LOCAL Progress getProgress() const;
+
+        private:
+
+    /**
+     * Opened video stream.
+     */
+    struct Source {
+        AVFormatContext* FormatCtx; //!< demuxer context
+        AVCodecContext*  CodecCtx;  //!< decoder context
+        SwsContext*      ScaleCtx;  //!< conversion context
+        StAVFrame        Frame;     //!< decoded frame
+        int              StreamId;  //!< video stream index
+        bool             IsEof;     //!< end of stream has been reached
+
+        Source() : FormatCtx(NULL), CodecCtx(NULL), ScaleCtx(NULL), StreamId(-1), IsEof(false) {}
+    };
+
+        private:
+
+    /**
+     * Working thread loop.
+     */
+    ST_LOCAL void mainLoop();
+
+    /**
+     * Working thread callback.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION threadFunction(void* theExporter);
+
+    /**
+     * Open the file and video decoder, and seek to specified position.
+     */
+    ST_LOCAL static bool openSource(Source&         theSource,
+                                    const StString& thePath,
+                                    const double    theFrom);
+
+    /**
+     * Close the file.
+     */
+    ST_LOCAL static void closeSource(Source& theSource);
+
+    /**
+     * Decode next frame.
+     * @param thePts decoded frame position in seconds
+     * @return false on end of stream or error
+     */
+    ST_LOCAL bool decodeNext(Source& theSource,
+                             double& thePts);
+
+    /**
+     * Decode frames until the one at or after specified position.
+     * @param theFrom position in seconds
+     * @param thePts  decoded frame position in seconds
+     * @return false on end of stream or error
+     */
+    ST_LOCAL bool decodeFrom(Source&      theSource,
+                             const double theFrom,
+                             double&      thePts);
+
+    /**
+     * Return half of the frame duration in seconds, used as tolerance for pairing views.
+     */
+    ST_LOCAL static double getHalfFrameDuration(const Source& theSource);
+
+    /**
+     * Convert decoded frame into new RGB image.
+     */
+    ST_LOCAL static StHandle<StImage> convertFrame(Source& theSource);
+
+        private:
+
+    StHandle<StImageExportQueue> myQueue;    //!< export queue
+    StHandle<StThread>           myThread;   //!< working thread
+    mutable StMutex              myMutex;    //!< lock for progress
+    Params                       myParams;   //!< active export parameters
+    Progress                     myProgress; //!< export progress
+    volatile bool                myToAbort;  //!< flag to abort export
+
+};
+
+#endif // __StVideoFrameExporter_h_
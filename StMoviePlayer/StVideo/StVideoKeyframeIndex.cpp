@@ -0,0 +1,134 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "StVideoKeyframeIndex.h"
+
+#include <algorithm>
+
+namespace {
+
+    /**
+     * Timestamps closer than this tolerance are considered to be the same key frame.
+     */
+    static const double THE_PTS_TOLERANCE = 0.001;
+
+    /**
+     * Maximum distance to the nearest key frame to consider index being populated around the position;
+     * otherwise index might have a gap at unvisited part of the file.
+     */
+    static const double THE_GAP_MAX = 10.0;
+
+}
+
+StVideoKeyframeIndex::StVideoKeyframeIndex()
+: myNbDemuxerEntries(0) {
+    //
+}
+
+void StVideoKeyframeIndex::clear() {
+    StMutexAuto aLock(myMutex);
+    myKeyframes.clear();
+    myNbDemuxerEntries = 0;
+}
+
+size_t StVideoKeyframeIndex::size() const {
+    StMutexAuto aLock(myMutex);
+    return myKeyframes.size();
+}
+
+void StVideoKeyframeIndex::insert(const double thePts) {
+    std::vector<double>::iterator anIter = std::lower_bound(myKeyframes.begin(), myKeyframes.end(), thePts - THE_PTS_TOLERANCE);
+    if(anIter != myKeyframes.end()
+    && *anIter <= thePts + THE_PTS_TOLERANCE) {
+        return;
+    }
+    myKeyframes.insert(anIter, thePts);
+}
+
+void StVideoKeyframeIndex::fillFromStream(const AVStream* theStream) {
+    if(theStream == NULL) {
+        return;
+    }
+
+    const double aStartPts = theStream->start_time != stAV::NOPTS_VALUE
+                           ? stAV::unitsToSeconds(theStream, theStream->start_time)
+                           : 0.0;
+    StMutexAuto aLock(myMutex);
+#if(LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100))
+    const int aNbEntries = avformat_index_get_entries_count(theStream);
+#else
+    const int aNbEntries = theStream->nb_index_entries;
+#endif
+    if(aNbEntries == myNbDemuxerEntries) {
+        return;
+    }
+
+    for(int anEntryIter = 0; anEntryIter < aNbEntries; ++anEntryIter) {
+    #if(LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100))
+        const AVIndexEntry* anEntry = avformat_index_get_entry((AVStream* )theStream, anEntryIter);
+    #else
+        const AVIndexEntry* anEntry = &theStream->index_entries[anEntryIter];
+    #endif
+        if(anEntry != NULL
+        && (anEntry->flags & AVINDEX_KEYFRAME) != 0
+        && anEntry->timestamp != stAV::NOPTS_VALUE) {
+            insert(stAV::unitsToSeconds(theStream, anEntry->timestamp) - aStartPts);
+        }
+    }
+    myNbDemuxerEntries = aNbEntries;
+}
+
+void StVideoKeyframeIndex::addPacket(const AVStream* theStream,
+                                     const AVPacket* thePacket) {
+    if(theStream == NULL
+    || thePacket == NULL
+    || (thePacket->flags & AV_PKT_FLAG_KEY) == 0) {
+        return;
+    }
+
+    const int64_t aTime = thePacket->pts != stAV::NOPTS_VALUE ? thePacket->pts : thePacket->dts;
+    if(aTime == stAV::NOPTS_VALUE) {
+        return;
+    }
+
+    const double aStartPts = theStream->start_time != stAV::NOPTS_VALUE
+                           ? stAV::unitsToSeconds(theStream, theStream->start_time)
+                           : 0.0;
+    StMutexAuto aLock(myMutex);
+    insert(stAV::unitsToSeconds(theStream, aTime) - aStartPts);
+}
+
+bool StVideoKeyframeIndex::findNearest(const double thePts,
+                                       double&      theKeyPts) const {
+    StMutexAuto aLock(myMutex);
+    if(myKeyframes.empty()) {
+        return false;
+    }
+
+    std::vector<double>::const_iterator aNext = std::lower_bound(myKeyframes.begin(), myKeyframes.end(), thePts);
+    if(aNext == myKeyframes.end()) {
+        theKeyPts = myKeyframes.back();
+    } else if(aNext == myKeyframes.begin()) {
+        theKeyPts = *aNext;
+    } else {
+        const double aPrev = *(aNext - 1);
+        theKeyPts = (thePts - aPrev) <= (*aNext - thePts) ? aPrev : *aNext;
+    }
+    return std::abs(theKeyPts - thePts) <= THE_GAP_MAX;
+}
@@ -0,0 +1,90 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __StVideoKeyframeIndex_h_
+#define __StVideoKeyframeIndex_h_
+
+#include <StAV/stAV.h>
+#include <StThreads/StMutex.h>
+
+#include <vector>
+
+/**
+ * Lazily populated index of key frames within video stream.
+ * The index is filled from demuxer index (when available)
+ * and complemented by key frame packets passed through demuxer during playback.
+ * Timestamps are stored in seconds relative to the stream start, as used for seeking.
+ */
+class StVideoKeyframeIndex {
+
+        public:
+
+    /**
+     * Empty constructor.
+     */
+    ST_LOCAL StVideoKeyframeIndex();
+
+    /**
+     * Clear the index.
+     */
+    ST_LOCAL void clear();
+
+    /**
+     * Return number of known key frames.
+     */
+    ST_LOCAL size_t size() const;
+
+    /**
+     * Import new entries of the demuxer index.
+     */
+    ST_LOCAL void fillFromStream(const AVStream* theStream);
+
+    /**
+     * Register key frame packet.
+     * @param theStream stream of the packet
+     * @param thePacket key frame packet
+     */
+    ST_LOCAL void addPacket(const AVStream* theStream,
+                            const AVPacket* thePacket);
+
+    /**
+     * Find the key frame nearest to specified position.
+     * @param thePts    position in seconds
+     * @param theKeyPts found key frame position
+     * @return false if index has no key frames close enough to specified position
+     */
+    ST_LOCAL bool findNearest(const double thePts,
+                              double&      theKeyPts) const;
+
+        private:
+
+    /**
+     * Insert timestamp into sorted list (should be called under lock).
+     */
+    ST_LOCAL void insert(const double thePts);
+
+        private:
+
+    mutable StMutex     myMutex;            //!< lock for thread-safety
+    std::vector<double> myKeyframes;        //!< sorted list of key frames timestamps in seconds
+    int                 myNbDemuxerEntries; //!< number of demuxer index entries already imported
+
+};
+
+#endif // __StVideoKeyframeIndex_h_
@@ -0,0 +1,302 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "StVideoPreview.h"
+
+#include <StAV/StAVPacket.h>
+#include <StFile/StFileNode.h>
+
+namespace {
+
+    /**
+     * Maximum number of packets to read looking for the key frame.
+     */
+    static const int THE_PACKETS_MAX = 256;
+
+}
+
+StVideoPreview::StVideoPreview(const int theSizeMax)
+: myEvent(false),
+  myRequestPts(0.0),
+  myHasRequest(false),
+  myHasResult(false),
+  myFormatCtx(NULL),
+  myCodecCtx(NULL),
+  myScaleCtx(NULL),
+  myStreamId(-1),
+  mySizeMax(stMax(theSizeMax, 1)),
+  myToQuit(false) {
+    //
+}
+
+StVideoPreview::~StVideoPreview() {
+    {
+        StMutexAuto aLock(myMutex);
+        myToQuit = true;
+        myEvent.set();
+    }
+    if(!myThread.isNull()) {
+        myThread->wait();
+        myThread.nullify();
+    }
+    closeSource();
+}
+
+void StVideoPreview::setSource(const StString& thePath) {
+    StMutexAuto aLock(myMutex);
+    mySourcePath = thePath;
+    myHasRequest = false;
+    myHasResult  = false;
+    myResult     = Result();
+}
+
+void StVideoPreview::request(const double thePts) {
+    StMutexAuto aLock(myMutex);
+    if(mySourcePath.isEmpty()) {
+        return;
+    }
+
+    // thread is created on first use, since previews are not needed during regular playback
+    if(myThread.isNull()) {
+        myThread = new StThread(threadFunction, (void* )this, "StVideoPreview");
+    }
+    myRequestPts = thePts;
+    myHasRequest = true;
+    myEvent.set();
+}
+
+bool StVideoPreview::popResult(Result& theResult) {
+    StMutexAuto aLock(myMutex);
+    if(!myHasResult) {
+        return false;
+    }
+    theResult   = myResult;
+    myResult    = Result();
+    myHasResult = false;
+    return true;
+}
+
+bool StVideoPreview::isQuitRequested() {
+    StMutexAuto aLock(myMutex);
+    return myToQuit;
+}
+
+SV_THREAD_FUNCTION StVideoPreview::threadFunction(void* thePreview) {
+    StVideoPreview* aPreview = (StVideoPreview* )thePreview;
+    aPreview->mainLoop();
+    return SV_THREAD_RETURN 0;
+}
+
+void StVideoPreview::mainLoop() {
+    StThread::setCurrentThreadLowPriority();
+    for(;;) {
+        myEvent.wait();
+
+        StString aPath;
+        double   aPts = 0.0;
+        {
+            StMutexAuto aLock(myMutex);
+            if(myToQuit) {
+                break;
+            }
+            if(!myHasRequest) {
+                myEvent.reset();
+                continue;
+            }
+            aPath = mySourcePath;
+            aPts  = myRequestPts;
+            myHasRequest = false;
+        }
+
+        if(aPath != myOpenedPath
+        && aPath != myFailedPath) {
+            // do not try opening unsupported file again on every hovered position
+            myFailedPath.clear();
+            if(!openSource(aPath)) {
+                myFailedPath = aPath;
+            }
+        }
+
+        Result aResult;
+        aResult.Pts = aPts;
+        if(myCodecCtx != NULL) {
+            aResult.Image = decodeAt(aPts);
+        }
+        if(aResult.Image.isNull()) {
+            continue;
+        }
+
+        StMutexAuto aLock(myMutex);
+        if(aPath == mySourcePath) {
+            myResult    = aResult;
+            myHasResult = true;
+        }
+    }
+    closeSource();
+}
+
+bool StVideoPreview::openSource(const StString& thePath) {
+    closeSource();
+    myOpenedPath = thePath;
+
+    // previews of remote streams would compete with playback for bandwidth
+    if(thePath.isEmpty()
+    || StFileNode::isRemoteProtocolPath(thePath)
+    || avformat_open_input(&myFormatCtx, thePath.toCString(), NULL, NULL) != 0) {
+        return false;
+    }
+    if(avformat_find_stream_info(myFormatCtx, NULL) < 0) {
+        closeSource();
+        return false;
+    }
+
+    for(unsigned int aStreamIter = 0; aStreamIter < myFormatCtx->nb_streams; ++aStreamIter) {
+        AVStream* aStream = myFormatCtx->streams[aStreamIter];
+        if(myStreamId == -1
+        && stAV::getCodecType(aStream) == AVMEDIA_TYPE_VIDEO
+        && !stAV::isAttachedPicture(aStream)) {
+            myStreamId = (int )aStreamIter;
+        } else {
+            // do not demux other streams
+            aStream->discard = AVDISCARD_ALL;
+        }
+    }
+    if(myStreamId == -1) {
+        closeSource();
+        return false;
+    }
+
+    const AVCodecParameters* aCodecPar = myFormatCtx->streams[myStreamId]->codecpar;
+    const AVCodec* aCodec = avcodec_find_decoder(aCodecPar->codec_id);
+    if(aCodec == NULL) {
+        closeSource();
+        return false;
+    }
+
+    myCodecCtx = avcodec_alloc_context3(aCodec);
+    if(myCodecCtx == NULL
+    || avcodec_parameters_to_context(myCodecCtx, aCodecPar) < 0) {
+        closeSource();
+        return false;
+    }
+
+    // single-threaded decoder skipping all but key frames, at reduced resolution when supported
+    myCodecCtx->thread_count = 1;
+    myCodecCtx->skip_frame   = AVDISCARD_NONKEY;
+    int aLowRes = 0;
+    while(aLowRes < (int )aCodec->max_lowres
+       && (aCodecPar->width  >> (aLowRes + 1)) >= mySizeMax
+       && (aCodecPar->height >> (aLowRes + 1)) >= mySizeMax) {
+        ++aLowRes;
+    }
+    myCodecCtx->lowres = aLowRes;
+    if(avcodec_open2(myCodecCtx, aCodec, NULL) < 0) {
+        closeSource();
+        return false;
+    }
+    return true;
+}
+
+void StVideoPreview::closeSource() {
+    myFrame.reset();
+    if(myCodecCtx != NULL) {
+        avcodec_free_context(&myCodecCtx);
+    }
+    if(myFormatCtx != NULL) {
+        avformat_close_input(&myFormatCtx);
+    }
+    if(myScaleCtx != NULL) {
+        sws_freeContext(myScaleCtx);
+        myScaleCtx = NULL;
+    }
+    myStreamId = -1;
+    myOpenedPath.clear();
+}
+
+StHandle<StImage> StVideoPreview::decodeAt(const double thePts) {
+    AVStream* aStream = myFormatCtx->streams[myStreamId];
+    const double aStartPts = aStream->start_time != stAV::NOPTS_VALUE
+                           ? stAV::unitsToSeconds(aStream, aStream->start_time)
+                           : 0.0;
+    if(av_seek_frame(myFormatCtx, myStreamId, stAV::secondsToUnits(aStream, thePts + aStartPts), AVSEEK_FLAG_BACKWARD) < 0) {
+        return StHandle<StImage>();
+    }
+    avcodec_flush_buffers(myCodecCtx);
+
+    StAVPacket aPacket;
+    bool isDecoded = false;
+    for(int aPacketIter = 0; aPacketIter < THE_PACKETS_MAX && !isDecoded && !isQuitRequested(); ++aPacketIter) {
+        if(av_read_frame(myFormatCtx, aPacket.getAVpkt()) < 0) {
+            break;
+        }
+        if(aPacket.getStreamId() != myStreamId) {
+            aPacket.free();
+            continue;
+        }
+
+        const int aResult = avcodec_send_packet(myCodecCtx, aPacket.getAVpkt());
+        aPacket.free();
+        if(aResult == 0 || aResult == AVERROR(EAGAIN)) {
+            isDecoded = avcodec_receive_frame(myCodecCtx, myFrame.Frame) == 0;
+        }
+    }
+    if(!isDecoded) {
+        // video decoders may delay output - flush decoder to retrieve the frame
+        avcodec_send_packet(myCodecCtx, NULL);
+        isDecoded = avcodec_receive_frame(myCodecCtx, myFrame.Frame) == 0;
+    }
+
+    const int aSrcSizeX = myFrame.Frame->width;
+    const int aSrcSizeY = myFrame.Frame->height;
+    if(!isDecoded
+    || aSrcSizeX < 1
+    || aSrcSizeY < 1) {
+        myFrame.reset();
+        return StHandle<StImage>();
+    }
+
+    size_t aSizeX = size_t(mySizeMax);
+    size_t aSizeY = size_t(mySizeMax);
+    if(aSrcSizeX >= aSrcSizeY) {
+        aSizeY = stMax(size_t(aSrcSizeY) * size_t(mySizeMax) / size_t(aSrcSizeX), size_t(1));
+    } else {
+        aSizeX = stMax(size_t(aSrcSizeX) * size_t(mySizeMax) / size_t(aSrcSizeY), size_t(1));
+    }
+
+    StHandle<StImage> anImage = new StImage();
+    anImage->setColorModelPacked(StImagePlane::ImgRGB);
+    myScaleCtx = sws_getCachedContext(myScaleCtx,
+                                      aSrcSizeX, aSrcSizeY, (AVPixelFormat )myFrame.Frame->format,
+                                      int(aSizeX), int(aSizeY), stAV::PIX_FMT::RGB24,
+                                      SWS_FAST_BILINEAR, NULL, NULL, NULL);
+    if(myScaleCtx == NULL
+    || !anImage->changePlane(0).initTrash(StImagePlane::ImgRGB, aSizeX, aSizeY)) {
+        myFrame.reset();
+        return StHandle<StImage>();
+    }
+
+    uint8_t* aDstData[4]     = { anImage->changePlane(0).changeData(), NULL, NULL, NULL };
+    int      aDstLineSize[4] = { (int )anImage->getPlane(0).getSizeRowBytes(), 0, 0, 0 };
+    sws_scale(myScaleCtx,
+              myFrame.Frame->data, myFrame.Frame->linesize,
+              0, aSrcSizeY,
+              aDstData, aDstLineSize);
+    myFrame.reset();
+    return anImage;
+}
@@ -0,0 +1,133 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __StVideoPreview_h_
+#define __StVideoPreview_h_
+
+#include <StAV/StAVFrame.h>
+#include <StImage/StImage.h>
+#include <StThreads/StCondition.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThread.h>
+
+/**
+ * Lightweight decoder of preview frames for scrubbing along the seek bar.
+ * Uses its own demuxer and single-threaded decoder, working at reduced resolution
+ * and decoding only key frames, so that playback is not disturbed.
+ * Only the latest request is processed, older ones are discarded.
+ */
+class StVideoPreview {
+
+        public:
+
+    /**
+     * Decoded preview.
+     */
+    struct Result {
+        StHandle<StImage> Image; //!< preview in RGB format
+        double            Pts;   //!< requested position in seconds
+
+        Result() : Pts(0.0) {}
+    };
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theSizeMax maximum preview dimension in pixels
+     */
+    ST_LOCAL StVideoPreview(const int theSizeMax);
+
+    /**
+     * Destructor, stops working thread.
+     */
+    ST_LOCAL ~StVideoPreview();
+
+    /**
+     * Set the video file to preview; empty path disables previews.
+     */
+    ST_LOCAL void setSource(const StString& thePath);
+
+    /**
+     * Request preview at specified position, replacing not yet processed request.
+     */
+    ST_LOCAL void request(const double thePts);
+
+    /**
+     * Retrieve decoded preview.
+     * @return false if there is no new result
+     */
+    ST_LOCAL bool popResult(Result& theResult);
+
+        private:
+
+    /**
+     * Working thread loop.
+     */
+    ST_LOCAL void mainLoop();
+
+    /**
+     * Working thread callback.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION threadFunction(void* thePreview);
+
+    /**
+     * Return TRUE if working thread should be stopped.
+     */
+    ST_LOCAL bool isQuitRequested();
+
+    /**
+     * Open the file and video decoder.
+     */
+    ST_LOCAL bool openSource(const StString& thePath);
+
+    /**
+     * Close the file.
+     */
+    ST_LOCAL void closeSource();
+
+    /**
+     * Decode the key frame preceding specified position and scale it down.
+     */
+    ST_LOCAL StHandle<StImage> decodeAt(const double thePts);
+
+        private:
+
+    StHandle<StThread> myThread;      //!< working thread
+    StMutex            myMutex;       //!< lock for request and result
+    StCondition        myEvent;       //!< event signaling new request
+    StString           mySourcePath;  //!< requested source
+    double             myRequestPts;  //!< requested position
+    bool               myHasRequest;  //!< flag indicating new request
+    Result             myResult;      //!< last decoded preview
+    bool               myHasResult;   //!< flag indicating new result
+
+    StString           myOpenedPath;  //!< currently opened file (working thread)
+    StString           myFailedPath;  //!< last file which could not be opened (working thread)
+    AVFormatContext*   myFormatCtx;   //!< demuxer context
+    AVCodecContext*    myCodecCtx;    //!< decoder context
+    SwsContext*        myScaleCtx;    //!< scaling context
+    StAVFrame          myFrame;       //!< decoded frame
+    int                myStreamId;    //!< video stream index
+    int                mySizeMax;     //!< maximum preview dimension
+    volatile bool      myToQuit;      //!< flag to stop working thread
+
+};
+
+#endif // __StVideoPreview_h_
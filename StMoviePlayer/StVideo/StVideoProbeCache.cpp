@@ -0,0 +1,240 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StVideoProbeCache.h"
+
+#include <StFile/StFileNode.h>
+#include <StFile/StRawFile.h>
+
+#include <cstdlib>
+
+namespace {
+
+    /**
+     * Maximum number of remembered files.
+     */
+    static const size_t THE_ENTRIES_MAX = 1024;
+
+    /**
+     * Cache file name.
+     */
+    static const char THE_CACHE_FILE[] = "probe.cache";
+
+}
+
+StVideoProbeCache::StVideoProbeCache(const StString& theCacheFolder)
+: myStamp(0),
+  myIsLoaded(false),
+  myIsDirty(false) {
+    if(!theCacheFolder.isEmpty()) {
+        myFilePath = theCacheFolder;
+        if(!myFilePath.isEndsWith(SYS_FS_SPLITTER)) {
+            myFilePath += StString(SYS_FS_SPLITTER);
+        }
+        myFilePath += THE_CACHE_FILE;
+    }
+}
+
+StVideoProbeCache::~StVideoProbeCache() {
+    flush();
+}
+
+StString StVideoProbeCache::getFileKey(const StString& thePath) {
+    int64_t aSize = 0, aModifTime = 0;
+    if(StFileNode::isRemoteProtocolPath(thePath)
+    || thePath.isContains('\t')
+    || thePath.isContains('\n')
+    || !StFileNode::getFileInfo(thePath, aSize, aModifTime)) {
+        return StString();
+    }
+    return thePath + "|" + aSize + "|" + aModifTime;
+}
+
+bool StVideoProbeCache::find(const StString& theKey,
+                             Entry&          theEntry) {
+    if(theKey.isEmpty()
+    || myFilePath.isEmpty()) {
+        return false;
+    }
+
+    load();
+    std::map<StString, Entry>::iterator anIter = myEntries.find(theKey);
+    if(anIter == myEntries.end()) {
+        return false;
+    }
+    anIter->second.Stamp = ++myStamp;
+    myIsDirty = true;
+    theEntry = anIter->second;
+    return true;
+}
+
+void StVideoProbeCache::add(const StString&        theKey,
+                            const AVFormatContext* theFormatCtx) {
+    if(theKey.isEmpty()
+    || myFilePath.isEmpty()
+    || theFormatCtx == NULL
+    || theFormatCtx->iformat == NULL
+    || theFormatCtx->iformat->name == NULL) {
+        return;
+    }
+
+    load();
+    Entry anEntry;
+    // demuxer name might be a comma-separated list of aliases
+    anEntry.Format = theFormatCtx->iformat->name;
+    for(StUtf8Iter anIter = anEntry.Format.iterator(); *anIter != 0; ++anIter) {
+        if(*anIter == ',') {
+            anEntry.Format = anEntry.Format.subString(0, anIter.getIndex());
+            break;
+        }
+    }
+    anEntry.Streams  = formatStreams(theFormatCtx);
+    anEntry.Duration = theFormatCtx->duration;
+    anEntry.Stamp    = ++myStamp;
+    if(myEntries.size() >= THE_ENTRIES_MAX
+    && myEntries.find(theKey) == myEntries.end()) {
+        // evict the least recently used entry
+        std::map<StString, Entry>::iterator anOldest = myEntries.begin();
+        for(std::map<StString, Entry>::iterator anIter = myEntries.begin(); anIter != myEntries.end(); ++anIter) {
+            if(anIter->second.Stamp < anOldest->second.Stamp) {
+                anOldest = anIter;
+            }
+        }
+        myEntries.erase(anOldest);
+    }
+    myEntries[theKey] = anEntry;
+    myIsDirty = true;
+}
+
+void StVideoProbeCache::remove(const StString& theKey) {
+    if(myEntries.erase(theKey) != 0) {
+        myIsDirty = true;
+    }
+}
+
+void StVideoProbeCache::flush() {
+    if(!myIsDirty
+    || myFilePath.isEmpty()) {
+        return;
+    }
+
+    myIsDirty = false;
+    save();
+}
+
+StString StVideoProbeCache::formatStreams(const AVFormatContext* theFormatCtx) {
+    StString aStreams;
+    for(unsigned int aStreamId = 0; aStreamId < theFormatCtx->nb_streams; ++aStreamId) {
+        const AVStream* aStream = theFormatCtx->streams[aStreamId];
+        char aType = 'u';
+        switch(stAV::getCodecType(aStream)) {
+            case AVMEDIA_TYPE_VIDEO:    aType = 'v'; break;
+            case AVMEDIA_TYPE_AUDIO:    aType = 'a'; break;
+            case AVMEDIA_TYPE_SUBTITLE: aType = 's'; break;
+            case AVMEDIA_TYPE_DATA:     aType = 'd'; break;
+            default: break;
+        }
+        if(!aStreams.isEmpty()) {
+            aStreams += " ";
+        }
+        aStreams += StString() + aType + int(stAV::getCodecId(aStream));
+    }
+    return aStreams;
+}
+
+bool StVideoProbeCache::isComplete(const Entry&           theEntry,
+                                   const AVFormatContext* theFormatCtx) {
+    if(formatStreams(theFormatCtx) != theEntry.Streams) {
+        return false;
+    }
+
+    for(unsigned int aStreamId = 0; aStreamId < theFormatCtx->nb_streams; ++aStreamId) {
+        const AVStream* aStream = theFormatCtx->streams[aStreamId];
+        const AVCodecParameters* aParams = aStream->codecpar;
+        switch(stAV::getCodecType(aStream)) {
+            case AVMEDIA_TYPE_VIDEO: {
+                if(!stAV::isAttachedPicture(aStream)
+                && (aParams->width  <= 0
+                 || aParams->height <= 0
+                 || aParams->format == -1)) {
+                    return false;
+                }
+                break;
+            }
+            case AVMEDIA_TYPE_AUDIO: {
+                if(aParams->sample_rate <= 0
+                || aParams->format == -1) {
+                    return false;
+                }
+                break;
+            }
+            default: break;
+        }
+    }
+    return true;
+}
+
+void StVideoProbeCache::load() {
+    if(myIsLoaded) {
+        return;
+    }
+
+    myIsLoaded = true;
+    const StString aContent = StRawFile::readTextFile(myFilePath);
+    if(aContent.isEmpty()) {
+        return;
+    }
+
+    StHandle< StArrayList<StString> > aLines = aContent.split('\n');
+    for(size_t aLineIter = 0; aLineIter < aLines->size(); ++aLineIter) {
+        StHandle< StArrayList<StString> > aFields = aLines->getValue(aLineIter).split('\t');
+        if(aFields->size() < 4) {
+            continue;
+        }
+
+        Entry anEntry;
+        anEntry.Format   = aFields->getValue(1);
+        anEntry.Streams  = aFields->getValue(2);
+        anEntry.Duration = (int64_t )std::atoll(aFields->getValue(3).toCString());
+        if(aFields->size() >= 5) {
+            anEntry.Stamp = (int64_t )std::atoll(aFields->getValue(4).toCString());
+            myStamp = stMax(myStamp, anEntry.Stamp);
+        }
+        myEntries[aFields->getValue(0)] = anEntry;
+    }
+}
+
+void StVideoProbeCache::save() const {
+    StRawFile aFile;
+    if(!aFile.openFile(StRawFile::WRITE, myFilePath)) {
+        return;
+    }
+
+    for(std::map<StString, Entry>::const_iterator anIter = myEntries.begin(); anIter != myEntries.end(); ++anIter) {
+        aFile.write(anIter->first);
+        aFile.write(stCString("\t"));
+        aFile.write(anIter->second.Format);
+        aFile.write(stCString("\t"));
+        aFile.write(anIter->second.Streams);
+        aFile.write(stCString("\t"));
+        aFile.write(StString() + anIter->second.Duration);
+        aFile.write(stCString("\t"));
+        aFile.write(StString() + anIter->second.Stamp);
+        aFile.write(stCString("\n"));
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StVideoProbeCache_h_
+#define __StVideoProbeCache_h_
+
+#include <StAV/stAV.h>
+#include <StStrings/StString.h>
+
+#include <map>
+
+/**
+ * Persistent cache of stream probing results.
+ * Full avformat_find_stream_info() reads and decodes up to several seconds of data,
+ * which is slow on high-latency storage.
+ * For already seen files the demuxer and streams layout are remembered,
+ * so that the file can be reopened with reduced probing.
+ * The least recently used entries are evicted when cache is full;
+ * modifications are written into the cache file by flush().
+ */
+class StVideoProbeCache {
+
+        public:
+
+    /**
+     * Probing results for one file.
+     */
+    struct Entry {
+        StString Format;   //!< short name of the demuxer
+        StString Streams;  //!< streams layout (codec type and id of each stream)
+        int64_t  Duration; //!< duration in AV_TIME_BASE units
+        int64_t  Stamp;    //!< last access stamp for LRU eviction
+
+        Entry() : Duration(stAV::NOPTS_VALUE), Stamp(0) {}
+    };
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theCacheFolder folder to store the cache file, cache is disabled when empty
+     */
+    ST_LOCAL StVideoProbeCache(const StString& theCacheFolder);
+
+    /**
+     * Destructor, writes pending modifications.
+     */
+    ST_LOCAL ~StVideoProbeCache();
+
+    /**
+     * Return cache key for the local file (path, size and modification time),
+     * or empty string if file can not be cached.
+     */
+    ST_LOCAL static StString getFileKey(const StString& thePath);
+
+    /**
+     * Find probing results for the file.
+     */
+    ST_LOCAL bool find(const StString& theKey,
+                       Entry&          theEntry);
+
+    /**
+     * Remember probing results of opened format context.
+     */
+    ST_LOCAL void add(const StString&        theKey,
+                      const AVFormatContext* theFormatCtx);
+
+    /**
+     * Remove outdated entry.
+     */
+    ST_LOCAL void remove(const StString& theKey);
+
+    /**
+     * Write cache file if it has been modified.
+     */
+    ST_LOCAL void flush();
+
+    /**
+     * Return true if reduced probing has found the same streams with complete codec parameters.
+     */
+    ST_LOCAL static bool isComplete(const Entry&           theEntry,
+                                    const AVFormatContext* theFormatCtx);
+
+        private:
+
+    /**
+     * Format streams layout of format context.
+     */
+    ST_LOCAL static StString formatStreams(const AVFormatContext* theFormatCtx);
+
+    /**
+     * Read cache file.
+     */
+    ST_LOCAL void load();
+
+    /**
+     * Write cache file.
+     */
+    ST_LOCAL void save() const;
+
+        private:
+
+    std::map<StString, Entry> myEntries;  //!< map file key -> probing results
+    StString                  myFilePath; //!< path to the cache file
+    int64_t                   myStamp;    //!< the last access stamp
+    bool                      myIsLoaded; //!< flag indicating that cache file has been read
+    bool                      myIsDirty;  //!< flag indicating that cache has been modified since last save
+
+};
+
+#endif // __StVideoProbeCache_h_
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -162,6 +162,7 @@ StVideoQueue::StVideoQueue(const StHandle<StGLTextureQueue>& theTextureQueue,
   myTextureQueue(theTextureQueue),
   myHasDataState(false),
   myMaster(theMaster),
+  myThreadBudget(!theMaster.isNull() ? theMaster->getThreadBudget() : new StVideoThreadBudget()),
 #if defined(__ANDROID__)
   myCodecH264HW(avcodec_find_decoder_by_name("h264_mediacodec")),
   myCodecHevcHW(avcodec_find_decoder_by_name("hevc_mediacodec")),
@@ -189,8 +190,11 @@ StVideoQueue::StVideoQueue(const StHandle<StGLTextureQueue>& theTextureQueue,
   //
   myAudioClock(0.0),
   myAudioDelayMSec(0),
+  myPlaybackRate(1.0f),
   myFramesCounter(1),
   myWasFlushed(false),
+  myHasFirstFrame(false),
+  myNbThreads(1),
   myStFormatByUser(StFormat_AUTO),
   myStFormatByName(StFormat_AUTO),
   myStFormatInStream(StFormat_AUTO),
@@ -286,9 +290,17 @@ bool StVideoQueue::initCodec(const AVCodec* theCodec,
     av_dict_set(&anOpts, "refcounted_frames", "1", 0);
 
     // attached pics are sparse, therefore we would not want to delay their decoding till EOF
-    int aNbThreads = theToUseGpu || isAttachedPicture()
-                   ? 1
-                   : StThread::countLogicalProcessors();
+    int aNbThreads = 1;
+    if(!theToUseGpu && !isAttachedPicture()) {
+        const StVideoThreadBudget::Config aThreads = myThreadBudget->configure(theCodec->id, myCodecCtx->width, myCodecCtx->height,
+                                                                              StVideoThreadBudget::isLiveStream(myFormatCtx));
+        aNbThreads = aThreads.NbThreads;
+        myCodecCtx->thread_type = aThreads.ThreadType;
+        if(aThreads.ToLowDelay
+        && myCodecCtx->has_b_frames == 0) {
+            myCodecCtx->flags |= AV_CODEC_FLAG_LOW_DELAY;
+        }
+    }
     myCodecCtx->thread_count = aNbThreads;
 
     // open codec
@@ -297,8 +309,10 @@ bool StVideoQueue::initCodec(const AVCodec* theCodec,
     }
 
     myCodec = theCodec;
-    fillCodecInfo(theCodec);
-    ST_DEBUG_LOG("FFmpeg: Setup AVcodec to use " + aNbThreads + " threads");
+    myNbThreads = myCodecCtx->active_thread_type != 0 ? stMax(myCodecCtx->thread_count, 1) : 1;
+    const StString aThreadsInfo = StVideoThreadBudget::formatThreading(myCodecCtx);
+    fillCodecInfo(theCodec, aThreadsInfo);
+    ST_DEBUG_LOG("FFmpeg: Setup AVcodec to use " + aNbThreads + " threads" + aThreadsInfo);
     return true;
 }
 
@@ -529,6 +543,8 @@ void StVideoQueue::deinit() {
 
     myFramesCounter = 1;
     myCachedFrame.nullify();
+    myHasFirstFrame = false;
+    myNbThreads     = 1;
 
     StAVPacketQueue::deinit();
     if(!myHWAccelCtx.isNull()) {
@@ -749,6 +765,7 @@ void StVideoQueue::pushFrame(const StImage&     theSrcDataLeft,
 
     myTextureQueue->push(theSrcDataLeft, theSrcDataRight, theStParams, theSrcFormat, theCubemapFormat, theSrcPTS);
     myTextureQueue->setConnectedStream(true);
+    myHasFirstFrame = true;
     if(myWasFlushed) {
         // force frame update after seeking regardless playback timer
         myTextureQueue->stglSwapFB(0);
@@ -920,6 +937,18 @@ bool StVideoQueue::decodeFrame(const StHandle<StAVPacket>& thePacket,
     static const double OVERR_LIMIT = 0.2;
     static const double GREATER_LIMIT = 100.0;
     if(myMaster.isNull()) {
+        // at high playback rate most frames are not displayed anyway
+        const float     aRate        = myPlaybackRate;
+        const AVDiscard aDiscardBase = aRate >= 3.0f ? AVDISCARD_NONREF : AVDISCARD_DEFAULT;
+        const AVDiscard aDiscardLoop = aRate >  1.5f ? AVDISCARD_NONREF : AVDISCARD_DEFAULT;
+        if(myCodecCtx->skip_loop_filter != aDiscardLoop) {
+            ST_DEBUG_LOG(StString("skip loop filter: ") + (aDiscardLoop == AVDISCARD_NONREF ? "AVDISCARD_NONREF (on)" : "AVDISCARD_DEFAULT (off)"));
+            myCodecCtx->skip_loop_filter = aDiscardLoop;
+            if(!mySlave.isNull()) {
+                mySlave->myCodecCtx->skip_loop_filter = aDiscardLoop;
+            }
+        }
+
         const double anAudioClock = getAClock() + double(myAudioDelayMSec) * 0.001;
         double diff = anAudioClock - myFramePts;
         if(diff > OVERR_LIMIT && diff < GREATER_LIMIT) {
@@ -937,9 +966,9 @@ bool StVideoQueue::decodeFrame(const StHandle<StAVPacket>& thePacket,
                 }
             }
         } else {
-            if(myAvDiscard != AVDISCARD_DEFAULT) {
-                ST_DEBUG_LOG("skip frames: AVDISCARD_DEFAULT (off)");
-                myAvDiscard = AVDISCARD_DEFAULT;
+            if(myAvDiscard != aDiscardBase) {
+                ST_DEBUG_LOG(StString("skip frames: ") + (aDiscardBase == AVDISCARD_NONREF ? "AVDISCARD_NONREF (fast playback)" : "AVDISCARD_DEFAULT (off)"));
+                myAvDiscard = aDiscardBase;
                 myCodecCtx->skip_frame = myAvDiscard;
                 if(!mySlave.isNull()) {
                     mySlave->myCodecCtx->skip_frame = myAvDiscard;
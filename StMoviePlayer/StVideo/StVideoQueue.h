@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -22,6 +22,7 @@
 #include <StGLStereo/StGLTextureQueue.h>
 
 #include "StAVPacketQueue.h"
+#include "StVideoThreadBudget.h"
 #include <StAV/StAVImage.h>
 
 // forward declarations
@@ -134,6 +135,27 @@ class StVideoQueue : public StAVPacketQueue {
         mySlave = theSlave;
     }
 
+    /**
+     * Return CPU budget shared between Master and Slave decoders.
+     */
+    ST_LOCAL const StHandle<StVideoThreadBudget>& getThreadBudget() const {
+        return myThreadBudget;
+    }
+
+    /**
+     * Return the number of decoding threads activated within opened codec (1 when threading is not used).
+     */
+    ST_LOCAL int getNbThreads() const {
+        return myNbThreads;
+    }
+
+    /**
+     * Return true if at least one frame has been pushed into textures queue since stream initialization.
+     */
+    ST_LOCAL bool hasFirstFrame() const {
+        return myHasFirstFrame;
+    }
+
     ST_LOCAL StImage* waitData(double& thePts) {
         myHasDataState.wait();
         if(myDataAdp.isNull()) {
@@ -164,6 +186,14 @@ class StVideoQueue : public StAVPacketQueue {
         myAudioDelayMSec = theDelayMSec;
     }
 
+    /**
+     * Set playback rate to relax decoding at high speed
+     * (skip non-reference frames at 3x and higher, skip loop filter above 1.5x).
+     */
+    ST_LOCAL void setPlaybackRate(const float theRate) {
+        myPlaybackRate = theRate;
+    }
+
     ST_LOCAL StCString getPixelFormatString() const {
         return stAV::PIX_FMT::getString(myCodecCtx->pix_fmt);
     }
@@ -372,6 +402,7 @@ private:
     StCondition                myHasDataState;
     StHandle<StVideoQueue>     myMaster;          //!< handle to Master decoding thread
     StHandle<StVideoQueue>     mySlave;           //!< handle to Slave  decoding thread
+    StHandle<StVideoThreadBudget> myThreadBudget; //!< decoding threads budget shared with Master / Slave
 
     StHandle<StHWAccelContext> myHWAccelCtx;
 #if defined(__ANDROID__)
@@ -408,11 +439,14 @@ private:
     StMutex                    myAudioClockMutex; //!< audio to video sync clock
     double                     myAudioClock;      //!< audio clock
     volatile int               myAudioDelayMSec;
+    volatile float             myPlaybackRate;    //!< playback rate
 
     int64_t                    myFramesCounter;
     StImage                    myCachedFrame;
     StImage                    myEmptyImage;
     bool                       myWasFlushed;
+    volatile bool              myHasFirstFrame;   //!< at least one frame has been pushed since initialization
+    volatile int               myNbThreads;       //!< number of decoding threads activated within opened codec
 
     volatile StFormat          myStFormatByUser;  //!< source format specified by user
     volatile StFormat          myStFormatByName;  //!< source format detected from file name
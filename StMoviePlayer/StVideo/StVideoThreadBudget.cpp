@@ -0,0 +1,92 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StVideoThreadBudget.h"
+
+#include <StThreads/StThread.h>
+
+namespace {
+
+    /**
+     * FFmpeg frame threading does not scale beyond this number of threads.
+     */
+    static const int THE_MAX_THREADS = 16;
+
+    /**
+     * Minimal number of pixels worth a dedicated thread;
+     * smaller frames are decoded faster than threads are synchronized.
+     */
+    static const int THE_PIXELS_PER_THREAD = 320 * 240;
+
+}
+
+StVideoThreadBudget::StVideoThreadBudget()
+: myNbProcessors(stMax(StThread::countLogicalProcessors(), 1)),
+  myNbDecoders(1) {
+    //
+}
+
+StVideoThreadBudget::Config StVideoThreadBudget::configure(const AVCodecID theCodecId,
+                                                           const int       theSizeX,
+                                                           const int       theSizeY,
+                                                           const bool      theIsLive) const {
+    Config aConfig;
+    aConfig.NbThreads = stMax(myNbProcessors / myNbDecoders, 1);
+    if(theSizeX > 0 && theSizeY > 0) {
+        const int aNbThreadsMax = stMax((theSizeX * theSizeY) / THE_PIXELS_PER_THREAD, 1);
+        aConfig.NbThreads = stMin(aConfig.NbThreads, aNbThreadsMax);
+    }
+    aConfig.NbThreads = stMin(aConfig.NbThreads, THE_MAX_THREADS);
+
+    if(theIsLive) {
+        // frame threading delays output by one frame per thread
+        aConfig.ThreadType = FF_THREAD_SLICE;
+        aConfig.ToLowDelay = true;
+    } else if(theCodecId == AV_CODEC_ID_MPEG2VIDEO
+           || theCodecId == AV_CODEC_ID_MPEG1VIDEO) {
+        // every macroblock row is a slice in MPEG-1/2, so that slice threading scales well without extra latency
+        aConfig.ThreadType = FF_THREAD_SLICE;
+    } else {
+        // let FFmpeg fallback to slice threading for codecs not supporting frame threading
+        aConfig.ThreadType = FF_THREAD_FRAME | FF_THREAD_SLICE;
+    }
+    return aConfig;
+}
+
+bool StVideoThreadBudget::isLiveStream(const AVFormatContext* theFormatCtx) {
+    if(theFormatCtx == NULL
+    || theFormatCtx->duration != stAV::NOPTS_VALUE) {
+        return false;
+    }
+    return theFormatCtx->pb == NULL
+       || (theFormatCtx->pb->seekable & AVIO_SEEKABLE_NORMAL) == 0;
+}
+
+StString StVideoThreadBudget::formatThreading(const AVCodecContext* theCodecCtx) {
+    if(theCodecCtx == NULL
+    || theCodecCtx->thread_count <= 1) {
+        return StString();
+    }
+
+    if((theCodecCtx->active_thread_type & FF_THREAD_FRAME) != 0) {
+        return StString(" (") + theCodecCtx->thread_count + " frame threads)";
+    } else if((theCodecCtx->active_thread_type & FF_THREAD_SLICE) != 0) {
+        return StString(" (") + theCodecCtx->thread_count + " slice threads)";
+    }
+    return StString();
+}
@@ -0,0 +1,98 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StVideoThreadBudget_h_
+#define __StVideoThreadBudget_h_
+
+#include <StAV/stAV.h>
+#include <StStrings/StString.h>
+
+/**
+ * CPU budget shared by video decoders working concurrently
+ * (Master and Slave streams of dual-stream stereoscopic video).
+ * Logical processors are partitioned between expected decoders
+ * instead of each decoder spawning as many threads as there are processors.
+ */
+class StVideoThreadBudget {
+
+        public:
+
+    /**
+     * Decoder threading configuration.
+     */
+    struct Config {
+        int  NbThreads;  //!< number of decoding threads
+        int  ThreadType; //!< FF_THREAD_FRAME and / or FF_THREAD_SLICE
+        bool ToLowDelay; //!< frame threading is avoided to not delay output by extra frames
+
+        Config() : NbThreads(1), ThreadType(0), ToLowDelay(false) {}
+    };
+
+        public:
+
+    /**
+     * Main constructor.
+     */
+    ST_LOCAL StVideoThreadBudget();
+
+    /**
+     * Return the number of logical processors to be partitioned.
+     */
+    ST_LOCAL int getNbProcessors() const { return myNbProcessors; }
+
+    /**
+     * Return the number of decoders expected to work concurrently.
+     */
+    ST_LOCAL int getNbDecoders() const { return myNbDecoders; }
+
+    /**
+     * Set the number of decoders expected to work concurrently.
+     * Should be defined before opening codecs, as threads cannot be changed for already opened decoder.
+     */
+    ST_LOCAL void setNbDecoders(const int theNbDecoders) { myNbDecoders = theNbDecoders > 0 ? theNbDecoders : 1; }
+
+    /**
+     * Choose threading configuration for the decoder.
+     * @param theCodecId codec to be opened
+     * @param theSizeX   frame width  (0 if unknown)
+     * @param theSizeY   frame height (0 if unknown)
+     * @param theIsLive  live stream, which should be decoded with minimal latency
+     */
+    ST_LOCAL Config configure(const AVCodecID theCodecId,
+                              const int       theSizeX,
+                              const int       theSizeY,
+                              const bool      theIsLive) const;
+
+    /**
+     * Return true if format context looks like a live stream (unknown duration and non-seekable input).
+     */
+    ST_LOCAL static bool isLiveStream(const AVFormatContext* theFormatCtx);
+
+    /**
+     * Format threading actually activated within opened codec, like " (4 frame threads)".
+     */
+    ST_LOCAL static StString formatThreading(const AVCodecContext* theCodecCtx);
+
+        private:
+
+    int myNbProcessors; //!< number of logical processors
+    int myNbDecoders;   //!< number of decoders expected to work concurrently
+
+};
+
+#endif // __StVideoThreadBudget_h_
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2013 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -20,6 +20,10 @@
 
 #include <StThreads/StThread.h>
 
+namespace {
+    static const double THE_MIN_FRAME_DELAY_MS = 1000.0 / 60.0; //!< minimal delay between frames at high rate when refresh rate is unknown
+}
+
 /**
  * Thread just call mainLoop() function.
  */
@@ -38,6 +42,7 @@ StVideoTimer::StVideoTimer(const StHandle<StVideoQueue>& theVideo,
   myTimer(false),
   myTimerThrCurr(theDelayVVFixedMs),
   myTimerThrNext(theDelayVVFixedMs),
+  myDeadlineUs(-1.0),
   myAudioPtsCurrSec(-1.0),
   myVideoPtsCurrSec(myVideo->getPts()),
   myVideoPtsNextSec(-1.0),
@@ -47,6 +52,7 @@ StVideoTimer::StVideoTimer(const StHandle<StVideoQueue>& theVideo,
   myDelayVV(0.0),
   myDelayVVAver(theDelayVVFixedMs),
   myDelayVVFixed(theDelayVVFixedMs),
+  myPlaybackRate(1.0),
   mySpeedFastSkip(3.0),
   mySpeedFast(1.5),
   mySpeedFastRev(1.0 / mySpeedFast),
@@ -72,16 +78,62 @@ bool StVideoTimer::isQuitMessage() {
             ///ST_DEBUG_LOG_AT("Not played!");
             myTimer.restart();
             myTimerThrNext = 0.0;
+            myDeadlineUs   = -1.0;
+            myVideo->getTextureQueue()->getFrameScheduler().resetCadence();
         } else {
             return false;
         }
     }
 }
 
+void StVideoTimer::scheduleNextFrame() {
+    myDeadlineUs = -1.0;
+    if(myIsBenchmark
+    || myVideoPtsNextSec < 0.0) {
+        return;
+    }
+
+    StFrameScheduler& aScheduler = myVideo->getTextureQueue()->getFrameScheduler();
+    const double aPeriodUs = aScheduler.getPeriodUs();
+    if(aPeriodUs <= 0.0) {
+        // refresh rate is unknown - fallback to plain timer
+        return;
+    }
+
+    // desired presentation time in scheduler clock
+    const double aRate       = myPlaybackRate;
+    const double aFrameDurUs = myDelayVVAver * 1000.0 / aRate;
+    double aTargetUs = aScheduler.getTimeUs() + (myTimerThrNext - myTimer.getElapsedTimeInMilliSec()) * 1000.0;
+    double aSlotUs   = aTargetUs;
+    for(int aSkipIter = 0; aSkipIter < 4; ++aSkipIter) {
+        if(aScheduler.pickVSync(aTargetUs, aFrameDurUs, aSlotUs) != 0) {
+            break;
+        }
+
+        // frame falls onto the same refresh slot as already shown one - skip it
+        double aPtsNext = myVideoPtsNextSec;
+        myVideo->getTextureQueue()->drop(1, aPtsNext);
+        if(aPtsNext == myVideoPtsNextSec) {
+            break; // nothing to skip
+        }
+        aScheduler.onFrameSkipped();
+        aTargetUs        += getDelayMsec(aPtsNext, myVideoPtsNextSec) * 1000.0 / aRate;
+        myTimerThrNext   += getDelayMsec(aPtsNext, myVideoPtsNextSec) / aRate;
+        myVideoPtsNextSec = aPtsNext;
+    }
+
+    // release the frame a little bit before presentation opportunity,
+    // so that GL thread will pick it up within the chosen refresh cycle
+    myDeadlineUs = aSlotUs - stMin(1500.0, aPeriodUs * 0.25);
+}
+
 void StVideoTimer::mainLoop() {
     if(myVideo->getId() < 0) {
         return; // nothing to refresh
     }
+    StFrameScheduler& aScheduler = myVideo->getTextureQueue()->getFrameScheduler();
+    aScheduler.resetStatistics();
+    aScheduler.resetCadence();
     myVideo->setAClock(0.0);
     myTimer.restart();
     for(;;) {
@@ -89,7 +141,10 @@ void StVideoTimer::mainLoop() {
             return;
         }
 
-        if(myTimer.getElapsedTimeInMilliSec() >= myTimerThrNext) {
+        const bool isReleaseTime = myDeadlineUs >= 0.0
+                                 ? aScheduler.getTimeUs() >= myDeadlineUs
+                                 : myTimer.getElapsedTimeInMilliSec() >= myTimerThrNext;
+        if(isReleaseTime) {
             // this is time we should show the next frame, call swap Front/Back here
             while(!myVideo->getTextureQueue()->stglSwapFB(1)) {
                 if(isQuitMessage()) {
@@ -97,6 +152,8 @@ void StVideoTimer::mainLoop() {
                 }
                 StThread::sleep(1);
             }
+            const double aReleaseUs = aScheduler.getTimeUs();
+            aScheduler.onFrameReleased(myDeadlineUs >= 0.0 ? myDeadlineUs : aReleaseUs, aReleaseUs);
 
             // store old timer threshold value to check diff at the end
             myTimerThrCurr = myTimerThrNext;
@@ -111,6 +168,7 @@ void StVideoTimer::mainLoop() {
                 StThread::sleep(1);
             }
 
+            const double aRate = myPlaybackRate;
             myDelayVV = getDelayMsec(myVideoPtsNextSec, myVideoPtsCurrSec);
             if(myDelayVV > 0.0 && myDelayVV < 201.0) {
                 myInfoLock.lock();
@@ -147,15 +205,39 @@ void StVideoTimer::mainLoop() {
                 } else {
                     //ST_DEBUG_LOG(getSpeedText() + "|  normal  |myDelayTimer= " + myDelayTimer + ", myDelayVV= " + myDelayVV);
                 }
+
+                // at high playback rate frames come faster than display can show them - skip redundant ones
+                // (when refresh rate is known, this is done by scheduleNextFrame())
+                if(aRate > 1.0
+                && !myIsBenchmark
+                && aScheduler.getPeriodUs() <= 0.0) {
+                    for(int aSkipIter = 0; aSkipIter < 8 && myDelayTimer < THE_MIN_FRAME_DELAY_MS * aRate; ++aSkipIter) {
+                        double aPtsNext = myVideoPtsNextSec;
+                        myVideo->getTextureQueue()->drop(1, aPtsNext);
+                        if(aPtsNext == myVideoPtsNextSec) {
+                            break; // nothing to skip
+                        }
+                        myDelayTimer     += getDelayMsec(aPtsNext, myVideoPtsNextSec);
+                        myVideoPtsNextSec = aPtsNext;
+                    }
+                }
             } else {
                 // fixed FPS
                 myDelayTimer = myDelayVVFixed;
             }
-            myTimerThrNext = myTimerThrCurr + myDelayTimer;
+            // delays are in stream time
+            myTimerThrNext = myTimerThrCurr + myDelayTimer / aRate;
             if(myIsBenchmark) {
                 myTimerThrNext = 0.0;
             }
+            scheduleNextFrame();
+        }
+
+        if(myDeadlineUs >= 0.0) {
+            // precise sleep, but wake up periodically to handle pause / quit
+            aScheduler.sleepUntil(stMin(myDeadlineUs, aScheduler.getTimeUs() + 10000.0));
+        } else {
+            StThread::sleep(1);
         }
-        StThread::sleep(1);
     }
 }
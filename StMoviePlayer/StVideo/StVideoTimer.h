@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2013 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StMoviePlayer program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -25,6 +25,8 @@
 /**
  * This class represents video refresher
  * and Audio to Video sync.
+ * When display refresh rate is known (see StFrameScheduler), frames are released aligned to refresh grid
+ * following n:m cadence instead of plain timer.
  */
 class StVideoTimer {
 
@@ -59,6 +61,14 @@ class StVideoTimer {
         myDelayVAFixed = theDelayMSec;
     }
 
+    /**
+     * Setup playback rate.
+     * Frames are released faster or slower, and redundant frames are skipped at high rate.
+     */
+    ST_LOCAL void setPlaybackRate(const double theRate) {
+        myPlaybackRate = theRate;
+    }
+
     /*ST_LOCAL double getSpeed() const {
         // TODO (Kirill Gavrilov#5#) not thread-safe
         return myDelayVVAver / myDelayTimer;
@@ -98,6 +108,12 @@ class StVideoTimer {
 
     ST_LOCAL bool isQuitMessage();
 
+    /**
+     * Align release time of the next frame to display refresh grid.
+     * Redundant frames (that would never be visible) are skipped.
+     */
+    ST_LOCAL void scheduleNextFrame();
+
         private:
 
     StHandle<StThread>     myThread;          //!< timer loop thread
@@ -109,6 +125,7 @@ class StVideoTimer {
 
     double                 myTimerThrCurr;    //!< current timer threshold (timer expired) (in milliseconds)
     double                 myTimerThrNext;    //!< timer threshold to show next Video frame (in milliseconds)
+    double                 myDeadlineUs;      //!< frame scheduler deadline to show next Video frame (in microseconds), -1 if undefined
 
     double                 myAudioPtsCurrSec; //!< real time Audio PTS value (in seconds)
     double                 myVideoPtsCurrSec; //!< current Video frame PTS value (in seconds)
@@ -120,6 +137,7 @@ class StVideoTimer {
     double                 myDelayVV;         //!< real frame's delay (in milliseconds)
     double                 myDelayVVAver;
     double                 myDelayVVFixed;    //!< fixed (for constant FPS) frame's delay (in milliseconds)
+    volatile double        myPlaybackRate;    //!< playback rate, all delays above are in stream time (not scaled by rate)
 
     double                 mySpeedFastSkip;   //!< video playback too FAST, so we speed down and SKIP some ready frames
     double                 mySpeedFast;       //!< video playback too FAST, so we speed down to this value
@@ -9,6 +9,7 @@
 
 #include "StProgramBarrel.h"
 #include "StProgramFlat.h"
+#include "StRenderScale.h"
 
 #include <StGL/StGLContext.h>
 #include <StGL/StGLEnums.h>
@@ -60,6 +61,9 @@ namespace {
         STTR_PARAMETER_DISTORTION = 1120,
         STTR_PARAMETER_DISTORTION_OFF    = 1121,
         STTR_PARAMETER_MONOCLONE         = 1123,
+        STTR_PARAMETER_RENDER_SCALE      = 1130,
+        STTR_PARAMETER_RENDER_SCALE_AUTO = 1131,
+        STTR_PARAMETER_LENS_MATCHED      = 1135,
 
         // about info
         STTR_PLUGIN_TITLE       = 2000,
@@ -180,6 +184,9 @@ void StOutDistorted::getOptions(StParamsList& theList) const {
     }
     if(myDevice != DEVICE_HMD) {
         theList.add(params.MonoClone);
+    } else {
+        theList.add(params.RenderScale);
+        theList.add(params.LensMatched);
     }
 }
 
@@ -196,6 +203,14 @@ void StOutDistorted::updateStrings() {
     }
 
     params.MonoClone->setName(aLangMap.changeValueId(STTR_PARAMETER_MONOCLONE, "Show Mono in Stereo"));
+    params.LensMatched->setName(aLangMap.changeValueId(STTR_PARAMETER_LENS_MATCHED, "Lens-matched rendering"));
+
+    params.RenderScale->setName(aLangMap.changeValueId(STTR_PARAMETER_RENDER_SCALE, "Render resolution"));
+    params.RenderScale->defineOption(RENDER_SCALE_AUTO, aLangMap.changeValueId(STTR_PARAMETER_RENDER_SCALE_AUTO, "Auto"));
+    params.RenderScale->defineOption(RENDER_SCALE_100,  stCString("100%"));
+    params.RenderScale->defineOption(RENDER_SCALE_85,   stCString("85%"));
+    params.RenderScale->defineOption(RENDER_SCALE_70,   stCString("70%"));
+    params.RenderScale->defineOption(RENDER_SCALE_50,   stCString("50%"));
 
     params.Layout->setName(aLangMap.changeValueId(STTR_PARAMETER_LAYOUT, "Layout"));
     params.Layout->defineOption(LAYOUT_SIDE_BY_SIDE_ANAMORPH, aLangMap.changeValueId(STTR_PARAMETER_LAYOUT_SBS_ANAMORPH,       "Side-by-Side (Anamorph)"));
@@ -230,9 +245,12 @@ StOutDistorted::StOutDistorted(const StHandle<StResourceManager>& theResMgr,
   myDevice(DEVICE_AUTO),
   myToResetDevice(false),
   myFrBuffer(new StGLFrameBuffer()),
+  myFrBufferInset(new StGLFrameBuffer()),
+  myRenderScale(new StRenderScale()),
   myCursor(new StGLTexture(GL_RGBA8)),
   myProgramFlat(new StProgramFlat()),
   myProgramBarrel(new StProgramBarrel()),
+  myProgramBarrelMR(new StProgramBarrel(true)),
   myBarrelCoef(1.0f, 0.22f, 0.24f, 0.041f), // 7 inches
   //myBarrelCoef(1.0f, 0.18f, 0.115f, 0.0387f),
   myChromAb(0.996f, -0.004f, 1.014f, 0.0f),
@@ -257,7 +275,8 @@ StOutDistorted::StOutDistorted(const StHandle<StResourceManager>& theResMgr,
   myIsStereoOn(false),
   myCanHdmiPack(false),
   myIsHdmiPack(false),
-  myIsForcedFboUsage(false) {
+  myIsForcedFboUsage(false),
+  myHasMultiRes(false) {
     const StSearchMonitors& aMonitors = StWindow::getMonitors();
 
     // detect connected displays
@@ -302,6 +321,9 @@ StOutDistorted::StOutDistorted(const StHandle<StResourceManager>& theResMgr,
     aDevVR->PluginId = ST_OUT_PLUGIN_NAME;
     aDevVR->DeviceId = stCString("OpenVR");
     aDevVR->Priority = aSupportOpenVr;
+#ifdef ST_HAVE_OPENVR
+    aDevVR->IsProbed = true;
+#endif
     aDevVR->Name     = stCString("OpenVR");
     myDevices.add(aDevVR);
 
@@ -325,6 +347,8 @@ StOutDistorted::StOutDistorted(const StHandle<StResourceManager>& theResMgr,
 
     // Distortion parameters
     params.MonoClone = new StBoolParamNamed(false, stCString("monoClone"), stCString("monoClone"));
+    params.LensMatched = new StBoolParamNamed(false, stCString("lensMatched"), stCString("lensMatched"));
+    params.RenderScale = new StEnumParam(RENDER_SCALE_100, stCString("renderScale"), stCString("renderScale"));
     // Layout option
     params.Layout = new StEnumParam(myCanHdmiPack ? LAYOUT_OVER_UNDER : LAYOUT_SIDE_BY_SIDE_ANAMORPH, stCString("layout"), stCString("layout"));
     updateStrings();
@@ -339,6 +363,8 @@ StOutDistorted::StOutDistorted(const StHandle<StResourceManager>& theResMgr,
     }
     mySettings->loadParam(params.MonoClone);
     mySettings->loadParam(params.Layout);
+    mySettings->loadParam(params.RenderScale);
+    mySettings->loadParam(params.LensMatched);
     checkHdmiPack();
     StWindow::setTitle("sView - Distorted Renderer");
 
@@ -361,6 +387,9 @@ void StOutDistorted::releaseResources() {
 
         myProgramFlat->release(*myContext);
         myProgramBarrel->release(*myContext);
+        myProgramBarrelMR->release(*myContext);
+        myRenderScale->release(*myContext);
+        myFrBufferInset->release(*myContext);
         myFrVertsBuf .release(*myContext);
         myFrTCrdsBuf .release(*myContext);
         myCurVertsBuf.release(*myContext);
@@ -384,6 +413,8 @@ void StOutDistorted::beforeClose() {
 
     mySettings->saveParam(params.Layout);
     mySettings->saveParam(params.MonoClone);
+    mySettings->saveParam(params.RenderScale);
+    mySettings->saveParam(params.LensMatched);
     mySettings->saveFloatVec4(ST_SETTING_WARP_COEF, myBarrelCoef);
     mySettings->saveFloatVec4(ST_SETTING_CHROME_AB, myChromAb);
     if(myWasUsed) {
@@ -440,6 +471,15 @@ bool StOutDistorted::create() {
     myProgramBarrel->setupCoeff (*myContext, myBarrelCoef);
     myProgramBarrel->setupChrome(*myContext, myChromAb);
 
+    // multi-resolution program is optional
+    myHasMultiRes = myProgramBarrelMR->init(*myContext);
+    if(myHasMultiRes) {
+        myProgramBarrelMR->setupCoeff (*myContext, myBarrelCoef);
+        myProgramBarrelMR->setupChrome(*myContext, myChromAb);
+    } else {
+        myProgramBarrelMR->release(*myContext);
+    }
+
     // create vertices buffers to draw simple textured quad
     const GLfloat QUAD_VERTICES[4 * 4] = {
          1.0f, -1.0f, 0.0f, 1.0f, // top-right
@@ -831,7 +871,7 @@ void StOutDistorted::stglDrawVR() {
         return;
     }
 
-    // force resizing instead of lazy resize as we do not pass texture bounds
+    // force resizing instead of lazy resize, render scale is passed as texture bounds
     const vr::VRTextureBounds_t* aTexBounds = NULL;
     if(!myFrBuffer->isValid()
      || myFrBuffer->getSizeX() != myVrRendSize.x()
@@ -845,6 +885,21 @@ void StOutDistorted::stglDrawVR() {
         }
     }
 
+    // apply render scale to the viewport and pass texture bounds to compositor
+    const float aRendScale = updateRenderScale();
+    myFrBuffer->setVPSizeX(stMax(GLsizei(float(myVrRendSize.x()) * aRendScale), 1));
+    myFrBuffer->setVPSizeY(stMax(GLsizei(float(myVrRendSize.y()) * aRendScale), 1));
+    vr::VRTextureBounds_t aScaledBounds;
+    aScaledBounds.uMin = 0.0f;
+    aScaledBounds.vMin = 0.0f;
+    aScaledBounds.uMax = float(myFrBuffer->getVPSizeX()) / float(myFrBuffer->getSizeX());
+    aScaledBounds.vMax = float(myFrBuffer->getVPSizeY()) / float(myFrBuffer->getSizeY());
+    if(aScaledBounds.uMax < 1.0f
+    || aScaledBounds.vMax < 1.0f) {
+        aTexBounds = &aScaledBounds;
+    }
+    myRenderScale->stglBegin(*myContext);
+
     // draw into virtual frame buffers (textures)
     myFrBuffer->setupViewPort(*myContext);       // we set TEXTURE sizes here
     {
@@ -867,7 +922,7 @@ void StOutDistorted::stglDrawVR() {
         stglDrawCursor(aCursorPos, ST_DRAW_RIGHT);
 
         vr::Texture_t aVRTexture = { (void* )(size_t )myFrBuffer->getTextureColor()->getTextureId(),  vr::TextureType_OpenGL, vr::ColorSpace_Gamma };
-        const vr::EVRCompositorError aVRError = vr::VRCompositor()->Submit(vr::Eye_Right, &aVRTexture);
+        const vr::EVRCompositorError aVRError = vr::VRCompositor()->Submit(vr::Eye_Right, &aVRTexture, aTexBounds);
         if(aVRError != vr::VRCompositorError_None) {
             //myMsgQueue->pushError(getVRCompositorError(aVRError));
             ST_ERROR_LOG(getVRCompositorError(aVRError));
@@ -875,6 +930,7 @@ void StOutDistorted::stglDrawVR() {
         }
         myFrBuffer->unbindBuffer(*myContext);
     }
+    myRenderScale->stglEnd(*myContext);
     glFinish();
 
     {
@@ -1052,9 +1108,24 @@ void StOutDistorted::stglDraw() {
     // resize FBO
     GLint aFrSizeX = aViewPortL.width();
     GLint aFrSizeY = aViewPortL.height();
+    GLint aFullSizeX = aFrSizeX, aFullSizeY = aFrSizeY;
+    bool toUseInset = myDevice == DEVICE_HMD
+                         && myHasMultiRes
+                         && params.LensMatched->getValue();
     if(myDevice == DEVICE_HMD) {
-        aFrSizeX = int(std::ceil(double(aFrSizeX) * 1.25) + 0.5);
-        aFrSizeY = int(std::ceil(double(aFrSizeY) * 1.25) + 0.5);
+        // 1.25 factor compensates barrel distortion magnification in the lens center
+        const double aScale = 1.25 * double(updateRenderScale());
+        aFullSizeX = int(std::ceil(double(aFrSizeX) * aScale) + 0.5);
+        aFullSizeY = int(std::ceil(double(aFrSizeY) * aScale) + 0.5);
+        aFrSizeX = aFullSizeX;
+        aFrSizeY = aFullSizeY;
+        if(toUseInset) {
+            // the lens compresses periphery - render it at half resolution
+            aFrSizeX = stMax(aFullSizeX / 2, 1);
+            aFrSizeY = stMax(aFullSizeY / 2, 1);
+        }
+    } else {
+        myFrBufferInset->release(*myContext);
     }
 
     if(!myFrBuffer->initLazy(*myContext, GL_RGBA8, aFrSizeX, aFrSizeY, StWindow::hasDepthBuffer())) {
@@ -1074,6 +1145,10 @@ void StOutDistorted::stglDraw() {
     myFrTCrdsBuf.init(*myContext, aTCoords);
 
     const GLfloat aLensDisp = getLensDist() * 0.5f;
+    StGLVec4 anInsetRect;
+    if(myDevice == DEVICE_HMD) {
+        myRenderScale->stglBegin(*myContext);
+    }
 
     // draw Left View into virtual frame buffer
     myFrBuffer->setupViewPort(*myContext); // we set TEXTURE sizes here
@@ -1081,6 +1156,12 @@ void StOutDistorted::stglDraw() {
         StWindow::signals.onRedraw(ST_DRAW_LEFT);
         stglDrawCursor(aCursorPos, ST_DRAW_LEFT);
     myFrBuffer->unbindBuffer(*myContext);
+    if(toUseInset
+    && !stglDrawInset(ST_DRAW_LEFT, aCursorPos, aFullSizeX, aFullSizeY, StGLVec2(0.5f + aLensDisp, 0.5f), anInsetRect)) {
+        // composite this frame without inset
+        toUseInset = false;
+        params.LensMatched->setValue(false);
+    }
 
     // now draw to real screen buffer
     // clear the screen and the depth buffer
@@ -1095,17 +1176,26 @@ void StOutDistorted::stglDraw() {
     StGLProgram*    aProgram   = myProgramFlat.access();
     StGLVarLocation aVertexLoc = myProgramFlat->getVVertexLoc();
     StGLVarLocation aTexCrdLoc = myProgramFlat->getVTexCoordLoc();
+    StProgramBarrel* aProgramBarrel = NULL;
+    StGLVec2 anInsetScale;
     if(myDevice == DEVICE_HMD) {
-        aProgram   = myProgramBarrel.access();
-        aVertexLoc = myProgramBarrel->getVVertexLoc();
-        aTexCrdLoc = myProgramBarrel->getVTexCoordLoc();
-        myProgramBarrel->setScaleIn(*myContext, StGLVec2(2.0f / aDX, 2.0f / aDY));
-        myProgramBarrel->setScale  (*myContext, StGLVec2(0.4f * aDX, 0.4f * aDY));
+        aProgramBarrel = toUseInset ? myProgramBarrelMR.access() : myProgramBarrel.access();
+        aProgram   = aProgramBarrel;
+        aVertexLoc = aProgramBarrel->getVVertexLoc();
+        aTexCrdLoc = aProgramBarrel->getVTexCoordLoc();
+        aProgramBarrel->setScaleIn(*myContext, StGLVec2(2.0f / aDX, 2.0f / aDY));
+        aProgramBarrel->setScale  (*myContext, StGLVec2(0.4f * aDX, 0.4f * aDY));
+        if(toUseInset) {
+            anInsetScale = StGLVec2(GLfloat(myFrBufferInset->getVPSizeX()) / GLfloat(myFrBufferInset->getSizeX()),
+                                    GLfloat(myFrBufferInset->getVPSizeY()) / GLfloat(myFrBufferInset->getSizeY()));
+            aProgramBarrel->setInset(*myContext, anInsetRect * StGLVec4(aDX, aDY, aDX, aDY), anInsetScale);
+            myFrBufferInset->bindTexture(*myContext, GL_TEXTURE1);
+        }
     }
 
     myFrBuffer->bindTexture(*myContext);
-    if(aProgram == myProgramBarrel.access()) {
-        myProgramBarrel->setLensCenter(*myContext, StGLVec2((0.5f + aLensDisp) * aDX, 0.5f * aDY));
+    if(aProgramBarrel != NULL) {
+        aProgramBarrel->setLensCenter(*myContext, StGLVec2((0.5f + aLensDisp) * aDX, 0.5f * aDY));
     }
     aProgram->use(*myContext);
         myFrVertsBuf.bindVertexAttrib(*myContext, aVertexLoc);
@@ -1116,7 +1206,10 @@ void StOutDistorted::stglDraw() {
         myFrTCrdsBuf.unBindVertexAttrib(*myContext, aTexCrdLoc);
         myFrVertsBuf.unBindVertexAttrib(*myContext, aVertexLoc);
     aProgram->unuse(*myContext);
-    myFrBuffer->unbindTexture(*myContext);
+    if(toUseInset) {
+        myFrBufferInset->unbindTexture(*myContext);
+    }
+    myFrBuffer->unbindTexture(*myContext); // restores GL_TEXTURE0 as active unit
     myContext->stglResetScissorRect();
 
     myFrBuffer->setupViewPort(*myContext); // we set TEXTURE sizes here
@@ -1124,14 +1217,21 @@ void StOutDistorted::stglDraw() {
         StWindow::signals.onRedraw(ST_DRAW_RIGHT);
         stglDrawCursor(aCursorPos, ST_DRAW_RIGHT);
     myFrBuffer->unbindBuffer(*myContext);
+    if(toUseInset) {
+        stglDrawInset(ST_DRAW_RIGHT, aCursorPos, aFullSizeX, aFullSizeY, StGLVec2(0.5f - aLensDisp, 0.5f), anInsetRect);
+    }
 
     // draw Right view
     myContext->stglResizeViewport(aViewPortR);
     myContext->stglSetScissorRect(aViewPortR, false);
 
+    if(toUseInset) {
+        aProgramBarrel->setInset(*myContext, anInsetRect * StGLVec4(aDX, aDY, aDX, aDY), anInsetScale);
+        myFrBufferInset->bindTexture(*myContext, GL_TEXTURE1);
+    }
     myFrBuffer->bindTexture(*myContext);
-    if(aProgram == myProgramBarrel.access()) {
-        myProgramBarrel->setLensCenter(*myContext, StGLVec2((0.5f - aLensDisp) * aDX, 0.5f * aDY));
+    if(aProgramBarrel != NULL) {
+        aProgramBarrel->setLensCenter(*myContext, StGLVec2((0.5f - aLensDisp) * aDX, 0.5f * aDY));
     }
     aProgram->use(*myContext);
     myFrVertsBuf.bindVertexAttrib(*myContext, aVertexLoc);
@@ -1143,14 +1243,68 @@ void StOutDistorted::stglDraw() {
     myFrVertsBuf.unBindVertexAttrib(*myContext, aVertexLoc);
 
     aProgram->unuse(*myContext);
-    myFrBuffer->unbindTexture(*myContext);
+    if(toUseInset) {
+        myFrBufferInset->unbindTexture(*myContext);
+    }
+    myFrBuffer->unbindTexture(*myContext); // restores GL_TEXTURE0 as active unit
     myContext->stglResetScissorRect();
+    if(myDevice == DEVICE_HMD) {
+        myRenderScale->stglEnd(*myContext);
+    }
 
     myFPSControl.sleepToTarget(); // decrease FPS to target by thread sleeps
     StWindow::stglSwap(ST_WIN_ALL);
     ++myFPSControl;
 }
 
+float StOutDistorted::updateRenderScale() {
+    switch(params.RenderScale->getValue()) {
+        case RENDER_SCALE_AUTO: break;
+        case RENDER_SCALE_85:   return 0.85f;
+        case RENDER_SCALE_70:   return 0.70f;
+        case RENDER_SCALE_50:   return 0.50f;
+        case RENDER_SCALE_100:
+        default:                return 1.0f;
+    }
+
+    const float aFreq = getMaximumTargetFps();
+    return myRenderScale->update(aFreq > 1.0f ? (1000.0 / double(aFreq)) : 0.0);
+}
+
+bool StOutDistorted::stglDrawInset(const unsigned int theView,
+                                   const StPointD_t&  theCursorPos,
+                                   const GLint        theFullSizeX,
+                                   const GLint        theFullSizeY,
+                                   const StGLVec2&    theLensCenter,
+                                   StGLVec4&          theRect) {
+    // inset covers half of the eye in each dimension (quarter of the area)
+    const GLint aSizeX = stMax(theFullSizeX / 2, 1);
+    const GLint aSizeY = stMax(theFullSizeY / 2, 1);
+    if(!myFrBufferInset->initLazy(*myContext, GL_RGBA8, aSizeX, aSizeY, StWindow::hasDepthBuffer())) {
+        myFrBufferInset->release(*myContext);
+        return false;
+    }
+
+    const GLint aLeft   = stMin(stMax(GLint(theLensCenter.x() * GLfloat(theFullSizeX)) - aSizeX / 2, 0), theFullSizeX - aSizeX);
+    const GLint aBottom = stMin(stMax(GLint(theLensCenter.y() * GLfloat(theFullSizeY)) - aSizeY / 2, 0), theFullSizeY - aSizeY);
+    theRect = StGLVec4(GLfloat(aLeft)          / GLfloat(theFullSizeX),
+                       GLfloat(aBottom)        / GLfloat(theFullSizeY),
+                       GLfloat(aLeft + aSizeX)   / GLfloat(theFullSizeX),
+                       GLfloat(aBottom + aSizeY) / GLfloat(theFullSizeY));
+
+    StGLBoxPx aViewPort;
+    aViewPort.x()      = -aLeft;
+    aViewPort.y()      = -aBottom;
+    aViewPort.width()  = theFullSizeX;
+    aViewPort.height() = theFullSizeY;
+    myFrBufferInset->bindBuffer(*myContext);
+    myContext->stglResizeViewport(aViewPort);
+        StWindow::signals.onRedraw(theView);
+        stglDrawCursor(theCursorPos, theView);
+    myFrBufferInset->unbindBuffer(*myContext);
+    return true;
+}
+
 void StOutDistorted::doSwitchVSync(const int32_t theValue) {
     if(myContext.isNull()) {
         return;
@@ -17,6 +17,7 @@
 class StSettings;
 class StProgramBarrel;
 class StProgramFlat;
+class StRenderScale;
 class StGLFrameBuffer;
 class StGLTexture;
 class StGLTextureQuad;
@@ -228,6 +229,29 @@ class StOutDistorted : public StWindow {
      */
     ST_LOCAL void updateVRProjectionFrustums();
 
+    /**
+     * Return render scale for HMD eye buffers (fixed or dynamically adjusted to frame time budget).
+     */
+    ST_LOCAL float updateRenderScale();
+
+    /**
+     * Render central area of the eye at full resolution into inset frame buffer (lens-matched mode).
+     * Viewport larger than the frame buffer is used, so that only the inset area is rasterized.
+     * @param theView       view to draw
+     * @param theCursorPos  cursor position
+     * @param theFullSizeX  width  of the eye at full resolution
+     * @param theFullSizeY  height of the eye at full resolution
+     * @param theLensCenter lens center within the eye (normalized)
+     * @param theRect       inset rectangle within the eye (normalized)
+     * @return FALSE if frame buffer cannot be allocated
+     */
+    ST_LOCAL bool stglDrawInset(const unsigned int theView,
+                                const StPointD_t&  theCursorPos,
+                                const GLint        theFullSizeX,
+                                const GLint        theFullSizeY,
+                                const StGLVec2&    theLensCenter,
+                                StGLVec4&          theRect);
+
         private:
 
     static StAtomic<int32_t> myInstancesNb; //!< shared counter for all instances
@@ -242,6 +266,14 @@ class StOutDistorted : public StWindow {
         DEVICE_NB,
     };
 
+    enum RenderScale {
+        RENDER_SCALE_AUTO = 0, //!< dynamic render scale driven by measured GPU frame time
+        RENDER_SCALE_100  = 1, //!< full resolution
+        RENDER_SCALE_85   = 2,
+        RENDER_SCALE_70   = 3,
+        RENDER_SCALE_50   = 4,
+    };
+
     enum Layout {
         LAYOUT_SIDE_BY_SIDE_ANAMORPH = 0, //!< anamorph  side by side
         LAYOUT_OVER_UNDER_ANAMORPH   = 1, //!< anamorph  over under
@@ -266,8 +298,10 @@ class StOutDistorted : public StWindow {
 
     struct {
 
-        StHandle<StEnumParam>      Layout;   //!< pair layout
-        StHandle<StBoolParamNamed> MonoClone;//!< display mono in stereo
+        StHandle<StEnumParam>      Layout;      //!< pair layout
+        StHandle<StBoolParamNamed> MonoClone;   //!< display mono in stereo
+        StHandle<StEnumParam>      RenderScale; //!< render resolution of HMD eye buffers
+        StHandle<StBoolParamNamed> LensMatched; //!< lens-matched (multi-resolution) eye buffers for barrel distortion
 
     } params;
 
@@ -285,9 +319,12 @@ class StOutDistorted : public StWindow {
     bool                      myToResetDevice;
     StHandle<StGLContext>     myContext;
     StHandle<StGLFrameBuffer> myFrBuffer;        //!< OpenGL frame buffer object
+    StHandle<StGLFrameBuffer> myFrBufferInset;   //!< frame buffer for full-resolution central area of the eye (lens-matched mode)
+    StHandle<StRenderScale>   myRenderScale;     //!< dynamic render scale controller
     StHandle<StGLTexture>     myCursor;          //!< cursor texture - we can not use normal cursor due to distortions
     StHandle<StProgramFlat>   myProgramFlat;
     StHandle<StProgramBarrel> myProgramBarrel;
+    StHandle<StProgramBarrel> myProgramBarrelMR; //!< multi-resolution variant of barrel distortion program
     StFPSControl              myFPSControl;
     StGLVertexBuffer          myFrVertsBuf;      //!< buffers to draw simple fullsreen quad
     StGLVertexBuffer          myFrTCrdsBuf;
@@ -324,6 +361,7 @@ class StOutDistorted : public StWindow {
     bool                      myCanHdmiPack;
     bool                      myIsHdmiPack;      //!< "frame packed" mode in HDMI 1.4a
     bool                      myIsForcedFboUsage;//!< use FBO even when rendering can be done by simple viewport adjustment
+    bool                      myHasMultiRes;     //!< multi-resolution program has been initialized
 
 };
 
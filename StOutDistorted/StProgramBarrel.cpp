@@ -10,8 +10,9 @@
 #include <StGLCore/StGLCore20.h>
 #include <StGL/StGLContext.h>
 
-StProgramBarrel::StProgramBarrel()
-: StGLProgram("StProgramBarrel") {}
+StProgramBarrel::StProgramBarrel(const bool theIsMultiRes)
+: StGLProgram(theIsMultiRes ? "StProgramBarrelMultiRes" : "StProgramBarrel"),
+  myIsMultiRes(theIsMultiRes) {}
 
 bool StProgramBarrel::init(StGLContext& theCtx) {
     const char VERTEX_SHADER[] =
@@ -33,6 +34,22 @@ bool StProgramBarrel::init(StGLContext& theCtx) {
        "uniform vec2 uScale;\n"
        "uniform vec2 uScaleIn;\n"
        "\n"
+       "#ifdef ST_MULTIRES\n"
+       "uniform sampler2D texInset;\n"
+       "uniform vec4 uInsetRect;\n"
+       "uniform vec2 uInsetScale;\n"
+       "#endif\n"
+       "\n"
+       "vec4 sampleEye(in vec2 theTCrd) {\n"
+       "#ifdef ST_MULTIRES\n"
+       "  vec2 anInset = (theTCrd - uInsetRect.xy) / (uInsetRect.zw - uInsetRect.xy);\n"
+       "  if(anInset.x >= 0.0 && anInset.y >= 0.0 && anInset.x <= 1.0 && anInset.y <= 1.0) {\n"
+       "    return texture2D(texInset, anInset * uInsetScale);\n"
+       "  }\n"
+       "#endif\n"
+       "  return texture2D(texR, theTCrd);\n"
+       "}\n"
+       "\n"
        "void main(void) {\n"
        "  vec2 aTheta = (fTexCoord - uLensCenter) * uScaleIn;\n" // scales to [-1, 1]
        "  float rSq = aTheta.x * aTheta.x + aTheta.y * aTheta.y;\n"
@@ -49,9 +66,9 @@ bool StProgramBarrel::init(StGLContext& theCtx) {
        "  vec2 aTCrdsGreen = uLensCenter + uScale * aTheta1;\n"
        "  vec2 aThetaRed = aTheta1 * (uChromAb.x + uChromAb.y * rSq);\n"
        "  vec2 aTCrdsRed = uLensCenter + uScale * aThetaRed;\n"
-       "  gl_FragColor = vec4(texture2D(texR, aTCrdsRed  ).r,\n"
-       "                      texture2D(texR, aTCrdsGreen).g,\n"
-       "                      texture2D(texR, aTCrdsBlue ).b, 1.0);\n"
+       "  gl_FragColor = vec4(sampleEye(aTCrdsRed  ).r,\n"
+       "                      sampleEye(aTCrdsGreen).g,\n"
+       "                      sampleEye(aTCrdsBlue ).b, 1.0);\n"
        "}\n";
 
     StGLVertexShader aVertexShader(StGLProgram::getTitle());
@@ -60,7 +77,7 @@ bool StProgramBarrel::init(StGLContext& theCtx) {
 
     StGLFragmentShader aFragmentShader(StGLProgram::getTitle());
     StGLAutoRelease aTmp2(theCtx, aFragmentShader);
-    aFragmentShader.init(theCtx, FRAGMENT_SHADER);
+    aFragmentShader.init(theCtx, myIsMultiRes ? "#define ST_MULTIRES\n" : "\n", FRAGMENT_SHADER);
     if(!StGLProgram::create(theCtx)
        .attachShader(theCtx, aVertexShader)
        .attachShader(theCtx, aFragmentShader)
@@ -75,6 +92,14 @@ bool StProgramBarrel::init(StGLContext& theCtx) {
     uniLensCenterLoc = StGLProgram::getUniformLocation(theCtx, "uLensCenter");
     uniScaleLoc      = StGLProgram::getUniformLocation(theCtx, "uScale");
     uniScaleInLoc    = StGLProgram::getUniformLocation(theCtx, "uScaleIn");
+    if(myIsMultiRes) {
+        uniInsetRectLoc  = StGLProgram::getUniformLocation(theCtx, "uInsetRect");
+        uniInsetScaleLoc = StGLProgram::getUniformLocation(theCtx, "uInsetScale");
+        const StGLVarLocation aTexInsetLoc = StGLProgram::getUniformLocation(theCtx, "texInset");
+        use(theCtx);
+        theCtx.core20fwd->glUniform1i(aTexInsetLoc, 1);
+        unuse(theCtx);
+    }
     return true;
 }
 
@@ -112,3 +137,15 @@ void StProgramBarrel::setScaleIn(StGLContext&    theCtx,
     theCtx.core20fwd->glUniform2fv(uniScaleInLoc, 1, theVec);
     unuse(theCtx);
 }
+
+void StProgramBarrel::setInset(StGLContext&    theCtx,
+                               const StGLVec4& theRect,
+                               const StGLVec2& theScale) {
+    if(!myIsMultiRes) {
+        return;
+    }
+    use(theCtx);
+    theCtx.core20fwd->glUniform4fv(uniInsetRectLoc,  1, theRect);
+    theCtx.core20fwd->glUniform2fv(uniInsetScaleLoc, 1, theScale);
+    unuse(theCtx);
+}
@@ -13,6 +13,9 @@
 
 /**
  * Distortion GLSL program.
+ * Multi-resolution variant composes eye image from two textures:
+ * low-resolution texture covering whole field of view (texture unit 0)
+ * and full-resolution inset covering central area around lens center (texture unit 1).
  */
 class StProgramBarrel : public StGLProgram {
 
@@ -20,8 +23,14 @@ class StProgramBarrel : public StGLProgram {
 
     /**
      * Empty constructor.
+     * @param theIsMultiRes multi-resolution (lens-matched) variant sampling inset texture
      */
-    ST_LOCAL StProgramBarrel();
+    ST_LOCAL StProgramBarrel(const bool theIsMultiRes = false);
+
+    /**
+     * Return TRUE for multi-resolution variant.
+     */
+    ST_LOCAL bool isMultiRes() const { return myIsMultiRes; }
 
     /**
      * Position vertex attribute location.
@@ -59,6 +68,15 @@ class StProgramBarrel : public StGLProgram {
     ST_LOCAL void setScaleIn(StGLContext&    theCtx,
                              const StGLVec2& theVec);
 
+    /**
+     * Setup inset (multi-resolution variant only).
+     * @param theRect  inset rectangle (min x, min y, max x, max y) in texture coordinates of main texture
+     * @param theScale texture coordinates scale within inset texture
+     */
+    ST_LOCAL void setInset(StGLContext&    theCtx,
+                           const StGLVec4& theRect,
+                           const StGLVec2& theScale);
+
         private:
 
     StGLVarLocation uniChromAbLoc;
@@ -66,6 +84,9 @@ class StProgramBarrel : public StGLProgram {
     StGLVarLocation uniLensCenterLoc;
     StGLVarLocation uniScaleLoc;
     StGLVarLocation uniScaleInLoc;
+    StGLVarLocation uniInsetRectLoc;
+    StGLVarLocation uniInsetScaleLoc;
+    bool            myIsMultiRes;
 
 };
 
@@ -0,0 +1,148 @@
+/**
+ * StRenderScale, dynamic render resolution controller for StOutDistorted using GPU timer queries.
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#include "StRenderScale.h"
+
+#include <StGL/StGLFunctions.h>
+
+#include <cmath>
+
+#ifndef GL_TIME_ELAPSED
+    #define GL_TIME_ELAPSED 0x88BF
+#endif
+
+StRenderScale::StRenderScale()
+: myQueryIter(0),
+  myIsInit(false),
+  myHasTimer(false),
+  myFrameTimer(true),
+  myAdjustTimer(true),
+  myGpuTimeMs(0.0),
+  myFrameTimeMs(0.0),
+  myScale(1.0f),
+  myScaleMin(0.5f),
+  myScaleMax(1.0f) {
+    stMemZero(myQueries,   sizeof(myQueries));
+    stMemZero(myIsPending, sizeof(myIsPending));
+}
+
+StRenderScale::~StRenderScale() {
+    ST_ASSERT(!myHasTimer, "~StRenderScale() with unreleased GL resources");
+}
+
+void StRenderScale::release(StGLContext& theCtx) {
+#if !defined(GL_ES_VERSION_2_0)
+    if(myHasTimer) {
+        theCtx.extAll->glDeleteQueries(THE_NB_QUERIES, myQueries);
+    }
+#else
+    (void )theCtx;
+#endif
+    stMemZero(myQueries,   sizeof(myQueries));
+    stMemZero(myIsPending, sizeof(myIsPending));
+    myQueryIter = 0;
+    myHasTimer  = false;
+    myIsInit    = false;
+}
+
+void StRenderScale::stglBegin(StGLContext& theCtx) {
+#if !defined(GL_ES_VERSION_2_0)
+    if(!myIsInit) {
+        myIsInit = true;
+        myHasTimer = theCtx.extAll->glGenQueries != NULL
+                  && (theCtx.isGlGreaterEqual(3, 3)
+                   || theCtx.stglCheckExtension("GL_ARB_timer_query")
+                   || theCtx.stglCheckExtension("GL_EXT_timer_query"));
+        if(myHasTimer) {
+            theCtx.extAll->glGenQueries(THE_NB_QUERIES, myQueries);
+        }
+    }
+    if(!myHasTimer) {
+        return;
+    }
+
+    // retrieve results of previously issued queries without waiting
+    for(int aQueryIter = 0; aQueryIter < THE_NB_QUERIES; ++aQueryIter) {
+        if(!myIsPending[aQueryIter]) {
+            continue;
+        }
+        GLuint isAvailable = GL_FALSE;
+        theCtx.extAll->glGetQueryObjectuiv(myQueries[aQueryIter], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if(isAvailable == GL_FALSE) {
+            continue;
+        }
+
+        GLuint aTimeNs = 0;
+        theCtx.extAll->glGetQueryObjectuiv(myQueries[aQueryIter], GL_QUERY_RESULT, &aTimeNs);
+        myIsPending[aQueryIter] = false;
+        const double aTimeMs = double(aTimeNs) * 0.000001;
+        myGpuTimeMs = myGpuTimeMs > 0.0 ? (myGpuTimeMs * 0.8 + aTimeMs * 0.2) : aTimeMs;
+    }
+
+    if(myIsPending[myQueryIter]) {
+        return; // all queries are in flight - skip measurement of this frame
+    }
+    theCtx.extAll->glBeginQuery(GL_TIME_ELAPSED, myQueries[myQueryIter]);
+    myIsPending[myQueryIter] = true;
+#else
+    (void )theCtx;
+#endif
+}
+
+void StRenderScale::stglEnd(StGLContext& theCtx) {
+    const double anIntervalMs = myFrameTimer.getElapsedTimeInMilliSec();
+    myFrameTimer.restart();
+    if(anIntervalMs < 1000.0) {
+        myFrameTimeMs = myFrameTimeMs > 0.0 ? (myFrameTimeMs * 0.8 + anIntervalMs * 0.2) : anIntervalMs;
+    }
+
+#if !defined(GL_ES_VERSION_2_0)
+    if(!myHasTimer
+    || !myIsPending[myQueryIter]) {
+        return;
+    }
+    theCtx.extAll->glEndQuery(GL_TIME_ELAPSED);
+    myQueryIter = (myQueryIter + 1) % THE_NB_QUERIES;
+#else
+    (void )theCtx;
+#endif
+}
+
+float StRenderScale::update(const double theBudgetMs) {
+    if(theBudgetMs <= 0.0
+    || myAdjustTimer.getElapsedTimeInMilliSec() < 250.0) {
+        return myScale;
+    }
+
+    float aNewScale = myScale;
+    if(myHasTimer) {
+        if(myGpuTimeMs <= 0.0) {
+            return myScale;
+        }
+
+        // keep some headroom for the rest of the frame (GUI, distortion pass, compositor)
+        const double aRatio = myGpuTimeMs / (theBudgetMs * 0.8);
+        if(aRatio > 1.05) {
+            // number of pixels is proportional to squared scale
+            aNewScale = myScale * float(stMax(0.85, std::sqrt(1.0 / aRatio)));
+        } else if(aRatio < 0.7) {
+            aNewScale = myScale * float(stMin(1.05, std::sqrt(1.0 / aRatio)));
+        }
+    } else if(myFrameTimeMs > 0.0) {
+        if(myFrameTimeMs > theBudgetMs * 1.4) {
+            aNewScale = myScale * 0.9f; // frames are missed
+        } else if(myAdjustTimer.getElapsedTimeInSec() > 3.0) {
+            aNewScale = myScale * 1.05f;
+        } else {
+            return myScale;
+        }
+    }
+
+    myScale = stMin(stMax(aNewScale, myScaleMin), myScaleMax);
+    myAdjustTimer.restart();
+    return myScale;
+}
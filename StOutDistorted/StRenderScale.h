@@ -0,0 +1,103 @@
+/**
+ * StRenderScale, dynamic render resolution controller for StOutDistorted using GPU timer queries.
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#ifndef __StRenderScale_h_
+#define __StRenderScale_h_
+
+#include <StGL/StGLContext.h>
+#include <StThreads/StTimer.h>
+
+/**
+ * Dynamic render resolution controller.
+ * Measures GPU time spent on eye buffers rendering using asynchronous timer queries (when available)
+ * and adjusts render scale to fit into the frame time budget.
+ * Without timer queries, frame interval is used instead - scale is reduced on missed frames
+ * and slowly restored when the frame rate is stable.
+ */
+class StRenderScale {
+
+        public:
+
+    /**
+     * Empty constructor.
+     */
+    ST_LOCAL StRenderScale();
+
+    /**
+     * Destructor, should be called after release().
+     */
+    ST_LOCAL ~StRenderScale();
+
+    /**
+     * Release GL resources.
+     */
+    ST_LOCAL void release(StGLContext& theCtx);
+
+    /**
+     * Setup scale range.
+     */
+    ST_LOCAL void setRange(const float theMin,
+                           const float theMax) {
+        myScaleMin = theMin;
+        myScaleMax = theMax;
+        myScale    = stMin(stMax(myScale, myScaleMin), myScaleMax);
+    }
+
+    /**
+     * Return current render scale.
+     */
+    ST_LOCAL float getScale() const { return myScale; }
+
+    /**
+     * Return filtered GPU time of measured section (in milliseconds) or frame interval if GPU timer is unavailable.
+     */
+    ST_LOCAL double getFrameTimeMs() const { return myHasTimer ? myGpuTimeMs : myFrameTimeMs; }
+
+    /**
+     * Return TRUE if GPU timer queries are used.
+     */
+    ST_LOCAL bool hasGpuTimer() const { return myHasTimer; }
+
+    /**
+     * Start GPU time measurement.
+     */
+    ST_LOCAL void stglBegin(StGLContext& theCtx);
+
+    /**
+     * Finish GPU time measurement.
+     */
+    ST_LOCAL void stglEnd(StGLContext& theCtx);
+
+    /**
+     * Adjust render scale according to measured time.
+     * @param theBudgetMs frame time budget in milliseconds
+     * @return new render scale
+     */
+    ST_LOCAL float update(const double theBudgetMs);
+
+        private:
+
+    enum { THE_NB_QUERIES = 4 }; //!< number of queries in flight to avoid pipeline stalls
+
+        private:
+
+    GLuint  myQueries[THE_NB_QUERIES];  //!< timer queries ring
+    bool    myIsPending[THE_NB_QUERIES];//!< query has been issued and result is not yet retrieved
+    int     myQueryIter;                //!< current query in the ring
+    bool    myIsInit;                   //!< timer queries initialization has been performed
+    bool    myHasTimer;                 //!< GPU timer queries are available
+    StTimer myFrameTimer;               //!< timer measuring frame interval
+    StTimer myAdjustTimer;              //!< timer since last scale adjustment
+    double  myGpuTimeMs;                //!< filtered GPU time
+    double  myFrameTimeMs;              //!< filtered frame interval
+    float   myScale;                    //!< current render scale
+    float   myScaleMin;                 //!< minimal render scale
+    float   myScaleMax;                 //!< maximal render scale
+
+};
+
+#endif // __StRenderScale_h_
@@ -87,6 +87,7 @@ namespace {
         STTR_PARAMETER_BIND_MON = 1103,
         STTR_PARAMETER_USE_MASK = 1104,
         STTR_PARAMETER_SMOOTHING= 1105,
+        STTR_PARAMETER_STENCIL  = 1106,
 
         // about info
         STTR_PLUGIN_TITLE       = 2000,
@@ -227,6 +228,7 @@ void StOutInterlace::getDevices(StOutDevicesList& theList) const {
 void StOutInterlace::getOptions(StParamsList& theList) const {
     theList.add(params.ToReverse);
     theList.add(params.ToSmooth);
+    theList.add(params.ToUseStencil);
 #if !defined(__ANDROID__)
     theList.add(params.BindToMon);
 #endif
@@ -250,6 +252,7 @@ void StOutInterlace::updateStrings() {
     params.BindToMon->setName(aLangMap.changeValueId(STTR_PARAMETER_BIND_MON, "Bind To Supported Monitor"));
     params.ToUseMask->setName(aLangMap.changeValueId(STTR_PARAMETER_USE_MASK, "Use texture mask (compatibility)"));
     params.ToSmooth ->setName(aLangMap.changeValueId(STTR_PARAMETER_SMOOTHING,"Smoothing"));
+    params.ToUseStencil->setName(aLangMap.changeValueId(STTR_PARAMETER_STENCIL, "Stencil masking (without smoothing)"));
 
     // about string
     StString& aTitle     = aLangMap.changeValueId(STTR_PLUGIN_TITLE,   "sView - Interlaced Output library");
@@ -269,6 +272,10 @@ StOutInterlace::StOutInterlace(const StHandle<StResourceManager>& theResMgr,
   myTextureMaskEmpty(new StGLTexture(GL_ALPHA)),
   myTexMaskDevice(DEVICE_AUTO),
   myTexMaskReversed(false),
+  myStencilDevice(DEVICE_AUTO),
+  myStencilReversed(false),
+  myStencilSizeX(0),
+  myStencilSizeY(0),
   myDevice(DEVICE_AUTO),
   myBarrierState(BarrierState_Unknown),
   myEDTimer(true),
@@ -380,6 +387,7 @@ StOutInterlace::StOutInterlace(const StHandle<StResourceManager>& theResMgr,
     params.BindToMon = new StBoolParamNamed(true,  stCString("bindMonitor"), stCString("bindMonitor"));
     params.ToUseMask = new StBoolParamNamed(false, stCString("useMask"),     stCString("useMask"));
     params.ToSmooth  = new StBoolParamNamed(true,  stCString("toSmooth"),    stCString("toSmooth"));
+    params.ToUseStencil = new StBoolParamNamed(true, stCString("useStencil"), stCString("useStencil"));
 #if defined(__ANDROID__)
     params.ToSmooth->setValue (false);
 #endif
@@ -388,6 +396,7 @@ StOutInterlace::StOutInterlace(const StHandle<StResourceManager>& theResMgr,
     mySettings->loadParam(params.ToReverse);
     mySettings->loadParam(params.BindToMon);
     mySettings->loadParam(params.ToSmooth);
+    mySettings->loadParam(params.ToUseStencil);
     myIsFirstDraw = !mySettings->loadParam(params.ToUseMask);
     params.BindToMon->signals.onChanged.connect(this, &StOutInterlace::doSetBindToMonitor);
 
@@ -462,6 +471,7 @@ void StOutInterlace::releaseResources() {
         myGlProgramMask->release(*myContext);
     }
     myContext.nullify();
+    myStencilDevice = DEVICE_AUTO;
 
     // read windowed placement
     StWindow::hide();
@@ -519,6 +529,7 @@ void StOutInterlace::beforeClose() {
     mySettings->saveParam(params.ToReverse);
     mySettings->saveParam(params.ToUseMask);
     mySettings->saveParam(params.ToSmooth);
+    mySettings->saveParam(params.ToUseStencil);
     mySettings->saveInt32(ST_SETTING_DEVICE_ID,    myDevice);
     mySettings->flush();
 
@@ -904,6 +915,32 @@ bool StOutInterlace::initTextureMask(int  theDevice,
     return true;
 }
 
+void StOutInterlace::stglDrawStencilMask(const StHandle<StProgramFB>& theProgram) {
+    myContext->core20fwd->glDisable(GL_DEPTH_TEST);
+    myContext->core20fwd->glDisable(GL_BLEND);
+    myContext->core20fwd->glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    myContext->core20fwd->glClearStencil(0);
+    myContext->core20fwd->glClear(GL_STENCIL_BUFFER_BIT);
+    myContext->core20fwd->glEnable(GL_STENCIL_TEST);
+    myContext->core20fwd->glStencilFunc(GL_ALWAYS, 1, 0xFF);
+    myContext->core20fwd->glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+
+    // the same discard rules as within composition pass
+    theProgram->use(*myContext);
+    myQuadVertBuf.bindVertexAttrib(*myContext, ST_VATTRIB_VERTEX);
+    myQuadTexCoordBuf.bindVertexAttrib(*myContext, ST_VATTRIB_TCOORD);
+    myContext->core20fwd->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    myQuadTexCoordBuf.unBindVertexAttrib(*myContext, ST_VATTRIB_TCOORD);
+    myQuadVertBuf.unBindVertexAttrib(*myContext, ST_VATTRIB_VERTEX);
+    theProgram->unuse(*myContext);
+
+    // setup state for drawing the view (enabled by caller)
+    myContext->core20fwd->glStencilFunc(GL_EQUAL, 1, 0xFF);
+    myContext->core20fwd->glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    myContext->core20fwd->glDisable(GL_STENCIL_TEST);
+    myContext->core20fwd->glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
 void StOutInterlace::stglDrawEDCodes() {
     if(myEDTimer.getElapsedTime() > 0.5) {
         StWindow::hide(ST_WIN_SLAVE);
@@ -962,7 +999,7 @@ void StOutInterlace::stglDraw() {
     const StGLBoxPx aVPort = StWindow::stglViewport(ST_WIN_MASTER);
     myContext->stglResizeViewport(aVPort);
     const bool toSmooth = params.ToSmooth->getValue();
-    if(!toSmooth || !StWindow::isStereoOutput() || myIsBroken) {
+    if(!StWindow::isStereoOutput() || myIsBroken) {
         StWindow::signals.onRedraw(ST_DRAW_LEFT);
     }
 
@@ -980,6 +1017,7 @@ void StOutInterlace::stglDraw() {
         if(myToCompressMem) {
             myFrmBuffer->release(*myContext);
             myTextureMask->release(*myContext);
+            myStencilDevice = DEVICE_AUTO;
         }
 
         if(myDevice == DEVICE_ROW_INTERLACED_ED) {
@@ -1016,10 +1054,23 @@ void StOutInterlace::stglDraw() {
     aBackStore.height() = aWinRect.height();
     convertRectToBacking(aBackStore, ST_WIN_MASTER);
 
+    // stencil masking is incompatible with smoothing, which blends neighbor rows of the same view;
+    // packed depth-stencil buffer is used within FBO
+    const bool toUseTexMask = params.ToUseMask->getValue();
+    const bool toUseStencil = !toSmooth
+                           && !toUseTexMask
+                           &&  params.ToUseStencil->getValue()
+                           &&  myContext->isGlGreaterEqual(3, 0);
+    if(toUseStencil
+    && myFrmBuffer->isValid()
+    && !myFrmBuffer->hasStencilBuffer()) {
+        myFrmBuffer->release(*myContext);
+    }
+
     // resize FBO
     if(!myFrmBuffer->initLazy(*myContext,
                               myContext->isDeepColorWindow() ? GL_RGB10_A2 : GL_RGBA8,
-                              aVPort.width(), aVPort.height(), StWindow::hasDepthBuffer())) {
+                              aVPort.width(), aVPort.height(), StWindow::hasDepthBuffer() || toUseStencil)) {
         myMsgQueue->pushError(stCString("Interlace output - critical error:\nFrame Buffer Object resize failed!"));
         myIsBroken = true;
         return;
@@ -1077,7 +1128,6 @@ void StOutInterlace::stglDraw() {
     }
 
     // initialize mask texture
-    const bool toUseTexMask = params.ToUseMask->getValue();
     if(toUseTexMask) {
         if(!initTextureMask(aDevice, isPixelReverse, myFrmBuffer->getSizeX(), myFrmBuffer->getSizeY())) {
             return;
@@ -1096,6 +1146,53 @@ void StOutInterlace::stglDraw() {
     aTCoords[3] = StGLVec2(0.0f, aDY);
     myQuadTexCoordBuf.init(*myContext, aTCoords);
 
+    if(!toSmooth) {
+        // draw LEFT view directly into the window,
+        // rasterization is restricted to its rows when window buffer has stencil bits
+        const bool toMaskWindow = toUseStencil && myContext->getWindowBits().Stencil > 0;
+        myContext->stglResizeViewport(aVPort);
+        if(toMaskWindow) {
+            stglDrawStencilMask(!isPixelReverse ? myGlProgramsRev[aDevice] : myGlPrograms[aDevice]);
+            myContext->core20fwd->glEnable(GL_STENCIL_TEST);
+        }
+        StWindow::signals.onRedraw(ST_DRAW_LEFT);
+        if(toMaskWindow) {
+            myContext->core20fwd->glDisable(GL_STENCIL_TEST);
+        }
+    }
+
+    // stencil mask within FBO for the RIGHT view - FBO pixels are shifted by viewport origin
+    const bool toMaskFbo = toUseStencil && myFrmBuffer->hasStencilBuffer();
+    if(toMaskFbo) {
+        bool isStencilReverse = isPixelReverse;
+        switch(aDevice) {
+            case DEVICE_ROW_INTERLACED:
+            case DEVICE_ROW_INTERLACED_ED:
+                isStencilReverse = (aVPort.y() % 2 != 0) ? !isStencilReverse : isStencilReverse; break;
+            case DEVICE_COL_INTERLACED:
+            case DEVICE_COL_INTERLACED_MI3D:
+                isStencilReverse = (aVPort.x() % 2 != 0) ? !isStencilReverse : isStencilReverse; break;
+            case DEVICE_CHESSBOARD:
+                isStencilReverse = ((aVPort.x() + aVPort.y()) % 2 != 0) ? !isStencilReverse : isStencilReverse; break;
+        }
+
+        if(myStencilDevice   != aDevice
+        || myStencilReversed != isStencilReverse
+        || myStencilSizeX    != myFrmBuffer->getSizeX()
+        || myStencilSizeY    != myFrmBuffer->getSizeY()) {
+            // mask is preserved between frames, since views never clear stencil buffer
+            myFrmBuffer->bindBuffer(*myContext);
+            myContext->stglResizeViewport(myFrmBuffer->getSizeX(), myFrmBuffer->getSizeY());
+            stglDrawStencilMask(isStencilReverse ? myGlProgramsRev[aDevice] : myGlPrograms[aDevice]);
+            myFrmBuffer->unbindBuffer(*myContext);
+
+            myStencilDevice   = aDevice;
+            myStencilReversed = isStencilReverse;
+            myStencilSizeX    = myFrmBuffer->getSizeX();
+            myStencilSizeY    = myFrmBuffer->getSizeY();
+        }
+    }
+
     for(int anEyeIter = toSmooth ? 0 : 1; anEyeIter < 2; ++anEyeIter) {
         const int anEye = (anEyeIter == 0) ? ST_DRAW_LEFT : ST_DRAW_RIGHT;
         const bool toReverseReverse = (anEyeIter == 0) ? !isPixelReverse : isPixelReverse;
@@ -1103,7 +1200,13 @@ void StOutInterlace::stglDraw() {
         // draw into virtual frame buffer
         myFrmBuffer->setupViewPort(*myContext); // we set TEXTURE sizes here
         myFrmBuffer->bindBuffer(*myContext);
+        if(toMaskFbo) {
+            myContext->core20fwd->glEnable(GL_STENCIL_TEST);
+        }
             StWindow::signals.onRedraw(anEye);
+        if(toMaskFbo) {
+            myContext->core20fwd->glDisable(GL_STENCIL_TEST);
+        }
         myFrmBuffer->unbindBuffer(*myContext);
 
         myContext->core20fwd->glDisable(GL_DEPTH_TEST);
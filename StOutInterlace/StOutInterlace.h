@@ -153,6 +153,12 @@ class StOutInterlace : public StWindow {
                                   int  theSizeX,
                                   int  theSizeY);
 
+    /**
+     * Write stencil mask (value 1) for the pixels passing discard test of specified program.
+     * Color writes are disabled during this pass, so that only stencil buffer of currently bound frame buffer is modified.
+     */
+    ST_LOCAL void stglDrawStencilMask(const StHandle<StProgramFB>& theProgram);
+
     /**
      * Release GL resources before window closing.
      */
@@ -190,6 +196,7 @@ class StOutInterlace : public StWindow {
         StHandle<StBoolParamNamed> BindToMon; //!< flag to bind to monitor
         StHandle<StBoolParamNamed> ToUseMask; //!< use mask texture instead of straightforward discard shader
         StHandle<StBoolParamNamed> ToSmooth;  //!< blend rows to smooth aliasing
+        StHandle<StBoolParamNamed> ToUseStencil; //!< restrict rendering of the views to their rows using stencil buffer
 
     } params;
 
@@ -223,6 +230,10 @@ class StOutInterlace : public StWindow {
     StHandle<StGLTexture>     myTextureMaskEmpty;         //!< empty texture (no discard)
     int                       myTexMaskDevice;            //!< texture mask device
     bool                      myTexMaskReversed;          //!< texture mask is initialized in reversed state
+    int                       myStencilDevice;            //!< device of the stencil mask within FBO
+    bool                      myStencilReversed;          //!< stencil mask within FBO is initialized in reversed state
+    GLsizei                   myStencilSizeX;             //!< FBO dimensions at the moment of stencil mask initialization
+    GLsizei                   myStencilSizeY;
 
     StGLVertexBuffer          myQuadVertBuf;
     StGLVertexBuffer          myQuadTexCoordBuf;
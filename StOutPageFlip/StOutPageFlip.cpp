@@ -530,6 +530,9 @@ StOutPageFlip::StOutPageFlip(const StHandle<StResourceManager>& theResMgr,
     aDevShutters->PluginId = ST_OUT_PLUGIN_NAME;
     aDevShutters->DeviceId = stCString("Shutters");
     aDevShutters->Priority = aSupportLevelShutters;
+#if !defined(__APPLE__)
+    aDevShutters->IsProbed = true;
+#endif
     aDevShutters->Name     = stCString("Shutter glasses");
     myDevices.add(aDevShutters);
 
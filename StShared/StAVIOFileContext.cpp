@@ -10,8 +10,9 @@ extern "C" {
     #include <libavutil/error.h>
 };
 
-StAVIOFileContext::StAVIOFileContext()
-: myFile(NULL) {
+StAVIOFileContext::StAVIOFileContext(const int theBufferSize)
+: StAVIOContext(theBufferSize),
+  myFile(NULL) {
     //
 }
 
@@ -20,6 +21,7 @@ StAVIOFileContext::~StAVIOFileContext() {
 }
 
 void StAVIOFileContext::close() {
+    myReadAhead.nullify();
     if(myFile != NULL) {
         fclose(myFile);
         myFile = NULL;
@@ -36,8 +38,24 @@ bool StAVIOFileContext::openFromDescriptor(int theFD, const char* theMode) {
     return myFile != NULL;
 }
 
+bool StAVIOFileContext::openReadAhead(const StCString& theFilePath,
+                                      const int        theFD,
+                                      const bool       theToMap) {
+    close();
+    myReadAhead = new StReadAheadFile();
+    if(!myReadAhead->open(theFilePath, theFD, theToMap)) {
+        myReadAhead.nullify();
+        return false;
+    }
+    return true;
+}
+
 int StAVIOFileContext::read(uint8_t* theBuf,
                             int      theBufSize) {
+    if(!myReadAhead.isNull()) {
+        const int aNbRead = myReadAhead->read(theBuf, theBufSize);
+        return aNbRead == 0 ? AVERROR_EOF : aNbRead;
+    }
 
     if(myFile == NULL) {
         return -1;
@@ -63,6 +81,12 @@ int StAVIOFileContext::write(const uint8_t* theBuf,
 
 int64_t StAVIOFileContext::seek(int64_t theOffset,
                                 int     theWhence) {
+    if(!myReadAhead.isNull()) {
+        return theWhence == AVSEEK_SIZE
+             ? myReadAhead->getSize()
+             : myReadAhead->seek(theOffset, theWhence & ~AVSEEK_FORCE);
+    }
+
     if(theWhence == AVSEEK_SIZE
     || myFile == NULL) {
         return -1;
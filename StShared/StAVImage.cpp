@@ -20,7 +20,8 @@ bool StAVImage::init() {
 StAVImage::StAVImage()
 : myFormatCtx(NULL),
   myCodecCtx(NULL),
-  myCodec(NULL) {
+  myCodec(NULL),
+  myLowRes(0) {
     StAVImage::init();
 }
 
@@ -268,6 +269,7 @@ bool StAVImage::loadExtra(const StString& theFilePath,
 
     AVInputFormat* anImgFormat = NULL;
     bool isForcedCodec = false;
+    int  aStreamId = 0;
     switch(theImageType) {
         case ST_TYPE_PNG:
         case ST_TYPE_PNS: {
@@ -360,15 +362,21 @@ bool StAVImage::loadExtra(const StString& theFilePath,
             return false;
         }
 
+        // video files might start with audio or cover art streams
+        const int aBestStream = av_find_best_stream(myFormatCtx, AVMEDIA_TYPE_VIDEO, -1, -1, NULL, 0);
+        if(aBestStream >= 0) {
+            aStreamId = aBestStream;
+        }
+
         // find the decoder for the video stream
     #if(LIBAVFORMAT_VERSION_INT < AV_VERSION_INT(59, 0, 100))
-        myCodecCtx = stAV::getCodecCtx(myFormatCtx->streams[0]);
+        myCodecCtx = stAV::getCodecCtx(myFormatCtx->streams[aStreamId]);
         if (!isForcedCodec) {
             myCodec = avcodec_find_decoder(myCodecCtx->codec_id);
         }
     #else
         if (!isForcedCodec) {
-            myCodec = avcodec_find_decoder(myFormatCtx->streams[0]->codecpar->codec_id);
+            myCodec = avcodec_find_decoder(myFormatCtx->streams[aStreamId]->codecpar->codec_id);
         }
     #endif
     }
@@ -380,6 +388,14 @@ bool StAVImage::loadExtra(const StString& theFilePath,
     } else if(myFormatCtx == NULL || myCodecCtx == NULL) {
         // use given image type to load decoder
         myCodecCtx = avcodec_alloc_context3(myCodec);
+    #if(LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(59, 0, 100))
+        if(myCodecCtx != NULL
+        && myFormatCtx != NULL
+        && !isForcedCodec) {
+            // extra data is required to decode video streams
+            avcodec_parameters_to_context(myCodecCtx, myFormatCtx->streams[aStreamId]->codecpar);
+        }
+    #endif
     }
 
     // stupid check
@@ -389,6 +405,10 @@ bool StAVImage::loadExtra(const StString& theFilePath,
         return false;
     }
 
+    if(myLowRes > 0) {
+        myCodecCtx->lowres = stMin(myLowRes, (int )myCodec->max_lowres);
+    }
+
     // open VIDEO codec
     if(avcodec_open2(myCodecCtx, myCodec, NULL) < 0) {
         setState("AVCodec library, could not open video codec");
@@ -404,10 +424,16 @@ bool StAVImage::loadExtra(const StString& theFilePath,
         anAvPkt.getAVpkt()->size = theDataSize;
     } else {
         if(myFormatCtx != NULL) {
-            if(av_read_frame(myFormatCtx, anAvPkt.getAVpkt()) < 0) {
-                setState("AVFormat library, could not read first packet");
-                close();
-                return false;
+            for(;;) {
+                if(av_read_frame(myFormatCtx, anAvPkt.getAVpkt()) < 0) {
+                    setState("AVFormat library, could not read first packet");
+                    close();
+                    return false;
+                } else if(anAvPkt.getStreamId() == aStreamId) {
+                    break;
+                }
+                // skip packets of other streams (like audio within video file)
+                anAvPkt.free();
             }
         } else {
             if(!aRawFile.readFile()) {
@@ -423,9 +449,14 @@ bool StAVImage::loadExtra(const StString& theFilePath,
 
     // decode one frame
     int isFrameFinished = 0;
-    if(avcodec_send_packet(myCodecCtx, anAvPkt.getAVpkt()) == 0
-    && avcodec_receive_frame(myCodecCtx, myFrame.Frame) == 0) {
-        isFrameFinished = 1;
+    if(avcodec_send_packet(myCodecCtx, anAvPkt.getAVpkt()) == 0) {
+        int aResult = avcodec_receive_frame(myCodecCtx, myFrame.Frame);
+        if(aResult == AVERROR(EAGAIN)) {
+            // video decoders may delay output - flush decoder to retrieve the frame
+            avcodec_send_packet(myCodecCtx, NULL);
+            aResult = avcodec_receive_frame(myCodecCtx, myFrame.Frame);
+        }
+        isFrameFinished = aResult == 0 ? 1 : 0;
     }
 
     if(isFrameFinished == 0) {
@@ -480,9 +511,9 @@ bool StAVImage::loadExtra(const StString& theFilePath,
             aTag = stAV::meta::findTag(myFormatCtx->metadata, "", aTag, stAV::meta::SEARCH_IGNORE_SUFFIX)) {
             myMetadata.add(StDictEntry(aTag->key, aTag->value));
         }
-        for(stAV::meta::Tag* aTag = stAV::meta::findTag(myFormatCtx->streams[0]->metadata, "", NULL, stAV::meta::SEARCH_IGNORE_SUFFIX);
+        for(stAV::meta::Tag* aTag = stAV::meta::findTag(myFormatCtx->streams[aStreamId]->metadata, "", NULL, stAV::meta::SEARCH_IGNORE_SUFFIX);
             aTag != NULL;
-            aTag = stAV::meta::findTag(myFormatCtx->streams[0]->metadata, "", aTag, stAV::meta::SEARCH_IGNORE_SUFFIX)) {
+            aTag = stAV::meta::findTag(myFormatCtx->streams[aStreamId]->metadata, "", aTag, stAV::meta::SEARCH_IGNORE_SUFFIX)) {
             myMetadata.add(StDictEntry(aTag->key, aTag->value));
         }
     }
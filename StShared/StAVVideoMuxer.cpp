@@ -1,5 +1,5 @@
 /**
- * Copyright © 2015-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2015-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * This code is licensed under MIT license (see docs/license-mit.txt for details).
  */
@@ -9,11 +9,60 @@
 #include <StAV/StAVPacket.h>
 #include <StStrings/StLogger.h>
 #include <StFile/StFileNode.h>
+#include <StFile/StRawFile.h>
+#include <StThreads/StTimer.h>
 
+#include <deque>
 #include <vector>
 
+namespace {
+
+    /**
+     * Interval between progress notifications in seconds.
+     */
+    static const double THE_PROGRESS_INTERVAL = 0.5;
+
+    /**
+     * Packet within per-file lookahead queue.
+     */
+    struct StMuxPacket {
+        StHandle<StAVPacket> Packet; //!< packet referencing input data
+        int64_t              Dts;    //!< decoding time stamp in AV_TIME_BASE units used for ordering
+    };
+
+    /**
+     * Per-file lookahead queue sorted by DTS.
+     */
+    struct StMuxLookahead {
+        std::deque<StMuxPacket> Queue;     //!< packets sorted by DTS
+        int64_t                 LastDts;   //!< last known DTS, used for packets without time stamps
+        int64_t                 StartTime; //!< start time of the file in AV_TIME_BASE units
+
+        StMuxLookahead() : LastDts(AV_NOPTS_VALUE), StartTime(0) {}
+
+        /**
+         * Insert the packet keeping DTS order, but never moving it ahead of packets of the same stream.
+         */
+        void push(const StMuxPacket& thePacket) {
+            const int aStreamId = thePacket.Packet->getStreamId();
+            std::deque<StMuxPacket>::iterator anIter = Queue.end();
+            while(anIter != Queue.begin()) {
+                const StMuxPacket& aPrev = *(anIter - 1);
+                if(aPrev.Dts <= thePacket.Dts
+                || aPrev.Packet->getStreamId() == aStreamId) {
+                    break;
+                }
+                --anIter;
+            }
+            Queue.insert(anIter, thePacket);
+        }
+    };
+
+}
+
 StAVVideoMuxer::StAVVideoMuxer()
-: myStereoFormat(StFormat_Mono) {
+: myStereoFormat(StFormat_Mono),
+  myLookahead(16) {
     //
 }
 
@@ -144,9 +193,24 @@ const char* formatToMetadata(const StFormat theFormat) {
 bool StAVVideoMuxer::addStream(AVFormatContext* theContext,
                                AVStream*        theStream) {
 #if(LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(59, 0, 100))
-    // TODO
-    (void )theContext; (void )theStream;
-    return false;
+    AVStream* aStreamOut = avformat_new_stream(theContext, NULL);
+    if(aStreamOut == NULL) {
+        signals.onError(StString("Failed allocating output stream."));
+        return false;
+    }
+    if(avcodec_parameters_copy(aStreamOut->codecpar, theStream->codecpar) < 0) {
+        signals.onError(StString("Failed to copy codec parameters from input to output stream."));
+        return false;
+    }
+    // codec tag of input container might be invalid for output one
+    aStreamOut->codecpar->codec_tag = 0;
+    aStreamOut->time_base = theStream->time_base;
+    aStreamOut->disposition = theStream->disposition;
+    av_dict_copy(&aStreamOut->metadata, theStream->metadata, AV_DICT_DONT_OVERWRITE);
+    if(theStream->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
+        aStreamOut->sample_aspect_ratio = theStream->sample_aspect_ratio;
+    }
+    return true;
 #else
     AVCodecContext* aCodecCtxSrc = stAV::getCodecCtx(theStream);
     AVStream* aStreamOut = avformat_new_stream(theContext, aCodecCtxSrc->codec);
@@ -254,47 +318,283 @@ bool StAVVideoMuxer::save(const StString& theFile) {
         return false;
     }
 
+    // merge packets from all files in DTS order;
+    // each file is read ahead only by a few packets, so that memory usage remains bounded
+    std::vector<StMuxLookahead> aLookaheads(aSrcCtxList.size());
+    int64_t aDurationMax = 0;
+    for(size_t aCtxId = 0; aCtxId < aSrcCtxList.size(); ++aCtxId) {
+        const AVFormatContext* aCtx = aSrcCtxList[aCtxId].Context;
+        aLookaheads[aCtxId].StartTime = aCtx->start_time != AV_NOPTS_VALUE ? aCtx->start_time : 0;
+        if(aCtx->duration != AV_NOPTS_VALUE) {
+            aDurationMax = stMax(aDurationMax, int64_t(aCtx->duration));
+        }
+    }
+
+    const AVRational aTimeBaseQ = {1, AV_TIME_BASE};
+    Progress aProgress;
+    StTimer  aTimer(true);
+    double   aProgressLast = 0.0;
     StAVPacket aPacket;
     for(;;) {
-        size_t aNbEmpty = 0;
+        // fill lookahead queues
         for(size_t aCtxId = 0; aCtxId < aSrcCtxList.size(); ++aCtxId) {
-            StRemuxContext& aCtxSrc = aSrcCtxList[aCtxId];
-            if(!aCtxSrc.State) {
-                ++aNbEmpty;
-                continue;
-            }
-
-            if(av_read_frame(aCtxSrc.Context, aPacket.getAVpkt()) < 0) {
-                aCtxSrc.State = false;
-                ++aNbEmpty;
-                continue;
-            }
+            StRemuxContext& aCtxSrc    = aSrcCtxList[aCtxId];
+            StMuxLookahead& aLookahead = aLookaheads[aCtxId];
+            while(aCtxSrc.State
+               && aLookahead.Queue.size() < myLookahead) {
+                if(av_read_frame(aCtxSrc.Context, aPacket.getAVpkt()) < 0) {
+                    aCtxSrc.State = false;
+                    break;
+                }
 
-            unsigned int aStreamOutIndex = aCtxSrc.Streams[aPacket.getStreamId()];
-            if(aStreamOutIndex == (unsigned int )-1) {
-                continue;
-            }
+                const int aStreamId = aPacket.getStreamId();
+                if(aStreamId < 0
+                || size_t(aStreamId) >= aCtxSrc.Streams.size()
+                || aCtxSrc.Streams[aStreamId] == (unsigned int )-1) {
+                    aPacket.free();
+                    continue;
+                }
 
-            AVStream* aStreamIn  = aCtxSrc.Context->streams[aPacket.getStreamId()];
-            AVStream* aStreamOut = aCtxOut.Context->streams[aStreamOutIndex];
+                const AVStream* aStreamIn = aCtxSrc.Context->streams[aStreamId];
+                StMuxPacket aMuxPacket;
+                aMuxPacket.Dts = aLookahead.LastDts;
+                if(aPacket.getDts() != AV_NOPTS_VALUE) {
+                    aMuxPacket.Dts = av_rescale_q(aPacket.getDts(), aStreamIn->time_base, aTimeBaseQ);
+                } else if(aPacket.getPts() != AV_NOPTS_VALUE
+                       && aLookahead.LastDts == AV_NOPTS_VALUE) {
+                    aMuxPacket.Dts = av_rescale_q(aPacket.getPts(), aStreamIn->time_base, aTimeBaseQ);
+                }
+                if(aMuxPacket.Dts == AV_NOPTS_VALUE) {
+                    aMuxPacket.Dts = aLookahead.StartTime;
+                }
+                aLookahead.LastDts = aMuxPacket.Dts;
 
-            const AVRounding aRoundParams = AVRounding(AV_ROUND_NEAR_INF | AV_ROUND_PASS_MINMAX);
-            aPacket.getAVpkt()->pts      = av_rescale_q_rnd(aPacket.getPts(), aStreamIn->time_base, aStreamOut->time_base, aRoundParams);
-            aPacket.getAVpkt()->dts      = av_rescale_q_rnd(aPacket.getDts(), aStreamIn->time_base, aStreamOut->time_base, aRoundParams);
-            aPacket.getAVpkt()->duration = static_cast<int >(av_rescale_q(aPacket.getDuration(), aStreamIn->time_base, aStreamOut->time_base));
-            aPacket.getAVpkt()->pos      = -1;
+                // copy constructor only references packet data
+                aMuxPacket.Packet = new StAVPacket(aPacket);
+                aPacket.free();
+                aLookahead.push(aMuxPacket);
+            }
+        }
 
-            aState = av_interleaved_write_frame(aCtxOut.Context, aPacket.getAVpkt());
-            if(aState < 0) {
-                signals.onError(StString("Error muxing packet (") + stAV::getAVErrorDescription(aState) + ").");
-                return false;
+        // pick the packet with the smallest DTS
+        size_t  aCtxNext = size_t(-1);
+        int64_t aDtsNext = 0;
+        for(size_t aCtxId = 0; aCtxId < aLookaheads.size(); ++aCtxId) {
+            const StMuxLookahead& aLookahead = aLookaheads[aCtxId];
+            if(!aLookahead.Queue.empty()
+            && (aCtxNext == size_t(-1) || aLookahead.Queue.front().Dts < aDtsNext)) {
+                aCtxNext = aCtxId;
+                aDtsNext = aLookahead.Queue.front().Dts;
             }
-            aPacket.free();
         }
-        if(aNbEmpty == aSrcCtxList.size()) {
+        if(aCtxNext == size_t(-1)) {
             break;
         }
+
+        StRemuxContext& aCtxSrc    = aSrcCtxList[aCtxNext];
+        StMuxLookahead& aLookahead = aLookaheads[aCtxNext];
+        StHandle<StAVPacket> aMuxPacket = aLookahead.Queue.front().Packet;
+        aLookahead.Queue.pop_front();
+
+        const int    aStreamId       = aMuxPacket->getStreamId();
+        unsigned int aStreamOutIndex = aCtxSrc.Streams[aStreamId];
+        AVStream* aStreamIn  = aCtxSrc.Context->streams[aStreamId];
+        AVStream* aStreamOut = aCtxOut.Context->streams[aStreamOutIndex];
+
+        const AVRounding aRoundParams = AVRounding(AV_ROUND_NEAR_INF | AV_ROUND_PASS_MINMAX);
+        AVPacket* anAVPacket = aMuxPacket->getAVpkt();
+        anAVPacket->pts          = av_rescale_q_rnd(anAVPacket->pts, aStreamIn->time_base, aStreamOut->time_base, aRoundParams);
+        anAVPacket->dts          = av_rescale_q_rnd(anAVPacket->dts, aStreamIn->time_base, aStreamOut->time_base, aRoundParams);
+        anAVPacket->duration     = static_cast<int >(av_rescale_q(anAVPacket->duration, aStreamIn->time_base, aStreamOut->time_base));
+        anAVPacket->pos          = -1;
+        anAVPacket->stream_index = int(aStreamOutIndex);
+
+        const int aPacketSize = anAVPacket->size;
+        aState = av_interleaved_write_frame(aCtxOut.Context, anAVPacket);
+        if(aState < 0) {
+            signals.onError(StString("Error muxing packet (") + stAV::getAVErrorDescription(aState) + ").");
+            return false;
+        }
+
+        aProgress.NbBytes    += uint64_t(stMax(aPacketSize, 0));
+        aProgress.NbPackets  += 1;
+        aProgress.MediaTime   = stMax(aProgress.MediaTime, double(aDtsNext - aLookahead.StartTime) / double(AV_TIME_BASE));
+        aProgress.ElapsedTime = aTimer.getElapsedTimeInSec();
+        if(aProgress.ElapsedTime - aProgressLast >= THE_PROGRESS_INTERVAL) {
+            aProgressLast   = aProgress.ElapsedTime;
+            aProgress.Ratio = aDurationMax > 0 ? stMin(aProgress.MediaTime * double(AV_TIME_BASE) / double(aDurationMax), 1.0) : 0.0;
+            signals.onProgress(aProgress);
+        }
     }
     av_write_trailer(aCtxOut.Context);
+
+    aProgress.Ratio       = 1.0;
+    aProgress.ElapsedTime = aTimer.getElapsedTimeInSec();
+    signals.onProgress(aProgress);
+    return true;
+}
+
+namespace {
+
+    /**
+     * Redirects muxer messages to the batch, prefixed by job number.
+     */
+    class StMuxJobListener {
+
+            public:
+
+        StMuxJobListener(StAVVideoMuxerBatch* theBatch,
+                         const size_t         theJobIndex,
+                         const size_t         theNbJobs)
+        : myBatch(theBatch),
+          myPrefix(StString("[") + (theJobIndex + 1) + "/" + theNbJobs + "] ") {}
+
+        void doOnError(const StCString& theMessage) {
+            myBatch->emitMessage(myPrefix + "Error: " + theMessage);
+        }
+
+        void doOnProgress(const StAVVideoMuxer::Progress& theProgress) {
+            char aBuffer[256];
+            stsprintf(aBuffer, sizeof(aBuffer), "%5.1f%%, %.1f MiB, %.1fx",
+                      theProgress.Ratio * 100.0,
+                      double(theProgress.NbBytes) / (1024.0 * 1024.0),
+                      theProgress.getSpeed());
+            myBatch->emitMessage(myPrefix + aBuffer);
+        }
+
+            private:
+
+        StAVVideoMuxerBatch* myBatch;
+        StString             myPrefix;
+
+    };
+
+}
+
+StAVVideoMuxerBatch::StAVVideoMuxerBatch()
+: myNextJob(0),
+  myNbDone(0) {
+    //
+}
+
+StAVVideoMuxerBatch::~StAVVideoMuxerBatch() {
+    //
+}
+
+void StAVVideoMuxerBatch::addJob(const Job& theJob) {
+    if(theJob.Left.isEmpty()) {
+        return;
+    }
+
+    Job aJob = theJob;
+    if(aJob.Output.isEmpty()) {
+        StString aName, anExt;
+        StFileNode::getNameAndExtension(aJob.Left, aName, anExt);
+        aJob.Output = aName + ".mkv";
+        if(aJob.Output.isEqualsIgnoreCase(aJob.Left)) {
+            aJob.Output = aName + "-3d.mkv";
+        }
+    }
+    myJobs.push_back(aJob);
+}
+
+bool StAVVideoMuxerBatch::loadList(const StString& theListFile) {
+    const StString aContent = StRawFile::readTextFile(theListFile);
+    if(aContent.isEmpty()) {
+        return false;
+    }
+
+    StHandle< StArrayList<StString> > aLines = aContent.split('\n');
+    for(size_t aLineIter = 0; aLineIter < aLines->size(); ++aLineIter) {
+        StString aLine = aLines->getValue(aLineIter);
+        aLine.leftAdjust();
+        aLine.rightAdjust();
+        if(aLine.isEmpty()
+        || aLine.isStartsWith('#')) {
+            continue;
+        }
+
+        StHandle< StArrayList<StString> > aParts = aLine.split('|', 3);
+        Job aJob;
+        aJob.Left = aParts->getValue(0);
+        if(aParts->size() > 1) {
+            aJob.Right = aParts->getValue(1);
+        }
+        if(aParts->size() > 2) {
+            aJob.Output = aParts->getValue(2);
+        }
+        addJob(aJob);
+    }
     return true;
 }
+
+void StAVVideoMuxerBatch::emitMessage(const StString& theMessage) {
+    StMutexAuto aLock(myMutex);
+    signals.onMessage(theMessage);
+}
+
+SV_THREAD_FUNCTION StAVVideoMuxerBatch::workerThread(void* theBatch) {
+    StAVVideoMuxerBatch* aBatch = (StAVVideoMuxerBatch* )theBatch;
+    aBatch->workerLoop();
+    return SV_THREAD_RETURN 0;
+}
+
+void StAVVideoMuxerBatch::workerLoop() {
+    for(;;) {
+        size_t aJobIndex = 0;
+        {
+            StMutexAuto aLock(myMutex);
+            if(myNextJob >= myJobs.size()) {
+                return;
+            }
+            aJobIndex = myNextJob++;
+        }
+
+        const bool isDone = performJob(aJobIndex);
+        StMutexAuto aLock(myMutex);
+        if(isDone) {
+            ++myNbDone;
+        }
+    }
+}
+
+bool StAVVideoMuxerBatch::performJob(const size_t theJobIndex) {
+    const Job& aJob = myJobs[theJobIndex];
+    StMuxJobListener aListener(this, theJobIndex, myJobs.size());
+    StAVVideoMuxer   aMuxer;
+    aMuxer.signals.onError   .connect(&aListener, &StMuxJobListener::doOnError);
+    aMuxer.signals.onProgress.connect(&aListener, &StMuxJobListener::doOnProgress);
+    if(!aMuxer.addFile(aJob.Left)
+    || (!aJob.Right.isEmpty() && !aMuxer.addFile(aJob.Right))) {
+        return false;
+    }
+
+    aMuxer.setStereoFormat(!aJob.Right.isEmpty() ? StFormat_SeparateFrames : StFormat_Mono);
+    const bool isDone = aMuxer.save(aJob.Output);
+    aMuxer.close();
+    emitMessage(StString("[") + (theJobIndex + 1) + "/" + myJobs.size() + "] "
+              + (isDone ? "Saved " : "Failed ") + aJob.Output);
+    return isDone;
+}
+
+size_t StAVVideoMuxerBatch::perform(const int theNbWorkers) {
+    myNextJob = 0;
+    myNbDone  = 0;
+    if(myJobs.empty()) {
+        return 0;
+    }
+
+    // never start more workers than jobs
+    const int aNbWorkers = stMin(theNbWorkers > 0 ? theNbWorkers : StThread::countLogicalProcessors(), int(myJobs.size()));
+    std::vector< StHandle<StThread> > aThreads;
+    for(int aWorkerIter = 1; aWorkerIter < aNbWorkers; ++aWorkerIter) {
+        aThreads.push_back(new StThread(workerThread, (void* )this, "StAVMuxBatch"));
+    }
+
+    // perform jobs within calling thread as well
+    workerLoop();
+    for(size_t aThreadIter = 0; aThreadIter < aThreads.size(); ++aThreadIter) {
+        aThreads[aThreadIter]->wait();
+    }
+    return myNbDone;
+}
@@ -18,6 +18,11 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#ifdef _WIN32
+    #include <sys/utime.h>
+#else
+    #include <utime.h>
+#endif
 
 StFileNode::StFileNode()
 : StNode(stCString(""), NULL, NODE_TYPE_FILE) {
@@ -79,6 +84,42 @@ bool StFileNode::isFileExists(const StCString& thePath) {
 #endif
 }
 
+bool StFileNode::getFileInfo(const StCString& thePath,
+                             int64_t&         theSize,
+                             int64_t&         theModifTime) {
+#ifdef _WIN32
+    StStringUtfWide aPath;
+    aPath.fromUnicode(thePath);
+    struct __stat64 aStatBuffer;
+    if(_wstat64(aPath.toCString(), &aStatBuffer) != 0) {
+        return false;
+    }
+#elif (defined(__APPLE__))
+    struct stat aStatBuffer;
+    if(stat(thePath.toCString(), &aStatBuffer) != 0) {
+        return false;
+    }
+#else
+    struct stat64 aStatBuffer;
+    if(stat64(thePath.toCString(), &aStatBuffer) != 0) {
+        return false;
+    }
+#endif
+    theSize      = (int64_t )aStatBuffer.st_size;
+    theModifTime = (int64_t )aStatBuffer.st_mtime;
+    return true;
+}
+
+bool StFileNode::touchFile(const StCString& thePath) {
+#ifdef _WIN32
+    StStringUtfWide aPath;
+    aPath.fromUnicode(thePath);
+    return _wutime(aPath.toCString(), NULL) == 0;
+#else
+    return utime(thePath.toCString(), NULL) == 0;
+#endif
+}
+
 bool StFileNode::isFileReadOnly(const StCString& thePath) {
 #ifdef _WIN32
     StStringUtfWide aPath;
@@ -15,9 +15,26 @@
     #include <dirent.h>
 #endif
 
+#include <algorithm>
+#include <ctime>
+#include <vector>
+
 namespace {
     static const StString IGNORE_DIR_CURR_NAME('.');
     static const StString IGNORE_DIR_UP_NAME("..");
+
+    /**
+     * Cached file properties.
+     */
+    struct StCachedFile {
+        StString Path;
+        int64_t  Size;
+        int64_t  ModifTime;
+
+        bool operator<(const StCachedFile& theOther) const {
+            return ModifTime > theOther.ModifTime; // newest first
+        }
+    };
 }
 
 StFolder::StFolder()
@@ -72,6 +89,50 @@ bool StFolder::createFolder(const StCString& thePath) {
 #endif
 }
 
+size_t StFolder::trimFiles(const StCString& thePath,
+                           const StString&  theExtension,
+                           const int64_t    theSizeMax,
+                           const int64_t    theAgeMax) {
+    StString aPath = thePath;
+    if(aPath.isEndsWith(SYS_FS_SPLITTER)) {
+        aPath = aPath.subString(0, aPath.getLength() - 1);
+    }
+    if(!isFolder(aPath)) {
+        return 0;
+    }
+
+    StArrayList<StString> anExtensions(1);
+    anExtensions.add(theExtension);
+    StFolder aFolder(aPath);
+    aFolder.init(anExtensions, 1);
+
+    std::vector<StCachedFile> aFiles;
+    aFiles.reserve(aFolder.size());
+    for(size_t anIter = 0; anIter < aFolder.size(); ++anIter) {
+        StCachedFile aFile;
+        aFile.Path = aFolder.getValue(anIter)->getPath();
+        if(getFileInfo(aFile.Path, aFile.Size, aFile.ModifTime)) {
+            aFiles.push_back(aFile);
+        }
+    }
+    std::sort(aFiles.begin(), aFiles.end());
+
+    const int64_t aNow = (int64_t )::time(NULL);
+    int64_t aSizeSum = 0;
+    size_t  aNbRemoved = 0;
+    for(std::vector<StCachedFile>::const_iterator aFileIter = aFiles.begin(); aFileIter != aFiles.end(); ++aFileIter) {
+        aSizeSum += aFileIter->Size;
+        if((theSizeMax > 0 && aSizeSum > theSizeMax)
+        || (theAgeMax  > 0 && aNow - aFileIter->ModifTime > theAgeMax)) {
+            if(removeFile(aFileIter->Path)) {
+                ++aNbRemoved;
+            }
+            aSizeSum -= aFileIter->Size;
+        }
+    }
+    return aNbRemoved;
+}
+
 void StFolder::addItem(const StArrayList<StString>& theExtensions,
                        int theDeep,
                        const StString& theSearchFolderPath,
@@ -17,7 +17,8 @@ StGLFrameBuffer::StGLFrameBuffer()
 : myGLFBufferId(NO_FRAMEBUFFER),
   myGLDepthRBId(NO_RENDERBUFFER),
   myViewPortX(0),
-  myViewPortY(0) {
+  myViewPortY(0),
+  myHasStencil(false) {
     //
 }
 
@@ -34,6 +35,7 @@ void StGLFrameBuffer::release(StGLContext& theCtx) {
         theCtx.arbFbo->glDeleteRenderbuffers(1, &myGLDepthRBId);
         myGLDepthRBId = NO_RENDERBUFFER;
     }
+    myHasStencil = false;
     if(isValidFrameBuffer()) {
         theCtx.arbFbo->glDeleteFramebuffers(1, &myGLFBufferId);
         myGLFBufferId = NO_FRAMEBUFFER;
@@ -121,13 +123,15 @@ bool StGLFrameBuffer::init(StGLContext&  theCtx,
     const GLuint aFboBakRead = theCtx.stglFramebufferRead();
     theCtx.stglBindFramebuffer(NO_FRAMEBUFFER);
 
+    myHasStencil = false;
     if(theNeedDepthBuffer) {
         // create RenderBuffer (will be used as depth buffer)
         if(myGLDepthRBId == NO_RENDERBUFFER) {
             theCtx.arbFbo->glGenRenderbuffers(1, &myGLDepthRBId);
         }
 
-        const GLint aDepthFormat = theCtx.isGlGreaterEqual(3, 0) ? GL_DEPTH24_STENCIL8 : GL_DEPTH_COMPONENT16;
+        myHasStencil = theCtx.isGlGreaterEqual(3, 0);
+        const GLint aDepthFormat = myHasStencil ? GL_DEPTH24_STENCIL8 : GL_DEPTH_COMPONENT16;
         theCtx.arbFbo->glBindRenderbuffer(GL_RENDERBUFFER, myGLDepthRBId);
         theCtx.arbFbo->glRenderbufferStorage(GL_RENDERBUFFER, aDepthFormat,
                                              theColorTexture->getSizeX(), theColorTexture->getSizeY());
@@ -148,6 +152,10 @@ bool StGLFrameBuffer::init(StGLContext&  theCtx,
         // bind render buffer to the FBO as depth buffer
         theCtx.arbFbo->glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER,
                                                  myGLDepthRBId);
+        if(myHasStencil) {
+            theCtx.arbFbo->glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER,
+                                                     myGLDepthRBId);
+        }
     }
     const bool isOk = theCtx.arbFbo->glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
     if(myGLDepthRBId != NO_RENDERBUFFER) {
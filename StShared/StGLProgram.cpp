@@ -10,6 +10,7 @@
 #include <StGL/StGLContext.h>
 
 #include <StStrings/StLogger.h>
+#include <StThreads/StStartupTrace.h>
 #include <stAssert.h>
 
 StGLProgram::StGLProgram(const StString& theTitle)
@@ -68,10 +69,15 @@ bool StGLProgram::link(StGLContext& theCtx) {
     if(!isValid()) {
         return false;
     }
-    theCtx.core20fwd->glLinkProgram(myProgramId);
+    bool isLinkedOk = false;
+    {
+        StStartupTrace::Phase aTracePhase("shaders linking");
+        theCtx.core20fwd->glLinkProgram(myProgramId);
+        isLinkedOk = isLinked(theCtx);
+    }
 
     // if linkage failed - automatically remove the program!
-    if(!isLinked(theCtx)) {
+    if(!isLinkedOk) {
         theCtx.pushError(StString("Linking of the program '") + myTitle + "' failed!\n" + getLinkageInfo(theCtx));
         release(theCtx);
         return false;
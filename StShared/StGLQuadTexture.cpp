@@ -25,7 +25,8 @@ StGLFrameTexture::StGLFrameTexture()
 
 StGLFrameTextures::StGLFrameTextures()
 : myParams(),
-  myImgCM(StImage::ImgColor_RGB) {
+  myImgCM(StImage::ImgColor_RGB),
+  myIsPackedPair(false) {
     //
 }
 
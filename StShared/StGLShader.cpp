@@ -11,6 +11,7 @@
 
 #include <StFile/StRawFile.h>
 #include <StStrings/StLogger.h>
+#include <StThreads/StStartupTrace.h>
 #include <stAssert.h>
 
 namespace {
@@ -89,10 +90,15 @@ bool StGLShader::init(StGLContext&       theCtx,
 #endif
 
     // compile shaders
-    theCtx.core20fwd->glCompileShader(myShaderId);
+    bool isCompiledOk = false;
+    {
+        StStartupTrace::Phase aTracePhase("shaders compilation");
+        theCtx.core20fwd->glCompileShader(myShaderId);
+        isCompiledOk = isCompiled(theCtx);
+    }
 
     // check compile success
-    if(!isCompiled(theCtx)) {
+    if(!isCompiledOk) {
         StString aSrc;
         StString aSrcNumbered;
         GLsizei aPartFrom = 0;
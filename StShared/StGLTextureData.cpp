@@ -6,6 +6,7 @@
 
 #include <StGLStereo/StGLTextureData.h>
 #include <StStrings/StLogger.h>
+#include <StThreads/StMemoryBudget.h>
 
 #include <StGLCore/StGLCore11.h>
 #include <StGL/StGLContext.h>
@@ -21,6 +22,7 @@ StGLTextureData::StGLTextureData(const StHandle<StGLTextureUploadParams>& theUpl
   myPts(0.0),
   mySrcFormat(StFormat_AUTO),
   myCubemapFormat(StCubemap_OFF),
+  myIsPackedPair(false),
   myUploadParams(theUploadParams),
   myFillFromRow(0),
   myFillRows(0) {
@@ -38,9 +40,27 @@ void StGLTextureData::reset() {
     if(myDataPtr != NULL) {
         stMemFreeAligned(myDataPtr);
         myDataPtr = NULL;
+        StMemoryBudget::add(StMemoryBudget::Consumer_Textures, -int64_t(myDataSizeBytes));
     }
     myDataSizeBytes = 0;
     myFillRows = myFillFromRow = 0;
+    myIsPackedPair = false;
+}
+
+void StGLTextureData::takeBuffer(StGLTextureData& theOther) {
+    if(&theOther == this
+    || myDataPtr != NULL
+    || theOther.myDataPtr == NULL) {
+        return;
+    }
+
+    // buffer remains accounted within the budget
+    reset();
+    myDataPtr       = theOther.myDataPtr;
+    myDataSizeBytes = theOther.myDataSizeBytes;
+    theOther.myDataPtr       = NULL;
+    theOther.myDataSizeBytes = 0;
+    theOther.reset();
 }
 
 bool StGLTextureData::reAllocate(const size_t theSizeBytes) {
@@ -52,6 +72,7 @@ bool StGLTextureData::reAllocate(const size_t theSizeBytes) {
         reset();
         myDataSizeBytes = theSizeBytes;
         myDataPtr       = stMemAllocAligned<GLubyte*>(myDataSizeBytes);
+        StMemoryBudget::add(StMemoryBudget::Consumer_Textures, int64_t(myDataSizeBytes));
 
         // reset the buffer (make black)
         /// this is probably useless and wrong in case of non RGB image data
@@ -372,14 +393,23 @@ void StGLTextureData::updateData(const StGLDeviceCaps&           theDeviceCaps,
 
     // reset fill texture state
     myFillRows = myFillFromRow = 0;
-
+    myIsPackedPair = false;
+
+    // packed stereo pair can be uploaded as is, so that each view samples its own half within the same texture;
+    // left / right wrappers are still defined for getCopy();
+    // the whole pair should fit into texture size limits, otherwise views are uploaded into dedicated textures
+    const bool toSharePair   = myUploadParams->ToSharePackedPair
+                            && theCubemap == StCubemap_OFF;
+    const bool toShareWidth  = toSharePair && theDataL.getSizeX() <= size_t(theDeviceCaps.maxTexDim);
+    const bool toShareHeight = toSharePair && theDataL.getSizeY() <= size_t(theDeviceCaps.maxTexDim);
     if(canCopyReference(theDataL)
     && canCopyReference(theDataR)) {
         bool toCopy = false;
         switch(mySrcFormat) {
             case StFormat_SideBySide_LR:
             case StFormat_SideBySide_RL: {
-                if(!theDeviceCaps.hasUnpack) {
+                if(!theDeviceCaps.hasUnpack
+                && !toShareWidth) {
                     // slow copying to GPU memory
                     toCopy = true;
                     break;
@@ -407,6 +437,7 @@ void StGLTextureData::updateData(const StGLDeviceCaps&           theDeviceCaps,
                                                              aSizeX, aFromPlane.getSizeY(),
                                                              aFromPlane.getSizeRowBytes());
                 }
+                myIsPackedPair = toShareWidth;
                 break;
             }
             case StFormat_TopBottom_LR:
@@ -440,6 +471,7 @@ void StGLTextureData::updateData(const StGLDeviceCaps&           theDeviceCaps,
                                                              aFromPlane.getSizeX(), aSizeY,
                                                              aFromPlane.getSizeRowBytes());
                 }
+                myIsPackedPair = toShareHeight;
                 break;
             }
             case StFormat_Rows: {
@@ -798,6 +830,28 @@ void StGLTextureData::setupDataRectangle(const StImagePlane& theImagePlane,
         anImgSizeY = anImgSizeY / aCoeffs[1];
     }
 
+    // each view occupies a half of packed stereo pair
+    StGLVec2 aViewOffsets[2];
+    if(myIsPackedPair) {
+        switch(mySrcFormat) {
+            case StFormat_SideBySide_LR:
+            case StFormat_SideBySide_RL: {
+                anImgSizeX /= 2;
+                aViewOffsets[mySrcFormat == StFormat_SideBySide_LR ? 1 : 0].x() = GLfloat(anImgSizeX) / GLfloat(theTextureFrame.getSizeX());
+                break;
+            }
+            case StFormat_TopBottom_LR:
+            case StFormat_TopBottom_RL: {
+                anImgSizeY /= 2;
+                aViewOffsets[mySrcFormat == StFormat_TopBottom_LR ? 1 : 0].y() = GLfloat(anImgSizeY) / GLfloat(theTextureFrame.getSizeY());
+                break;
+            }
+            default: break;
+        }
+    }
+    theTextureFrame.setDataOffset(false, aViewOffsets[0]);
+    theTextureFrame.setDataOffset(true,  aViewOffsets[1]);
+
     const GLfloat aSizeXFloat = stMin(GLfloat(anImgSizeX), GLfloat(theTextureFrame.getSizeX()));
     const GLfloat aSizeYFloat = stMin(GLfloat(anImgSizeY), GLfloat(theTextureFrame.getSizeY()));
     StGLVec2 aDataSize (aSizeXFloat / GLfloat(theTextureFrame.getSizeX()),
@@ -884,20 +938,23 @@ static void prepareTextures(StGLContext&       theCtx,
 
 bool StGLTextureData::fillTexture(StGLContext&     theCtx,
                                   StGLQuadTexture& theQTexture) {
+    // packed stereo pair is uploaded into the left textures only
+    const StImage& aDataL = myIsPackedPair ? myDataPair : myDataL;
+    const StImage& aDataR = myIsPackedPair ? myDataEmpty : myDataR;
 
     // setup rows count to be filled per fillTexture()
     if(myFillRows == 0 || myFillFromRow == 0) {
         // prepare textures for new data
-        prepareTextures(theCtx, myDataL, myCubemapFormat, theQTexture.getBack(StGLQuadTexture::LEFT_TEXTURE));
-        prepareTextures(theCtx, myDataR, myCubemapFormat, theQTexture.getBack(StGLQuadTexture::RIGHT_TEXTURE));
+        prepareTextures(theCtx, aDataL, myCubemapFormat, theQTexture.getBack(StGLQuadTexture::LEFT_TEXTURE));
+        prepareTextures(theCtx, aDataR, myCubemapFormat, theQTexture.getBack(StGLQuadTexture::RIGHT_TEXTURE));
 
         // remove links to old stereo parameters
         theQTexture.getBack(StGLQuadTexture::LEFT_TEXTURE).setSource(StHandle<StStereoParams>());
         theQTexture.getBack(StGLQuadTexture::RIGHT_TEXTURE).setSource(StHandle<StStereoParams>());
 
-        const int aNbRowsL = stMin(int(myDataL.getSizeY()), theQTexture.getBack(StGLQuadTexture::LEFT_TEXTURE).getSizeY());
-        const int aNbRowsR = !myDataR.isNull()
-                           ? stMin(int(myDataR.getSizeY()), theQTexture.getBack(StGLQuadTexture::RIGHT_TEXTURE).getSizeY())
+        const int aNbRowsL = stMin(int(aDataL.getSizeY()), theQTexture.getBack(StGLQuadTexture::LEFT_TEXTURE).getSizeY());
+        const int aNbRowsR = !aDataR.isNull()
+                           ? stMin(int(aDataR.getSizeY()), theQTexture.getBack(StGLQuadTexture::RIGHT_TEXTURE).getSizeY())
                            : 0;
         const int aNbMaxRows = stMax(aNbRowsL, aNbRowsR);
 
@@ -907,13 +964,13 @@ bool StGLTextureData::fillTexture(StGLContext&     theCtx,
         if(aMaxUploadChunkMiB > 0 && aMaxUploadIterations > 1) {
             size_t aStride = 0;
             for(int aPlaneIter = 0; aPlaneIter < 4; ++aPlaneIter) {
-                const StImagePlane& aPlaneL = myDataL.getPlane(aPlaneIter);
+                const StImagePlane& aPlaneL = aDataL.getPlane(aPlaneIter);
                 if(!aPlaneL.isNull()) {
                     // don't use aPlane.getSizeRowBytes() here since it may contain extra padding for side-by-side input
                     aStride += aPlaneL.getSizeX() * aPlaneL.getSizePixelBytes();
                 }
-                if(!myDataR.isNull()) {
-                    const StImagePlane& aPlaneR = myDataR.getPlane(aPlaneIter);
+                if(!aDataR.isNull()) {
+                    const StImagePlane& aPlaneR = aDataR.getPlane(aPlaneIter);
                     if(!aPlaneR.isNull()) {
                         aStride += aPlaneR.getSizeX() * aPlaneR.getSizePixelBytes();
                     }
@@ -939,27 +996,29 @@ bool StGLTextureData::fillTexture(StGLContext&     theCtx,
         for(size_t aPlaneId = 0; aPlaneId < 4; ++aPlaneId) {
             fillTexture(theCtx,
                         theQTexture.getBack(StGLQuadTexture::LEFT_TEXTURE).getPlane(aPlaneId),
-                        myDataL.getPlane(aPlaneId));
+                        aDataL.getPlane(aPlaneId));
         }
     }
     if(theQTexture.getBack(StGLQuadTexture::RIGHT_TEXTURE).isValid()) {
         for(size_t aPlaneId = 0; aPlaneId < 4; ++aPlaneId) {
             fillTexture(theCtx,
                         theQTexture.getBack(StGLQuadTexture::RIGHT_TEXTURE).getPlane(aPlaneId),
-                        myDataR.getPlane(aPlaneId));
+                        aDataR.getPlane(aPlaneId));
         }
     }
     theQTexture.getBack(StGLQuadTexture::LEFT_TEXTURE).unbind(theCtx);
 
     myFillFromRow += myFillRows;
-    if(myFillFromRow >= GLsizei(myDataL.getSizeY())
-    && (myDataR.isNull() || myFillFromRow >= GLsizei(myDataR.getSizeY()))) {
-        if(!myDataL.isNull() && theQTexture.getBack(StGLQuadTexture::LEFT_TEXTURE).isValid()) {
-            setupAttributes(theQTexture.getBack(StGLQuadTexture::LEFT_TEXTURE), myDataL);
+    if(myFillFromRow >= GLsizei(aDataL.getSizeY())
+    && (aDataR.isNull() || myFillFromRow >= GLsizei(aDataR.getSizeY()))) {
+        if(!aDataL.isNull() && theQTexture.getBack(StGLQuadTexture::LEFT_TEXTURE).isValid()) {
+            setupAttributes(theQTexture.getBack(StGLQuadTexture::LEFT_TEXTURE), aDataL);
         }
-        if(!myDataR.isNull() && theQTexture.getBack(StGLQuadTexture::RIGHT_TEXTURE).isValid()) {
-            setupAttributes(theQTexture.getBack(StGLQuadTexture::RIGHT_TEXTURE), myDataR);
+        if(!aDataR.isNull() && theQTexture.getBack(StGLQuadTexture::RIGHT_TEXTURE).isValid()) {
+            setupAttributes(theQTexture.getBack(StGLQuadTexture::RIGHT_TEXTURE), aDataR);
         }
+        theQTexture.getBack(StGLQuadTexture::LEFT_TEXTURE).setPackedPair(myIsPackedPair);
+        theQTexture.getBack(StGLQuadTexture::RIGHT_TEXTURE).setPackedPair(false);
 
         if(!myStParams.isNull()) {
             myStParams->StereoFormat = mySrcFormat;
@@ -979,3 +1038,32 @@ void StGLTextureData::getCopy(StImage* theDataL,
         theDataR->initCopy(myDataR, true);
     }
 }
+
+namespace {
+
+    /**
+     * Reference the view, which might be a wrapper over the packed pair buffer.
+     */
+    static void referenceView(StImage&       theOut,
+                              const StImage& theView,
+                              const StImage& thePair) {
+        if(theOut.initReference(theView)) {
+            return;
+        } else if(!thePair.getBufferCounter().isNull()
+               && theOut.initReference(theView, thePair.getBufferCounter())) {
+            return;
+        }
+        theOut.initCopy(theView, true);
+    }
+
+}
+
+void StGLTextureData::getReference(StImage* theDataL,
+                                   StImage* theDataR) const {
+    if(theDataL != NULL) {
+        referenceView(*theDataL, myDataL, myDataPair);
+    }
+    if(theDataR != NULL) {
+        referenceView(*theDataR, myDataR, myDataPair);
+    }
+}
@@ -7,6 +7,7 @@
 #include <StGLStereo/StGLTextureQueue.h>
 
 #include <StGL/StGLContext.h>
+#include <StThreads/StMemoryBudget.h>
 
 StGLTextureQueue::StGLTextureQueue(const size_t theQueueSizeMax)
 : myDataFront(NULL),
@@ -14,12 +15,14 @@ StGLTextureQueue::StGLTextureQueue(const size_t theQueueSizeMax)
   myDataBack(NULL),
   myQueueSize(0),
   myQueueSizeMax(theQueueSizeMax),
+  myQueueSizeLimit(theQueueSizeMax),
   mySwapFBCount(0),
   myCurrSrcFormat(StFormat_Mono),
   myCurrPts(0.0),
   myNewShotEvent(false),
   myIsInUpdTexture(false),
   myIsReadyToSwap(false),
+  myHasNewFrame(false),
   myToCompress(false),
   myHasStream(false),
   myUploadParams(new StGLTextureUploadParams()) {
@@ -80,8 +83,15 @@ bool StGLTextureQueue::push(const StImage&     theSrcDataLeft,
         myCurrSrcFormat = myDataBack->getSourceFormat();
     myMutexSrcFormat.unlock();
 
+    // size the queue from the memory budget, so that 8K frames do not exhaust memory
+    const size_t aFrameBytes = myDataBack->getDataSizeBytes();
+    const size_t aNbFrames   = aFrameBytes != 0
+                             ? StMemoryBudget::getAvailable(StMemoryBudget::Consumer_Textures) / aFrameBytes
+                             : myQueueSizeMax;
+
     myMutexSize.lock();
         ++myQueueSize;
+        myQueueSizeLimit = stMin(stMax(aNbFrames, size_t(2)), myQueueSizeMax);
     myMutexSize.unlock();
     myMutexPush.unlock();
     return true;
@@ -99,6 +109,7 @@ int StGLTextureQueue::swapFBOnReady(StGLContext& theCtx) {
         mySwapFBMutex.unlock();
 
         myQTexture.swapFB();
+        myHasNewFrame = true;
         if(myToCompress) {
             myQTexture.getBack(StGLQuadTexture::LEFT_TEXTURE ).release(theCtx);
             myQTexture.getBack(StGLQuadTexture::RIGHT_TEXTURE).release(theCtx);
@@ -147,9 +158,27 @@ bool StGLTextureQueue::stglUpdateStTextures(StGLContext& theCtx) {
         myIsReadyToSwap = true;
         myMutexSize.lock();
             myCurrPts   = myDataFront->getPTS();
+            StGLTextureData* aPrevSnap = myDataSnap;
             myDataSnap  = myDataFront; myNewShotEvent.set();
             if(myToCompress) {
                 myDataFront->reset();
+            } else if(aPrevSnap != NULL
+                   && aPrevSnap != myDataFront
+                   && (myQueueSizeLimit < myQueueSizeMax || StMemoryBudget::isUnderPressure())
+                   && myMutexPush.tryLock()) {
+                // previously shown frame is out of queue - hand its buffer over to the slot to be filled next,
+                // so that only frames within the budget-limited queue keep their buffers
+                // without reallocating the buffer on every frame
+                StGLTextureData* aNextPush = myQueueSize > 1 ? myDataBack->getNext() : myDataFront->getNext();
+                if(aNextPush != aPrevSnap) {
+                    if(aNextPush != myDataFront
+                    && aNextPush->getDataSizeBytes() == 0) {
+                        aNextPush->takeBuffer(*aPrevSnap);
+                    } else {
+                        aPrevSnap->reset();
+                    }
+                }
+                myMutexPush.unlock();
             }
             myDataFront = myDataFront->getNext();
             ST_ASSERT(myQueueSize != 0, "StGLTextureQueue::stglUpdateStTextures() - critical error!");
@@ -222,7 +251,8 @@ void StGLTextureQueue::drop(const size_t theCount,
 
 int StGLTextureQueue::getSnapshot(StImage* theOutDataLeft,
                                   StImage* theOutDataRight,
-                                  bool     theToForce) {
+                                  bool     theToForce,
+                                  bool     theToReference) {
     if(!myNewShotEvent.check() && !theToForce) {
         return SNAPSHOT_NO_NEW;
     }
@@ -231,7 +261,11 @@ int StGLTextureQueue::getSnapshot(StImage* theOutDataLeft,
         myMutexPop.unlock();
         return SNAPSHOT_NO_NEW;
     }
-    myDataSnap->getCopy(theOutDataLeft, theOutDataRight);
+    if(theToReference) {
+        myDataSnap->getReference(theOutDataLeft, theOutDataRight);
+    } else {
+        myDataSnap->getCopy(theOutDataLeft, theOutDataRight);
+    }
     myNewShotEvent.reset();
     myMutexPop.unlock();
     return SNAPSHOT_SUCCESS;
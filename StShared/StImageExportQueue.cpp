@@ -0,0 +1,198 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#include <StImage/StImageExportQueue.h>
+
+#include <StStrings/StLogger.h>
+#include <StThreads/StMemoryBudget.h>
+
+/**
+ * Job encoding single image within the working pool.
+ */
+class StImageExportQueue::PoolJob : public StThreadPool::Job {
+
+        public:
+
+    PoolJob(StImageExportQueue*            theQueue,
+            const StImageExportQueue::Job& theJob)
+    : myQueue(theQueue), myJob(theJob) {}
+
+    virtual void perform() ST_ATTR_OVERRIDE {
+        myQueue->process(myJob);
+    }
+
+        private:
+
+    StImageExportQueue*     myQueue;
+    StImageExportQueue::Job myJob;
+
+};
+
+StImageExportQueue::StImageExportQueue(const StImageFile::ImageClass theImageLib,
+                                       const int                     theNbJobsMax)
+: myPool(StThreadPool::getShared()),
+  myQueuedBytes(0),
+  myImageLib(theImageLib),
+  myNbJobsMax(theNbJobsMax > 0
+            ? theNbJobsMax
+            : stMax(1, myPool->getNbThreads() / 2)),
+  myNbRunning(0) {
+    //
+}
+
+StImageExportQueue::~StImageExportQueue() {
+    // snapshots requested by user should not be lost;
+    // jobs passed to the pool reference this queue, so that destruction should wait for them anyway
+    wait();
+}
+
+void StImageExportQueue::setImageLib(const StImageFile::ImageClass theImageLib) {
+    StMutexAuto aLock(myMutex);
+    myImageLib = theImageLib;
+}
+
+size_t StImageExportQueue::getJobBytes(const Job& theJob) {
+    size_t aBytes = 0;
+    for(size_t aPlaneIter = 0; aPlaneIter < 4; ++aPlaneIter) {
+        if(!theJob.Left.isNull()) {
+            aBytes += theJob.Left->getPlane(aPlaneIter).getSizeBytes();
+        }
+        if(!theJob.Right.isNull()) {
+            aBytes += theJob.Right->getPlane(aPlaneIter).getSizeBytes();
+        }
+    }
+    return aBytes;
+}
+
+void StImageExportQueue::push(const Job& theJob) {
+    if(theJob.Left.isNull()
+    || theJob.Path.isEmpty()) {
+        return;
+    }
+
+    const size_t aBytes = getJobBytes(theJob);
+    for(;;) {
+        {
+            StMutexAuto aLock(myMutex);
+            // single job is always accepted, even if it exceeds the budget on its own
+            if(myJobs.empty()
+            || myQueuedBytes + aBytes <= StMemoryBudget::getAvailable(StMemoryBudget::Consumer_Images)) {
+                if(myStats.NbPending == 0) {
+                    myStats = Statistics();
+                    myTimer.restart();
+                }
+                myJobs.push_back(theJob);
+                myQueuedBytes += aBytes;
+                ++myStats.NbPending;
+                StMemoryBudget::add(StMemoryBudget::Consumer_Images, int64_t(aBytes));
+                dispatchJobs();
+                return;
+            }
+        }
+        StThread::sleep(10);
+    }
+}
+
+void StImageExportQueue::wait() {
+    for(;;) {
+        {
+            StMutexAuto aLock(myMutex);
+            if(myStats.NbPending == 0) {
+                return;
+            }
+        }
+        StThread::sleep(10);
+    }
+}
+
+bool StImageExportQueue::isEmpty() const {
+    StMutexAuto aLock(myMutex);
+    return myStats.NbPending == 0;
+}
+
+StImageExportQueue::Statistics StImageExportQueue::getStatistics() const {
+    StMutexAuto aLock(myMutex);
+    Statistics aStats = myStats;
+    if(aStats.NbPending != 0) {
+        aStats.ElapsedTime = myTimer.getElapsedTimeInSec();
+    }
+    return aStats;
+}
+
+StString StImageExportQueue::formatStatistics() const {
+    const Statistics aStats = getStatistics();
+    if(aStats.NbSaved == 0
+    && aStats.NbFailed == 0
+    && aStats.NbPending == 0) {
+        return StString();
+    }
+
+    char aBuffer[256];
+    stsprintf(aBuffer, sizeof(aBuffer), "%u saved, %u pending, %u failed, %.1f files/s, %.1f MiB/s",
+              (unsigned int )aStats.NbSaved, (unsigned int )aStats.NbPending, (unsigned int )aStats.NbFailed,
+              aStats.getFilesPerSecond(), aStats.getMegabytesPerSecond());
+    return StString(aBuffer);
+}
+
+void StImageExportQueue::dispatchJobs() {
+    while(myNbRunning < myNbJobsMax
+      && !myJobs.empty()) {
+        myPool->push(new PoolJob(this, myJobs.front()));
+        myJobs.pop_front();
+        ++myNbRunning;
+    }
+}
+
+void StImageExportQueue::process(Job& theJob) {
+    const size_t aBytes  = getJobBytes(theJob);
+    const bool   isSaved = perform(theJob);
+
+    // release references to decoded buffers before reporting the job as done
+    theJob = Job();
+    StMemoryBudget::add(StMemoryBudget::Consumer_Images, -int64_t(aBytes));
+
+    StMutexAuto aLock(myMutex);
+    myQueuedBytes -= stMin(myQueuedBytes, aBytes);
+    --myNbRunning;
+    --myStats.NbPending;
+    if(isSaved) {
+        ++myStats.NbSaved;
+        myStats.NbBytes += aBytes;
+    } else {
+        ++myStats.NbFailed;
+    }
+    myStats.ElapsedTime = myTimer.getElapsedTimeInSec();
+    dispatchJobs();
+}
+
+bool StImageExportQueue::perform(const Job& theJob) {
+    StImageFile::ImageClass anImageLib = StImageFile::ST_LIBAV;
+    {
+        StMutexAuto aLock(myMutex);
+        anImageLib = myImageLib;
+    }
+
+    StHandle<StImageFile> anImage = StImageFile::create(anImageLib);
+    if(anImage.isNull()) {
+        signals.onError(stCString("No any image library was found!"));
+        return false;
+    }
+
+    if(theJob.Right.isNull()
+    || !anImage->initSideBySide(*theJob.Left, *theJob.Right,
+                                theJob.SeparationDx, theJob.SeparationDy)) {
+        anImage->initWrapper(*theJob.Left);
+    }
+
+    ST_DEBUG_LOG("Save image to the path '" + theJob.Path + '\'');
+    if(!anImage->save(theJob.Path, theJob.SaveParams)) {
+        signals.onError(anImage->getState());
+        return false;
+    } else if(!anImage->getState().isEmpty()) {
+        ST_DEBUG_LOG(anImage->getState());
+    }
+    return true;
+}
@@ -11,6 +11,8 @@
 
 #include <StStrings/StLogger.h>
 
+#include <vector>
+
 /**
  * JPEG markers consist of one or more 0xFF bytes, followed by a marker
  * code byte (which is not an 0xFF).
@@ -75,6 +77,14 @@ enum {
 };
 
 namespace {
+
+    static const size_t THE_HEADERS_CHUNK  = 64 * 1024;        //!< size of the chunk to read headers
+    static const size_t THE_HEADERS_MAX    = 16 * 1024 * 1024; //!< limit for headers of a single image
+    static const size_t THE_MPO_IMAGES_MAX = 16;               //!< limit for images in MPO to read headers
+    static const uint16_t THE_MPO_TAG_ENTRY = 0xB002;          //!< MPEntry tag
+    static const uint16_t THE_EXIF_TAG_THUMB_OFFSET = 0x0201;  //!< JPEGInterchangeFormat tag
+    static const uint16_t THE_EXIF_TAG_THUMB_LENGTH = 0x0202;  //!< JPEGInterchangeFormatLength tag
+
     inline StString markerString(const int theMarker) {
         switch(theMarker) {
             case M_SOF0:  return stCString("SOF0 ");
@@ -141,7 +151,8 @@ StJpegParser::StJpegParser(const StCString& theFilePath)
 : StRawFile(theFilePath),
   myImages(NULL),
   myStFormat(StFormat_AUTO),
-  myPanorama(StPanorama_OFF) {
+  myPanorama(StPanorama_OFF),
+  myIsHeadersOnly(false) {
     stMemZero(myOffsets, sizeof(myOffsets));
 #if !defined(_MSC_VER)
     (void )markerString;
@@ -159,6 +170,7 @@ void StJpegParser::reset() {
     myXMP.clear();
     myStFormat = StFormat_AUTO;
     myPanorama = StPanorama_OFF;
+    myIsHeadersOnly = false;
     myLength = 0;
     stMemZero(myOffsets, sizeof(myOffsets));
 }
@@ -175,6 +187,187 @@ bool StJpegParser::readFile(const StCString& theFilePath,
     return parse();
 }
 
+bool StJpegParser::readHeaders(const StCString& theFilePath,
+                               const int        theOpenedFd) {
+    reset();
+    freeBuffer();
+    if(!openFile(StRawFile::READ, theFilePath, theOpenedFd)) {
+        return false;
+    }
+
+    myIsHeadersOnly = true;
+    if(!readHeadersAt(0)
+    || !parse()) {
+        closeFile();
+        return false;
+    }
+
+    // MP Entries of the first image define offsets of other images in MPO,
+    // relative to the endianness field following "MPF\0" in APP2 segment
+    StArrayList<int64_t> anOffsets(2);
+    StExifDir::Query aQuery(StExifDir::DType_MPO, THE_MPO_TAG_ENTRY);
+    if(myOffsets[Offset_Mpf] != 0
+    && StExifDir::findEntry(myImages->Exif, aQuery)
+    && aQuery.Folder != NULL) {
+        const size_t aNbEntries = stMin(size_t(aQuery.Entry.Components / 16), THE_MPO_IMAGES_MAX);
+        for(size_t anEntryIter = 1; anEntryIter < aNbEntries; ++anEntryIter) {
+            const stUByte_t* anEntry  = aQuery.Entry.ValuePtr + anEntryIter * 16;
+            const uint32_t   anOffset = aQuery.Folder->get32u(anEntry + 8);
+            if(anOffset != 0) {
+                anOffsets.add(int64_t(myOffsets[Offset_Mpf]) + 8 + int64_t(anOffset));
+            }
+        }
+    }
+
+    if(anOffsets.isEmpty()) {
+        // stereo pair might be stored as concatenated images without MP index
+        const int64_t aNextOffset = findNextImage(int64_t(myLength));
+        if(aNextOffset > 0) {
+            anOffsets.add(aNextOffset);
+        }
+    }
+
+    if(!anOffsets.isEmpty()) {
+        for(size_t anIter = 0; anIter < anOffsets.size(); ++anIter) {
+            if(!readHeadersAt(anOffsets[anIter])) {
+                break;
+            }
+        }
+
+        // buffer has been reallocated - parse all images once again
+        const size_t aLength = myLength;
+        reset();
+        myIsHeadersOnly = true;
+        myLength = aLength;
+        parse();
+    }
+    closeFile();
+    return !myImages.isNull();
+}
+
+bool StJpegParser::growBuffer(const size_t theSize) {
+    if(theSize <= myBuffSize) {
+        return true;
+    }
+
+    const size_t aNewSize = stMax(theSize, myBuffSize * 2);
+    stUByte_t* aNewData = stMemAllocAligned<stUByte_t*>(aNewSize);
+    if(aNewData == NULL) {
+        return false;
+    }
+    if(myBuffer != NULL) {
+        stMemCpy(aNewData, myBuffer, myBuffSize);
+    }
+    freeBuffer();
+    myBuffer    = aNewData;
+    myBuffSize  = aNewSize;
+    myIsOwnData = true;
+    return true;
+}
+
+int64_t StJpegParser::findNextImage(const int64_t theFileOffset) {
+    // compressed data escapes 0xFF bytes, so that SOI marker followed by another marker means the next image
+    std::vector<stUByte_t> aChunk(THE_HEADERS_CHUNK + 2);
+    size_t  aNbKept = 0;
+    int64_t anOffset = theFileOffset;
+    for(;;) {
+        const size_t aNbRead = readRange(anOffset, &aChunk[aNbKept], THE_HEADERS_CHUNK);
+        const size_t aNbData = aNbKept + aNbRead;
+        if(aNbData < 3) {
+            return -1;
+        }
+
+        for(size_t aPos = 0; aPos + 2 < aNbData; ++aPos) {
+            if(aChunk[aPos]     == 0xFF
+            && aChunk[aPos + 1] == M_SOI
+            && aChunk[aPos + 2] == 0xFF) {
+                return anOffset - int64_t(aNbKept) + int64_t(aPos);
+            }
+        }
+        if(aNbRead < THE_HEADERS_CHUNK) {
+            return -1;
+        }
+
+        // keep the tail to find the marker crossing chunks boundary
+        aChunk[0] = aChunk[aNbData - 2];
+        aChunk[1] = aChunk[aNbData - 1];
+        aNbKept   = 2;
+        anOffset += int64_t(aNbRead);
+    }
+}
+
+bool StJpegParser::readHeadersRange(const int64_t theFileOffset,
+                                    const size_t  theStart,
+                                    size_t&       theNbRead,
+                                    const size_t  theNbNeeded) {
+    if(theNbNeeded <= theNbRead) {
+        return true;
+    } else if(theNbNeeded > THE_HEADERS_MAX) {
+        ST_DEBUG_LOG("StJpegParser, headers exceed " + THE_HEADERS_MAX + " bytes");
+        return false;
+    }
+
+    const size_t aNbToRead = stMax(theNbNeeded - theNbRead, THE_HEADERS_CHUNK);
+    if(!growBuffer(theStart + theNbRead + aNbToRead)) {
+        return false;
+    }
+
+    theNbRead += readRange(theFileOffset + int64_t(theNbRead), myBuffer + theStart + theNbRead, aNbToRead);
+    return theNbNeeded <= theNbRead;
+}
+
+bool StJpegParser::readHeadersAt(const int64_t theFileOffset) {
+    const size_t aStart  = myLength;
+    size_t       aNbRead = 0;
+    if(!readHeadersRange(theFileOffset, aStart, aNbRead, 2)
+    || myBuffer[aStart] != 0xFF || myBuffer[aStart + 1] != M_SOI) {
+        return false;
+    }
+
+    size_t aPos = 2;
+    for(;;) {
+        if(!readHeadersRange(theFileOffset, aStart, aNbRead, aPos + 2)) {
+            return false;
+        }
+
+        const stUByte_t* aData   = myBuffer + aStart + aPos;
+        const stUByte_t  aMarker = aData[1];
+        if(aData[0] != 0xFF) {
+            ST_DEBUG_LOG("StJpegParser, no marker at position " + (theFileOffset + int64_t(aPos)));
+            return false;
+        } else if(aMarker == 0xFF) {
+            ++aPos; // fill byte
+            continue;
+        } else if(aMarker == M_EOI) {
+            aPos += 2;
+            break;
+        } else if(aMarker >= M_RST0 && aMarker <= M_RST7) {
+            aPos += 2; // standalone marker without length
+            continue;
+        }
+
+        if(!readHeadersRange(theFileOffset, aStart, aNbRead, aPos + 4)) {
+            return false;
+        }
+        const size_t aSegLen = StAlienData::Get16uBE(myBuffer + aStart + aPos + 2);
+        if(aSegLen < 2) {
+            return false;
+        }
+
+        aPos += 2 + aSegLen;
+        if(!readHeadersRange(theFileOffset, aStart, aNbRead, aPos)) {
+            return false;
+        }
+        if(aMarker == M_SOS) {
+            // compressed data follows
+            break;
+        }
+    }
+
+    myLength = aStart + aPos;
+    return true;
+}
+
 bool StJpegParser::parse() {
     if(myBuffer == NULL) {
         return false;
@@ -251,7 +444,8 @@ StHandle<StJpegParser::Image> StJpegParser::parseImage(const int      theImgCoun
         }
 
         //ST_DEBUG_LOG(" #" + theImgCount + "." + theDepth + " [" + markerString(aMarker) + "] at position " + size_t(aData - myBuffer) + " / " + myLength); ///
-        if(aMarker == M_EOI) {
+        if(aMarker == M_EOI
+        || (aMarker == M_SOS && myIsHeadersOnly)) { // compressed data is not read in headers-only mode
             //ST_DEBUG_LOG("Jpeg, EOI at position " + size_t(aData - myBuffer) + " / " + myLength);
 
             bool isPanoStereo = false;
@@ -387,8 +581,25 @@ StHandle<StJpegParser::Image> StJpegParser::parseImage(const int      theImgCoun
                     if(!aSubDir->parseExif(anImg->Exif, aData + 8, anItemLen - 8)) {
                         //
                     }
+
+                    // thumbnail embedded into IFD1, offset is relative to TIFF header
+                    StExifDir::Query aThumbOffset(StExifDir::DType_General, THE_EXIF_TAG_THUMB_OFFSET, StExifEntry::FMT_ULONG);
+                    StExifDir::Query aThumbLength(StExifDir::DType_General, THE_EXIF_TAG_THUMB_LENGTH, StExifEntry::FMT_ULONG);
+                    if(anImg->Thumb.isNull()
+                    && StExifDir::findEntry(anImg->Exif, aThumbOffset)
+                    && StExifDir::findEntry(anImg->Exif, aThumbLength)) {
+                        const size_t anOffset = aThumbOffset.Folder->get32u(aThumbOffset.Entry.ValuePtr);
+                        const size_t aLength  = aThumbLength.Folder->get32u(aThumbLength.Entry.ValuePtr);
+                        if(aLength > 2
+                        && anOffset + aLength <= size_t(anItemLen - 8)) {
+                            anImg->Thumb = new StJpegParser::Image();
+                            anImg->Thumb->Data   = aData + 8 + anOffset;
+                            anImg->Thumb->Length = aLength;
+                        }
+                    }
                 } else if(stAreEqual(aData + 2, "MPF\0", 4)) {
                     // MP Extensions (MPO)
+                    myOffsets[Offset_Mpf] = aData - myBuffer - 2;
                     StHandle<StExifDir> aSubDir = new StExifDir();
                     aSubDir->Type = StExifDir::DType_MPO;
                     anImg->Exif.add(aSubDir);
@@ -0,0 +1,194 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#include <StThreads/StMemoryBudget.h>
+
+#include <StThreads/StMutex.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#elif defined(__APPLE__)
+    #include <sys/types.h>
+    #include <sys/sysctl.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace {
+
+    /**
+     * Fraction of the limit reserved for each consumer.
+     */
+    static const double THE_CONSUMER_SHARES[StMemoryBudget::Consumer_NB] = {
+        0.50, // Consumer_Textures
+        0.20, // Consumer_Packets
+        0.20, // Consumer_ReadAhead
+        0.10, // Consumer_Images
+    };
+
+    /**
+     * Consumer names for displaying.
+     */
+    static const char* THE_CONSUMER_NAMES[StMemoryBudget::Consumer_NB] = {
+        "frames",
+        "packets",
+        "read-ahead",
+        "images",
+    };
+
+    static const size_t THE_MIB = 1024 * 1024;
+
+    /**
+     * Global budget state.
+     */
+    struct StMemoryBudgetState {
+        StMutex Mutex;
+        int64_t Usage[StMemoryBudget::Consumer_NB];
+        size_t  Limit;
+
+        StMemoryBudgetState() : Limit(0) {
+            for(int aConsIter = 0; aConsIter < StMemoryBudget::Consumer_NB; ++aConsIter) {
+                Usage[aConsIter] = 0;
+            }
+        }
+
+        size_t getTotal() const {
+            int64_t aTotal = 0;
+            for(int aConsIter = 0; aConsIter < StMemoryBudget::Consumer_NB; ++aConsIter) {
+                aTotal += Usage[aConsIter];
+            }
+            return size_t(stMax(aTotal, int64_t(0)));
+        }
+    };
+
+    static StMemoryBudgetState& getState() {
+        static StMemoryBudgetState THE_STATE;
+        return THE_STATE;
+    }
+
+    /**
+     * Default limit - quarter of physical memory.
+     */
+    static size_t computeDefaultLimit() {
+        const uint64_t aPhysMem = StMemoryBudget::getPhysicalMemory();
+        const uint64_t aLimitMax = sizeof(void*) == 4 ? uint64_t(1024) * THE_MIB : uint64_t(4096) * THE_MIB;
+        if(aPhysMem == 0) {
+            return size_t(512 * THE_MIB);
+        }
+        return size_t(stMin(stMax(aPhysMem / 4, uint64_t(256) * THE_MIB), aLimitMax));
+    }
+
+}
+
+uint64_t StMemoryBudget::getPhysicalMemory() {
+#ifdef _WIN32
+    MEMORYSTATUSEX aStatus;
+    aStatus.dwLength = sizeof(aStatus);
+    if(::GlobalMemoryStatusEx(&aStatus)) {
+        return uint64_t(aStatus.ullTotalPhys);
+    }
+    return 0;
+#elif defined(__APPLE__)
+    int      aMib[2] = { CTL_HW, HW_MEMSIZE };
+    uint64_t aMemSize = 0;
+    size_t   aLen = sizeof(aMemSize);
+    if(::sysctl(aMib, 2, &aMemSize, &aLen, NULL, 0) == 0) {
+        return aMemSize;
+    }
+    return 0;
+#else
+    const long aNbPages  = ::sysconf(_SC_PHYS_PAGES);
+    const long aPageSize = ::sysconf(_SC_PAGE_SIZE);
+    if(aNbPages <= 0
+    || aPageSize <= 0) {
+        return 0;
+    }
+    return uint64_t(aNbPages) * uint64_t(aPageSize);
+#endif
+}
+
+void StMemoryBudget::add(const Consumer theConsumer,
+                         const int64_t  theBytes) {
+    if(theBytes == 0) {
+        return;
+    }
+
+    StMemoryBudgetState& aState = getState();
+    StMutexAuto aLock(aState.Mutex);
+    aState.Usage[theConsumer] += theBytes;
+}
+
+size_t StMemoryBudget::getUsage(const Consumer theConsumer) {
+    StMemoryBudgetState& aState = getState();
+    StMutexAuto aLock(aState.Mutex);
+    return size_t(stMax(aState.Usage[theConsumer], int64_t(0)));
+}
+
+size_t StMemoryBudget::getTotalUsage() {
+    StMemoryBudgetState& aState = getState();
+    StMutexAuto aLock(aState.Mutex);
+    return aState.getTotal();
+}
+
+size_t StMemoryBudget::getLimit() {
+    StMemoryBudgetState& aState = getState();
+    StMutexAuto aLock(aState.Mutex);
+    if(aState.Limit == 0) {
+        aState.Limit = computeDefaultLimit();
+    }
+    return aState.Limit;
+}
+
+void StMemoryBudget::setLimit(const size_t theBytes) {
+    StMemoryBudgetState& aState = getState();
+    StMutexAuto aLock(aState.Mutex);
+    aState.Limit = theBytes != 0 ? theBytes : computeDefaultLimit();
+}
+
+bool StMemoryBudget::isUnderPressure() {
+    const size_t aLimit = getLimit();
+    return getTotalUsage() > aLimit;
+}
+
+size_t StMemoryBudget::getAvailable(const Consumer theConsumer) {
+    const size_t aLimit = getLimit();
+    StMemoryBudgetState& aState = getState();
+    StMutexAuto aLock(aState.Mutex);
+    const size_t anOwn    = size_t(stMax(aState.Usage[theConsumer], int64_t(0)));
+    const size_t anOthers = aState.getTotal() - stMin(anOwn, aState.getTotal());
+    const size_t aShare   = size_t(double(aLimit) * THE_CONSUMER_SHARES[theConsumer]);
+
+    // consumer may borrow unused memory of others, but never the memory already occupied by them
+    const size_t aFree = aLimit > anOthers ? aLimit - anOthers : 0;
+    return stMin(stMax(aShare, aFree / 2), aFree);
+}
+
+size_t StMemoryBudget::computeNbItems(const Consumer theConsumer,
+                                      const size_t   theItemBytes,
+                                      const size_t   theNbMin,
+                                      const size_t   theNbMax) {
+    if(theItemBytes == 0) {
+        return theNbMax;
+    }
+
+    const size_t aNbItems = getAvailable(theConsumer) / theItemBytes;
+    return stMin(stMax(aNbItems, theNbMin), theNbMax);
+}
+
+StString StMemoryBudget::format() {
+    const size_t aLimit = getLimit();
+    StMemoryBudgetState& aState = getState();
+    StMutexAuto aLock(aState.Mutex);
+    StString aText = StString() + int(aState.getTotal() / THE_MIB) + " of " + int(aLimit / THE_MIB) + " MiB (";
+    for(int aConsIter = 0; aConsIter < Consumer_NB; ++aConsIter) {
+        if(aConsIter != 0) {
+            aText += ", ";
+        }
+        aText += StString(THE_CONSUMER_NAMES[aConsIter]) + " " + int(stMax(aState.Usage[aConsIter], int64_t(0)) / int64_t(THE_MIB));
+    }
+    aText += ")";
+    return aText;
+}
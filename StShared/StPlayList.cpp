@@ -250,6 +250,7 @@ void StPlayList::clear() {
     myItemsCount = myPlayedCount = 0;
 
     anAutoLock.unlock();
+    myRevision.increment();
     signals.onPlaylistChange();
 }
 
@@ -604,6 +605,7 @@ bool StPlayList::remove(const StString& thePath,
     }
 
     anAutoLock.unlock();
+    myRevision.increment();
     signals.onPlaylistChange();
     return isDeleted;
 }
@@ -636,6 +638,7 @@ void StPlayList::addOneFile(const StString& theFilePath,
     addPlayItem(new StPlayItem(aFileNode, myDefStParams));
 
     anAutoLock.unlock();
+    myRevision.increment();
     signals.onPlaylistChange();
 }
 
@@ -651,6 +654,7 @@ void StPlayList::addOneFile(const StString& theFilePathLeft,
     addPlayItem(new StPlayItem(aFileNode, myDefStParams));
 
     anAutoLock.unlock();
+    myRevision.increment();
     signals.onPlaylistChange();
 }
 
@@ -773,6 +777,36 @@ void StPlayList::getSubList(StArrayList<StString>& theList,
     }
 }
 
+void StPlayList::getSubList(StArrayList<StString>& theTitles,
+                            StArrayList<StString>& thePaths,
+                            const size_t           theStart,
+                            const size_t           theEnd) const {
+    theTitles.clear();
+    thePaths .clear();
+    StMutexAuto anAutoLock(myMutex);
+
+    size_t anIter = 0;
+    StPlayItem* anItem = myFirst;
+    for(; anItem != NULL; anItem = anItem->getNext(), ++anIter) {
+        if(anIter == theStart) {
+            break;
+        }
+    }
+
+    if(anIter != theStart) {
+        return;
+    }
+
+    for(; anItem != NULL; anItem = anItem->getNext(), ++anIter) {
+        if(anIter == theEnd) {
+            break;
+        }
+
+        theTitles.add(anItem->getTitle());
+        thePaths .add(anItem->getPath());
+    }
+}
+
 namespace {
     ST_LOCAL bool stAreSameRecent(const StFileNode& theA,
                                   const StFileNode& theB) {
@@ -1105,6 +1139,7 @@ void StPlayList::open(const StCString& thePath,
                 }
 
                 anAutoLock.unlock();
+                myRevision.increment();
                 signals.onPlaylistChange();
                 return;
             }
@@ -1127,6 +1162,7 @@ void StPlayList::open(const StCString& thePath,
         addPlayItem(new StPlayItem(aFileNode, myDefStParams));
 
         anAutoLock.unlock();
+        myRevision.increment();
         signals.onPlaylistChange();
         return;
     }
@@ -1151,5 +1187,6 @@ void StPlayList::open(const StCString& thePath,
     }
 
     anAutoLock.unlock();
+    myRevision.increment();
     signals.onPlaylistChange();
 }
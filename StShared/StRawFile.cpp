@@ -275,6 +275,52 @@ bool StRawFile::readFile(const StCString& theFilePath,
     return true;
 }
 
+size_t StRawFile::readRange(const int64_t theOffset,
+                            stUByte_t*    theBuffer,
+                            const size_t  theBytes) {
+    if(theBuffer == NULL
+    || theBytes == 0) {
+        return 0;
+    }
+
+    if(myContextIO != NULL) {
+        if(avio_seek(myContextIO, theOffset, SEEK_SET) < 0) {
+            return 0;
+        }
+
+        const size_t aChunkLimit = size_t(std::numeric_limits<int>::max());
+        size_t aBytesRead = 0;
+        while(aBytesRead < theBytes) {
+            const int aResult = avio_read(myContextIO, theBuffer + aBytesRead, int(stMin(theBytes - aBytesRead, aChunkLimit)));
+            if(aResult <= 0) {
+                break;
+            }
+            aBytesRead += size_t(aResult);
+        }
+        return aBytesRead;
+    } else if(myFileHandle == NULL
+           || fseek64(myFileHandle, theOffset, SEEK_SET) != 0) {
+        return 0;
+    }
+    return fread(theBuffer, 1, theBytes, myFileHandle);
+}
+
+int64_t StRawFile::getFileSize() {
+    if(myContextIO != NULL) {
+        return avio_size(myContextIO);
+    } else if(myFileHandle == NULL) {
+        return -1;
+    }
+
+    const int64_t aPosition = ftell64(myFileHandle);
+    if(fseek64(myFileHandle, 0, SEEK_END) != 0) {
+        return -1;
+    }
+    const int64_t aSize = ftell64(myFileHandle);
+    fseek64(myFileHandle, aPosition, SEEK_SET);
+    return aSize;
+}
+
 bool StRawFile::saveFile(const StCString& theFilePath,
                          const int        theOpenedFd) {
     if(!openFile(StRawFile::WRITE, theFilePath, theOpenedFd)) {
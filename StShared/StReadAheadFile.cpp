@@ -0,0 +1,433 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#include <StFile/StReadAheadFile.h>
+
+#include <StThreads/StMemoryBudget.h>
+#include <StThreads/StTimer.h>
+#include <StStrings/StLogger.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#include <limits>
+
+namespace {
+
+    /**
+     * Alignment of block buffers.
+     */
+    static const size_t THE_BLOCK_ALIGN = 4096;
+
+    /**
+     * Maximum time to wait for the data before checking thread state.
+     */
+    static const size_t THE_WAIT_MS = 100;
+
+    /**
+     * Maximum number of attempts to re-read the data after failed read within the file.
+     */
+    static const int THE_READ_RETRIES_MAX = 5;
+
+    /**
+     * Initial delay before re-reading the data after failed read, doubled on each attempt.
+     */
+    static const int THE_READ_RETRY_MS = 10;
+
+}
+
+StReadAheadFile::StReadAheadFile(const size_t theBlockSize)
+: myRequestEvent(false),
+  myDataEvent(false),
+  myMappedData(NULL),
+  mySize(-1),
+  myPosition(0),
+  myNextOffset(0),
+  myEofOffset(-1),
+  myIsFailed(false),
+  myBlockSize(stMax(theBlockSize, THE_BLOCK_ALIGN)),
+  myNbBlocksMax(4),
+  myGeneration(0),
+  myToQuit(false) {
+    //
+}
+
+StReadAheadFile::~StReadAheadFile() {
+    close();
+}
+
+bool StReadAheadFile::open(const StCString& theFilePath,
+                           const int        theOpenedFd,
+                           const bool       theToMap) {
+    close();
+    myCounters = Counters();
+    if(theToMap
+    && theOpenedFd == -1
+    && !StFileNode::isRemoteProtocolPath(theFilePath)
+    && !StFileNode::isContentProtocolPath(theFilePath)
+    && mapFile(theFilePath)) {
+        return true;
+    }
+
+    if(!myFile.openFile(StRawFile::READ, theFilePath, theOpenedFd)) {
+        return false;
+    }
+
+    mySize   = myFile.getFileSize();
+    myThread = new StThread(readerThread, (void* )this, "StReadAhead");
+    StMutexAuto aLock(myMutex);
+    myRequestEvent.set();
+    return true;
+}
+
+void StReadAheadFile::close() {
+    if(!myThread.isNull()) {
+        {
+            StMutexAuto aLock(myMutex);
+            myToQuit = true;
+            myRequestEvent.set();
+        }
+        myThread->wait();
+        myThread.nullify();
+    }
+    myFile.closeFile();
+    unmapFile();
+
+    for(std::deque<Block>::iterator aBlockIter = myBlocks.begin(); aBlockIter != myBlocks.end(); ++aBlockIter) {
+        stMemFreeAligned(aBlockIter->Data);
+    }
+    for(std::vector<Block>::iterator aBlockIter = myFreeBlocks.begin(); aBlockIter != myFreeBlocks.end(); ++aBlockIter) {
+        stMemFreeAligned(aBlockIter->Data);
+    }
+    StMemoryBudget::add(StMemoryBudget::Consumer_ReadAhead, -int64_t((myBlocks.size() + myFreeBlocks.size()) * myBlockSize));
+    myBlocks.clear();
+    myFreeBlocks.clear();
+    myRequestEvent.reset();
+    myDataEvent.reset();
+    mySize       = -1;
+    myPosition   = 0;
+    myNextOffset = 0;
+    myEofOffset  = -1;
+    myIsFailed   = false;
+    myToQuit     = false;
+}
+
+bool StReadAheadFile::mapFile(const StCString& theFilePath) {
+    void*   aData = NULL;
+    int64_t aSize = 0;
+#ifdef _WIN32
+    StStringUtfWide aPath;
+    aPath.fromUnicode(theFilePath);
+    HANDLE aFile = ::CreateFileW(aPath.toCString(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                 NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if(aFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER aFileSize;
+    if(!::GetFileSizeEx(aFile, &aFileSize)
+    ||  aFileSize.QuadPart <= 0
+    ||  uint64_t(aFileSize.QuadPart) > uint64_t(std::numeric_limits<size_t>::max())) {
+        ::CloseHandle(aFile);
+        return false;
+    }
+
+    // the view keeps references to mapping and file objects
+    HANDLE aMapping = ::CreateFileMappingW(aFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    ::CloseHandle(aFile);
+    if(aMapping == NULL) {
+        return false;
+    }
+    aData = ::MapViewOfFile(aMapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(aMapping);
+    if(aData == NULL) {
+        return false;
+    }
+    aSize = (int64_t )aFileSize.QuadPart;
+#else
+    const int aFile = ::open(theFilePath.toCString(), O_RDONLY);
+    if(aFile == -1) {
+        return false;
+    }
+
+    struct stat aStat;
+    if(::fstat(aFile, &aStat) != 0
+    || aStat.st_size <= 0
+    || uint64_t(aStat.st_size) > uint64_t(std::numeric_limits<size_t>::max())) {
+        ::close(aFile);
+        return false;
+    }
+
+    aData = ::mmap(NULL, size_t(aStat.st_size), PROT_READ, MAP_PRIVATE, aFile, 0);
+    ::close(aFile);
+    if(aData == MAP_FAILED) {
+        return false;
+    }
+    ::madvise(aData, size_t(aStat.st_size), MADV_SEQUENTIAL);
+    aSize = (int64_t )aStat.st_size;
+#endif
+    myMappedData = (const uint8_t* )aData;
+    mySize       = aSize;
+    return true;
+}
+
+void StReadAheadFile::unmapFile() {
+    if(myMappedData == NULL) {
+        return;
+    }
+
+#ifdef _WIN32
+    ::UnmapViewOfFile(myMappedData);
+#else
+    ::munmap((void* )myMappedData, size_t(mySize));
+#endif
+    myMappedData = NULL;
+}
+
+void StReadAheadFile::setReadAhead(const size_t theBytes) {
+    const size_t aBudget = StMemoryBudget::getAvailable(StMemoryBudget::Consumer_ReadAhead);
+    StMutexAuto aLock(myMutex);
+    myNbBlocksMax = stMax((stMin(theBytes, aBudget) + myBlockSize - 1) / myBlockSize, size_t(2));
+    if(!myThread.isNull()) {
+        myRequestEvent.set();
+    }
+}
+
+StReadAheadFile::Counters StReadAheadFile::getCounters() const {
+    StMutexAuto aLock(myMutex);
+    return myCounters;
+}
+
+int64_t StReadAheadFile::seek(const int64_t theOffset,
+                              const int     theWhence) {
+    int64_t aPosition = -1;
+    switch(theWhence) {
+        case SEEK_SET: aPosition = theOffset; break;
+        case SEEK_CUR: aPosition = myPosition + theOffset; break;
+        case SEEK_END: {
+            if(mySize < 0) {
+                return -1;
+            }
+            aPosition = mySize + theOffset;
+            break;
+        }
+        default: return -1;
+    }
+    if(aPosition < 0) {
+        return -1;
+    }
+
+    // blocks are invalidated lazily by read(), so that seeking back and forth within loaded window is cheap
+    myPosition = aPosition;
+    return myPosition;
+}
+
+void StReadAheadFile::invalidate(const int64_t thePosition) {
+    for(std::deque<Block>::iterator aBlockIter = myBlocks.begin(); aBlockIter != myBlocks.end(); ++aBlockIter) {
+        myFreeBlocks.push_back(*aBlockIter);
+    }
+    myBlocks.clear();
+    myNextOffset = thePosition - thePosition % int64_t(myBlockSize);
+    myEofOffset  = -1;
+    myIsFailed   = false;
+    ++myGeneration;
+}
+
+int StReadAheadFile::read(uint8_t*  theBuffer,
+                          const int theBytes) {
+    if(theBuffer == NULL
+    || theBytes <= 0) {
+        return 0;
+    }
+
+    if(myMappedData != NULL) {
+        if(myPosition >= mySize) {
+            return 0;
+        }
+
+        const size_t aNbBytes = (size_t )stMin(int64_t(theBytes), mySize - myPosition);
+        stMemCpy(theBuffer, myMappedData + myPosition, aNbBytes);
+        myPosition += aNbBytes;
+
+        StMutexAuto aLock(myMutex);
+        myCounters.BytesRead   += aNbBytes;
+        myCounters.BytesServed += aNbBytes;
+        ++myCounters.NbHits;
+        return int(aNbBytes);
+    } else if(myThread.isNull()) {
+        return -1;
+    }
+
+    StTimer aStallTimer(false);
+    bool    isStalled = false;
+    size_t  aNbDone   = 0;
+    myMutex.lock();
+    while(aNbDone < size_t(theBytes)) {
+        // release blocks behind current position for reading further
+        while(!myBlocks.empty()
+           &&  myBlocks.front().Offset + int64_t(myBlocks.front().Size) <= myPosition) {
+            myFreeBlocks.push_back(myBlocks.front());
+            myBlocks.pop_front();
+        }
+
+        if(!myBlocks.empty()
+        &&  myBlocks.front().Offset <= myPosition) {
+            const Block& aBlock   = myBlocks.front();
+            const size_t aFrom    = size_t(myPosition - aBlock.Offset);
+            const size_t aNbBytes = stMin(aBlock.Size - aFrom, size_t(theBytes) - aNbDone);
+            stMemCpy(theBuffer + aNbDone, aBlock.Data + aFrom, aNbBytes);
+            aNbDone    += aNbBytes;
+            myPosition += aNbBytes;
+            continue;
+        }
+
+        if((myEofOffset >= 0 && myPosition >= myEofOffset)
+        || aNbDone > 0
+        || myToQuit) {
+            // return partial data instead of waiting for the next block
+            break;
+        }
+
+        const int64_t aWindowFrom = myBlocks.empty() ? myNextOffset : myBlocks.front().Offset;
+        if(myPosition <  aWindowFrom
+        || myPosition >= myNextOffset + int64_t(myBlockSize)) {
+            invalidate(myPosition);
+        }
+
+        if(!isStalled) {
+            isStalled = true;
+            aStallTimer.restart();
+        }
+        myDataEvent.reset();
+        myRequestEvent.set();
+        myMutex.unlock();
+        myDataEvent.wait(THE_WAIT_MS);
+        myMutex.lock();
+    }
+
+    if(isStalled) {
+        ++myCounters.NbMisses;
+        myCounters.StallTime += aStallTimer.getElapsedTimeInSec();
+    } else {
+        ++myCounters.NbHits;
+    }
+    myCounters.BytesServed += aNbDone;
+    if(myBlocks.size() < myNbBlocksMax) {
+        myRequestEvent.set();
+    }
+    const bool isFailed = aNbDone == 0
+                       && myIsFailed
+                       && myPosition >= myEofOffset;
+    myMutex.unlock();
+    return isFailed ? -1 : int(aNbDone);
+}
+
+SV_THREAD_FUNCTION StReadAheadFile::readerThread(void* theFile) {
+    StReadAheadFile* aFile = (StReadAheadFile* )theFile;
+    aFile->readerLoop();
+    return SV_THREAD_RETURN 0;
+}
+
+void StReadAheadFile::readerLoop() {
+    int aNbFailures = 0;
+    for(;;) {
+        myRequestEvent.wait();
+
+        const bool isUnderPressure = StMemoryBudget::isUnderPressure();
+        Block   aBlock;
+        int     aGeneration = 0;
+        {
+            StMutexAuto aLock(myMutex);
+            if(myToQuit) {
+                return;
+            }
+
+            if(isUnderPressure) {
+                // release pooled blocks and keep reading with minimal window
+                for(std::vector<Block>::iterator aBlockIter = myFreeBlocks.begin(); aBlockIter != myFreeBlocks.end(); ++aBlockIter) {
+                    stMemFreeAligned(aBlockIter->Data);
+                }
+                StMemoryBudget::add(StMemoryBudget::Consumer_ReadAhead, -int64_t(myFreeBlocks.size() * myBlockSize));
+                myFreeBlocks.clear();
+                if(myBlocks.size() >= 2) {
+                    myRequestEvent.reset();
+                    continue;
+                }
+            }
+
+            if(myBlocks.size() >= myNbBlocksMax
+            || (myEofOffset >= 0 && myNextOffset >= myEofOffset)) {
+                myRequestEvent.reset();
+                continue;
+            }
+
+            if(!myFreeBlocks.empty()) {
+                aBlock = myFreeBlocks.back();
+                myFreeBlocks.pop_back();
+            } else {
+                aBlock.Data = stMemAllocAligned<uint8_t*>(myBlockSize, THE_BLOCK_ALIGN);
+                if(aBlock.Data == NULL) {
+                    ST_ERROR_LOG(StString("StReadAheadFile, unable to allocate ") + myBlockSize + " bytes");
+                    myEofOffset = myNextOffset;
+                    myDataEvent.set();
+                    myRequestEvent.reset();
+                    continue;
+                }
+                StMemoryBudget::add(StMemoryBudget::Consumer_ReadAhead, int64_t(myBlockSize));
+            }
+            aBlock.Offset = myNextOffset;
+            aGeneration   = myGeneration;
+        }
+
+        aBlock.Size = myFile.readRange(aBlock.Offset, aBlock.Data, myBlockSize);
+
+        int aRetryDelay = 0;
+        {
+            StMutexAuto aLock(myMutex);
+            myCounters.BytesRead += aBlock.Size;
+            if(aGeneration != myGeneration) {
+                // consumer has seeked to another position
+                myFreeBlocks.push_back(aBlock);
+                continue;
+            }
+
+            const int64_t aBlockEnd = aBlock.Offset + int64_t(aBlock.Size);
+            if(aBlock.Size < myBlockSize
+            && (mySize < 0 || aBlockEnd >= mySize)) {
+                // end of file
+                myEofOffset = aBlockEnd;
+            } else if(aBlock.Size == 0) {
+                // failed read within the file (e.g. network share hiccup) - retry with back-off
+                if(++aNbFailures > THE_READ_RETRIES_MAX) {
+                    ST_ERROR_LOG(StString("StReadAheadFile, unable to read data at offset ") + aBlock.Offset);
+                    myEofOffset = aBlockEnd;
+                    myIsFailed  = true;
+                    aNbFailures = 0;
+                } else {
+                    aRetryDelay = THE_READ_RETRY_MS << (aNbFailures - 1);
+                }
+            } else {
+                aNbFailures = 0;
+            }
+            if(aBlock.Size != 0) {
+                myBlocks.push_back(aBlock);
+                myNextOffset += int64_t(aBlock.Size);
+            } else {
+                myFreeBlocks.push_back(aBlock);
+            }
+            myDataEvent.set();
+        }
+        if(aRetryDelay > 0) {
+            StThread::sleep(aRetryDelay);
+        }
+    }
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#include <StThreads/StStartupTrace.h>
+
+#include <StThreads/StMutex.h>
+#include <StThreads/StTimer.h>
+
+#include <vector>
+
+namespace {
+
+    /**
+     * Recorded phase.
+     */
+    struct StStartupPhase {
+        StString Name;     //!< phase name
+        double   Start;    //!< start time of the first occurrence in seconds
+        double   Duration; //!< accumulated duration in seconds
+        int      Depth;    //!< nesting level
+        int      NbCalls;  //!< number of occurrences
+    };
+
+    /**
+     * Global trace state.
+     */
+    struct StStartupTraceState {
+        StMutex                     Mutex;
+        StTimer                     Timer;
+        std::vector<StStartupPhase> Phases;
+        int                         Depth;
+        bool                        IsFinished;
+
+        StStartupTraceState() : Timer(true), Depth(0), IsFinished(false) {}
+    };
+
+    static StStartupTraceState& getState() {
+        static StStartupTraceState THE_STATE;
+        return THE_STATE;
+    }
+
+}
+
+StStartupTrace::Phase::Phase(const char* theName,
+                             const char* theSuffix)
+: myName(theName),
+  mySuffix(theSuffix),
+  myStart(StStartupTrace::getTime()) {
+    if(myStart >= 0.0) {
+        StStartupTraceState& aState = getState();
+        StMutexAuto aLock(aState.Mutex);
+        ++aState.Depth;
+    }
+}
+
+StStartupTrace::Phase::~Phase() {
+    if(myStart < 0.0) {
+        return;
+    }
+
+    StStartupTraceState& aState = getState();
+    int aDepth = 0;
+    {
+        StMutexAuto aLock(aState.Mutex);
+        aDepth = --aState.Depth;
+    }
+    const double aTime = StStartupTrace::getTime();
+    if(aTime >= 0.0) {
+        StString aName(myName);
+        if(mySuffix != NULL) {
+            aName += StString(mySuffix);
+        }
+        StStartupTrace::addPhase(aName, myStart, aTime - myStart, aDepth);
+    }
+}
+
+double StStartupTrace::getTime() {
+    StStartupTraceState& aState = getState();
+    StMutexAuto aLock(aState.Mutex);
+    return !aState.IsFinished
+         ? aState.Timer.getElapsedTimeInSec()
+         : -1.0;
+}
+
+void StStartupTrace::addPhase(const StString& theName,
+                              const double    theStart,
+                              const double    theDuration,
+                              const int       theDepth) {
+    StStartupTraceState& aState = getState();
+    StMutexAuto aLock(aState.Mutex);
+    if(aState.IsFinished) {
+        return;
+    }
+
+    for(std::vector<StStartupPhase>::iterator aPhaseIter = aState.Phases.begin(); aPhaseIter != aState.Phases.end(); ++aPhaseIter) {
+        if(aPhaseIter->Name == theName) {
+            aPhaseIter->Duration += theDuration;
+            ++aPhaseIter->NbCalls;
+            return;
+        }
+    }
+
+    StStartupPhase aPhase;
+    aPhase.Name     = theName;
+    aPhase.Start    = theStart;
+    aPhase.Duration = theDuration;
+    aPhase.Depth    = theDepth;
+    aPhase.NbCalls  = 1;
+
+    // keep phases sorted by start time, nested phases are finished before their parent
+    std::vector<StStartupPhase>::iterator aPos = aState.Phases.end();
+    while(aPos != aState.Phases.begin()
+       && (aPos - 1)->Start > theStart) {
+        --aPos;
+    }
+    aState.Phases.insert(aPos, aPhase);
+}
+
+void StStartupTrace::mark(const StString& theName) {
+    const double aTime = getTime();
+    if(aTime >= 0.0) {
+        addPhase(theName, aTime, 0.0, 0);
+    }
+}
+
+void StStartupTrace::finish() {
+    StStartupTraceState& aState = getState();
+    StMutexAuto aLock(aState.Mutex);
+    aState.IsFinished = true;
+}
+
+bool StStartupTrace::isFinished() {
+    StStartupTraceState& aState = getState();
+    StMutexAuto aLock(aState.Mutex);
+    return aState.IsFinished;
+}
+
+StString StStartupTrace::format() {
+    StStartupTraceState& aState = getState();
+    StMutexAuto aLock(aState.Mutex);
+    StString aText = "Startup trace (start, duration in milliseconds):\n";
+    for(std::vector<StStartupPhase>::const_iterator aPhaseIter = aState.Phases.begin(); aPhaseIter != aState.Phases.end(); ++aPhaseIter) {
+        char aBuffer[64];
+        stsprintf(aBuffer, sizeof(aBuffer), "%9.1f %9.1f  ", aPhaseIter->Start * 1000.0, aPhaseIter->Duration * 1000.0);
+        aText += aBuffer;
+        for(int aDepthIter = 0; aDepthIter < aPhaseIter->Depth; ++aDepthIter) {
+            aText += "  ";
+        }
+        aText += aPhaseIter->Name;
+        if(aPhaseIter->NbCalls > 1) {
+            aText += StString(" (x") + aPhaseIter->NbCalls + ")";
+        }
+        aText += "\n";
+    }
+    return aText;
+}
@@ -35,6 +35,14 @@
     #else
         #include <sched.h>
     #endif
+
+    #if defined(__APPLE__)
+        #include <pthread.h>
+    #elif defined(__linux__)
+        #include <sys/resource.h>
+        #include <sys/syscall.h>
+        #include <unistd.h>
+    #endif
 #endif
 
 #include <StFile/StRawFile.h>
@@ -113,6 +121,17 @@ void StThread::setCurrentThreadName(const char* theName) {
 #endif
 }
 
+void StThread::setCurrentThreadLowPriority() {
+#ifdef _WIN32
+    ::SetThreadPriority(::GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(__APPLE__)
+    pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+#elif defined(__linux__)
+    // nice value is per-thread on Linux
+    setpriority(PRIO_PROCESS, (id_t )syscall(SYS_gettid), 10);
+#endif
+}
+
 bool StThread::wait() {
     if(!isValid()) {
         return false;
@@ -0,0 +1,128 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#include <StThreads/StThreadPool.h>
+
+StThreadPool::Job::Job()
+: myDoneEvent(false),
+  myIsCancelled(false) {
+    //
+}
+
+StThreadPool::Job::~Job() {
+    //
+}
+
+bool StThreadPool::Job::isDone() const {
+    return myDoneEvent.check();
+}
+
+const StHandle<StThreadPool>& StThreadPool::getShared() {
+    static const StHandle<StThreadPool> THE_POOL = new StThreadPool("StWorker");
+    return THE_POOL;
+}
+
+StThreadPool::StThreadPool(const char* theName,
+                           const int   theNbThreads)
+: myEvent(false),
+  myName(theName),
+  myNbThreads(theNbThreads > 0
+            ? theNbThreads
+            : stMax(2, stMin(4, StThread::countLogicalProcessors() - 1))),
+  myToQuit(false) {
+    //
+}
+
+StThreadPool::~StThreadPool() {
+    {
+        StMutexAuto aLock(myMutex);
+        for(std::deque< StHandle<Job> >::iterator aJobIter = myJobs.begin(); aJobIter != myJobs.end(); ++aJobIter) {
+            (*aJobIter)->myIsCancelled = true;
+            (*aJobIter)->myDoneEvent.set();
+        }
+        myJobs.clear();
+        myToQuit = true;
+        myEvent.set();
+    }
+    for(size_t aThreadIter = 0; aThreadIter < myThreads.size(); ++aThreadIter) {
+        myThreads[aThreadIter]->wait();
+    }
+    myThreads.clear();
+}
+
+void StThreadPool::push(const StHandle<Job>& theJob) {
+    if(theJob.isNull()) {
+        return;
+    }
+
+    StMutexAuto aLock(myMutex);
+    if(myThreads.empty()) {
+        for(int aThreadIter = 0; aThreadIter < myNbThreads; ++aThreadIter) {
+            myThreads.push_back(new StThread(threadFunction, (void* )this, myName));
+        }
+    }
+
+    theJob->myIsCancelled = false;
+    theJob->myDoneEvent.reset();
+    myJobs.push_back(theJob);
+    myEvent.set();
+}
+
+void StThreadPool::cancel(const StHandle<Job>& theJob) {
+    if(theJob.isNull()) {
+        return;
+    }
+
+    StMutexAuto aLock(myMutex);
+    theJob->myIsCancelled = true;
+    for(std::deque< StHandle<Job> >::iterator aJobIter = myJobs.begin(); aJobIter != myJobs.end(); ++aJobIter) {
+        if(*aJobIter == theJob) {
+            // job has not been started yet
+            myJobs.erase(aJobIter);
+            theJob->myDoneEvent.set();
+            return;
+        }
+    }
+}
+
+bool StThreadPool::wait(const StHandle<Job>& theJob,
+                        const size_t         theTimeMilliseconds) {
+    return theJob.isNull()
+        || theJob->myDoneEvent.wait(theTimeMilliseconds);
+}
+
+SV_THREAD_FUNCTION StThreadPool::threadFunction(void* thePool) {
+    StThreadPool* aPool = (StThreadPool* )thePool;
+    aPool->mainLoop();
+    return SV_THREAD_RETURN 0;
+}
+
+void StThreadPool::mainLoop() {
+    for(;;) {
+        myEvent.wait();
+
+        StHandle<Job> aJob;
+        {
+            StMutexAuto aLock(myMutex);
+            if(myToQuit) {
+                return;
+            }
+            if(myJobs.empty()) {
+                if(!myToQuit) {
+                    myEvent.reset();
+                }
+                continue;
+            }
+            aJob = myJobs.front();
+            myJobs.pop_front();
+        }
+
+        if(!aJob->myIsCancelled) {
+            aJob->perform();
+        }
+        aJob->myDoneEvent.set();
+    }
+}
@@ -0,0 +1,312 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#include <StImage/StThumbnailService.h>
+
+#include <StAV/StAVImage.h>
+#include <StFile/StFileNode.h>
+#include <StFile/StFolder.h>
+#include <StFile/StMIME.h>
+#include <StImage/StJpegParser.h>
+#include <StStrings/StLogger.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+namespace {
+
+    /**
+     * Maximum resolution reduction supported by JPEG decoder (1/8).
+     */
+    static const int THE_LOWRES_MAX = 3;
+
+    /**
+     * Maximum size of on-disk cache in bytes.
+     */
+    static const int64_t THE_CACHE_SIZE_MAX = 64 * 1024 * 1024;
+
+    /**
+     * Maximum age of cached thumbnail in seconds (90 days).
+     */
+    static const int64_t THE_CACHE_AGE_MAX = 90 * 24 * 3600;
+
+    /**
+     * Number of new cached thumbnails between cache trimming.
+     */
+    static const size_t THE_CACHE_TRIM_PERIOD = 256;
+
+    /**
+     * Maximum age of cache trimming lock file in seconds.
+     */
+    static const int64_t THE_CACHE_LOCK_AGE_MAX = 600;
+
+    /**
+     * Compute 64-bit FNV-1a hash of the string.
+     */
+    static uint64_t hashFnv1a(const StString& theString) {
+        uint64_t aHash = 14695981039346656037ULL;
+        for(size_t aByteIter = 0; aByteIter < theString.getSize(); ++aByteIter) {
+            aHash ^= (uint8_t )theString.toCString()[aByteIter];
+            aHash *= 1099511628211ULL;
+        }
+        return aHash;
+    }
+
+}
+
+StThumbnailService::StThumbnailService(const StString& theCacheFolder,
+                                       const int       theSizeMax,
+                                       const int       theNbThreads)
+: myEvent(false),
+  myCacheFolder(theCacheFolder),
+  mySizeMax(stMax(theSizeMax, 1)),
+  myNbCached(0),
+  myToTrimCache(true),
+  myToQuit(false) {
+    if(!myCacheFolder.isEmpty()) {
+        if(!myCacheFolder.isEndsWith(SYS_FS_SPLITTER)) {
+            myCacheFolder += StString(SYS_FS_SPLITTER);
+        }
+        if(!StFolder::isFolder(myCacheFolder)
+        && !StFolder::createFolder(myCacheFolder)) {
+            ST_ERROR_LOG("StThumbnailService, unable to create cache folder '" + myCacheFolder + "'");
+            myCacheFolder.clear();
+        }
+    }
+
+    // thumbnails are generated in background and should not steal CPU from rendering / playback
+    const int aNbThreads = theNbThreads > 0
+                         ? theNbThreads
+                         : stMax(1, stMin(2, StThread::countLogicalProcessors() / 4));
+    for(int aThreadIter = 0; aThreadIter < aNbThreads; ++aThreadIter) {
+        myThreads.push_back(new StThread(threadFunction, (void* )this, "StThumbnail"));
+    }
+}
+
+StThumbnailService::~StThumbnailService() {
+    {
+        StMutexAuto aLock(myMutex);
+        myToQuit = true;
+        myEvent.set();
+    }
+    for(size_t aThreadIter = 0; aThreadIter < myThreads.size(); ++aThreadIter) {
+        myThreads[aThreadIter]->wait();
+    }
+    myThreads.clear();
+}
+
+void StThumbnailService::request(const StString& thePath) {
+    StMutexAuto aLock(myMutex);
+    std::deque<StString>::iterator anIter = std::find(myRequests.begin(), myRequests.end(), thePath);
+    if(anIter != myRequests.end()) {
+        myRequests.erase(anIter);
+    }
+    myRequests.push_back(thePath);
+    myEvent.set();
+}
+
+void StThumbnailService::clearRequests() {
+    StMutexAuto aLock(myMutex);
+    myRequests.clear();
+}
+
+bool StThumbnailService::popResult(Result& theResult) {
+    StMutexAuto aLock(myMutex);
+    if(myResults.empty()) {
+        return false;
+    }
+    theResult = myResults.front();
+    myResults.pop_front();
+    return true;
+}
+
+SV_THREAD_FUNCTION StThumbnailService::threadFunction(void* theService) {
+    StThumbnailService* aService = (StThumbnailService* )theService;
+    aService->mainLoop();
+    return SV_THREAD_RETURN 0;
+}
+
+void StThumbnailService::mainLoop() {
+    StThread::setCurrentThreadLowPriority();
+    for(;;) {
+        myEvent.wait();
+
+        StString aPath;
+        {
+            StMutexAuto aLock(myMutex);
+            if(myToQuit) {
+                return;
+            }
+            if(myRequests.empty()) {
+                if(!myToQuit) {
+                    myEvent.reset();
+                }
+                continue;
+            }
+            aPath = myRequests.back();
+            myRequests.pop_back();
+        }
+
+        if(myToTrimCache) {
+            bool toTrim = false;
+            {
+                StMutexAuto aLock(myMutex);
+                toTrim = myToTrimCache;
+                myToTrimCache = false;
+            }
+            if(toTrim) {
+                trimCache();
+            }
+        }
+
+        Result aResult;
+        aResult.Path = aPath;
+        if(!StFileNode::isFileExists(aPath)) {
+            // remote streams are not processed
+            StMutexAuto aLock(myMutex);
+            myResults.push_back(aResult);
+            continue;
+        }
+
+        const StString aCachePath = getCachePath(aPath);
+        if(!aCachePath.isEmpty()
+        && StFileNode::isFileExists(aCachePath)) {
+            StAVImage aCached;
+            if(aCached.load(aCachePath, StImageFile::ST_TYPE_JPEG)) {
+                aResult.Image = scaleToFit(aCached, mySizeMax);
+                // cache is trimmed from the least recently used files
+                StFileNode::touchFile(aCachePath);
+            }
+        }
+
+        if(aResult.Image.isNull()) {
+            aResult.Image = generate(aPath, mySizeMax);
+            if(!aResult.Image.isNull()
+            && !aCachePath.isEmpty()) {
+                StAVImage aCached;
+                StImageFile::SaveImageParams aParams;
+                aParams.SaveImageType = StImageFile::ST_TYPE_JPEG;
+                if(!aCached.initWrapper(*aResult.Image)
+                || !aCached.save(aCachePath, aParams)) {
+                    ST_DEBUG_LOG("StThumbnailService, unable to save '" + aCachePath + "'");
+                } else {
+                    StMutexAuto aLock(myMutex);
+                    if(++myNbCached % THE_CACHE_TRIM_PERIOD == 0) {
+                        myToTrimCache = true;
+                    }
+                }
+            }
+        }
+
+        StMutexAuto aLock(myMutex);
+        myResults.push_back(aResult);
+    }
+}
+
+void StThumbnailService::trimCache() {
+    // the same folder might be shared by several services and by several application instances,
+    // so that trimming is guarded by lock file; stalled lock left by terminated process is removed
+    const StString aLockPath = myCacheFolder + "trim.lock";
+    int64_t aLockSize = 0, aLockTime = 0;
+    if(StFileNode::getFileInfo(aLockPath, aLockSize, aLockTime)) {
+        if((int64_t )::time(NULL) - aLockTime < THE_CACHE_LOCK_AGE_MAX) {
+            return;
+        }
+        StFileNode::removeFile(aLockPath);
+    }
+
+#ifdef _WIN32
+    StStringUtfWide aLockPathW;
+    aLockPathW.fromUnicode(aLockPath);
+    FILE* aLockFile = _wfopen(aLockPathW.toCString(), L"wx");
+#else
+    FILE* aLockFile = ::fopen(aLockPath.toCString(), "wx");
+#endif
+    if(aLockFile == NULL) {
+        return;
+    }
+    ::fclose(aLockFile);
+
+    StFolder::trimFiles(myCacheFolder, "jpg", THE_CACHE_SIZE_MAX, THE_CACHE_AGE_MAX);
+    StFileNode::removeFile(aLockPath);
+}
+
+StString StThumbnailService::getCachePath(const StString& thePath) const {
+    if(myCacheFolder.isEmpty()) {
+        return StString();
+    }
+
+    int64_t aSize = 0, aModifTime = 0;
+    if(!StFileNode::getFileInfo(thePath, aSize, aModifTime)) {
+        return StString();
+    }
+
+    const StString aKey = thePath + "|" + aSize + "|" + aModifTime + "|" + mySizeMax;
+    char aName[32];
+    stsprintf(aName, sizeof(aName), "%016llx.jpg", (unsigned long long )hashFnv1a(aKey));
+    return myCacheFolder + aName;
+}
+
+StHandle<StImage> StThumbnailService::generate(const StString& thePath,
+                                               const int       theSizeMax) {
+    const StImageFile::ImageType anImgType = StImageFile::guessImageType(thePath, StMIME());
+    StAVImage anImage;
+    if(anImgType == StImageFile::ST_TYPE_JPEG
+    || anImgType == StImageFile::ST_TYPE_MPO
+    || anImgType == StImageFile::ST_TYPE_JPS) {
+        StJpegParser aParser;
+        if(aParser.readHeaders(thePath)
+        && !aParser.getImage(0).isNull()) {
+            const StHandle<StJpegParser::Image> anImg = aParser.getImage(0);
+            if(!anImg->Thumb.isNull()
+            && anImage.load(thePath, StImageFile::ST_TYPE_JPEG, anImg->Thumb->Data, (int )anImg->Thumb->Length)) {
+                return scaleToFit(anImage, theSizeMax);
+            }
+
+            // no embedded thumbnail - decode at the smallest resolution still covering thumbnail
+            int aLowRes = 0;
+            while(aLowRes < THE_LOWRES_MAX
+               && (anImg->SizeX >> (aLowRes + 1)) >= size_t(theSizeMax)
+               && (anImg->SizeY >> (aLowRes + 1)) >= size_t(theSizeMax)) {
+                ++aLowRes;
+            }
+            anImage.setLowResolution(aLowRes);
+        }
+    }
+
+    // for video files the first key frame is decoded
+    if(!anImage.load(thePath, anImgType)) {
+        return StHandle<StImage>();
+    }
+    return scaleToFit(anImage, theSizeMax);
+}
+
+StHandle<StImage> StThumbnailService::scaleToFit(const StImage& theImage,
+                                                 const int      theSizeMax) {
+    if(theImage.isNull()
+    || theImage.getSizeX() < 1
+    || theImage.getSizeY() < 1) {
+        return StHandle<StImage>();
+    }
+
+    const GLfloat aRatio = theImage.getRatio();
+    size_t aSizeX = size_t(theSizeMax);
+    size_t aSizeY = size_t(theSizeMax);
+    if(aRatio >= 1.0f) {
+        aSizeY = stMax(size_t(GLfloat(theSizeMax) / aRatio), size_t(1));
+    } else {
+        aSizeX = stMax(size_t(GLfloat(theSizeMax) * aRatio), size_t(1));
+    }
+
+    StHandle<StImage> aThumb = new StImage();
+    aThumb->setColorModelPacked(StImagePlane::ImgRGB);
+    if(!aThumb->changePlane(0).initTrash(StImagePlane::ImgRGB, aSizeX, aSizeY)
+    || !StAVImage::resize(theImage, *aThumb)) {
+        return StHandle<StImage>();
+    }
+    return aThumb;
+}
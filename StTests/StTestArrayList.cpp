@@ -0,0 +1,152 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StTestArrayList.h"
+
+#include <StFile/StNode.h>
+#include <StStrings/stConsole.h>
+#include <StTemplates/StArrayList.h>
+
+namespace {
+
+    static const size_t THE_NB_ELEMENTS = 100000;
+    static const size_t THE_NB_LEGACY   = 20000; //!< constant growth is quadratic, so that smaller list is used
+
+    /**
+     * List element counting copies and moves.
+     */
+    struct StTestArrayItem {
+
+        static size_t NbCopies;
+        static size_t NbMoves;
+
+        StString Name;
+
+        StTestArrayItem() {}
+
+        explicit StTestArrayItem(const StString& theName) : Name(theName) {}
+
+        StTestArrayItem(const StTestArrayItem& theCopy) : Name(theCopy.Name) { ++NbCopies; }
+
+        StTestArrayItem(StTestArrayItem&& theOther) : Name(std::move(theOther.Name)) { ++NbMoves; }
+
+        StTestArrayItem& operator=(const StTestArrayItem& theCopy) {
+            Name = theCopy.Name;
+            ++NbCopies;
+            return *this;
+        }
+
+        StTestArrayItem& operator=(StTestArrayItem&& theOther) {
+            Name = std::move(theOther.Name);
+            ++NbMoves;
+            return *this;
+        }
+
+        bool operator==(const StTestArrayItem& theOther) const { return Name == theOther.Name; }
+        bool operator!=(const StTestArrayItem& theOther) const { return Name != theOther.Name; }
+        bool operator> (const StTestArrayItem& theOther) const { return Name >  theOther.Name; }
+        bool operator<=(const StTestArrayItem& theOther) const { return Name <= theOther.Name; }
+
+    };
+
+    size_t StTestArrayItem::NbCopies = 0;
+    size_t StTestArrayItem::NbMoves  = 0;
+
+}
+
+void StTestArrayList::testList(const Mode theMode) {
+    switch(theMode) {
+        case Mode_Legacy:  st::cout << stostream_text("  add(), growth by 8 elements:  ") << THE_NB_LEGACY << stostream_text(" elements, "); break;
+        case Mode_Copy:    st::cout << stostream_text("  add(const Element_t& ):       "); break;
+        case Mode_Move:    st::cout << stostream_text("  add(Element_t&& ):            "); break;
+        case Mode_Emplace: st::cout << stostream_text("  emplace():                    "); break;
+        case Mode_Reserve: st::cout << stostream_text("  reserve() + emplace():        "); break;
+    }
+
+    StTestArrayItem::NbCopies = 0;
+    StTestArrayItem::NbMoves  = 0;
+    size_t aNbReallocs = 0;
+    const StString aName("/home/user/Videos/some_folder/movie_file_name.mkv");
+
+    const size_t aNbElements = theMode == Mode_Legacy ? THE_NB_LEGACY : THE_NB_ELEMENTS;
+    myTimer.restart();
+    {
+        StArrayList<StTestArrayItem> aList(1);
+        if(theMode == Mode_Reserve) {
+            aList.reserve(THE_NB_ELEMENTS);
+        }
+        size_t aCapacity = aList.getCapacity();
+        for(size_t anIter = 0; anIter < aNbElements; ++anIter) {
+            switch(theMode) {
+                case Mode_Legacy: {
+                    if(aList.size() >= aList.getCapacity()) {
+                        aList.reserve(aList.getCapacity() + 8);
+                    }
+                    aList.add(StTestArrayItem(aName));
+                    break;
+                }
+                case Mode_Copy: {
+                    const StTestArrayItem anItem(aName);
+                    aList.add(anItem);
+                    break;
+                }
+                case Mode_Move: {
+                    aList.add(StTestArrayItem(aName));
+                    break;
+                }
+                case Mode_Emplace:
+                case Mode_Reserve: {
+                    aList.emplace(aName);
+                    break;
+                }
+            }
+            if(aCapacity != aList.getCapacity()) {
+                aCapacity = aList.getCapacity();
+                ++aNbReallocs;
+            }
+        }
+    }
+    const double aTimeMSec = myTimer.getElapsedTimeInMilliSec();
+    st::cout << aTimeMSec << stostream_text(" msec, ")
+             << aNbReallocs << stostream_text(" reallocations, ")
+             << StTestArrayItem::NbCopies << stostream_text(" copies, ")
+             << StTestArrayItem::NbMoves  << stostream_text(" moves\n");
+}
+
+void StTestArrayList::testNodes() {
+    myTimer.restart();
+    {
+        StNode aFolder(stCString("folder"));
+        for(size_t anIter = 0; anIter < THE_NB_ELEMENTS; ++anIter) {
+            aFolder.add(new StNode(stCString("file.jpg"), &aFolder));
+        }
+    }
+    const double aTimeMSec = myTimer.getElapsedTimeInMilliSec();
+    st::cout << stostream_text("  StNode with ") << THE_NB_ELEMENTS << stostream_text(" children:\t")
+             << aTimeMSec << stostream_text(" msec\n");
+}
+
+void StTestArrayList::perform() {
+    st::cout << stostream_text("StArrayList filling tests (") << THE_NB_ELEMENTS << stostream_text(" elements).\n");
+    testList(Mode_Legacy);
+    testList(Mode_Copy);
+    testList(Mode_Move);
+    testList(Mode_Emplace);
+    testList(Mode_Reserve);
+    testNodes();
+}
@@ -0,0 +1,50 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StTestArrayList_h_
+#define __StTestArrayList_h_
+
+#include "StTest.h"
+
+/**
+ * Tests StArrayList filling performance - number of reallocations,
+ * element copies / moves and time to build large lists and node trees.
+ */
+class ST_LOCAL StTestArrayList : public StTest {
+
+        public:
+
+    virtual void perform() ST_ATTR_OVERRIDE;
+
+        private:
+
+    enum Mode {
+        Mode_Legacy,  //!< constant growth by 8 elements (previous behavior)
+        Mode_Copy,    //!< add() copying element
+        Mode_Move,    //!< add() moving element
+        Mode_Emplace, //!< emplace() constructing element from arguments
+        Mode_Reserve, //!< reserve() followed by emplace()
+    };
+
+    void testList(const Mode theMode);
+
+    void testNodes();
+
+};
+
+#endif // __StTestArrayList_h_
@@ -0,0 +1,573 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StTestBench.h"
+
+#include "../StMoviePlayer/StVideo/StPCMBuffer.h"
+#include "../StMoviePlayer/StVideo/StPCMStretch.h"
+
+#include <StStrings/stConsole.h>
+#include <StAV/StAVFrame.h>
+#include <StAV/StAVImage.h>
+#include <StFile/StRawFile.h>
+#include <StGL/StPlayList.h>
+#include <StGLStereo/StGLTextureData.h>
+#include <StImage/StJpegParser.h>
+#include <StThreads/StProcess.h>
+
+namespace {
+
+    static const int THE_CLIP_SIZE_X    = 1280;
+    static const int THE_CLIP_SIZE_Y    = 720;
+    static const int THE_CLIP_NB_FRAMES = 100;
+
+    /**
+     * Fill the plane with moving gradient.
+     */
+    static void fillPattern(uint8_t*     theData,
+                            const int    theLineSize,
+                            const size_t theSizeX,
+                            const size_t theSizeY,
+                            const size_t theBytesPerPixel,
+                            const size_t theSeed) {
+        for(size_t aRow = 0; aRow < theSizeY; ++aRow) {
+            uint8_t* aLine = theData + aRow * size_t(theLineSize);
+            for(size_t aCol = 0; aCol < theSizeX * theBytesPerPixel; ++aCol) {
+                aLine[aCol] = uint8_t((aCol / theBytesPerPixel + aRow + theSeed * 4 + (aCol % theBytesPerPixel) * 50) & 0xFF);
+            }
+        }
+    }
+
+    /**
+     * Initialize synthetic RGB image.
+     */
+    static void initImageRgb(StImage&     theImage,
+                             const size_t theSizeX,
+                             const size_t theSizeY) {
+        theImage.setColorModel(StImage::ImgColor_RGB);
+        theImage.changePlane(0).initTrash(StImagePlane::ImgRGB, theSizeX, theSizeY);
+        fillPattern(theImage.changePlane(0).changeData(), (int )theImage.getPlane(0).getSizeRowBytes(),
+                    theSizeX, theSizeY, 3, 0);
+    }
+
+    /**
+     * Initialize synthetic YUV 4:2:0 image.
+     */
+    static void initImageYuv(StImage&     theImage,
+                             const size_t theSizeX,
+                             const size_t theSizeY) {
+        theImage.setColorModel(StImage::ImgColor_YUV);
+        theImage.setColorScale(StImage::ImgScale_Mpeg);
+        for(size_t aPlaneIter = 0; aPlaneIter < 3; ++aPlaneIter) {
+            const size_t aDiv = aPlaneIter == 0 ? 1 : 2;
+            StImagePlane& aPlane = theImage.changePlane(aPlaneIter);
+            aPlane.initTrash(StImagePlane::ImgGray, theSizeX / aDiv, theSizeY / aDiv);
+            fillPattern(aPlane.changeData(), (int )aPlane.getSizeRowBytes(),
+                        aPlane.getSizeX(), aPlane.getSizeY(), 1, aPlaneIter);
+        }
+    }
+
+    /**
+     * Auxiliary buffer counter keeping nothing, so that texture data would reference image buffers instead of copying.
+     */
+    class StBenchBufferCounter : public StBufferCounter {
+
+            public:
+
+        virtual void createReference(StHandle<StBufferCounter>& theOther) const ST_ATTR_OVERRIDE {
+            if(theOther.isNull()) {
+                theOther = new StBenchBufferCounter();
+            }
+        }
+
+        virtual void releaseReference() ST_ATTR_OVERRIDE {}
+
+    };
+
+}
+
+StTestBench::StTestBench(const StString& theOutput)
+: myOutput(theOutput) {
+    //
+}
+
+void StTestBench::addResult(const StString& theGroup,
+                            const StString& theName,
+                            const double    theValue,
+                            const StString& theUnits) {
+    Result aResult;
+    aResult.Group = theGroup;
+    aResult.Name  = theName;
+    aResult.Units = theUnits;
+    aResult.Value = theValue;
+    myResults.push_back(aResult);
+    st::cout << stostream_text("  ") << theName << stostream_text(":\t") << theValue
+             << stostream_text(" ") << theUnits << stostream_text("\n");
+}
+
+bool StTestBench::saveResults() const {
+    StString aJson = "{\n  \"results\": [\n";
+    for(size_t aResIter = 0; aResIter < myResults.size(); ++aResIter) {
+        const Result& aRes = myResults[aResIter];
+        aJson += StString("    {\"group\": \"") + aRes.Group
+               + "\", \"name\": \"" + aRes.Name
+               + "\", \"value\": " + aRes.Value
+               + ", \"units\": \"" + aRes.Units + "\"}"
+               + (aResIter + 1 < myResults.size() ? ",\n" : "\n");
+    }
+    aJson += "  ]\n}\n";
+
+    StRawFile aFile(myOutput);
+    if(!aFile.openFile(StRawFile::WRITE)) {
+        return false;
+    }
+    aFile.write(aJson);
+    aFile.closeFile();
+    return true;
+}
+
+bool StTestBench::encodeClip(const char* theEncoder,
+                             const int   thePixFmt,
+                             std::vector< StHandle<StAVPacket> >& thePackets) {
+    const AVCodec* aCodec = avcodec_find_encoder_by_name(theEncoder);
+    if(aCodec == NULL) {
+        return false;
+    }
+
+    AVCodecContext* aCtx = avcodec_alloc_context3(aCodec);
+    aCtx->width   = THE_CLIP_SIZE_X;
+    aCtx->height  = THE_CLIP_SIZE_Y;
+    aCtx->pix_fmt = (AVPixelFormat )thePixFmt;
+    aCtx->time_base.num = 1;
+    aCtx->time_base.den = 25;
+    aCtx->gop_size = 12;
+    aCtx->bit_rate = 8000000;
+    aCtx->qmin = 2;
+    aCtx->qmax = 8;
+    if(avcodec_open2(aCtx, aCodec, NULL) < 0) {
+        avcodec_free_context(&aCtx);
+        return false;
+    }
+
+    const AVPixFmtDescriptor* aDesc = av_pix_fmt_desc_get(aCtx->pix_fmt);
+    StAVFrame aFrame;
+    aFrame.Frame->format = aCtx->pix_fmt;
+    aFrame.Frame->width  = aCtx->width;
+    aFrame.Frame->height = aCtx->height;
+    if(av_frame_get_buffer(aFrame.Frame, 32) < 0) {
+        avcodec_free_context(&aCtx);
+        return false;
+    }
+
+    StAVPacket aPacket;
+    for(int aFrameIter = 0; aFrameIter <= THE_CLIP_NB_FRAMES; ++aFrameIter) {
+        if(aFrameIter < THE_CLIP_NB_FRAMES) {
+            av_frame_make_writable(aFrame.Frame);
+            for(int aPlaneIter = 0; aPlaneIter < 3; ++aPlaneIter) {
+                const int aShiftX = aPlaneIter == 0 ? 0 : aDesc->log2_chroma_w;
+                const int aShiftY = aPlaneIter == 0 ? 0 : aDesc->log2_chroma_h;
+                fillPattern(aFrame.Frame->data[aPlaneIter], aFrame.Frame->linesize[aPlaneIter],
+                            size_t(aCtx->width >> aShiftX), size_t(aCtx->height >> aShiftY), 1,
+                            size_t(aFrameIter + aPlaneIter));
+            }
+            aFrame.Frame->pts = aFrameIter;
+        }
+        if(avcodec_send_frame(aCtx, aFrameIter < THE_CLIP_NB_FRAMES ? aFrame.Frame : NULL) < 0) {
+            break;
+        }
+        while(avcodec_receive_packet(aCtx, aPacket.getAVpkt()) == 0) {
+            thePackets.push_back(new StAVPacket(aPacket));
+            aPacket.free();
+        }
+    }
+    avcodec_free_context(&aCtx);
+    return !thePackets.empty();
+}
+
+void StTestBench::testVideoDecode() {
+    st::cout << stostream_text("Video decoding (") << THE_CLIP_SIZE_X << stostream_text("x") << THE_CLIP_SIZE_Y << stostream_text(")\n");
+
+    struct ClipFormat {
+        const char*   Encoder;
+        AVPixelFormat PixFmt;
+    };
+    const ClipFormat THE_FORMATS[] = {
+        { "mpeg4", stAV::PIX_FMT::YUV420P  },
+        { "mjpeg", stAV::PIX_FMT::YUVJ420P },
+        { "mjpeg", stAV::PIX_FMT::YUVJ422P },
+        { "mjpeg", stAV::PIX_FMT::YUVJ444P },
+    };
+
+    StGLDeviceCaps aCaps;
+    aCaps.maxTexDim = 16384;
+    StHandle<StStereoParams>          aParams = new StStereoParams();
+    StHandle<StGLTextureUploadParams> anUploadParams = new StGLTextureUploadParams();
+    StGLTextureData aTexData(anUploadParams);
+    for(size_t aFormatIter = 0; aFormatIter < sizeof(THE_FORMATS) / sizeof(THE_FORMATS[0]); ++aFormatIter) {
+        const ClipFormat& aFormat = THE_FORMATS[aFormatIter];
+        const StString aName = StString(aFormat.Encoder) + " " + stAV::PIX_FMT::getString(aFormat.PixFmt);
+        std::vector< StHandle<StAVPacket> > aPackets;
+        if(!encodeClip(aFormat.Encoder, aFormat.PixFmt, aPackets)) {
+            st::cout << stostream_text("  ") << aName << stostream_text(": encoder is unavailable! Skipped.\n");
+            continue;
+        }
+
+        // the first pass measures decoding only, the second one - decoding with frame preparation
+        for(int aPass = 0; aPass < 2; ++aPass) {
+            const AVCodec*  aCodec = avcodec_find_decoder_by_name(aFormat.Encoder);
+            AVCodecContext* aCtx   = aCodec != NULL ? avcodec_alloc_context3(aCodec) : NULL;
+            if(aCtx == NULL
+            || avcodec_open2(aCtx, aCodec, NULL) < 0) {
+                avcodec_free_context(&aCtx);
+                st::cout << stostream_text("  ") << aName << stostream_text(": decoder is unavailable! Skipped.\n");
+                break;
+            }
+
+            StAVFrame aFrame;
+            size_t aNbFrames = 0;
+            myTimer.restart();
+            for(size_t aPktIter = 0; aPktIter <= aPackets.size(); ++aPktIter) {
+                if(avcodec_send_packet(aCtx, aPktIter < aPackets.size() ? aPackets[aPktIter]->getAVpkt() : NULL) < 0) {
+                    break;
+                }
+                while(avcodec_receive_frame(aCtx, aFrame.Frame) == 0) {
+                    ++aNbFrames;
+                    stAV::dimYUV aDims;
+                    if(aPass == 1
+                    && stAV::isFormatYUVPlanar(aCtx, aDims)) {
+                        StImage anImage;
+                        anImage.setColorModel(StImage::ImgColor_YUV);
+                        anImage.setColorScale(aDims.isFullScale ? StImage::ImgScale_Full : StImage::ImgScale_Mpeg);
+                        anImage.changePlane(0).initWrapper(StImagePlane::ImgGray, aFrame.getPlane(0),
+                                                           size_t(aDims.widthY), size_t(aDims.heightY), aFrame.getLineSize(0));
+                        anImage.changePlane(1).initWrapper(StImagePlane::ImgGray, aFrame.getPlane(1),
+                                                           size_t(aDims.widthU), size_t(aDims.heightU), aFrame.getLineSize(1));
+                        anImage.changePlane(2).initWrapper(StImagePlane::ImgGray, aFrame.getPlane(2),
+                                                           size_t(aDims.widthV), size_t(aDims.heightV), aFrame.getLineSize(2));
+                        aTexData.updateData(aCaps, anImage, StImage(), aParams, StFormat_Mono, StCubemap_OFF, 0.0);
+                    }
+                    av_frame_unref(aFrame.Frame);
+                }
+            }
+            const double aTimeMSec = myTimer.getElapsedTimeInMilliSec();
+            avcodec_free_context(&aCtx);
+            addResult("video", aName + (aPass == 0 ? " decode" : " decode+prepare"),
+                      aTimeMSec > 0.0 ? 1000.0 * double(aNbFrames) / aTimeMSec : 0.0, "fps");
+        }
+    }
+    aTexData.reset();
+}
+
+void StTestBench::testTextureData() {
+    static const size_t THE_SIZE_X = 3840;
+    static const size_t THE_SIZE_Y = 2160;
+    static const int    THE_NB_ITERS = 20;
+    st::cout << stostream_text("Texture data update (") << THE_SIZE_X << stostream_text("x") << THE_SIZE_Y << stostream_text(")\n");
+
+    const StFormat THE_FORMATS[] = {
+        StFormat_Mono,
+        StFormat_SideBySide_LR,
+        StFormat_TopBottom_LR,
+        StFormat_Rows,
+        StFormat_Columns,
+        StFormat_Tiled4x,
+        StFormat_SeparateFrames,
+    };
+
+    StGLDeviceCaps aCaps;
+    aCaps.maxTexDim = 16384;
+    StHandle<StStereoParams>          aParams = new StStereoParams();
+    StHandle<StGLTextureUploadParams> anUploadParams = new StGLTextureUploadParams();
+    StGLTextureData aTexData(anUploadParams);
+    for(int aColorIter = 0; aColorIter < 2; ++aColorIter) {
+        StImage anImageL, anImageR;
+        if(aColorIter == 0) {
+            initImageRgb(anImageL, THE_SIZE_X, THE_SIZE_Y);
+            initImageRgb(anImageR, THE_SIZE_X, THE_SIZE_Y);
+        } else {
+            initImageYuv(anImageL, THE_SIZE_X, THE_SIZE_Y);
+            initImageYuv(anImageR, THE_SIZE_X, THE_SIZE_Y);
+        }
+
+        // images without buffer counter are always copied, while referenced ones might be just wrapped
+        for(int aRefIter = 0; aRefIter < 2; ++aRefIter) {
+            StImage aRefL, aRefR;
+            if(aRefIter == 1) {
+                StHandle<StBufferCounter> aCounter = new StBenchBufferCounter();
+                aRefL.initReference(anImageL, aCounter);
+                aRefR.initReference(anImageR, aCounter);
+            }
+            const StImage& aDataL = aRefIter == 1 ? aRefL : anImageL;
+            const StImage& aDataR = aRefIter == 1 ? aRefR : anImageR;
+            for(size_t aFormatIter = 0; aFormatIter < sizeof(THE_FORMATS) / sizeof(THE_FORMATS[0]); ++aFormatIter) {
+                const StFormat aFormat = THE_FORMATS[aFormatIter];
+                const StImage  anEmpty;
+                myTimer.restart();
+                for(int anIter = 0; anIter < THE_NB_ITERS; ++anIter) {
+                    aTexData.updateData(aCaps, aDataL, aFormat == StFormat_SeparateFrames ? aDataR : anEmpty,
+                                        aParams, aFormat, StCubemap_OFF, 0.0);
+                }
+                const double aTimeMSec = myTimer.getElapsedTimeInMilliSec();
+                addResult("textureData",
+                          StString(aColorIter == 0 ? "rgb " : "yuv420p ") + (aRefIter == 0 ? "copy " : "ref ")
+                        + st::formatToString(aFormat),
+                          aTimeMSec / double(THE_NB_ITERS), "ms");
+            }
+        }
+    }
+    aTexData.reset();
+}
+
+void StTestBench::testPcmConvert() {
+    static const size_t THE_NB_SAMPLES = 4096;
+    static const int    THE_NB_ITERS   = 2000;
+    st::cout << stostream_text("Audio PCM conversion (stereo, ") << THE_NB_SAMPLES << stostream_text(" samples per chunk)\n");
+
+    struct PcmFormat {
+        StPcmFormat Format;
+        const char* Name;
+    };
+    const PcmFormat THE_FORMATS[] = {
+        { StPcmFormat_UInt8,   "u8"  },
+        { StPcmFormat_Int16,   "s16" },
+        { StPcmFormat_Int32,   "s32" },
+        { StPcmFormat_Float32, "flt" },
+        { StPcmFormat_Float64, "dbl" },
+    };
+    const size_t aNbFormats = sizeof(THE_FORMATS) / sizeof(THE_FORMATS[0]);
+    for(size_t aSrcIter = 0; aSrcIter < aNbFormats; ++aSrcIter) {
+        for(int aPlanarIter = 0; aPlanarIter < 2; ++aPlanarIter) {
+            StPCMBuffer aBufferSrc(THE_FORMATS[aSrcIter].Format);
+            aBufferSrc.setFreq(FREQ_48000);
+            aBufferSrc.setupChannels(StChannelMap::CH20, StChannelMap::PCM, aPlanarIter == 0 ? 1 : 2);
+            aBufferSrc.resize(aBufferSrc.getSecondSize(), false);
+            const size_t aSampleBytes = aBufferSrc.getSecondSize() / (2 * FREQ_48000);
+            if(!aBufferSrc.setDataSize(THE_NB_SAMPLES * 2 * aSampleBytes)) {
+                continue;
+            }
+            for(size_t aPlaneIter = 0; aPlaneIter < aBufferSrc.getPlanesNb(); ++aPlaneIter) {
+                fillPattern(aBufferSrc.getPlane(aPlaneIter), 0, aBufferSrc.getPlaneSize(), 1, 1, aPlaneIter);
+            }
+
+            // OpenAL output is either planar float32 or interleaved int16
+            for(int anOutIter = 0; anOutIter < 2; ++anOutIter) {
+                StPCMBuffer aBufferOut(anOutIter == 0 ? StPcmFormat_Float32 : StPcmFormat_Int16);
+                aBufferOut.setFreq(FREQ_48000);
+                aBufferOut.setupChannels(StChannelMap::CH20, StChannelMap::PCM, anOutIter == 0 ? 2 : 1);
+                aBufferOut.resize(aBufferOut.getSecondSize(), false);
+
+                bool isDone = true;
+                myTimer.restart();
+                for(int anIter = 0; anIter < THE_NB_ITERS && isDone; ++anIter) {
+                    aBufferOut.setDataSize(0);
+                    isDone = aBufferOut.addData(aBufferSrc);
+                }
+                const double aTimeMSec = myTimer.getElapsedTimeInMilliSec();
+                if(!isDone) {
+                    st::cout << stostream_text("  ") << THE_FORMATS[aSrcIter].Name << stostream_text(": conversion failed!\n");
+                    continue;
+                }
+                addResult("pcm",
+                          StString(THE_FORMATS[aSrcIter].Name) + (aPlanarIter == 0 ? "" : "p")
+                        + (anOutIter == 0 ? " -> fltp" : " -> s16"),
+                          aTimeMSec > 0.0 ? double(THE_NB_SAMPLES) * double(THE_NB_ITERS) / (aTimeMSec * 1000.0) : 0.0,
+                          "Msamples/s");
+            }
+        }
+    }
+}
+
+void StTestBench::testTimeStretch() {
+    static const size_t THE_NB_SAMPLES = 4096;
+    static const int    THE_NB_ITERS   = 500;
+    st::cout << stostream_text("Audio time-stretching (stereo s16 48 kHz, ") << THE_NB_SAMPLES << stostream_text(" samples per chunk)\n");
+
+    // two tones with different pitch in each channel
+    StPCMBuffer aBufferSrc(StPcmFormat_Int16);
+    aBufferSrc.setFreq(FREQ_48000);
+    aBufferSrc.setupChannels(StChannelMap::CH20, StChannelMap::PCM, 1);
+    aBufferSrc.resize(THE_NB_SAMPLES * 2 * sizeof(int16_t), false);
+    aBufferSrc.setDataSize(THE_NB_SAMPLES * 2 * sizeof(int16_t));
+    int16_t* aData = (int16_t* )aBufferSrc.getPlane(0);
+    for(size_t aSmplIter = 0; aSmplIter < THE_NB_SAMPLES; ++aSmplIter) {
+        const double aTime = double(aSmplIter) / double(FREQ_48000);
+        aData[aSmplIter * 2 + 0] = int16_t(10000.0 * std::sin(2.0 * M_PI * 375.0 * aTime));
+        aData[aSmplIter * 2 + 1] = int16_t(10000.0 * std::sin(2.0 * M_PI * 750.0 * aTime));
+    }
+
+    const double THE_RATES[] = { 0.5, 0.75, 1.25, 1.5, 2.0, 3.0, 4.0 };
+    for(size_t aRateIter = 0; aRateIter < sizeof(THE_RATES) / sizeof(THE_RATES[0]); ++aRateIter) {
+        StPCMStretch aStretch;
+        StPCMBuffer  aBufferOut(StPcmFormat_Int16);
+        aStretch.setRate(THE_RATES[aRateIter]);
+
+        bool   isDone     = true;
+        size_t aNbSamples = 0;
+        myTimer.restart();
+        for(int anIter = 0; anIter < THE_NB_ITERS && isDone; ++anIter) {
+            isDone = aStretch.process(aBufferSrc, aBufferOut);
+            aNbSamples += aBufferOut.getDataSizeWhole() / (2 * sizeof(int16_t));
+        }
+        const double aTimeMSec = myTimer.getElapsedTimeInMilliSec();
+        if(!isDone) {
+            st::cout << stostream_text("  x") << THE_RATES[aRateIter] << stostream_text(": processing failed!\n");
+            continue;
+        }
+
+        const StString aName = StString("x") + THE_RATES[aRateIter];
+        addResult("stretch", aName + " CPU", aStretch.getCpuLoad(), "% of playback time");
+        addResult("stretch", aName + " speed",
+                  aTimeMSec > 0.0 ? double(aNbSamples) / (aTimeMSec * double(FREQ_48000)) : 0.0,
+                  "x realtime");
+    }
+}
+
+void StTestBench::testPlayList() {
+    static const size_t THE_NB_ITEMS = 100000;
+    st::cout << stostream_text("Playlist navigation (") << THE_NB_ITEMS << stostream_text(" items)\n");
+
+    StPlayList aList(1, false);
+    const StMIME anEmptyMime;
+    myTimer.restart();
+    for(size_t anItemIter = 0; anItemIter < THE_NB_ITEMS; ++anItemIter) {
+        aList.addOneFile(StString("/bench/folder/file") + anItemIter + ".jpg", anEmptyMime);
+    }
+    addResult("playlist", "add", 1000.0 * myTimer.getElapsedTimeInMilliSec() / double(THE_NB_ITEMS), "us");
+
+    aList.walkToFirst();
+    myTimer.restart();
+    for(size_t anItemIter = 1; anItemIter < THE_NB_ITEMS; ++anItemIter) {
+        aList.walkToNext();
+    }
+    addResult("playlist", "walkToNext", 1000.0 * myTimer.getElapsedTimeInMilliSec() / double(THE_NB_ITEMS), "us");
+
+    myTimer.restart();
+    for(size_t anItemIter = 1; anItemIter < THE_NB_ITEMS; ++anItemIter) {
+        aList.walkToPrev();
+    }
+    addResult("playlist", "walkToPrev", 1000.0 * myTimer.getElapsedTimeInMilliSec() / double(THE_NB_ITEMS), "us");
+
+    // pseudo-random jumps with fixed seed for repeatable numbers
+    uint32_t aSeed = 12345;
+    myTimer.restart();
+    for(size_t anItemIter = 0; anItemIter < THE_NB_ITEMS; ++anItemIter) {
+        aSeed = aSeed * 1664525u + 1013904223u;
+        aList.walkToPosition(size_t(aSeed % THE_NB_ITEMS));
+    }
+    addResult("playlist", "walkToPosition", 1000.0 * myTimer.getElapsedTimeInMilliSec() / double(THE_NB_ITEMS), "us");
+
+    StHandle<StFileNode>     aFileNode;
+    StHandle<StStereoParams> aFileParams;
+    myTimer.restart();
+    for(size_t anItemIter = 0; anItemIter < THE_NB_ITEMS; ++anItemIter) {
+        aList.getCurrentFile(aFileNode, aFileParams);
+    }
+    addResult("playlist", "getCurrentFile", 1000.0 * myTimer.getElapsedTimeInMilliSec() / double(THE_NB_ITEMS), "us");
+
+    myTimer.restart();
+    aList.clear();
+    addResult("playlist", "clear", myTimer.getElapsedTimeInMilliSec(), "ms");
+}
+
+void StTestBench::testJpegLoad() {
+    static const size_t THE_SIZE_X   = 3000;
+    static const size_t THE_SIZE_Y   = 2000;
+    static const int    THE_NB_ITERS = 10;
+    st::cout << stostream_text("JPEG loading (") << THE_SIZE_X << stostream_text("x") << THE_SIZE_Y << stostream_text(")\n");
+
+    const StString aPathJpeg = StProcess::getTempFolder() + "stTestBench.jpg";
+    const StString aPathMpo  = StProcess::getTempFolder() + "stTestBench.mpo";
+    {
+        StAVImage anImage;
+        initImageRgb(anImage, THE_SIZE_X, THE_SIZE_Y);
+        StImageFile::SaveImageParams aSaveParams;
+        aSaveParams.SaveImageType = StImageFile::ST_TYPE_JPEG;
+        if(!anImage.save(aPathJpeg, aSaveParams)) {
+            st::cout << stostream_text("  JPEG encoder is unavailable! Skipped.\n");
+            return;
+        }
+    }
+
+    // MPO is emulated by two concatenated JPEG images
+    StRawFile aJpegFile(aPathJpeg);
+    if(!aJpegFile.readFile()) {
+        st::cout << stostream_text("  file can not be read! Skipped.\n");
+        return;
+    }
+    {
+        StRawFile aMpoFile(aPathMpo);
+        aMpoFile.initBuffer(aJpegFile.getSize() * 2);
+        stMemCpy(aMpoFile.changeBuffer(), aJpegFile.getBuffer(), aJpegFile.getSize());
+        stMemCpy(aMpoFile.changeBuffer() + aJpegFile.getSize(), aJpegFile.getBuffer(), aJpegFile.getSize());
+        aMpoFile.saveFile(aPathMpo);
+    }
+    aJpegFile.freeBuffer();
+
+    StAVImage anImageL, anImageR;
+    myTimer.restart();
+    for(int anIter = 0; anIter < THE_NB_ITERS; ++anIter) {
+        anImageL.load(aPathJpeg, StImageFile::ST_TYPE_JPEG);
+        anImageL.close();
+    }
+    addResult("jpeg", "jpeg load", myTimer.getElapsedTimeInMilliSec() / double(THE_NB_ITERS), "ms");
+
+    myTimer.restart();
+    for(int anIter = 0; anIter < THE_NB_ITERS; ++anIter) {
+        StJpegParser aParser;
+        if(!aParser.readFile(aPathMpo)
+        || aParser.getImage(0).isNull()
+        || aParser.getImage(1).isNull()) {
+            st::cout << stostream_text("  MPO file can not be parsed! Skipped.\n");
+            break;
+        }
+        const StHandle<StJpegParser::Image> anImg1 = aParser.getImage(0);
+        const StHandle<StJpegParser::Image> anImg2 = aParser.getImage(1);
+        anImageL.load(aPathMpo, StImageFile::ST_TYPE_JPEG, (uint8_t* )anImg1->Data, (int )anImg1->Length);
+        anImageR.load(aPathMpo, StImageFile::ST_TYPE_JPEG, (uint8_t* )anImg2->Data, (int )anImg2->Length);
+        anImageL.close();
+        anImageR.close();
+    }
+    addResult("jpeg", "mpo load", myTimer.getElapsedTimeInMilliSec() / double(THE_NB_ITERS), "ms");
+
+    StFileNode::removeFile(aPathJpeg);
+    StFileNode::removeFile(aPathMpo);
+}
+
+void StTestBench::perform() {
+    st::cout << stostream_text("Benchmark suite\n");
+    if(!StAVImage::init()) {
+        st::cout << stostream_text("  FFmpeg is unavailable! Skipped.\n");
+        return;
+    }
+
+    testVideoDecode();
+    testTextureData();
+    testPcmConvert();
+    testTimeStretch();
+    testPlayList();
+    testJpegLoad();
+    st::cout << stostream_text("glTF import is not measured - importer is a part of StCADViewer built with OCCT.\n");
+
+    if(!myOutput.isEmpty()) {
+        if(saveResults()) {
+            st::cout << stostream_text("Results are saved into '") << myOutput << stostream_text("'\n");
+        } else {
+            st::cout << stostream_text("Error! Results can not be saved into '") << myOutput << stostream_text("'\n");
+        }
+    }
+}
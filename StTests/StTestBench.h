@@ -0,0 +1,117 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StTestBench_h_
+#define __StTestBench_h_
+
+#include "StTest.h"
+#include <StAV/StAVPacket.h>
+#include <StStrings/StString.h>
+
+#include <vector>
+
+/**
+ * Benchmark suite for software hot paths (decoding, frame preparation, audio conversion and time-stretching, playlist navigation).
+ * Input data is generated at run time (using FFmpeg encoders), so that numbers do not depend on external files.
+ * Results are printed to console and optionally stored into JSON file for trend tracking.
+ */
+class ST_LOCAL StTestBench : public StTest {
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theOutput path to JSON file with results, can be empty
+     */
+    StTestBench(const StString& theOutput);
+
+    virtual void perform() ST_ATTR_OVERRIDE;
+
+        private:
+
+    /**
+     * Video decoding and frame preparation speed per pixel format.
+     */
+    void testVideoDecode();
+
+    /**
+     * Encode synthetic clip.
+     * @return false if encoder is unavailable
+     */
+    bool encodeClip(const char* theEncoder,
+                    const int   thePixFmt,
+                    std::vector< StHandle<StAVPacket> >& thePackets);
+
+    /**
+     * StGLTextureData::updateData() speed per stereo format.
+     */
+    void testTextureData();
+
+    /**
+     * StPCMBuffer conversion speed per sample format.
+     */
+    void testPcmConvert();
+
+    /**
+     * Audio time-stretching CPU cost per playback rate.
+     */
+    void testTimeStretch();
+
+    /**
+     * StPlayList navigation speed on a long list.
+     */
+    void testPlayList();
+
+    /**
+     * JPEG and MPO files loading speed.
+     */
+    void testJpegLoad();
+
+    /**
+     * Print and store the result.
+     */
+    void addResult(const StString& theGroup,
+                   const StString& theName,
+                   const double    theValue,
+                   const StString& theUnits);
+
+    /**
+     * Store results into JSON file.
+     */
+    bool saveResults() const;
+
+        private:
+
+    /**
+     * Single measurement.
+     */
+    struct Result {
+        StString Group;
+        StString Name;
+        StString Units;
+        double   Value;
+    };
+
+        private:
+
+    std::vector<Result> myResults; //!< collected results
+    StString            myOutput;  //!< path to JSON file
+
+};
+
+#endif // __StTestBench_h_
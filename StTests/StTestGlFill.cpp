@@ -0,0 +1,277 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StTestGlFill.h"
+
+#include <StCore/StWindow.h>
+
+#include <StGL/StGLContext.h>
+#include <StGL/StGLFrameBuffer.h>
+#include <StGLCore/StGLCore20.h>
+
+#include <StStrings/stConsole.h>
+
+namespace {
+
+    static const size_t TEST_ITERATIONS   = 50;
+    static const double TEST_ITERATIONS_F = 50.0;
+
+    static const StGLVarLocation ST_VATTRIB_VERTEX(0);
+
+    static const char THE_VERT_SHADER[] =
+        "attribute vec4 vVertex;\n"
+        "varying vec2 fTexCoord;\n"
+        "void main(void) {\n"
+        "  fTexCoord = vVertex.xy * 0.5 + vec2(0.5, 0.5);\n"
+        "  gl_Position = vVertex;\n"
+        "}\n";
+
+    static const char THE_FRAG_SCENE[] =
+        "uniform sampler2D uTexture;\n"
+        "varying vec2 fTexCoord;\n"
+        "void main(void) {\n"
+        "  vec4 aColor = vec4(0.0);\n"
+        "  for(int anIter = 0; anIter < 16; ++anIter) {\n"
+        "    aColor += texture2D(uTexture, fTexCoord + vec2(float(anIter) * 0.003, 0.0));\n"
+        "  }\n"
+        "  gl_FragColor = aColor * 0.0625;\n"
+        "}\n";
+
+    static const char THE_FRAG_COPY[] =
+        "uniform sampler2D uTexture;\n"
+        "varying vec2 fTexCoord;\n"
+        "void main(void) {\n"
+        "  gl_FragColor = texture2D(uTexture, fTexCoord);\n"
+        "}\n";
+
+    static const char THE_FRAG_EVEN[] =
+        "uniform sampler2D uTexture;\n"
+        "varying vec2 fTexCoord;\n"
+        "void main(void) {\n"
+        "  if(int(mod(gl_FragCoord.y - 1023.5, 2.0)) == 1) { discard; }\n"
+        "  gl_FragColor = texture2D(uTexture, fTexCoord);\n"
+        "}\n";
+
+    static const char THE_FRAG_ODD[] =
+        "uniform sampler2D uTexture;\n"
+        "varying vec2 fTexCoord;\n"
+        "void main(void) {\n"
+        "  if(int(mod(gl_FragCoord.y - 1023.5, 2.0)) != 1) { discard; }\n"
+        "  gl_FragColor = texture2D(uTexture, fTexCoord);\n"
+        "}\n";
+
+    static bool initProgram(StGLContext&            theCtx,
+                            StGLProgram&            theProgram,
+                            const StGLVertexShader& theVertShader,
+                            const char*             theFragSrc) {
+        StGLFragmentShader aFragShader(theProgram.getTitle());
+        if(!aFragShader.init(theCtx, theFragSrc)) {
+            aFragShader.release(theCtx);
+            return false;
+        }
+        theProgram.create(theCtx)
+                  .attachShader(theCtx, theVertShader)
+                  .attachShader(theCtx, aFragShader)
+                  .bindAttribLocation(theCtx, "vVertex", ST_VATTRIB_VERTEX);
+        const bool isOk = theProgram.link(theCtx);
+        aFragShader.release(theCtx);
+        return isOk;
+    }
+
+}
+
+StTestGlFill::StTestGlFill()
+: myProgramScene("Fill Scene"),
+  myProgramCopy ("Fill Copy"),
+  myProgramEven ("Fill Even Rows"),
+  myProgramOdd  ("Fill Odd Rows"),
+  myTexture(GL_RGBA8) {
+    //
+}
+
+bool StTestGlFill::init(StGLContext& theCtx) {
+    const GLfloat QUAD_VERTICES[4 * 4] = {
+         1.0f, -1.0f, 0.0f, 1.0f,
+         1.0f,  1.0f, 0.0f, 1.0f,
+        -1.0f, -1.0f, 0.0f, 1.0f,
+        -1.0f,  1.0f, 0.0f, 1.0f
+    };
+    if(!myQuadVerts.init(theCtx, 4, 4, QUAD_VERTICES)
+    || !myTexture.initTrash(theCtx, 256, 256)) {
+        return false;
+    }
+
+    StGLVertexShader aVertShader("Fill");
+    if(!aVertShader.init(theCtx, THE_VERT_SHADER)) {
+        aVertShader.release(theCtx);
+        return false;
+    }
+    const bool isOk = initProgram(theCtx, myProgramScene, aVertShader, THE_FRAG_SCENE)
+                   && initProgram(theCtx, myProgramCopy,  aVertShader, THE_FRAG_COPY)
+                   && initProgram(theCtx, myProgramEven,  aVertShader, THE_FRAG_EVEN)
+                   && initProgram(theCtx, myProgramOdd,   aVertShader, THE_FRAG_ODD);
+    aVertShader.release(theCtx);
+    return isOk;
+}
+
+void StTestGlFill::release(StGLContext& theCtx) {
+    myProgramScene.release(theCtx);
+    myProgramCopy .release(theCtx);
+    myProgramEven .release(theCtx);
+    myProgramOdd  .release(theCtx);
+    myTexture     .release(theCtx);
+    myQuadVerts   .release(theCtx);
+}
+
+void StTestGlFill::drawQuad(StGLContext& theCtx,
+                            StGLProgram& theProgram) {
+    theProgram.use(theCtx);
+    myQuadVerts.bindVertexAttrib(theCtx, ST_VATTRIB_VERTEX);
+    theCtx.core20fwd->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    myQuadVerts.unBindVertexAttrib(theCtx, ST_VATTRIB_VERTEX);
+    theProgram.unuse(theCtx);
+}
+
+void StTestGlFill::drawScene(StGLContext& theCtx) {
+    // applications clear color and depth buffers (but not stencil) for each view
+    theCtx.core20fwd->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    myTexture.bind(theCtx);
+    drawQuad(theCtx, myProgramScene);
+    drawQuad(theCtx, myProgramScene); // emulate some overdraw
+    myTexture.unbind(theCtx);
+}
+
+void StTestGlFill::drawMask(StGLContext& theCtx,
+                            StGLProgram& theProgram) {
+    theCtx.core20fwd->glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    theCtx.core20fwd->glClearStencil(0);
+    theCtx.core20fwd->glClear(GL_STENCIL_BUFFER_BIT);
+    theCtx.core20fwd->glEnable(GL_STENCIL_TEST);
+    theCtx.core20fwd->glStencilFunc(GL_ALWAYS, 1, 0xFF);
+    theCtx.core20fwd->glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+    drawQuad(theCtx, theProgram);
+    theCtx.core20fwd->glStencilFunc(GL_EQUAL, 1, 0xFF);
+    theCtx.core20fwd->glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    theCtx.core20fwd->glDisable(GL_STENCIL_TEST);
+    theCtx.core20fwd->glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+void StTestGlFill::testMode(StGLContext&     theCtx,
+                            StGLFrameBuffer& theScreen,
+                            StGLFrameBuffer& theView,
+                            const Mode       theMode) {
+    switch(theMode) {
+        case Mode_TwoFbo:  st::cout << stostream_text("Two offscreen views + composition ");   break;
+        case Mode_OneFbo:  st::cout << stostream_text("Direct view + offscreen view ");        break;
+        case Mode_Stencil: st::cout << stostream_text("Direct view + offscreen view (stencil) "); break;
+    }
+    st::cout << theScreen.getVPSizeX() << stostream_text(" x ") << theScreen.getVPSizeY() << stostream_text("\n");
+
+    theScreen.setupViewPort(theCtx);
+    if(theMode == Mode_Stencil) {
+        // mask within offscreen view is preserved between frames
+        theView.bindBuffer(theCtx);
+        drawMask(theCtx, myProgramOdd);
+    }
+
+    theCtx.core20fwd->glFinish();
+    myTimer.restart();
+    for(size_t anIter = 0; anIter < TEST_ITERATIONS; ++anIter) {
+        if(theMode == Mode_TwoFbo) {
+            for(int anEye = 0; anEye < 2; ++anEye) {
+                theView.bindBuffer(theCtx);
+                drawScene(theCtx);
+                theScreen.bindBuffer(theCtx);
+                theView.bindTexture(theCtx);
+                drawQuad(theCtx, anEye == 0 ? myProgramCopy : myProgramOdd);
+                theView.unbindTexture(theCtx);
+            }
+            continue;
+        }
+
+        // left view directly into the "window"
+        theScreen.bindBuffer(theCtx);
+        if(theMode == Mode_Stencil) {
+            drawMask(theCtx, myProgramEven);
+            theCtx.core20fwd->glEnable(GL_STENCIL_TEST);
+        }
+        drawScene(theCtx);
+
+        // right view offscreen
+        theView.bindBuffer(theCtx);
+        drawScene(theCtx);
+        theCtx.core20fwd->glDisable(GL_STENCIL_TEST);
+
+        theScreen.bindBuffer(theCtx);
+        theView.bindTexture(theCtx);
+        drawQuad(theCtx, myProgramOdd);
+        theView.unbindTexture(theCtx);
+    }
+    theCtx.core20fwd->glFinish();
+    theScreen.unbindBuffer(theCtx);
+
+    const double aTimeAllSec = myTimer.getElapsedTimeInSec();
+    const double aTimeSec    = aTimeAllSec / TEST_ITERATIONS_F;
+    st::cout << stostream_text("  frame time:\t") << (1000.0 * aTimeSec) << stostream_text(" msec\n");
+    st::cout << stostream_text("  frame FPS: \t") << (TEST_ITERATIONS_F / aTimeAllSec) << stostream_text("\n");
+}
+
+void StTestGlFill::perform() {
+    // create the window
+    StHandle<StWindow> aWin = new StWindow();
+    aWin->setPlacement(StRectI_t(256, 768, 256, 768));
+    aWin->setTitle("sView - Tests");
+    aWin->create();
+
+    // perform tests
+    aWin->stglMakeCurrent();
+    StGLContext aCtx(true);
+    if(!init(aCtx)) {
+        st::cout << stostream_text("Fail to initialize GLSL programs\n");
+        release(aCtx);
+        aWin.nullify();
+        return;
+    }
+
+    // 4K passive 3D display
+    const GLsizei aFrameSizeX = 3840;
+    const GLsizei aFrameSizeY = 2160;
+    StGLFrameBuffer aScreen, aView;
+    if(!aScreen.initLazy(aCtx, GL_RGBA8, aFrameSizeX, aFrameSizeY, true)
+    || !aView  .initLazy(aCtx, GL_RGBA8, aFrameSizeX, aFrameSizeY, true)) {
+        st::cout << stostream_text("Fail to create FBO ") << aFrameSizeX << stostream_text(" x ") << aFrameSizeY << stostream_text("\n");
+    } else {
+        aCtx.core20fwd->glDisable(GL_DEPTH_TEST);
+        aCtx.core20fwd->glDisable(GL_BLEND);
+        testMode(aCtx, aScreen, aView, Mode_TwoFbo);
+        testMode(aCtx, aScreen, aView, Mode_OneFbo);
+        if(aScreen.hasStencilBuffer()
+        && aView  .hasStencilBuffer()) {
+            testMode(aCtx, aScreen, aView, Mode_Stencil);
+        } else {
+            st::cout << stostream_text("Stencil buffer is unavailable (OpenGL 3.0+ is required)\n");
+        }
+    }
+
+    aScreen.release(aCtx);
+    aView  .release(aCtx);
+    release(aCtx);
+
+    // close the window
+    aWin.nullify();
+}
@@ -0,0 +1,80 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StTestGlFill_h_
+#define __StTestGlFill_h_
+
+#include "StTest.h"
+
+#include <StGL/StGLProgram.h>
+#include <StGL/StGLTexture.h>
+#include <StGL/StGLVertexBuffer.h>
+
+class StGLContext;
+class StGLFrameBuffer;
+
+/**
+ * Fill-rate test of interlaced output composition paths:
+ * two offscreen views + composition, one direct view + one offscreen view,
+ * and the same with views restricted to their rows by stencil buffer.
+ */
+class ST_LOCAL StTestGlFill : public StTest {
+
+        public:
+
+    StTestGlFill();
+
+    virtual void perform() ST_ATTR_OVERRIDE;
+
+        private:
+
+    enum Mode {
+        Mode_TwoFbo,     //!< both views rendered offscreen and composed (smoothing path)
+        Mode_OneFbo,     //!< left view rendered directly, right view offscreen with discard composition
+        Mode_Stencil,    //!< as Mode_OneFbo but both views rasterize only their rows
+    };
+
+    bool init(StGLContext& theCtx);
+
+    void release(StGLContext& theCtx);
+
+    void testMode(StGLContext&     theCtx,
+                  StGLFrameBuffer& theScreen,
+                  StGLFrameBuffer& theView,
+                  const Mode       theMode);
+
+    void drawQuad(StGLContext& theCtx,
+                  StGLProgram& theProgram);
+
+    void drawScene(StGLContext& theCtx);
+
+    void drawMask(StGLContext& theCtx,
+                  StGLProgram& theProgram);
+
+        private:
+
+    StGLProgram      myProgramScene; //!< synthetic "heavy" view shading
+    StGLProgram      myProgramCopy;  //!< composition without discard
+    StGLProgram      myProgramEven;  //!< composition of even rows
+    StGLProgram      myProgramOdd;   //!< composition of odd  rows
+    StGLTexture      myTexture;      //!< texture sampled by scene program
+    StGLVertexBuffer myQuadVerts;
+
+};
+
+#endif // __StTestGlFill_h_
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2012-2015 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2012-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StTests program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -26,7 +26,10 @@
 #include <StThreads/StProcess.h>
 
 #include "StTestMutex.h"
+#include "StTestArrayList.h"
+#include "StTestBench.h"
 #include "StTestGlBand.h"
+#include "StTestGlFill.h"
 #include "StTestEmbed.h"
 #include "StTestImageLib.h"
 
@@ -118,9 +121,12 @@ namespace {
 
         StArrayList<StString> anArgs = StProcess::getArguments();
         const StString ST_TEST_MUTICES = "mutex";
+        const StString ST_TEST_ARRAYS  = "arrays";
         const StString ST_TEST_GLBAND  = "glband";
+        const StString ST_TEST_GLFILL  = "glfill";
         const StString ST_TEST_EMBED   = "embed";
         const StString ST_TEST_IMAGE   = "image";
+        const StString ST_TEST_BENCH   = "bench";
         const StString ST_TEST_ALL     = "all";
         size_t aFound = 0;
         for(size_t anArgId = 0; anArgId < anArgs.size(); ++anArgId) {
@@ -130,11 +136,21 @@ namespace {
                 StTestMutex aMutices;
                 aMutices.perform();
                 ++aFound;
+            } else if(aParam == ST_TEST_ARRAYS) {
+                // array list filling speed test
+                StTestArrayList anArrays;
+                anArrays.perform();
+                ++aFound;
             } else if(aParam == ST_TEST_GLBAND) {
                 // gl <-> cpu trasfer speed test
                 StTestGlBand aGlBand;
                 aGlBand.perform();
                 ++aFound;
+            } else if(aParam == ST_TEST_GLFILL) {
+                // interlaced output fill-rate test
+                StTestGlFill aGlFill;
+                aGlFill.perform();
+                ++aFound;
             } else if(aParam == ST_TEST_EMBED) {
                 // StWindow embed to native window
                 StTestEmbed anEmbed;
@@ -150,11 +166,26 @@ namespace {
                 StTestImageLib anImage(anArgs[anArgId]);
                 anImage.perform();
                 ++aFound;
+            } else if(aParam == ST_TEST_BENCH) {
+                // software hot paths benchmark, optionally followed by JSON file for results
+                StString anOutput;
+                if(anArgId + 1 < anArgs.size()
+                && anArgs[anArgId + 1].isEndsWithIgnoreCase(stCString(".json"))) {
+                    anOutput = anArgs[++anArgId];
+                }
+
+                StTestBench aBench(anOutput);
+                aBench.perform();
+                ++aFound;
             } else if(aParam == ST_TEST_ALL) {
                 // mutex speed test
                 StTestMutex aMutices;
                 aMutices.perform();
 
+                // array list filling speed test
+                StTestArrayList anArrays;
+                anArrays.perform();
+
                 // gl <-> cpu trasfer speed test
                 StTestGlBand aGlBand;
                 aGlBand.perform();
@@ -173,9 +204,12 @@ namespace {
             st::cout << stostream_text("No test selected. Options:\n")
                      << stostream_text("  all    - execute all available tests\n")
                      << stostream_text("  mutex  - mutex speed test\n")
+                     << stostream_text("  arrays - array list filling speed test\n")
                      << stostream_text("  glband - gl <-> cpu trasfer speed test\n")
+                     << stostream_text("  glfill - interlaced output fill-rate test\n")
                      << stostream_text("  embed  - test window embedding\n")
-                     << stostream_text("  image fileName - test image libraries\n");
+                     << stostream_text("  image fileName - test image libraries\n")
+                     << stostream_text("  bench [results.json] - benchmark decoding and frame preparation paths\n");
         }
     }
 
@@ -18,8 +18,9 @@ class StAVIOContext {
 
     /**
      * Main constructor.
+     * @param theBufferSize size of AVIO buffer, which defines the size of read requests
      */
-    ST_CPPEXPORT StAVIOContext();
+    ST_CPPEXPORT StAVIOContext(const int theBufferSize = 32768);
 
     /**
      * Destructor.
@@ -8,6 +8,7 @@
 #define __StAVIOFileContext_h_
 
 #include <StAV/StAVIOContext.h>
+#include <StFile/StReadAheadFile.h>
 
 /**
  * Custom AVIO context for the file.
@@ -18,8 +19,9 @@ class StAVIOFileContext : public StAVIOContext {
 
     /**
      * Empty constructor.
+     * @param theBufferSize size of AVIO buffer
      */
-    ST_CPPEXPORT StAVIOFileContext();
+    ST_CPPEXPORT StAVIOFileContext(const int theBufferSize = 32768);
 
     /**
      * Destructor.
@@ -37,6 +39,21 @@ class StAVIOFileContext : public StAVIOContext {
      */
     ST_CPPEXPORT bool openFromDescriptor(int theFD, const char* theMode);
 
+    /**
+     * Open the file for reading with large blocks loaded in advance by dedicated thread.
+     * @param theFilePath file path to open
+     * @param theFD       when specified, already opened file descriptor will be used
+     * @param theToMap    try mapping local file into memory
+     */
+    ST_CPPEXPORT bool openReadAhead(const StCString& theFilePath,
+                                    const int        theFD    = -1,
+                                    const bool       theToMap = false);
+
+    /**
+     * Return read-ahead reader or NULL if file was opened without read-ahead.
+     */
+    ST_LOCAL const StHandle<StReadAheadFile>& getReadAhead() const { return myReadAhead; }
+
     /**
      * Read from the file.
      */
@@ -57,7 +74,8 @@ class StAVIOFileContext : public StAVIOContext {
 
         protected:
 
-    FILE* myFile;
+    StHandle<StReadAheadFile> myReadAhead; //!< read-ahead reader
+    FILE*                     myFile;      //!< file handle for synchronous I/O
 
 };
 
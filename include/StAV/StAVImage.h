@@ -69,6 +69,17 @@ class StAVImage : public StImageFile {
      */
     ST_CPPEXPORT virtual void close() ST_ATTR_OVERRIDE;
 
+    /**
+     * Return decoding resolution reduction as power of 2 (0 by default).
+     */
+    ST_LOCAL int getLowResolution() const { return myLowRes; }
+
+    /**
+     * Set decoding resolution reduction as power of 2 (1 for 1/2, 2 for 1/4, 3 for 1/8).
+     * Only a few decoders (JPEG) support this option, which is useful for quick previews.
+     */
+    ST_LOCAL void setLowResolution(const int theLowRes) { myLowRes = theLowRes; }
+
     /**
      * Decode image from specified file or memory pointer.
      */
@@ -99,6 +110,7 @@ class StAVImage : public StImageFile {
     AVCodecContext*  myCodecCtx;  //!< codec context
     const AVCodec*   myCodec;     //!< codec
     StAVFrame        myFrame;
+    int              myLowRes;    //!< decoding resolution reduction
 
 };
 
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2015-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2015-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * This code is licensed under MIT license (see docs/license-mit.txt for details).
  */
@@ -10,6 +10,10 @@
 #include <StGLStereo/StFormatEnum.h>
 #include <StSlots/StSignal.h>
 #include <StTemplates/StArrayList.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThread.h>
+
+#include <vector>
 
 struct AVFormatContext;
 struct AVCodecContext;
@@ -19,9 +23,31 @@ struct AVStream;
 
 /**
  * This class implements video re-muxing operation using libav* libraries.
+ * Packets from input files are merged in DTS order using small per-file lookahead,
+ * so that memory usage remains bounded regardless of interleaving within input files.
  */
 class StAVVideoMuxer {
 
+        public:
+
+    /**
+     * Re-muxing progress.
+     */
+    struct Progress {
+        double   Ratio;       //!< processed fraction of the longest input within 0..1 range
+        double   MediaTime;   //!< processed media duration in seconds
+        double   ElapsedTime; //!< elapsed wall time in seconds
+        uint64_t NbBytes;     //!< number of written bytes (packets payload)
+        size_t   NbPackets;   //!< number of written packets
+
+        Progress() : Ratio(0.0), MediaTime(0.0), ElapsedTime(0.0), NbBytes(0), NbPackets(0) {}
+
+        /**
+         * Return re-muxing speed relative to playback speed.
+         */
+        double getSpeed() const { return ElapsedTime > 0.0 ? MediaTime / ElapsedTime : 0.0; }
+    };
+
         protected:
 
     struct StRemuxContext {
@@ -59,6 +85,16 @@ class StAVVideoMuxer {
      */
     ST_LOCAL void setStereoFormat(const StFormat theStereoFormat) { myStereoFormat = theStereoFormat; }
 
+    /**
+     * Return the number of packets read ahead from each input file for DTS ordering.
+     */
+    ST_LOCAL size_t getLookahead() const { return myLookahead; }
+
+    /**
+     * Set the number of packets read ahead from each input file for DTS ordering (16 by default).
+     */
+    ST_LOCAL void setLookahead(const size_t theNbPackets) { myLookahead = theNbPackets > 0 ? theNbPackets : 1; }
+
     /**
      * Add input file.
      */
@@ -80,6 +116,12 @@ class StAVVideoMuxer {
          * @param theUserData (const StString& ) - error description.
          */
         StSignal<void (const StCString& )> onError;
+
+        /**
+         * Emit callback Slot on re-muxing progress (throttled).
+         * @param theProgress (const Progress& ) - current progress.
+         */
+        StSignal<void (const Progress& )> onProgress;
     } signals;
 
         protected:
@@ -94,6 +136,104 @@ class StAVVideoMuxer {
 
     StArrayList<AVFormatContext*> myCtxListSrc;
     StFormat                      myStereoFormat;
+    size_t                        myLookahead;
+
+};
+
+/**
+ * Batch re-muxing of left/right video pairs into multi-track MKV files using several worker threads.
+ * Each job is performed by its own StAVVideoMuxer instance.
+ */
+class StAVVideoMuxerBatch {
+
+        public:
+
+    /**
+     * Re-muxing job.
+     */
+    struct Job {
+        StString Left;   //!< path to the left view file
+        StString Right;  //!< path to the right view file (optional)
+        StString Output; //!< path to the output file
+    };
+
+        public:
+
+    /**
+     * Empty constructor.
+     */
+    ST_CPPEXPORT StAVVideoMuxerBatch();
+
+    /**
+     * Destructor.
+     */
+    ST_CPPEXPORT ~StAVVideoMuxerBatch();
+
+    /**
+     * Return the list of jobs.
+     */
+    ST_LOCAL const std::vector<Job>& getJobs() const { return myJobs; }
+
+    /**
+     * Append the job.
+     * Output file name is generated from left file name when empty.
+     */
+    ST_CPPEXPORT void addJob(const Job& theJob);
+
+    /**
+     * Read jobs from the text file having one job per line in format "left|right|output",
+     * where right and output paths are optional; empty lines and lines starting with '#' are ignored.
+     */
+    ST_CPPEXPORT bool loadList(const StString& theListFile);
+
+    /**
+     * Perform all jobs.
+     * @param theNbWorkers number of worker threads, 0 means number of logical processors
+     * @return number of successfully performed jobs
+     */
+    ST_CPPEXPORT size_t perform(const int theNbWorkers);
+
+    /**
+     * Emit message (thread-safe).
+     */
+    ST_CPPEXPORT void emitMessage(const StString& theMessage);
+
+        public: //! @name signals
+
+    /**
+     * All callback handlers should be thread-safe.
+     */
+    struct {
+        /**
+         * Emit callback Slot on job progress, finish or error.
+         * @param theMessage (const StCString& ) - message text.
+         */
+        StSignal<void (const StCString& )> onMessage;
+    } signals;
+
+        private:
+
+    /**
+     * Worker thread function.
+     */
+    static SV_THREAD_FUNCTION workerThread(void* theBatch);
+
+    /**
+     * Fetch and perform jobs until the list is exhausted.
+     */
+    ST_LOCAL void workerLoop();
+
+    /**
+     * Perform single job.
+     */
+    ST_LOCAL bool performJob(const size_t theJobIndex);
+
+        private:
+
+    std::vector<Job> myJobs;    //!< jobs list
+    StMutex          myMutex;   //!< mutex for fetching next job and emitting messages
+    size_t           myNextJob; //!< index of the next job to perform
+    size_t           myNbDone;  //!< number of successfully performed jobs
 
 };
 
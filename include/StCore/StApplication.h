@@ -16,6 +16,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 class StEventsBuffer;
 class StSettings;
@@ -186,11 +187,43 @@ class StApplication {
      */
     ST_CPPEXPORT virtual bool resetDevice();
 
+    /**
+     * Renderer factory function.
+     */
+    typedef StWindow* (*RendererFactory_t)(const StHandle<StResourceManager>& theResMgr,
+                                           const StNativeWin_t                theParentWin);
+
+    /**
+     * Default renderer factory.
+     */
+    template<typename Renderer_t>
+    static StWindow* createRenderer(const StHandle<StResourceManager>& theResMgr,
+                                    const StNativeWin_t                theParentWin) {
+        return new Renderer_t(theResMgr, theParentWin);
+    }
+
     /**
      * Register renderer.
      */
     ST_CPPEXPORT void addRenderer(const StHandle<StWindow>& theRenderer);
 
+    /**
+     * Register renderer to be created on demand.
+     * The list of devices is taken from the cache saved by previous launch,
+     * so that only the active renderer is actually initialized.
+     * The renderer is created immediately when cache is missing or outdated
+     * (new application version, another language or displays configuration).
+     * @param theRendererId renderer identifier, should match StWindow::getRendererId()
+     * @param theFactory    renderer factory
+     */
+    ST_CPPEXPORT void addRenderer(const StString&         theRendererId,
+                                  const RendererFactory_t theFactory);
+
+    /**
+     * Setup window attributes for all registered renderers, including those not yet created.
+     */
+    ST_CPPEXPORT void setRenderersAttributes(const StWinAttr* theAttributes);
+
     /**
      * Modify actions.
      */
@@ -333,9 +366,71 @@ class StApplication {
     ST_LOCAL void stApplicationInit(const StHandle<StOpenInfo>& theOpenInfo);
     ST_LOCAL void doDrawProxy(unsigned int theView);
 
+    /**
+     * Return renderer with specified index, creating it if needed.
+     */
+    ST_LOCAL const StHandle<StWindow>& getRenderer(const size_t theIndex);
+
+    /**
+     * Setup common renderer properties.
+     */
+    ST_LOCAL void setupRenderer(const StHandle<StWindow>& theRenderer);
+
+    /**
+     * Append devices of created renderer, replacing cached entries and removing outdated ones.
+     */
+    ST_LOCAL void registerDevices(const StHandle<StWindow>& theRenderer);
+
+    /**
+     * Select renderer of the device with highest priority as main window.
+     */
+    ST_LOCAL void selectBestRenderer();
+
+    /**
+     * Return the key identifying validity of cached devices lists (application version and language).
+     */
+    ST_LOCAL const StString& getDevicesCacheKey();
+
+    /**
+     * Return the key identifying displays configuration, as detected by the renderer.
+     */
+    ST_LOCAL static StString getMonitorsCacheKey(const StHandle<StWindow>& theRenderer);
+
+    /**
+     * Create not yet created renderers which devices have been cached for another displays configuration.
+     * @return true if cache was outdated
+     */
+    ST_LOCAL bool validateDevicesCache();
+
+    /**
+     * Load cached devices of the renderer.
+     * @param theRendererId  renderer identifier
+     * @param theMonitorsKey displays configuration of cached devices
+     * @return false if cache is missing or outdated
+     */
+    ST_LOCAL bool loadDevicesCache(const StString& theRendererId,
+                                   StString&       theMonitorsKey);
+
+    /**
+     * Save devices of created renderer into cache.
+     */
+    ST_LOCAL void saveDevicesCache(const StHandle<StWindow>& theRenderer);
+
+    /**
+     * Write startup trace after the first frame, when requested.
+     */
+    ST_LOCAL void finishStartupTrace();
+
         protected: //! @name protected fields
 
-    StArrayList< StHandle<StWindow> > myRenderers; //!< list of registered renderers
+    StArrayList< StHandle<StWindow> > myRenderers; //!< list of registered renderers, NULL for not yet created ones
+    StArrayList<StString>             myRendererIds;       //!< identifiers of registered renderers
+    std::vector<RendererFactory_t>    myRendererFactories; //!< factories of registered renderers
+    std::vector<StString>             myRendererMonitors;  //!< displays configuration of cached devices of registered renderers
+    std::vector<StWinAttr>            myRendererAttribs;   //!< attributes to be applied to created renderers
+    StString                          myDevicesCacheKey;   //!< key identifying validity of cached devices
+    StString                          myStartupTraceFile;  //!< file to write startup trace
+    bool                              myToTraceStartup;    //!< flag to write startup trace after the first frame
     StHandle<StResourceManager>       myResMgr;    //!< resources manager
     StHandle<StTranslations>          myLangMap;   //!< translated strings map
     StHandle<StMsgQueue>  myMsgQueue;              //!< messages queue
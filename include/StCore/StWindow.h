@@ -1,6 +1,6 @@
 /**
  * StCore, window system independent C++ toolkit for writing OpenGL applications.
- * Copyright © 2007-2017 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2007-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * This code is licensed under MIT license (see docs/license-mit.txt for details).
  */
@@ -49,6 +49,9 @@ struct StOutDevice {
     StString Name;     //!< device   name
     StString Desc;     //!< device   description
     int      Priority; //!< device   priority (ST_DEVICE_SUPPORT_ enumeration)
+    bool     IsProbed; //!< priority depends on runtime probe (connected HMD, driver capabilities) and should not be cached
+
+    StOutDevice() : Priority(ST_DEVICE_SUPPORT_NONE), IsProbed(false) {}
 
 };
 typedef StArrayList< StHandle<StOutDevice> > StOutDevicesList;
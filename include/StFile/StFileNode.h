@@ -213,6 +213,24 @@ class StFileNode : public StNode {
      */
     ST_CPPEXPORT static bool isFileExists(const StCString& thePath);
 
+    /**
+     * Retrieve file size and modification time.
+     * @param thePath      file path
+     * @param theSize      file size in bytes
+     * @param theModifTime modification time in seconds since epoch
+     * @return true if file exists
+     */
+    ST_CPPEXPORT static bool getFileInfo(const StCString& thePath,
+                                         int64_t&         theSize,
+                                         int64_t&         theModifTime);
+
+    /**
+     * Set file modification time to the current time.
+     * @param thePath file path
+     * @return true on success
+     */
+    ST_CPPEXPORT static bool touchFile(const StCString& thePath);
+
     /**
      * @param thePath file path
      * @return true if file/folder has read-only flag
@@ -21,6 +21,20 @@ class StFolder : public StFileNode {
      */
     ST_CPPEXPORT static bool createFolder(const StCString& thePath);
 
+    /**
+     * Remove the oldest files with specified extension from the (cache) folder to fit the limits.
+     * Files are ordered by modification time (the oldest are removed first).
+     * @param thePath      folder path
+     * @param theExtension extension of files to consider
+     * @param theSizeMax   maximum summary size of files in bytes, 0 means no limit
+     * @param theAgeMax    maximum age of files in seconds, 0 means no limit
+     * @return number of removed files
+     */
+    ST_CPPEXPORT static size_t trimFiles(const StCString& thePath,
+                                         const StString&  theExtension,
+                                         const int64_t    theSizeMax,
+                                         const int64_t    theAgeMax);
+
         public:
 
     /**
@@ -130,6 +130,23 @@ class StRawFile : public StFileNode {
                                        const int        theOpenedFd = -1,
                                        const size_t     theReadMax  = 0);
 
+    /**
+     * Read the range of already opened file.
+     * @param theOffset offset from the file beginning
+     * @param theBuffer destination buffer
+     * @param theBytes  number of bytes to read
+     * @return number of bytes actually read
+     */
+    ST_CPPEXPORT size_t readRange(const int64_t theOffset,
+                                  stUByte_t*    theBuffer,
+                                  const size_t  theBytes);
+
+    /**
+     * Return the size of already opened file.
+     * @return file size in bytes or -1 if size is unknown (e.g. for live streams)
+     */
+    ST_CPPEXPORT int64_t getFileSize();
+
     /**
      * Write the buffer into the file.
      * @param theFilePath the file path
@@ -0,0 +1,190 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#ifndef __StReadAheadFile_h_
+#define __StReadAheadFile_h_
+
+#include <StFile/StRawFile.h>
+#include <StThreads/StCondition.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThread.h>
+
+#include <deque>
+#include <vector>
+
+/**
+ * Sequential reader loading large aligned blocks of the file in advance.
+ * Blocks are read by a dedicated thread using StRawFile into the ring of buffers,
+ * so that consumer (e.g. demuxer thread) is not blocked by disk / network latency.
+ * Seeking outside of already loaded window invalidates read-ahead.
+ * Local files might be memory-mapped instead, in this case no thread is created.
+ */
+class StReadAheadFile {
+
+        public:
+
+    /**
+     * I/O statistics.
+     */
+    struct Counters {
+        int64_t BytesRead;   //!< number of bytes read from the file
+        int64_t BytesServed; //!< number of bytes returned to consumer
+        int64_t NbHits;      //!< number of read requests served from already loaded data
+        int64_t NbMisses;    //!< number of read requests waiting for data
+        double  StallTime;   //!< overall consumer waiting time in seconds
+
+        Counters() : BytesRead(0), BytesServed(0), NbHits(0), NbMisses(0), StallTime(0.0) {}
+
+        /**
+         * Return the ratio of read requests served without waiting.
+         */
+        double getHitRate() const {
+            const int64_t aNbTotal = NbHits + NbMisses;
+            return aNbTotal > 0 ? double(NbHits) / double(aNbTotal) : 0.0;
+        }
+    };
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theBlockSize size of the single block to read
+     */
+    ST_CPPEXPORT StReadAheadFile(const size_t theBlockSize = 1024 * 1024);
+
+    /**
+     * Destructor.
+     */
+    ST_CPPEXPORT ~StReadAheadFile();
+
+    /**
+     * Open the file for reading.
+     * @param theFilePath file path to open
+     * @param theOpenedFd when specified, already opened file descriptor will be used; passed descriptor will be automatically closed
+     * @param theToMap    try mapping local file into memory instead of reading it in blocks
+     * @return true if file has been opened
+     */
+    ST_CPPEXPORT bool open(const StCString& theFilePath,
+                           const int        theOpenedFd = -1,
+                           const bool       theToMap    = false);
+
+    /**
+     * Close the file and stop reading thread.
+     */
+    ST_CPPEXPORT void close();
+
+    /**
+     * Returns true if file is opened.
+     */
+    ST_LOCAL bool isOpen() const {
+        return myMappedData != NULL
+           || !myThread.isNull();
+    }
+
+    /**
+     * Returns true if file has been memory-mapped.
+     */
+    ST_LOCAL bool isMapped() const { return myMappedData != NULL; }
+
+    /**
+     * Return file size in bytes or -1 if it is unknown.
+     */
+    ST_LOCAL int64_t getSize() const { return mySize; }
+
+    /**
+     * Return current reading position.
+     */
+    ST_LOCAL int64_t getPosition() const { return myPosition; }
+
+    /**
+     * Set the amount of data to read in advance (rounded to the number of blocks, at least two).
+     */
+    ST_CPPEXPORT void setReadAhead(const size_t theBytes);
+
+    /**
+     * Read the data at current position.
+     * @return number of bytes read, 0 at end of file or -1 on error
+     */
+    ST_CPPEXPORT int read(uint8_t* theBuffer,
+                          const int theBytes);
+
+    /**
+     * Change current position.
+     * Data is not invalidated until reading outside of already loaded window.
+     * @param theOffset offset
+     * @param theWhence SEEK_SET, SEEK_CUR or SEEK_END
+     * @return new position or -1 on error
+     */
+    ST_CPPEXPORT int64_t seek(const int64_t theOffset,
+                              const int     theWhence);
+
+    /**
+     * Return I/O statistics.
+     */
+    ST_CPPEXPORT Counters getCounters() const;
+
+        private:
+
+    /**
+     * Loaded block of the file.
+     */
+    struct Block {
+        uint8_t* Data;   //!< block data (aligned)
+        int64_t  Offset; //!< offset of the block within the file
+        size_t   Size;   //!< number of loaded bytes
+    };
+
+        private:
+
+    /**
+     * Try memory-mapping the file.
+     */
+    ST_LOCAL bool mapFile(const StCString& theFilePath);
+
+    /**
+     * Release memory-mapped file.
+     */
+    ST_LOCAL void unmapFile();
+
+    /**
+     * Drop all loaded blocks and restart reading from specified position (should be called under lock).
+     */
+    ST_LOCAL void invalidate(const int64_t thePosition);
+
+    /**
+     * Reading thread loop.
+     */
+    ST_LOCAL void readerLoop();
+
+    /**
+     * Reading thread callback.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION readerThread(void* theFile);
+
+        private:
+
+    StRawFile           myFile;         //!< file handle used by reading thread
+    StHandle<StThread>  myThread;       //!< reading thread
+    mutable StMutex     myMutex;        //!< lock for blocks queue and counters
+    StCondition         myRequestEvent; //!< event to wake up reading thread
+    StCondition         myDataEvent;    //!< event signaling new loaded block
+    std::deque<Block>   myBlocks;       //!< contiguous sequence of loaded blocks
+    std::vector<Block>  myFreeBlocks;   //!< allocated but unused blocks
+    Counters            myCounters;     //!< I/O statistics
+    const uint8_t*      myMappedData;   //!< memory-mapped file content
+    int64_t             mySize;         //!< file size or -1 if unknown
+    int64_t             myPosition;     //!< consumer position
+    int64_t             myNextOffset;   //!< offset of the next block to be loaded
+    int64_t             myEofOffset;    //!< end of file position detected by reading thread, -1 if not yet reached
+    bool                myIsFailed;     //!< flag indicating that reading has failed at myEofOffset position
+    size_t              myBlockSize;    //!< size of the single block
+    size_t              myNbBlocksMax;  //!< maximum number of blocks to read in advance
+    int                 myGeneration;   //!< counter incremented on invalidation to discard obsolete blocks
+    volatile bool       myToQuit;       //!< flag to stop reading thread
+
+};
+
+#endif // __StReadAheadFile_h_
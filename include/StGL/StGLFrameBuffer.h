@@ -90,6 +90,13 @@ class StGLFrameBuffer : public StGLResource {
         return myTextureColor->getSizeY();
     }
 
+    /**
+     * @return TRUE if depth buffer has stencil bits attached.
+     */
+    inline bool hasStencilBuffer() const {
+        return myHasStencil;
+    }
+
     /**
      * FBO viewport width.
      */
@@ -210,6 +217,7 @@ class StGLFrameBuffer : public StGLResource {
     GLuint  myGLDepthRBId; //!< RenderBuffer object for depth ID
     GLsizei myViewPortX;   //!< FBO viewport width  <= texture width
     GLsizei myViewPortY;   //!< FBO viewport height <= texture height
+    bool    myHasStencil;  //!< depth buffer has packed stencil attached
 
 };
 
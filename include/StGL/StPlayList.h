@@ -150,6 +150,13 @@ class StPlayList {
      */
     ST_CPPEXPORT int32_t getSerial();
 
+    /**
+     * @return revision of playlist content, incremented on every modification of items list
+     */
+    ST_LOCAL int32_t getRevision() const {
+        return myRevision.getValue();
+    }
+
     inline StStereoParams& changeDefParams() {
         return myDefStParams;
     }
@@ -321,6 +328,18 @@ class StPlayList {
                                  const size_t           theStart,
                                  const size_t           theEnd) const;
 
+    /**
+     * Fill lists with playlist items titles and paths.
+     * @param theTitles the list to fill with titles
+     * @param thePaths  the list to fill with paths
+     * @param theStart  start index (inclusive) in playlist
+     * @param theEnd    end   index (exclusive) in playlist
+     */
+    ST_CPPEXPORT void getSubList(StArrayList<StString>& theTitles,
+                                 StArrayList<StString>& thePaths,
+                                 const size_t           theStart,
+                                 const size_t           theEnd) const;
+
         public: //! @name recently opened files list
 
     /**
@@ -466,6 +485,7 @@ class StPlayList {
     mutable bool            myIsNewRecent;   //!< flag indicates modified state of recent files list
 
     StAtomic<int32_t>       mySerial;        //!< serial number of playlist content
+    StAtomic<int32_t>       myRevision;      //!< revision of playlist content
     bool                    myWasCleared;    //!< flag to indicate that playlist was cleared recently
 
 };
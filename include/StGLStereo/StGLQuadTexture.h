@@ -32,6 +32,18 @@ class StGLFrameTexture : public StGLTexture {
      */
     ST_LOCAL void setDataSize(const StGLVec2& theDataSize) { myDataSize = theDataSize; }
 
+    /**
+     * @return offset to the data of specified view within texture (non-zero only for packed stereo pair).
+     */
+    ST_LOCAL const StGLVec2& getDataOffset(const bool theIsRight) const { return myDataOffset[theIsRight ? 1 : 0]; }
+
+    /**
+     * @param theIsRight    view to set offset
+     * @param theDataOffset offset to the data of specified view within texture
+     */
+    ST_LOCAL void setDataOffset(const bool      theIsRight,
+                                const StGLVec2& theDataOffset) { myDataOffset[theIsRight ? 1 : 0] = theDataOffset; }
+
     /**
      * @return display aspect ratio.
      */
@@ -64,10 +76,11 @@ class StGLFrameTexture : public StGLTexture {
 
         private:
 
-    StGLVec2   myDataSize;     //!< data size in the texture (x()=right and y()=bottom)
-    float      myDisplayRatio; //!< display aspect ratio
-    float      myPAR;          //!< pixel aspect ratio
-    StPanorama myPanorama;     //!< packed panorama format
+    StGLVec2   myDataSize;      //!< data size in the texture (x()=right and y()=bottom)
+    StGLVec2   myDataOffset[2]; //!< offsets to the left / right view data within packed stereo pair texture
+    float      myDisplayRatio;  //!< display aspect ratio
+    float      myPAR;           //!< pixel aspect ratio
+    StPanorama myPanorama;      //!< packed panorama format
 
 };
 
@@ -106,6 +119,20 @@ class StGLFrameTextures : public StGLResource {
         myImgScale = theColorScale;
     }
 
+    /**
+     * @return true if textures hold both views (side-by-side or over-under) sampled at getDataOffset().
+     */
+    inline bool isPackedPair() const {
+        return myIsPackedPair;
+    }
+
+    /**
+     * Mark textures holding packed stereo pair.
+     */
+    inline void setPackedPair(const bool theIsPacked) {
+        myIsPackedPair = theIsPacked;
+    }
+
     /**
      * @return true if main data is valid.
      */
@@ -191,6 +218,7 @@ class StGLFrameTextures : public StGLResource {
     StGLFrameTexture         myTextures[4]; //!< texture planes
     StImage::ImgColorModel   myImgCM;       //!< color model
     StImage::ImgColorScale   myImgScale;    //!< color scale
+    bool                     myIsPackedPair; //!< textures hold both views
 
 };
 
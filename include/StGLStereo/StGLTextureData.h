@@ -67,6 +67,13 @@ class StGLTextureData {
         return myPts;
     }
 
+    /**
+     * @return allocated data size in bytes
+     */
+    ST_LOCAL size_t getDataSizeBytes() const {
+        return myDataSizeBytes;
+    }
+
     /**
      * @return format of source data
      */
@@ -148,11 +155,23 @@ class StGLTextureData {
 
     ST_CPPEXPORT void getCopy(StImage* outDataL, StImage* outDataR) const;
 
+    /**
+     * Same as getCopy() but shares decoded buffers instead of copying them when possible.
+     * Data is copied when buffers are owned by this object (e.g. converted on upload).
+     */
+    ST_CPPEXPORT void getReference(StImage* outDataL, StImage* outDataR) const;
+
     /**
      * Release memory.
      */
     ST_CPPEXPORT void reset();
 
+    /**
+     * Take over the allocated buffer of another frame (which is released) to avoid reallocation.
+     * Does nothing if this frame already has a buffer.
+     */
+    ST_CPPEXPORT void takeBuffer(StGLTextureData& theOther);
+
         private:
 
     ST_LOCAL bool reAllocate(const size_t theSizeBytes);
@@ -188,11 +207,13 @@ class StGLTextureData {
     StImage                  myDataPair;
     StImage                  myDataL;
     StImage                  myDataR;
+    StImage                  myDataEmpty;     //!< empty image (for the right textures in case of packed stereo pair)
 
     StHandle<StStereoParams> myStParams;
     double                   myPts;           //!< presentation timestamp
     StFormat                 mySrcFormat;
     StCubemap                myCubemapFormat;
+    bool                     myIsPackedPair;  //!< upload myDataPair as single texture shared by both views
 
     StHandle<StGLTextureUploadParams> myUploadParams; //!< texture streaming parameters
     GLsizei                  myFillFromRow;
@@ -9,6 +9,7 @@
 
 #include <StThreads/StCondition.h>
 #include <StThreads/StFPSMeter.h>
+#include <StThreads/StFrameScheduler.h>
 #include <StThreads/StMutex.h>
 
 #include <StGL/StGLDeviceCaps.h>
@@ -106,7 +107,7 @@ class StGLTextureQueue {
         myMeterMutex.lock();
         if(myHasStream) {
             theQueued   = int(myQueueSize + 1);
-            theQueueLen = int(myQueueSizeMax);
+            theQueueLen = int(myQueueSizeLimit);
             theFps      = myFPSMeter.getAverage();
         } else {
             theQueued   = 0;
@@ -120,6 +121,22 @@ class StGLTextureQueue {
         }
     }
 
+    /**
+     * Return frame scheduler tracking presented frames of GL draw loop (see onFramePresented()).
+     */
+    ST_LOCAL StFrameScheduler& getFrameScheduler() {
+        return myScheduler;
+    }
+
+    /**
+     * Register presentation of the rendered frame, should be called right after buffers swap.
+     * Frames skipped without rendering should not be registered.
+     */
+    ST_LOCAL void onFramePresented() {
+        myScheduler.onDisplayFrame(myHasNewFrame);
+        myHasNewFrame = false;
+    }
+
     /**
      * Function called in loop from general GL draw loop
      * and do update quad texture data / state (display frame).
@@ -149,7 +166,7 @@ class StGLTextureQueue {
      */
     ST_LOCAL bool isFull() const {
         myMutexSize.lock();
-            const bool aResult = ((myQueueSize + 1) == myQueueSizeMax);
+            const bool aResult = ((myQueueSize + 1) >= myQueueSizeLimit);
         myMutexSize.unlock();
         return aResult;
     }
@@ -237,9 +254,17 @@ class StGLTextureQueue {
         SNAPSHOT_SUCCESS = 1,
     };
 
+    /**
+     * Retrieve the last shown frame.
+     * @param theOutDataLeft  left view or mono image
+     * @param theOutDataRight right view
+     * @param theToForce      retrieve the frame even if it has been already retrieved
+     * @param theToReference  share decoded buffers instead of copying them (see StGLTextureData::getReference())
+     */
     ST_CPPEXPORT int getSnapshot(StImage* theOutDataLeft,
                                  StImage* theOutDataRight,
-                                 bool     theToForce = false);
+                                 bool     theToForce = false,
+                                 bool     theToReference = false);
 
         private:
 
@@ -264,6 +289,7 @@ class StGLTextureQueue {
     mutable StMutex  myMutexSize;
     size_t           myQueueSize;
     size_t           myQueueSizeMax;
+    size_t           myQueueSizeLimit; //!< current queue limit within memory budget, <= myQueueSizeMax
 
     StGLQuadTexture  myQTexture;       //!< quad stereo texture
 
@@ -272,6 +298,7 @@ class StGLTextureQueue {
 
     StMutex          myMeterMutex;
     StFPSMeter       myFPSMeter;
+    StFrameScheduler myScheduler;      //!< frame pacing scheduler
 
     StMutex          myMutexSrcFormat;
     int              myCurrSrcFormat;  //!< current source format
@@ -281,6 +308,7 @@ class StGLTextureQueue {
     StCondition      myNewShotEvent;
     bool             myIsInUpdTexture; //!< private bools for plugin thread
     bool             myIsReadyToSwap;
+    bool             myHasNewFrame;    //!< front texture has been swapped since last presented frame
     bool             myToCompress;     //!< release unused memory as fast as possible
     volatile bool    myHasStream;      //!< flag indicates that some stream connected to this queue
 
@@ -29,8 +29,10 @@ struct StGLTextureUploadParams {
     int MaxUploadIterations; //!< maximum number of texture upload iterations (frames); 1 means texture should be uploaded immediately
     int MaxUploadChunkMiB;   //!< maximum number of data in MiB to be uploaded within single iteration; 0 means no limit;
                              //!  MaxUploadIterations is stronger limit
+    bool ToSharePackedPair;  //!< upload side-by-side / over-under frame as a single texture sampled by both views
+                             //!  instead of splitting it into two textures
 
-    StGLTextureUploadParams() : MaxUploadIterations(1), MaxUploadChunkMiB(0) {}
+    StGLTextureUploadParams() : MaxUploadIterations(1), MaxUploadChunkMiB(0), ToSharePackedPair(true) {}
 
 };
 
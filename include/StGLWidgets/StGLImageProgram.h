@@ -1,6 +1,6 @@
 /**
  * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
- * Copyright © 2010-2019 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2010-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * This code is licensed under MIT license (see docs/license-mit.txt for details).
  */
@@ -14,9 +14,15 @@
 #include <StGLMesh/StGLMesh.h>
 #include <StImage/StImage.h>
 #include <StSettings/StFloat32Param.h>
+#include <StSettings/StParam.h>
 
 /**
  * GLSL program for Image Region widget.
+ *
+ * Color corrections (brightness, saturation, de-anaglyph color scale and gamma)
+ * are either evaluated per-pixel by dedicated shader sections,
+ * or baked into a small 3D LUT texture regenerated on CPU only when parameters change,
+ * so that fragment shader performs a single trilinear lookup.
  */
 class StGLImageProgram : public StGLProgramMatrix<1, 6, StGLMeshProgram> {
 
@@ -93,6 +99,7 @@ class StGLImageProgram : public StGLProgramMatrix<1, 6, StGLMeshProgram> {
     enum FragCorrect {
         FragCorrect_Off = 0,
         FragCorrect_On,
+        FragCorrect_Lut,          //!< corrections including gamma baked into 3D LUT
         FragCorrect_NB
     };
 
@@ -114,12 +121,27 @@ class StGLImageProgram : public StGLProgramMatrix<1, 6, StGLMeshProgram> {
         FragTexEAC_NB
     };
 
+    /**
+     * Color processing variants, measured separately.
+     */
+    enum ColorPipeline {
+        ColorPipeline_Off = 0, //!< no color corrections
+        ColorPipeline_Shader,  //!< corrections evaluated per-pixel
+        ColorPipeline_Lut,     //!< corrections baked into 3D LUT
+        ColorPipeline_NB
+    };
+
         public:
 
     ST_CPPEXPORT StGLImageProgram();
 
     ST_CPPEXPORT virtual ~StGLImageProgram();
 
+    /**
+     * Release GL resources.
+     */
+    ST_CPPEXPORT virtual void release(StGLContext& theCtx) ST_ATTR_OVERRIDE;
+
     ST_CPPEXPORT void setTextureSizePx(StGLContext&    theCtx,
                                        const StGLVec2& theVec2);
 
@@ -152,6 +174,33 @@ class StGLImageProgram : public StGLProgramMatrix<1, 6, StGLMeshProgram> {
                            const FragGetColor           theFilter,
                            const FragTexEAC theTexCoord = FragTexEAC_Off);
 
+    /**
+     * Return active color processing variant.
+     */
+    ST_CPPEXPORT ColorPipeline getColorPipeline() const;
+
+    /**
+     * Start GPU time measurement of drawing with active color processing variant.
+     * Uses timestamp queries, so that measurements can be nested into other timer queries.
+     */
+    ST_CPPEXPORT void stglBeginTimer(StGLContext& theCtx);
+
+    /**
+     * Finish GPU time measurement started by stglBeginTimer().
+     */
+    ST_CPPEXPORT void stglEndTimer(StGLContext& theCtx);
+
+    /**
+     * Return filtered GPU time in milliseconds for specified color processing variant,
+     * or 0 if it has not been measured.
+     */
+    ST_LOCAL double getGpuTimeMs(const ColorPipeline theVariant) const { return myGpuTimeMs[theVariant]; }
+
+    /**
+     * Format GPU time measurements for displaying.
+     */
+    ST_CPPEXPORT StString formatGpuTimes() const;
+
         public: //!< Properties
 
     struct {
@@ -159,6 +208,7 @@ class StGLImageProgram : public StGLProgramMatrix<1, 6, StGLMeshProgram> {
         StHandle<StFloat32Param> gamma;      //!< gamma correction coefficient
         StHandle<StFloat32Param> brightness; //!< brightness level
         StHandle<StFloat32Param> saturation; //!< saturation value
+        StHandle<StBoolParamNamed> toUseLut; //!< bake color corrections into 3D LUT
 
     } params;
 
@@ -170,6 +220,16 @@ class StGLImageProgram : public StGLProgramMatrix<1, 6, StGLMeshProgram> {
                            const StString& theText);
     ST_LOCAL void registerFragments(const StGLContext& theCtx);
 
+    /**
+     * Return true if 3D LUT textures are supported.
+     */
+    ST_LOCAL bool hasLutSupport(StGLContext& theCtx) const;
+
+    /**
+     * Regenerate 3D LUT when color correction parameters have been changed.
+     */
+    ST_LOCAL bool setupLut(StGLContext& theCtx);
+
         protected:
 
     ST_LOCAL bool hasNoColorScale() const {
@@ -188,10 +248,29 @@ class StGLImageProgram : public StGLProgramMatrix<1, 6, StGLMeshProgram> {
     StGLVarLocation uniTexCubeFlipZLoc;
     StGLVarLocation uniColorProcessingLoc;
     StGLVarLocation uniGammaLoc;
+    StGLVarLocation uniColorLutScaleLoc;
 
     StGLVec3        myColorScale; //!< scale filter for de-anaglyph processing
     bool            myIsRegistered;
 
+        protected: //! @name 3D LUT
+
+    static const GLsizei THE_LUT_SIZE = 33; //!< number of LUT nodes per dimension
+
+    GLuint          myLutTexture;           //!< 3D LUT texture
+    GLfloat         myLutKey[6];            //!< parameters baked into 3D LUT (brightness, saturation, gamma and color scale)
+
+        protected: //! @name GPU time measurements
+
+    static const int THE_NB_TIMERS = 4;     //!< number of timestamp query pairs in flight
+
+    GLuint          myTimerQueries[THE_NB_TIMERS * 2]; //!< timestamp queries ring
+    int             myTimerVariants[THE_NB_TIMERS];    //!< color processing variant of pending query pair, -1 if not pending
+    int             myTimerIter;                       //!< current query pair in the ring
+    bool            myIsTimerInit;                     //!< timer queries initialization state
+    bool            myHasTimer;                        //!< timestamp queries are available
+    double          myGpuTimeMs[ColorPipeline_NB];     //!< filtered GPU time per color processing variant
+
 };
 
 #endif //__StGLImageProgram_h_
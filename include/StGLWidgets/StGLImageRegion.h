@@ -1,6 +1,6 @@
 /**
  * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
- * Copyright © 2010-2020 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2010-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * This code is licensed under MIT license (see docs/license-mit.txt for details).
  */
@@ -198,6 +198,11 @@ class StGLImageRegion : public StGLWidget {
     */
     ST_LOCAL const StVec2<int>& getFrameSize() const { return myFrameSize; }
 
+    /**
+     * Return GPU time of image drawing measured for each color processing variant.
+     */
+    ST_LOCAL StString getColorGpuTimes() const { return myProgram.formatGpuTimes(); }
+
         public: //! @name Properties
 
     struct {
@@ -209,6 +214,7 @@ class StGLImageRegion : public StGLWidget {
         StHandle<StFloat32Param>      Gamma;                 //!< gamma correction coefficient
         StHandle<StFloat32Param>      Brightness;            //!< brightness level
         StHandle<StFloat32Param>      Saturation;            //!< saturation value
+        StHandle<StBoolParamNamed>    ToUseColorLut;         //!< bake color corrections into 3D LUT
 
         // per file parameters
         StHandle<StStereoParams>      stereoFile;
@@ -16,6 +16,7 @@
 class StGLMenu;
 class StGLMenuItem;
 class StGLMenuCheckbox;
+class StThumbnailService;
 
 /**
  * Widget for file system navigation.
@@ -72,6 +73,12 @@ class StGLOpenFile : public StGLMessageBox {
      */
     ST_CPPEXPORT void openFolder(const StString& theFolder);
 
+    /**
+     * Apply thumbnails generated in background.
+     */
+    ST_CPPEXPORT virtual void stglUpdate(const StPointD_t& theCursorZo,
+                                         bool theIsPreciseInput) ST_ATTR_OVERRIDE;
+
         public:    //! @name Signals
 
     struct {
@@ -139,6 +146,7 @@ class StGLOpenFile : public StGLMessageBox {
     StMIMEList                 myExtraFilter;   //!< extra file filter
     StArrayList<StString>      myExtensions;    //!< extensions filter
     StString                   myItemToLoad;    //!< new item to open
+    StHandle<StThumbnailService> myThumbnails;  //!< background generator of file thumbnails
 
         protected: //! @name main file list settings
 
@@ -11,6 +11,12 @@
 #include <StGLWidgets/StGLMenu.h>
 
 #include <StGL/StPlayList.h>
+#include <StImage/StImage.h>
+
+#include <map>
+#include <vector>
+
+class StThumbnailService;
 
 /**
  * PlayList widget.
@@ -59,6 +65,7 @@ class StGLPlayList : public StGLWidget {
         private: //! @name callback slots
 
     ST_LOCAL void updateList();
+    ST_LOCAL void trimThumbs();
     ST_LOCAL void doResetList();
     ST_LOCAL void doChangeItem(const size_t );
     ST_LOCAL void doItemClick(const size_t );
@@ -74,6 +81,19 @@ class StGLPlayList : public StGLWidget {
 
         private:
 
+    /**
+     * Thumbnail kept in memory.
+     */
+    struct StThumbEntry {
+        StHandle<StImage> Image; //!< thumbnail, NULL for items without thumbnail
+        size_t            Stamp; //!< stamp of the last list update displaying the item, for LRU eviction
+        size_t            Bytes; //!< image size in bytes
+
+        StThumbEntry() : Stamp(0), Bytes(0) {}
+    };
+
+        private:
+
     StGLMenu*            myMenu;         //!< menu with items
     StMarginsI           myFitMargins;   //!< margin for auto-fit
 
@@ -81,6 +101,12 @@ class StGLPlayList : public StGLWidget {
     StGLVec4             myBarColor;     //!< color of scroll bar
 
     StHandle<StPlayList> myList;         //!< handle to playlist
+    StHandle<StThumbnailService> myThumbnails; //!< background generator of item thumbnails
+    std::map<StString, StThumbEntry> myThumbs; //!< generated thumbnails bounded by count and size
+    std::vector<StString> myIconPaths;   //!< paths of thumbnails currently shown by menu items
+    size_t               myThumbsStamp;  //!< current list update stamp
+    size_t               myThumbsBytes;  //!< summary size of thumbnails in memory
+    int                  myThumbSize;    //!< maximum thumbnail dimension
     size_t               myFromId;       //!< id in playlist of first item displayed on screen
     int                  myItemsNb;      //!< number of items displayed on screen
     volatile bool        myToResetList;  //!< playlist has been reseted
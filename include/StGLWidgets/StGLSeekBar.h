@@ -10,6 +10,9 @@
 
 #include <StGLWidgets/StGLWidget.h>
 #include <StGL/StGLVertexBuffer.h>
+#include <StImage/StImage.h>
+
+class StGLIcon;
 
 /**
  * Simple seeking bar widget.
@@ -42,6 +45,26 @@ class StGLSeekBar : public StGLWidget {
         myMoveTolerPx = theTolerPx;
     }
 
+    /**
+     * Return TRUE while seek bar is being dragged by mouse / touch.
+     */
+    ST_LOCAL bool isDragging() const {
+        return myClickPos >= 0
+            && isClicked(ST_MOUSE_LEFT);
+    }
+
+    /**
+     * Show preview image above the seek bar at hovered position.
+     * Preview is ignored if the seek bar is not hovered anymore.
+     * @param theImage preview image in RGB format, NULL to hide preview
+     */
+    ST_CPPEXPORT void setPreview(const StHandle<StImage>& theImage);
+
+    /**
+     * Setup opacity value, keeping hidden preview invisible.
+     */
+    ST_CPPEXPORT virtual void setOpacity(const float theOpacity, bool theToSetChildren) ST_ATTR_OVERRIDE;
+
     ST_CPPEXPORT virtual void stglResize() ST_ATTR_OVERRIDE;
     ST_CPPEXPORT virtual bool stglInit() ST_ATTR_OVERRIDE;
     ST_CPPEXPORT virtual void stglUpdate(const StPointD_t& theCursor,
@@ -64,6 +87,12 @@ class StGLSeekBar : public StGLWidget {
          * @param theDelta scrolling direction
          */
         StSignal<void (const double )> onSeekScroll;
+
+        /**
+         * Emit callback Slot on moving cursor over the seek bar.
+         * @param theProgress hovered position from 0.0 to 1.0, or negative value when cursor leaves the seek bar
+         */
+        StSignal<void (const double )> onSeekHover;
     } signals;
 
         private: //! @name callback Slots (private overriders)
@@ -76,6 +105,16 @@ class StGLSeekBar : public StGLWidget {
     ST_LOCAL void stglUpdateVertices();
     ST_LOCAL double getPointInEx(const StPointD_t& thePointZo) const;
 
+    /**
+     * Track hovered position and emit onSeekHover signal.
+     */
+    ST_LOCAL void updateHover(const StPointD_t& theCursor);
+
+    /**
+     * Move preview image to hovered position.
+     */
+    ST_LOCAL void updatePreviewPosition();
+
         private:
 
     class StProgramSB;
@@ -87,6 +126,9 @@ class StGLSeekBar : public StGLWidget {
     int                   myProgressPx; //!< current progress - width in pixels
     int                   myClickPos;
     int                   myMoveTolerPx;
+    int                   myHoverPx;    //!< hovered position in pixels, -1 if not hovered
+    StGLIcon*             myPreview;    //!< preview image above the bar, texture is reused by consequent previews
+    bool                  myIsPreviewShown; //!< flag indicating that preview is displayed
 
 };
 
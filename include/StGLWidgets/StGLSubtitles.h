@@ -1,6 +1,6 @@
 /**
  * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
- * Copyright © 2010-2025 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2010-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * This code is licensed under MIT license (see docs/license-mit.txt for details).
  */
@@ -14,6 +14,8 @@
 #include <StSettings/StEnumParam.h>
 #include <StSettings/StFloat32Param.h>
 
+#include <vector>
+
 // dummy
 template<>
 inline void StArray<StHandle <StSubItem> >::sort() {}
@@ -22,6 +24,9 @@ class StGLImageRegion;
 
 /**
  * Subtitles widget.
+ * Image-based subtitles are packed into a reusable texture atlas and text layouts are cached,
+ * while upcoming items (within lookahead interval) are prepared in advance,
+ * so that changing subtitles does not cause texture allocation or text formatting spikes.
  */
 class StGLSubtitles : public StGLTextArea {
 
@@ -35,9 +40,8 @@ class StGLSubtitles : public StGLTextArea {
 
             public:
 
-        StString     Text;  //!< active string representation
-        StImagePlane Image; //!< active image  representation
-        float        Scale; //!< image scale factor
+        StString            Text;      //!< active string representation
+        StHandle<StSubItem> ImageItem; //!< item defining active image representation
 
             public:
 
@@ -106,7 +110,87 @@ class StGLSubtitles : public StGLTextArea {
 
         private:
 
-    StGLTexture              myTexture;   //!< texture for image-based subtitles
+    /**
+     * Atlas region occupied by the image of subtitle item.
+     */
+    struct AtlasSlot {
+        StHandle<StSubItem> Item;  //!< subtitle item
+        int                 Left;  //!< left   position within the atlas
+        int                 Top;   //!< top    position within the atlas
+        int                 SizeX; //!< image width
+        int                 SizeY; //!< image height
+    };
+
+    /**
+     * Cached text layout.
+     */
+    struct LayoutSlot {
+        StString   Text;   //!< formatted text
+        TextLayout Layout; //!< formatted text layout
+    };
+
+    /**
+     * Find atlas region with the image of specified subtitle item.
+     */
+    ST_LOCAL const AtlasSlot* findAtlasSlot(const StHandle<StSubItem>& theItem) const;
+
+    /**
+     * Upload image of subtitle item into the atlas.
+     * @param theCtx     active context
+     * @param theItem    subtitle item
+     * @param theToReset allow discarding of other images when atlas is full
+     * @return atlas region or NULL if image does not fit
+     */
+    ST_LOCAL const AtlasSlot* uploadToAtlas(StGLContext&               theCtx,
+                                            const StHandle<StSubItem>& theItem,
+                                            const bool                 theToReset);
+
+    /**
+     * Release atlas regions of outdated items.
+     */
+    ST_LOCAL void pruneAtlas();
+
+    /**
+     * Activate layout of current text, formatting it only if not yet cached.
+     */
+    ST_LOCAL void showLayout(StGLContext& theCtx);
+
+    /**
+     * Release cached text layouts.
+     */
+    ST_LOCAL void clearLayouts(StGLContext& theCtx);
+
+    /**
+     * Predict displayed text at specified position, combining active and upcoming items like stglUpdate() does.
+     */
+    ST_LOCAL StString predictText(const double thePts) const;
+
+    /**
+     * Format and cache the layout of the text, if not yet cached.
+     * @return true if new layout has been formatted
+     */
+    ST_LOCAL bool prepareLayout(StGLContext&    theCtx,
+                                const StString& theText);
+
+    /**
+     * Prepare images and text layouts of upcoming subtitle items.
+     */
+    ST_LOCAL void prepareUpcoming(StGLContext& theCtx);
+
+        private:
+
+    StGLTexture              myTexture;   //!< texture for image-based subtitles not fitting into the atlas
+    StHandle<StSubItem>      myTextureItem; //!< subtitle item uploaded into myTexture
+    StGLTexture              myAtlas;     //!< texture atlas for image-based subtitles
+    std::vector<AtlasSlot>   myAtlasSlots;//!< occupied atlas regions
+    int                      myAtlasShelfX;     //!< position within the current shelf of the atlas
+    int                      myAtlasShelfY;     //!< top of the current shelf of the atlas
+    int                      myAtlasShelfSizeY; //!< height of the current shelf of the atlas
+    std::vector<LayoutSlot>  myLayouts;   //!< cached text layouts (least recently used first)
+    StString                 myLayoutText;//!< text of active layout
+    StGLVec4                 myLayoutKey; //!< formatting parameters of cached layouts (width, height, size, parser)
+    StArrayList< StHandle<StSubItem> >
+                             myUpcoming;  //!< temporary list of upcoming items
     StGLVertexBuffer         myVertBuf;   //!< vertex buffer for image-based subtitles
     StGLVertexBuffer         myTCrdBuf;   //!< texture coordinates buffer for image-based subtitles
     StHandle<StSubQueue>     myQueue;     //!< thread-safe subtitles queue
@@ -1,6 +1,6 @@
 /**
  * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
- * Copyright © 2009-2020 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * This code is licensed under MIT license (see docs/license-mit.txt for details).
  */
@@ -218,8 +218,40 @@ class StGLTextArea : public StGLWidget {
 
         protected:
 
+    /**
+     * Formatted text, which can be prepared in advance and swapped with the active one.
+     */
+    struct TextLayout {
+        std::vector<GLuint>                       Textures; //!< font textures
+        StArrayList< StHandle<StGLVertexBuffer> > VertBuf;  //!< vertices per texture
+        StArrayList< StHandle<StGLVertexBuffer> > TCrdBuf;  //!< texture coordinates per texture
+        StGLRect                                  BndBox;   //!< text boundary box
+
+        /**
+         * Release GL resources.
+         */
+        ST_CPPEXPORT void release(StGLContext& theCtx);
+    };
+
     ST_CPPEXPORT void formatText(StGLContext& theCtx);
 
+    /**
+     * Format specified text using current formatter settings without changing the active text.
+     */
+    ST_CPPEXPORT void formatLayout(StGLContext&    theCtx,
+                                   const StString& theText,
+                                   TextLayout&     theLayout);
+
+    /**
+     * Exchange active formatted text with the layout prepared by formatLayout().
+     * @param theCtx    active context
+     * @param theText   text formatted within the layout
+     * @param theLayout layout to show, receives previously active formatted text
+     */
+    ST_CPPEXPORT void swapLayout(StGLContext&    theCtx,
+                                 const StString& theText,
+                                 TextLayout&     theLayout);
+
         private:
 
     ST_LOCAL void drawText(StGLContext& theCtx);
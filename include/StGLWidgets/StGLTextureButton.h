@@ -12,6 +12,7 @@
 
 #include <StGL/StGLVertexBuffer.h>
 #include <StGL/StGLTexture.h>
+#include <StImage/StImage.h>
 
 class StAction;
 
@@ -197,6 +198,7 @@ class StGLIcon : public StGLTextureButton {
 
     ST_CPPEXPORT virtual ~StGLIcon();
 
+    ST_CPPEXPORT virtual bool stglInit() ST_ATTR_OVERRIDE;
     ST_CPPEXPORT virtual bool tryClick  (const StClickEvent& theEvent, bool& theIsItemClicked)   ST_ATTR_OVERRIDE;
     ST_CPPEXPORT virtual bool tryUnClick(const StClickEvent& theEvent, bool& theIsItemUnclicked) ST_ATTR_OVERRIDE;
 
@@ -208,9 +210,15 @@ class StGLIcon : public StGLTextureButton {
         myIsExternalTexture = true;
     }
 
+    /**
+     * Define image (like file thumbnail) to be uploaded into texture within next stglInit().
+     */
+    ST_CPPEXPORT void setImage(const StHandle<StImage>& theImage);
+
         protected:
 
-    bool myIsExternalTexture; //!< flag indicating that assigned texture should not be released
+    StHandle<StImage> myImage;             //!< image to be uploaded into texture
+    bool              myIsExternalTexture; //!< flag indicating that assigned texture should not be released
 
 };
 
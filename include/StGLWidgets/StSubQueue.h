@@ -1,6 +1,6 @@
 /**
  * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
- * Copyright © 2010-2014 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2010-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * This code is licensed under MIT license (see docs/license-mit.txt for details).
  */
@@ -73,6 +73,17 @@ class StSubQueue {
      */
     ST_CPPEXPORT StHandle<StSubItem> pop(const double thePTS);
 
+    /**
+     * Retrieve queued items starting before specified timestamp without removing them,
+     * so that they can be prepared for displaying in advance.
+     * @param thePtsTo   lookahead presentation timestamp
+     * @param theItems   output list of items
+     * @param theNbMax   maximum number of items to retrieve
+     */
+    ST_CPPEXPORT void peek(const double                        thePtsTo,
+                           StArrayList< StHandle<StSubItem> >& theItems,
+                           const size_t                        theNbMax);
+
     /**
      * Append subtitle item to the queue.
      * @param theSubItem item to add
@@ -0,0 +1,167 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#ifndef __StImageExportQueue_h_
+#define __StImageExportQueue_h_
+
+#include <StImage/StImageFile.h>
+#include <StSlots/StSignal.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThreadPool.h>
+#include <StThreads/StTimer.h>
+
+#include <deque>
+
+/**
+ * Queue of images to be encoded and written into files by the shared pool of working threads (see StThreadPool::getShared()),
+ * so that saving snapshots and exporting frames does not block loading / playback threads.
+ * Queued images are expected to reference decoded buffers (see StImage::initReference()) rather than hold copies;
+ * memory occupied by pending images is reported to StMemoryBudget and push() waits
+ * when the budget is exhausted.
+ * The number of simultaneously encoded images is limited, so that the pool remains available for decoding.
+ */
+class StImageExportQueue {
+
+        public:
+
+    /**
+     * Export job.
+     */
+    struct Job {
+        StHandle<StImage>            Left;         //!< left view or mono image
+        StHandle<StImage>            Right;        //!< optional right view, packed with the left one into side-by-side image
+        StString                     Path;         //!< path to the file to write
+        StImageFile::SaveImageParams SaveParams;   //!< image saving parameters
+        int                          SeparationDx; //!< horizontal separation for side-by-side packing
+        int                          SeparationDy; //!< vertical   separation for side-by-side packing
+
+        Job() : SeparationDx(0), SeparationDy(0) {}
+    };
+
+    /**
+     * Export statistics.
+     */
+    struct Statistics {
+        size_t   NbSaved;     //!< number of written files
+        size_t   NbFailed;    //!< number of failed jobs
+        size_t   NbPending;   //!< number of queued or processed jobs
+        uint64_t NbBytes;     //!< size of encoded images in bytes (uncompressed)
+        double   ElapsedTime; //!< time since the first job in seconds
+
+        Statistics() : NbSaved(0), NbFailed(0), NbPending(0), NbBytes(0), ElapsedTime(0.0) {}
+
+        /**
+         * Return the number of written files per second.
+         */
+        double getFilesPerSecond() const { return ElapsedTime > 0.0 ? double(NbSaved) / ElapsedTime : 0.0; }
+
+        /**
+         * Return encoding throughput in megabytes (of uncompressed data) per second.
+         */
+        double getMegabytesPerSecond() const { return ElapsedTime > 0.0 ? double(NbBytes) / (1024.0 * 1024.0) / ElapsedTime : 0.0; }
+    };
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theImageLib  image library to encode images
+     * @param theNbJobsMax maximum number of images encoded simultaneously, 0 for automatic selection
+     */
+    ST_CPPEXPORT StImageExportQueue(const StImageFile::ImageClass theImageLib = StImageFile::ST_LIBAV,
+                                    const int                     theNbJobsMax = 0);
+
+    /**
+     * Destructor, finishes pending jobs.
+     */
+    ST_CPPEXPORT ~StImageExportQueue();
+
+    /**
+     * Set image library to encode images.
+     */
+    ST_CPPEXPORT void setImageLib(const StImageFile::ImageClass theImageLib);
+
+    /**
+     * Append the job.
+     * Blocks the caller while pending images exceed the memory budget.
+     */
+    ST_CPPEXPORT void push(const Job& theJob);
+
+    /**
+     * Wait until all pending jobs are finished.
+     */
+    ST_CPPEXPORT void wait();
+
+    /**
+     * Return true if there are no pending jobs.
+     */
+    ST_CPPEXPORT bool isEmpty() const;
+
+    /**
+     * Return export statistics.
+     */
+    ST_CPPEXPORT Statistics getStatistics() const;
+
+    /**
+     * Format export statistics for displaying.
+     */
+    ST_CPPEXPORT StString formatStatistics() const;
+
+        public: //! @name signals
+
+    /**
+     * All callback handlers should be thread-safe.
+     */
+    struct {
+        /**
+         * Emit callback Slot on error.
+         * @param theUserData (const StCString& ) - error description.
+         */
+        StSignal<void (const StCString& )> onError;
+    } signals;
+
+        private:
+
+    /**
+     * Job of the working pool.
+     */
+    class PoolJob;
+
+    /**
+     * Pass queued jobs to the working pool within limit of simultaneously encoded images (should be called under lock).
+     */
+    ST_LOCAL void dispatchJobs();
+
+    /**
+     * Encode and write the image, and update statistics (called within working thread).
+     */
+    ST_LOCAL void process(Job& theJob);
+
+    /**
+     * Encode and write the image.
+     */
+    ST_LOCAL bool perform(const Job& theJob);
+
+    /**
+     * Return memory occupied by images of the job.
+     */
+    ST_LOCAL static size_t getJobBytes(const Job& theJob);
+
+        private:
+
+    StHandle<StThreadPool>            myPool;       //!< shared working threads
+    std::deque<Job>                   myJobs;       //!< queued jobs not yet passed to the pool
+    mutable StMutex                   myMutex;      //!< lock for jobs queue and statistics
+    StTimer                           myTimer;      //!< timer started by the first job
+    Statistics                        myStats;      //!< export statistics
+    size_t                            myQueuedBytes;//!< memory occupied by pending images
+    StImageFile::ImageClass           myImageLib;   //!< image library
+    int                               myNbJobsMax;  //!< maximum number of images encoded simultaneously
+    int                               myNbRunning;  //!< number of jobs passed to the pool
+
+};
+
+#endif // __StImageExportQueue_h_
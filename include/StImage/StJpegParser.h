@@ -49,6 +49,7 @@ class StJpegParser : public StRawFile {
         Offset_Jps,       //!< APP3
         Offset_Iptc,      //!< APP13
         Offset_Comment,
+        Offset_Mpf,       //!< APP2 with MP extensions
         OffsetsNb,
     };
 
@@ -57,7 +58,7 @@ class StJpegParser : public StRawFile {
         size_t          Length;   //!< data length
         StArrayList< StHandle<StExifDir> >
                         Exif;     //!< EXIF sections
-        StHandle<Image> Thumb;    //!< optional thumbnail
+        StHandle<Image> Thumb;    //!< optional thumbnail (only Data and Length are defined for thumbnail embedded into EXIF)
         StHandle<Image> Next;     //!< link to the next image in file (if any)
         size_t          SizeX;    //!< image width  in pixels
         size_t          SizeY;    //!< image height in pixels
@@ -130,6 +131,24 @@ class StJpegParser : public StRawFile {
                                        const int        theOpenedFd = -1,
                                        const size_t     theReadMax  = 0) ST_ATTR_OVERRIDE;
 
+    /**
+     * Read only the headers of the file (segments up to SOS) without compressed image data.
+     * Headers of other images in MPO are located using MP Entries of the first image
+     * and read by bounded ranges, so that the whole file is never loaded into memory.
+     * Without MP index, the file is scanned by chunks for SOI of concatenated second image.
+     * Images returned by getImage() contain only the headers in this mode and cannot be decoded.
+     * @param theFilePath the file path
+     * @param theOpenedFd when specified, already opened file descriptor will be used; passed descriptor will be automatically closed
+     * @return true if headers of at least the first image were read
+     */
+    ST_CPPEXPORT bool readHeaders(const StCString& theFilePath,
+                                  const int        theOpenedFd = -1);
+
+    /**
+     * Return true if only headers have been read by readHeaders().
+     */
+    ST_LOCAL bool isHeadersOnly() const { return myIsHeadersOnly; }
+
     /**
      * Determines images count.
      */
@@ -239,6 +258,39 @@ class StJpegParser : public StRawFile {
                                     const uint16_t  theSectLen,
                                     const ptrdiff_t theOffset);
 
+    /**
+     * Append headers of the image at specified file offset to the buffer.
+     * Segments are read up to SOS (inclusive), or EOI.
+     * @param theFileOffset offset of the image SOI marker within the file
+     * @return true if headers have been read
+     */
+    ST_LOCAL bool readHeadersAt(const int64_t theFileOffset);
+
+    /**
+     * Scan the file for SOI marker of the next image (concatenated JPEG files without MP index).
+     * @param theFileOffset offset to start scanning from
+     * @return offset of the found SOI marker or -1
+     */
+    ST_LOCAL int64_t findNextImage(const int64_t theFileOffset);
+
+    /**
+     * Ensure that specified number of bytes of the image has been read into the buffer.
+     * @param theFileOffset offset of the image within the file
+     * @param theStart      offset of the image within the buffer
+     * @param theNbRead     number of image bytes already read, to be updated
+     * @param theNbNeeded   number of image bytes required
+     * @return false if file is shorter than required
+     */
+    ST_LOCAL bool readHeadersRange(const int64_t theFileOffset,
+                                   const size_t  theStart,
+                                   size_t&       theNbRead,
+                                   const size_t  theNbNeeded);
+
+    /**
+     * Grow the buffer preserving its content.
+     */
+    ST_LOCAL bool growBuffer(const size_t theSize);
+
         protected:
 
     StHandle<Image> myImages;     //!< images list
@@ -249,6 +301,7 @@ class StJpegParser : public StRawFile {
     StString        myXMP;        //!< string stored in XMP segment
     StFormat        myStFormat;   //!< stereo format
     StPanorama      myPanorama;   //!< panorama format
+    bool            myIsHeadersOnly; //!< only headers have been read, image data is unavailable
 
 };
 
@@ -0,0 +1,130 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#ifndef __StThumbnailService_h_
+#define __StThumbnailService_h_
+
+#include <StImage/StImage.h>
+#include <StThreads/StCondition.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThread.h>
+
+#include <deque>
+#include <vector>
+
+/**
+ * Background generator of small previews for image and video files.
+ * Thumbnails are produced by low-priority working threads:
+ * - from thumbnail embedded into EXIF of JPEG / MPO files, read using only file headers;
+ * - from image decoded at reduced resolution (when supported by decoder);
+ * - from the first key frame of video file.
+ * Results are stored in on-disk cache as small JPEG files, keyed by file path, size and modification time;
+ * the least recently used files are removed when the cache exceeds size or age limits.
+ */
+class StThumbnailService {
+
+        public:
+
+    /**
+     * Generated thumbnail.
+     */
+    struct Result {
+        StString          Path;  //!< path to the file
+        StHandle<StImage> Image; //!< thumbnail in RGB format, NULL if thumbnail can not be created
+    };
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theCacheFolder folder to store thumbnails, cache is disabled when empty
+     * @param theSizeMax     maximum thumbnail dimension in pixels
+     * @param theNbThreads   number of working threads, 0 for automatic selection
+     */
+    ST_CPPEXPORT StThumbnailService(const StString& theCacheFolder,
+                                    const int       theSizeMax,
+                                    const int       theNbThreads = 0);
+
+    /**
+     * Destructor, stops working threads.
+     */
+    ST_CPPEXPORT ~StThumbnailService();
+
+    /**
+     * Return maximum thumbnail dimension.
+     */
+    ST_LOCAL int getSizeMax() const { return mySizeMax; }
+
+    /**
+     * Append request to generate thumbnail for the file.
+     * The latest requests are processed first, so that visible items should be requested last.
+     */
+    ST_CPPEXPORT void request(const StString& thePath);
+
+    /**
+     * Discard requests which have not been yet processed.
+     */
+    ST_CPPEXPORT void clearRequests();
+
+    /**
+     * Retrieve next generated thumbnail.
+     * @return false if there are no new results
+     */
+    ST_CPPEXPORT bool popResult(Result& theResult);
+
+    /**
+     * Generate thumbnail for the file within current thread (cache is not used).
+     * @param thePath    path to the file
+     * @param theSizeMax maximum thumbnail dimension
+     * @return thumbnail in RGB format or NULL on failure
+     */
+    ST_CPPEXPORT static StHandle<StImage> generate(const StString& thePath,
+                                                   const int       theSizeMax);
+
+        private:
+
+    /**
+     * Working thread loop.
+     */
+    ST_LOCAL void mainLoop();
+
+    /**
+     * Working thread callback.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION threadFunction(void* theService);
+
+    /**
+     * Remove the oldest files from cache folder.
+     * Does nothing if cache is currently trimmed by another service or process.
+     */
+    ST_LOCAL void trimCache();
+
+    /**
+     * Return path to the cached thumbnail or empty string if file is inaccessible.
+     */
+    ST_LOCAL StString getCachePath(const StString& thePath) const;
+
+    /**
+     * Scale image to fit into specified dimensions.
+     */
+    ST_LOCAL static StHandle<StImage> scaleToFit(const StImage& theImage,
+                                                 const int      theSizeMax);
+
+        private:
+
+    std::vector< StHandle<StThread> > myThreads;     //!< working threads
+    std::deque<StString>              myRequests;    //!< paths waiting for processing
+    std::deque<Result>                myResults;     //!< generated thumbnails
+    StMutex                           myMutex;       //!< lock for requests and results queues
+    StCondition                       myEvent;       //!< event signaling new requests
+    StString                          myCacheFolder; //!< folder for cached thumbnails
+    int                               mySizeMax;     //!< maximum thumbnail dimension
+    size_t                            myNbCached;    //!< number of thumbnails written into cache
+    volatile bool                     myToTrimCache; //!< flag to remove outdated files from cache
+    volatile bool                     myToQuit;      //!< flag to stop working threads
+};
+
+#endif // __StThumbnailService_h_
@@ -10,6 +10,8 @@
 #include <StStrings/StString.h>
 #include <StTemplates/StQuickSort.h>
 
+#include <utility>
+
 /**
  * This template declare Array class.
  * Memory allocated as flat array.
@@ -83,6 +85,27 @@ class StArray {
         return (*this);
     }
 
+    /**
+     * Move constructor.
+     */
+    StArray(StArray&& theOther)
+    : mySize(theOther.mySize),
+      myArray(theOther.myArray) {
+        theOther.mySize  = 0;
+        theOther.myArray = NULL;
+    }
+
+    /**
+     * Move assignment operator.
+     */
+    StArray& operator=(StArray&& theOther) {
+        if(this != &theOther) {
+            std::swap(mySize,  theOther.mySize);
+            std::swap(myArray, theOther.myArray);
+        }
+        return (*this);
+    }
+
     /**
      * Deallocate the array.
      */
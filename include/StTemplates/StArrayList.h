@@ -13,8 +13,9 @@
  * This template declare simple-to-use size-scaled Array class.
  * This mean you can work with this class like with List (methods add() and remove()),
  * but memory allocated as array (not a single-linked or double-linked list!).
- * You can manage array-allocation size on construction. When array is full, it automatically upscaled + 8 items
- * and array copying processed.
+ * You can manage array-allocation size on construction (or later with reserve()).
+ * When array is full, its capacity is doubled and existing elements are moved into new array,
+ * so that filling the list element by element takes linear time.
  */
 template<typename Element_t>
 class StArrayList : public StArray<Element_t> {
@@ -64,6 +65,26 @@ class StArrayList : public StArray<Element_t> {
         return (*this);
     }
 
+    /**
+     * Move constructor.
+     */
+    StArrayList(StArrayList&& theOther)
+    : StArray<Element_t>(std::move(theOther)),
+      mySizeMax(theOther.mySizeMax) {
+        theOther.mySizeMax = 0;
+    }
+
+    /**
+     * Move assignment operator.
+     */
+    StArrayList& operator=(StArrayList&& theOther) {
+        if(this != &theOther) {
+            StArray<Element_t>::operator=(std::move(theOther));
+            std::swap(mySizeMax, theOther.mySizeMax);
+        }
+        return (*this);
+    }
+
     /**
      * Deallocate the list.
      */
@@ -71,6 +92,24 @@ class StArrayList : public StArray<Element_t> {
         //
     }
 
+    /**
+     * @return number of elements which can be stored without reallocation.
+     */
+    size_t getCapacity() const {
+        return mySizeMax;
+    }
+
+    /**
+     * Ensure that specified number of elements can be stored without reallocation.
+     * Existing elements are preserved.
+     */
+    StArrayList& reserve(const size_t theCapacity) {
+        if(theCapacity > mySizeMax) {
+            reAllocate(theCapacity);
+        }
+        return (*this);
+    }
+
     /**
      * Method to initialize the array list as array.
      * You can access elements within the specified size limit.
@@ -102,24 +141,34 @@ class StArrayList : public StArray<Element_t> {
      */
     StArrayList& add(const size_t theIndex, const Element_t& theElement) {
         if(theIndex >= mySizeMax) {
-            size_t aNewSize = getAligned(theIndex + 7); // increment with 8 elements...
-            Element_t* aNewArray = new Element_t[aNewSize];
-            for(size_t anElem = 0; anElem < mySizeMax; ++anElem) {
-                aNewArray[anElem] = StArray<Element_t>::myArray[anElem];
-            }
-            // perform copy before deleting (make it safe for adding self-element)
-            aNewArray[theIndex] = theElement;
-            if(theIndex >= StArray<Element_t>::mySize) {
-                StArray<Element_t>::mySize = theIndex + 1;
-            }
-            delete[] StArray<Element_t>::myArray;
-            StArray<Element_t>::myArray = aNewArray;
-            mySizeMax = aNewSize;
+            // perform copy before reallocation (make it safe for adding self-element)
+            Element_t aCopy(theElement);
+            grow(theIndex + 1);
+            return add(theIndex, std::move(aCopy));
+        }
+
+        StArray<Element_t>::myArray[theIndex] = theElement;
+        if(theIndex >= StArray<Element_t>::mySize) {
+            StArray<Element_t>::mySize = theIndex + 1;
+        }
+        return (*this);
+    }
+
+    /**
+     * @param theIndex (size_t ) - list position to add new element;
+     * @param theElement (Element_t&& ) - element to move into the list;
+     * @return this list.
+     */
+    StArrayList& add(const size_t theIndex, Element_t&& theElement) {
+        if(theIndex >= mySizeMax) {
+            Element_t aCopy(std::move(theElement));
+            grow(theIndex + 1);
+            StArray<Element_t>::myArray[theIndex] = std::move(aCopy);
         } else {
-            StArray<Element_t>::myArray[theIndex] = theElement;
-            if(theIndex >= StArray<Element_t>::mySize) {
-                StArray<Element_t>::mySize = theIndex + 1;
-            }
+            StArray<Element_t>::myArray[theIndex] = std::move(theElement);
+        }
+        if(theIndex >= StArray<Element_t>::mySize) {
+            StArray<Element_t>::mySize = theIndex + 1;
         }
         return (*this);
     }
@@ -133,6 +182,31 @@ class StArrayList : public StArray<Element_t> {
         return add(aLastId, theElement);
     }
 
+    /**
+     * @param theElement (Element_t&& ) - element to move at the end of list;
+     * @return this list.
+     */
+    StArrayList& add(Element_t&& theElement) {
+        size_t aLastId = StArray<Element_t>::mySize;
+        return add(aLastId, std::move(theElement));
+    }
+
+    /**
+     * Append new element constructed from specified arguments at the end of list.
+     * Array slots are always default-constructed, so that the new element is moved into the slot.
+     * @return added element.
+     */
+    template<typename... Args_t>
+    Element_t& emplace(Args_t&&... theArgs) {
+        const size_t aLastId = StArray<Element_t>::mySize;
+        if(aLastId >= mySizeMax) {
+            grow(aLastId + 1);
+        }
+        StArray<Element_t>::myArray[aLastId] = Element_t(std::forward<Args_t>(theArgs)...);
+        StArray<Element_t>::mySize = aLastId + 1;
+        return StArray<Element_t>::myArray[aLastId];
+    }
+
     /**
      * Removes the element at the specified position in this list.
      */
@@ -140,14 +214,12 @@ class StArrayList : public StArray<Element_t> {
         if(theIndex >= StArray<Element_t>::mySize) {
             return (*this);
         }
-        // make sure the object destroyed (like handle)
-        StArray<Element_t>::myArray[theIndex] = Element_t();
-
         for(size_t aMoveFromId = theIndex + 1; aMoveFromId < StArray<Element_t>::mySize; ++aMoveFromId) {
-            // move object to the top... slow!
-            StArray<Element_t>::myArray[aMoveFromId - 1] = StArray<Element_t>::myArray[aMoveFromId];
+            StArray<Element_t>::myArray[aMoveFromId - 1] = std::move(StArray<Element_t>::myArray[aMoveFromId]);
         }
         --StArray<Element_t>::mySize;
+        // make sure the object destroyed (like handle)
+        StArray<Element_t>::myArray[StArray<Element_t>::mySize] = Element_t();
         return (*this);
     }
 
@@ -170,6 +242,29 @@ class StArrayList : public StArray<Element_t> {
         return StArray<Element_t>::mySize == 0;
     }
 
+        private:
+
+    /**
+     * Grow capacity geometrically to fit at least specified number of elements.
+     */
+    void grow(const size_t theMinCapacity) {
+        reAllocate(stMax(theMinCapacity, mySizeMax * 2));
+    }
+
+    /**
+     * Allocate new array of specified capacity and move existing elements into it.
+     */
+    void reAllocate(const size_t theCapacity) {
+        const size_t aNewSize = (theCapacity > 1) ? getAligned(theCapacity) : 1;
+        Element_t* aNewArray = new Element_t[aNewSize];
+        for(size_t anElem = 0; anElem < StArray<Element_t>::mySize; ++anElem) {
+            aNewArray[anElem] = std::move(StArray<Element_t>::myArray[anElem]);
+        }
+        delete[] StArray<Element_t>::myArray;
+        StArray<Element_t>::myArray = aNewArray;
+        mySizeMax = aNewSize;
+    }
+
 };
 
 #endif //__StArrayList_H__
@@ -73,6 +73,29 @@ class StAtomicOp {
     #endif
     }
 
+    /**
+     * Read the value with full memory barrier,
+     * so that data published before modification of the value becomes visible.
+     * @param theValue (volatile int32_t& ) - input value;
+     * @return current value.
+     */
+    static inline int32_t Load(volatile int32_t& theValue) {
+    #ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4
+        // g++ compiler
+        return __sync_fetch_and_add(&theValue, 0);
+    #elif defined(_WIN32)
+        return InterlockedCompareExchange((volatile LONG* )&theValue, 0, 0);
+    #elif defined(__APPLE__)
+        return OSAtomicAdd32Barrier(0, &theValue);
+    #elif defined(__GNUC__)
+        #error "Set -march=i486 or -march=armv7-a for gcc compiler"
+        return theValue;
+    #else
+        #error "Atomic operation doesn't implemented for current platform!"
+        return theValue;
+    #endif
+    }
+
     /**
      * Increment the value with 1 and return result.
      * @param theValue (volatile uint32_t& ) - input value;
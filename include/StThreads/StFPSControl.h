@@ -8,11 +8,14 @@
 #define __StFPSControl_h_
 
 #include "StFPSMeter.h"
+#include "StFrameScheduler.h"
 #include "StThread.h"
 
 /**
  * Class extend FPS measurements features with possibility
  * to adjust FPS to target using thread sleeping.
+ * Positive target FPS is reached by sleeping until the next frame deadline with sub-millisecond precision;
+ * zero target FPS adjusts sleep time adaptively to reduce CPU utilization.
  */
 class StFPSControl : public StFPSMeter {
 
@@ -20,8 +23,10 @@ class StFPSControl : public StFPSMeter {
 
     StFPSControl()
     : StFPSMeter(),
+      myClock(true),
       mySleeper(10),
       myTargetFps(-1.0),
+      myDeadlineUs(-1.0),
       myDecCount(0),
       myIsIncreased(false) {
         //
@@ -39,10 +44,7 @@ class StFPSControl : public StFPSMeter {
         if(StFPSMeter::nextFrame()) {
             const double aNewFPS = getAverage();
             // compute sleep time to get target FPS
-            if(myTargetFps > 0.0) {
-                //ST_DEBUG_LOG("adjustFPSToTarget " + myTargetFps);
-                adjustFPSToTarget(aNewFPS);
-            } else if(myTargetFps == 0.0) {
+            if(myTargetFps == 0.0) {
                 //ST_DEBUG_LOG("adjustFPSToMax " + myTargetFps);
                 adjustFPSToMax(aPrevFPS, aNewFPS);
             }
@@ -55,6 +57,9 @@ class StFPSControl : public StFPSMeter {
      * @param theFps (const double& ) - target fps.
      */
     void setTargetFPS(const double theFps) {
+        if(myTargetFps != theFps) {
+            myDeadlineUs = -1.0;
+        }
         myTargetFps = theFps;
     }
 
@@ -66,7 +71,18 @@ class StFPSControl : public StFPSMeter {
      * Notice: on some system (Windows) you should adjust system timer before call!
      */
     void sleepToTarget() {
-        if(myTargetFps >= 0.0) {
+        if(myTargetFps > 0.0) {
+            const double aPeriodUs = 1000000.0 / myTargetFps;
+            const double aNowUs    = myClock.getElapsedTimeInMicroSec();
+            if(myDeadlineUs < 0.0
+            || aNowUs - myDeadlineUs > aPeriodUs) {
+                // first frame or too late - restart pacing from current time
+                myDeadlineUs = aNowUs;
+            } else {
+                StFrameScheduler::sleepUntil(myClock, myDeadlineUs);
+            }
+            myDeadlineUs += aPeriodUs;
+        } else if(myTargetFps == 0.0) {
             mySleeper.sleep();
         }
     }
@@ -139,36 +155,6 @@ class StFPSControl : public StFPSMeter {
 
         private:
 
-    /**
-     * Try to adjust sleep timers to tend to target FPS.
-     */
-    void adjustFPSToTarget(const double theNewFps) {
-        const double aFpsPrecision = myTargetFps * 0.01; // 1%
-        const double aDiffFps = theNewFps - myTargetFps;
-        if(aDiffFps > aFpsPrecision) {
-            mySleeper.inc();
-            if(aDiffFps >= 8.0) {
-                // great diff - reduce time to adjust
-                for(size_t anIter = 0; anIter < 3; ++anIter) {
-                    mySleeper.inc();
-                }
-            }
-        } else if(aDiffFps < -aFpsPrecision) {
-            if(mySleeper.isZero()) {
-                // TODO (Kirill Gavrilov#7) if target FPS higher than maximal
-                //                          - no mehanism to reduce CPU utilization
-                return;
-            }
-            mySleeper.dec();
-            if(aDiffFps <= -8.0) {
-                // great diff - reduce time to adjust
-                for(size_t anIter = 0; anIter < 3; ++anIter) {
-                    mySleeper.dec();
-                }
-            }
-        }
-    }
-
     /**
      * Try to reduce CPU utilization (using sleep timers)
      * with minimal affect to FPS.
@@ -202,8 +188,10 @@ class StFPSControl : public StFPSMeter {
 
         private:
 
+    StTimer   myClock;       //!< clock for frame deadlines
     StSleeper mySleeper;
     double    myTargetFps;   //!< target average FPS
+    double    myDeadlineUs;  //!< deadline for the next frame (in micro-seconds)
     int       myDecCount;
     bool      myIsIncreased;
 
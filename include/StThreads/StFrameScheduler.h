@@ -0,0 +1,375 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#ifndef __StFrameScheduler_h_
+#define __StFrameScheduler_h_
+
+#include "StMutex.h"
+#include "StThread.h"
+#include "StTimer.h"
+
+#include <cmath>
+
+/**
+ * Frame pacing helper synchronizing video frames with display refresh.
+ *
+ * Rendering thread reports each presented frame (right after buffers swap) with onDisplayFrame(),
+ * which is used to estimate refresh period and phase of the display (vsync grid)
+ * and to measure actual hold time of video frames (judder statistics).
+ * Video thread uses pickVSync() to map presentation time of the next video frame to the grid
+ * using explicit n:m cadence (e.g. 3:2 pull-down for 23.976 FPS on 60 Hz display),
+ * sleepUntil() to wait for frame release with sub-millisecond precision,
+ * and onFrameReleased() to collect late frames statistics.
+ *
+ * All time values are in micro-seconds relative to internal timer (see getTimeUs()).
+ */
+class StFrameScheduler {
+
+        public:
+
+    /**
+     * Frame pacing statistics.
+     */
+    struct Statistics {
+        double RefreshPeriodMs; //!< estimated display refresh period (in milliseconds), 0.0 if unknown
+        double VSyncsPerFrame;  //!< average number of refresh periods per video frame (2.5 for 3:2 cadence)
+        double JudderMs;        //!< RMS deviation of measured frame hold time from nominal frame duration (in milliseconds)
+        double MaxLateMs;       //!< maximum frame release delay after deadline (in milliseconds)
+        int    CadenceLong;     //!< measured cadence - longest hold in refresh periods (3 for 3:2 cadence)
+        int    CadenceShort;    //!< measured cadence - shortest hold in refresh periods (2 for 3:2 cadence)
+        size_t NbFrames;        //!< number of released frames
+        size_t NbLate;          //!< number of frames released after their refresh slot
+        size_t NbSkipped;       //!< number of frames skipped to catch up refresh grid
+
+        Statistics() : RefreshPeriodMs(0.0), VSyncsPerFrame(0.0), JudderMs(0.0), MaxLateMs(0.0),
+                       CadenceLong(0), CadenceShort(0), NbFrames(0), NbLate(0), NbSkipped(0) {}
+    };
+
+        public:
+
+    /**
+     * Default constructor.
+     */
+    StFrameScheduler()
+    : myTimer(true),
+      myNbSamples(0),
+      mySampleIter(0),
+      myLastUs(0.0),
+      myPeriodUs(0.0),
+      myPhaseUs(-1.0),
+      myIsValid(false),
+      mySlotF(0.0),
+      mySlotPrev(0),
+      myHasSlot(false),
+      myLastFrameUs(-1.0),
+      myNbHolds(0),
+      myJudderSum(0.0) {
+        stMemZero(mySamples, sizeof(mySamples));
+        stMemZero(myHolds,   sizeof(myHolds));
+    }
+
+    /**
+     * @return current time in micro-seconds
+     */
+    double getTimeUs() const {
+        return myTimer.getElapsedTimeInMicroSec();
+    }
+
+    /**
+     * Register presented frame (should be called right after buffers swap from rendering thread).
+     * @param theHasNewFrame presented frame shows new video frame
+     */
+    void onDisplayFrame(const bool theHasNewFrame) {
+        const double aTime = getTimeUs();
+        StMutexAuto aLock(myMutex);
+        if(myPhaseUs >= 0.0) {
+            const double anInterval = aTime - myLastUs;
+            if(anInterval > 0.0 && anInterval < 1000000.0) {
+                mySamples[mySampleIter] = anInterval;
+                mySampleIter = (mySampleIter + 1) % THE_NB_SAMPLES;
+                myNbSamples  = stMin(myNbSamples + 1, (size_t )THE_NB_SAMPLES);
+            }
+        }
+        myLastUs = aTime;
+        updatePeriod();
+
+        if(theHasNewFrame) {
+            registerHold(aTime);
+        }
+
+        // lock to the phase using simple phase-locked loop
+        if(!myIsValid || myPhaseUs < 0.0) {
+            myPhaseUs = aTime;
+            return;
+        }
+        const double aNbPeriods = std::floor((aTime - myPhaseUs) / myPeriodUs + 0.5);
+        const double aPredicted = myPhaseUs + aNbPeriods * myPeriodUs;
+        const double anError    = aTime - aPredicted;
+        if(std::abs(anError) < myPeriodUs * 0.25) {
+            myPhaseUs = aPredicted + anError * 0.1;
+        } else {
+            myPhaseUs = aTime; // phase jump (missed refresh or changed rate)
+        }
+    }
+
+    /**
+     * Return TRUE if refresh period has been estimated and considered stable.
+     */
+    bool isValid() const {
+        StMutexAuto aLock(myMutex);
+        return myIsValid;
+    }
+
+    /**
+     * @return estimated refresh period in micro-seconds or 0.0 if unknown
+     */
+    double getPeriodUs() const {
+        StMutexAuto aLock(myMutex);
+        return myIsValid ? myPeriodUs : 0.0;
+    }
+
+    /**
+     * Predict the first presentation opportunity after specified time.
+     * @param theTimeUs time in micro-seconds
+     * @return predicted time or theTimeUs if refresh period is unknown
+     */
+    double predictNextVSync(const double theTimeUs) const {
+        StMutexAuto aLock(myMutex);
+        if(!myIsValid) {
+            return theTimeUs;
+        }
+        return myPhaseUs + std::ceil((theTimeUs - myPhaseUs) / myPeriodUs) * myPeriodUs;
+    }
+
+    /**
+     * Reset cadence state (e.g. on seek or pause).
+     */
+    void resetCadence() {
+        StMutexAuto aLock(myMutex);
+        myHasSlot     = false;
+        myLastFrameUs = -1.0;
+    }
+
+    /**
+     * Map the desired presentation time of the next video frame onto the refresh grid.
+     * Consecutive frames are advanced by the exact ratio between frame duration and refresh period
+     * (accumulated with fractional part), so that hold times follow stable n:m cadence
+     * (e.g. 3:2:3:2 for 23.976 FPS on 60 Hz) instead of random rounding of noisy timestamps;
+     * drift from desired time (A/V sync) is corrected gradually.
+     * @param theTargetUs    desired presentation time of the frame
+     * @param theFrameDurUs  nominal frame duration (in micro-seconds)
+     * @param theSlotTimeUs  presentation time of chosen refresh slot
+     * @return number of refresh periods since previous frame (0 means the frame is redundant and should be skipped),
+     *         or -1 if refresh period is unknown
+     */
+    int pickVSync(const double theTargetUs,
+                  const double theFrameDurUs,
+                  double&      theSlotTimeUs) {
+        StMutexAuto aLock(myMutex);
+        theSlotTimeUs = theTargetUs;
+        if(!myIsValid) {
+            return -1;
+        }
+
+        const double aTargetSlot = (theTargetUs - myPhaseUs) / myPeriodUs;
+        const double aRatio      = theFrameDurUs > 0.0 ? (theFrameDurUs / myPeriodUs) : 1.0;
+        if(!myHasSlot) {
+            mySlotF = aTargetSlot;
+        } else {
+            mySlotF += aRatio;
+            const double aDrift = aTargetSlot - mySlotF;
+            if(std::abs(aDrift) > stMax(2.0, aRatio)) {
+                mySlotF = aTargetSlot; // discontinuity - resynchronize
+            } else {
+                // correct drift slowly to keep cadence stable
+                const double aStep = 0.05 * stMax(aRatio, 1.0);
+                mySlotF += stMax(-aStep, stMin(aStep, aDrift));
+            }
+        }
+
+        const int64_t aSlot = (int64_t )std::floor(mySlotF + 0.5);
+        const int aHold = myHasSlot ? int(stMax(aSlot - mySlotPrev, (int64_t )0)) : 1;
+        if(aHold == 0) {
+            // frame would never be visible - let the caller skip it
+            return 0;
+        }
+
+        myHasSlot  = true;
+        mySlotPrev = aSlot;
+        myStats.VSyncsPerFrame = aRatio;
+        theSlotTimeUs = myPhaseUs + double(aSlot) * myPeriodUs;
+        return aHold;
+    }
+
+    /**
+     * Register released frame.
+     * @param theDeadlineUs planned release time
+     * @param theReleaseUs  actual release time
+     */
+    void onFrameReleased(const double theDeadlineUs,
+                         const double theReleaseUs) {
+        StMutexAuto aLock(myMutex);
+        ++myStats.NbFrames;
+        const double aLateUs = theReleaseUs - theDeadlineUs;
+        if(myIsValid && aLateUs > myPeriodUs * 0.5) {
+            ++myStats.NbLate;
+        }
+        myStats.MaxLateMs = stMax(myStats.MaxLateMs, aLateUs * 0.001);
+    }
+
+    /**
+     * Register frame skipped by the scheduler.
+     */
+    void onFrameSkipped() {
+        StMutexAuto aLock(myMutex);
+        ++myStats.NbSkipped;
+    }
+
+    /**
+     * Retrieve statistics.
+     */
+    Statistics getStatistics() const {
+        StMutexAuto aLock(myMutex);
+        Statistics aStats = myStats;
+        aStats.RefreshPeriodMs = myIsValid ? myPeriodUs * 0.001 : 0.0;
+        aStats.JudderMs        = myNbHolds > 0 ? std::sqrt(myJudderSum / double(myNbHolds)) * 0.001 : 0.0;
+        const size_t aNbHolds = stMin(myNbHolds, (size_t )THE_NB_HOLDS);
+        for(size_t aHoldIter = 0; aHoldIter < aNbHolds; ++aHoldIter) {
+            const int aHold = myHolds[aHoldIter];
+            if(aHold <= 0) {
+                continue;
+            }
+            aStats.CadenceLong  = stMax(aStats.CadenceLong, aHold);
+            aStats.CadenceShort = aStats.CadenceShort == 0 ? aHold : stMin(aStats.CadenceShort, aHold);
+        }
+        return aStats;
+    }
+
+    /**
+     * Reset statistics.
+     */
+    void resetStatistics() {
+        StMutexAuto aLock(myMutex);
+        myStats = Statistics();
+        myLastFrameUs = -1.0;
+        myNbHolds     = 0;
+        myJudderSum   = 0.0;
+        stMemZero(myHolds, sizeof(myHolds));
+    }
+
+    /**
+     * Sleep until specified time with sub-millisecond precision.
+     * Coarse system sleep is used while remaining time is large,
+     * and thread yielding for the last fraction of millisecond.
+     * @param theTargetUs wake up time
+     */
+    void sleepUntil(const double theTargetUs) const {
+        sleepUntil(myTimer, theTargetUs);
+    }
+
+    /**
+     * Sleep until specified time of another timer with sub-millisecond precision.
+     * @param theTimer    timer defining the clock
+     * @param theTargetUs wake up time in micro-seconds
+     */
+    static void sleepUntil(const StTimer& theTimer,
+                           const double   theTargetUs) {
+        for(;;) {
+            const double aRemainUs = theTargetUs - theTimer.getElapsedTimeInMicroSec();
+            if(aRemainUs <= 0.0) {
+                return;
+            } else if(aRemainUs > 2000.0) {
+                // system sleep granularity might be ~1 ms
+                StThread::sleep(int((aRemainUs - 1000.0) * 0.001));
+            } else {
+                StThread::yield();
+            }
+        }
+    }
+
+        private:
+
+    /**
+     * Measure hold time of the previous video frame, which has been replaced by the new one at specified time.
+     */
+    void registerHold(const double theTimeUs) {
+        const double aHoldUs = theTimeUs - myLastFrameUs;
+        if(myLastFrameUs >= 0.0
+        && myIsValid
+        && aHoldUs < 1000000.0) {
+            myHolds[myNbHolds % THE_NB_HOLDS] = int(std::floor(aHoldUs / myPeriodUs + 0.5));
+            ++myNbHolds;
+            const double aDevUs = myStats.VSyncsPerFrame > 0.0
+                                ? aHoldUs - myStats.VSyncsPerFrame * myPeriodUs
+                                : 0.0;
+            myJudderSum += aDevUs * aDevUs;
+        }
+        myLastFrameUs = theTimeUs;
+    }
+
+    /**
+     * Estimate refresh period as median of recent presentation intervals.
+     * The estimation is considered stable when most intervals are close to median.
+     */
+    void updatePeriod() {
+        if(myNbSamples < THE_NB_SAMPLES_MIN) {
+            myIsValid = false;
+            return;
+        }
+
+        double aSorted[THE_NB_SAMPLES];
+        for(size_t anIter = 0; anIter < myNbSamples; ++anIter) {
+            double aValue = mySamples[anIter];
+            size_t aPos   = anIter;
+            for(; aPos > 0 && aSorted[aPos - 1] > aValue; --aPos) {
+                aSorted[aPos] = aSorted[aPos - 1];
+            }
+            aSorted[aPos] = aValue;
+        }
+
+        const double aMedian = aSorted[myNbSamples / 2];
+        size_t aNbStable = 0;
+        double aSum = 0.0;
+        for(size_t anIter = 0; anIter < myNbSamples; ++anIter) {
+            if(std::abs(mySamples[anIter] - aMedian) < aMedian * 0.1) {
+                aSum += mySamples[anIter];
+                ++aNbStable;
+            }
+        }
+        myIsValid  = aNbStable * 4 >= myNbSamples * 3;
+        myPeriodUs = aNbStable != 0 ? (aSum / double(aNbStable)) : aMedian;
+    }
+
+        private:
+
+    static const size_t THE_NB_SAMPLES     = 64;
+    static const size_t THE_NB_SAMPLES_MIN = 16;
+    static const size_t THE_NB_HOLDS       = 8;
+
+        private:
+
+    mutable StMutex myMutex;
+    StTimer    myTimer;                  //!< scheduler clock
+    double     mySamples[THE_NB_SAMPLES];//!< presentation intervals ring
+    size_t     myNbSamples;              //!< number of filled samples
+    size_t     mySampleIter;             //!< ring position
+    double     myLastUs;                 //!< last presentation opportunity
+    double     myPeriodUs;               //!< estimated refresh period
+    double     myPhaseUs;                //!< refresh grid phase
+    bool       myIsValid;                //!< refresh period estimation is stable
+
+    double     mySlotF;                  //!< unrounded refresh slot of last video frame
+    int64_t    mySlotPrev;               //!< refresh slot of last video frame
+    bool       myHasSlot;                //!< cadence is initialized
+    double     myLastFrameUs;            //!< presentation time of the last new video frame
+    size_t     myNbHolds;                //!< number of measured frame hold times
+    int        myHolds[THE_NB_HOLDS];    //!< recent measured frame hold times (in refresh periods)
+    double     myJudderSum;              //!< sum of squared hold time deviations
+    Statistics myStats;                  //!< statistics
+
+};
+
+#endif // __StFrameScheduler_h_
@@ -0,0 +1,96 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#ifndef __StMemoryBudget_h_
+#define __StMemoryBudget_h_
+
+#include <StStrings/StString.h>
+
+/**
+ * Process-wide memory budget shared by large buffer consumers (decoded frames, packets, read-ahead blocks).
+ * Consumers report allocated and released memory, and size their queues from the budget
+ * instead of using fixed limits, so that 8K content does not exhaust memory on low-RAM devices
+ * and small frames are not limited by queue length designed for large ones.
+ */
+class StMemoryBudget {
+
+        public:
+
+    /**
+     * Tracked memory consumers.
+     */
+    enum Consumer {
+        Consumer_Textures = 0, //!< decoded frames within StGLTextureQueue
+        Consumer_Packets,      //!< demuxed packets within StAVPacketQueue
+        Consumer_ReadAhead,    //!< file read-ahead blocks
+        Consumer_Images,       //!< decoded images kept in memory
+        Consumer_NB
+    };
+
+        public:
+
+    /**
+     * Register allocated (positive) or released (negative) memory.
+     */
+    ST_CPPEXPORT static void add(const Consumer theConsumer,
+                                 const int64_t  theBytes);
+
+    /**
+     * Return memory used by specified consumer in bytes.
+     */
+    ST_CPPEXPORT static size_t getUsage(const Consumer theConsumer);
+
+    /**
+     * Return memory used by all consumers in bytes.
+     */
+    ST_CPPEXPORT static size_t getTotalUsage();
+
+    /**
+     * Return memory limit in bytes.
+     */
+    ST_CPPEXPORT static size_t getLimit();
+
+    /**
+     * Set memory limit in bytes, 0 means default limit computed from physical memory size.
+     */
+    ST_CPPEXPORT static void setLimit(const size_t theBytes);
+
+    /**
+     * Return the size of physical memory in bytes or 0 if unknown.
+     */
+    ST_CPPEXPORT static uint64_t getPhysicalMemory();
+
+    /**
+     * Return true if consumers exceed the limit and should release cached buffers.
+     */
+    ST_CPPEXPORT static bool isUnderPressure();
+
+    /**
+     * Return the budget available to specified consumer, which is a fraction of the limit
+     * further reduced when other consumers occupy more than their share.
+     */
+    ST_CPPEXPORT static size_t getAvailable(const Consumer theConsumer);
+
+    /**
+     * Compute number of items (frames, packets) fitting into the consumer budget.
+     * @param theConsumer  memory consumer
+     * @param theItemBytes size of single item in bytes
+     * @param theNbMin     minimal number of items
+     * @param theNbMax     maximal number of items
+     */
+    ST_CPPEXPORT static size_t computeNbItems(const Consumer theConsumer,
+                                              const size_t   theItemBytes,
+                                              const size_t   theNbMin,
+                                              const size_t   theNbMax);
+
+    /**
+     * Format current usage for displaying.
+     */
+    ST_CPPEXPORT static StString format();
+
+};
+
+#endif // __StMemoryBudget_h_
@@ -0,0 +1,92 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#ifndef __StStartupTrace_h_
+#define __StStartupTrace_h_
+
+#include <StStrings/StString.h>
+
+/**
+ * Global trace of application startup phases (settings load, plugins load, monitors scan, GL context creation, shaders compilation).
+ * Time is measured since the first call to the trace.
+ * Recording stops on finish() call (normally after the first frame has been drawn),
+ * so that measurements have no impact on further execution.
+ * Phases with the same name are accumulated (e.g. compilation of multiple shaders).
+ */
+class StStartupTrace {
+
+        public:
+
+    /**
+     * Auxiliary class measuring the phase within the scope.
+     */
+    class Phase {
+
+            public:
+
+        /**
+         * Start the phase.
+         * Name is not copied and should remain valid within the scope;
+         * the string is built only when the phase is actually recorded.
+         * @param theName   phase name
+         * @param theSuffix optional suffix appended to the name
+         */
+        ST_CPPEXPORT Phase(const char* theName,
+                           const char* theSuffix = NULL);
+
+        /**
+         * Finish the phase.
+         */
+        ST_CPPEXPORT ~Phase();
+
+            private:
+
+        const char* myName;   //!< phase name
+        const char* mySuffix; //!< optional phase name suffix
+        double      myStart;  //!< phase start time in seconds, negative if trace is not recorded
+
+    };
+
+        public:
+
+    /**
+     * Record the instant event (like the first frame).
+     */
+    ST_CPPEXPORT static void mark(const StString& theName);
+
+    /**
+     * Stop recording.
+     */
+    ST_CPPEXPORT static void finish();
+
+    /**
+     * Return true if recording has been stopped.
+     */
+    ST_CPPEXPORT static bool isFinished();
+
+    /**
+     * Format recorded phases as a text table.
+     */
+    ST_CPPEXPORT static StString format();
+
+        private:
+
+    /**
+     * Return time since the trace start in seconds, or negative value if recording is stopped.
+     */
+    ST_LOCAL static double getTime();
+
+    /**
+     * Append phase or accumulate phase duration.
+     */
+    ST_LOCAL static void addPhase(const StString& theName,
+                                  const double    theStart,
+                                  const double    theDuration,
+                                  const int       theDepth);
+
+};
+
+#endif // __StStartupTrace_h_
@@ -13,8 +13,10 @@
 
 #ifdef _WIN32
     extern "C" __declspec(dllimport) void __stdcall Sleep(unsigned long theMilliseconds);
+    extern "C" __declspec(dllimport) int  __stdcall SwitchToThread();
 #else
     #include <pthread.h>
+    #include <sched.h>
     #include <unistd.h>
     #include <errno.h>
     #include <sys/time.h>
@@ -51,6 +53,18 @@ class StThread {
     #endif
     }
 
+    /**
+     * Give up the rest of current time slice to another ready thread (if any).
+     * Intended for short busy-wait loops requiring sub-millisecond precision.
+     */
+    static void yield() {
+    #ifdef _WIN32
+        SwitchToThread();
+    #else
+        sched_yield();
+    #endif
+    }
+
     /**
      * Returns the logical processors count in system.
      * This number could be used to tune multithreading algorithms.
@@ -63,6 +77,11 @@ class StThread {
      */
     ST_CPPEXPORT static void setCurrentThreadName(const char* theName);
 
+    /**
+     * Lower the priority of the active thread, so that background tasks do not compete with playback and GUI.
+     */
+    ST_CPPEXPORT static void setCurrentThreadLowPriority();
+
     /**
      * Returns the CPU architecture used to build the program (may not match the system).
      */
@@ -0,0 +1,144 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * This code is licensed under MIT license (see docs/license-mit.txt for details).
+ */
+
+#ifndef __StThreadPool_h_
+#define __StThreadPool_h_
+
+#include <StTemplates/StHandle.h>
+#include <StThreads/StCondition.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThread.h>
+
+#include <deque>
+#include <vector>
+
+/**
+ * Bounded pool of working threads executing short independent jobs (image decoding, resizing, metadata parsing).
+ * Jobs are executed in submission order; pending jobs can be cancelled before they are started,
+ * while running jobs may poll Job::isCancelled() to stop early.
+ */
+class StThreadPool {
+
+        public:
+
+    /**
+     * Interface of the job.
+     */
+    class Job {
+
+            public:
+
+        /**
+         * Empty constructor.
+         */
+        ST_CPPEXPORT Job();
+
+        /**
+         * Destructor.
+         */
+        ST_CPPEXPORT virtual ~Job();
+
+        /**
+         * Execute the job within working thread.
+         */
+        virtual void perform() = 0;
+
+        /**
+         * Return true if the job has been executed or cancelled.
+         */
+        ST_CPPEXPORT bool isDone() const;
+
+        /**
+         * Return true if the job has been cancelled.
+         * Can be polled by perform() to stop early.
+         */
+        ST_LOCAL bool isCancelled() const { return myIsCancelled; }
+
+            private:
+
+        mutable StCondition myDoneEvent;   //!< event signaling job completion
+        volatile bool       myIsCancelled; //!< cancellation flag
+
+        friend class StThreadPool;
+
+    };
+
+        public:
+
+    /**
+     * Return the process-wide pool shared by image loaders and export queues,
+     * so that the number of working threads does not grow with the number of their instances.
+     */
+    ST_CPPEXPORT static const StHandle<StThreadPool>& getShared();
+
+    /**
+     * Main constructor.
+     * @param theName      name of working threads
+     * @param theNbThreads number of working threads, 0 for automatic selection (2..4 threads depending on CPU)
+     */
+    ST_CPPEXPORT StThreadPool(const char* theName,
+                              const int   theNbThreads = 0);
+
+    /**
+     * Destructor, cancels pending jobs and waits for running ones.
+     */
+    ST_CPPEXPORT ~StThreadPool();
+
+    /**
+     * Return the number of working threads.
+     */
+    ST_LOCAL int getNbThreads() const { return myNbThreads; }
+
+    /**
+     * Append the job to the queue.
+     * Working threads are started on first call.
+     */
+    ST_CPPEXPORT void push(const StHandle<Job>& theJob);
+
+    /**
+     * Cancel the job: pending job is removed from the queue and marked as done,
+     * running job is flagged to let it stop early.
+     */
+    ST_CPPEXPORT void cancel(const StHandle<Job>& theJob);
+
+    /**
+     * Wait for the job completion.
+     * @param theTimeMilliseconds time limit
+     * @return true if the job has been done
+     */
+    ST_CPPEXPORT bool wait(const StHandle<Job>& theJob,
+                           const size_t         theTimeMilliseconds);
+
+        private:
+
+    /**
+     * Working thread loop.
+     */
+    ST_LOCAL void mainLoop();
+
+    /**
+     * Working thread callback.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION threadFunction(void* thePool);
+
+        private:
+
+    std::vector< StHandle<StThread> > myThreads;   //!< working threads
+    std::deque< StHandle<Job> >       myJobs;      //!< pending jobs
+    StMutex                           myMutex;     //!< lock for jobs queue
+    StCondition                       myEvent;     //!< event signaling new jobs
+    const char*                       myName;      //!< name of working threads
+    int                               myNbThreads; //!< number of working threads to start
+    volatile bool                     myToQuit;    //!< flag to stop working threads
+
+        private: //! @name no copies, please
+
+    StThreadPool(const StThreadPool& theCopy);
+    const StThreadPool& operator=(const StThreadPool& theCopy);
+
+};
+
+#endif // __StThreadPool_h_
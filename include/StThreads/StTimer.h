@@ -1,5 +1,5 @@
 /**
- * Copyright © 2008-2014 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2008-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * This code is licensed under MIT license (see docs/license-mit.txt for details).
  */
@@ -35,6 +35,7 @@ class StTimer {
      */
     StTimer(bool isStart = false)
     : myTimeInMicroSec(0.0),
+      mySpeed(1.0),
       myIsPaused(true) {
         if(isStart) {
             restart(0.0);
@@ -70,6 +71,26 @@ class StTimer {
         return !myIsPaused;
     }
 
+    /**
+     * @return speed factor of the timer
+     */
+    double getSpeed() const {
+        return mySpeed;
+    }
+
+    /**
+     * Change the speed of the timer (e.g. to follow playback rate).
+     * Time elapsed so far is preserved.
+     * @param theSpeed speed factor (1.0 for real time)
+     */
+    void setSpeed(const double theSpeed) {
+        if(!myIsPaused) {
+            myTimeInMicroSec += getElapsedTimeFromLastStartInMicroSec();
+            fillCounter(myCounterStart);
+        }
+        mySpeed = theSpeed;
+    }
+
     /**
      * Pause the timer (freeze current timestamp).
      */
@@ -124,7 +145,7 @@ class StTimer {
      * @return micro-seconds from start
      */
     double getElapsedTimeFromLastStartInMicroSec() const {
-        return myIsPaused ? 0.0 : timeFromStart();
+        return myIsPaused ? 0.0 : timeFromStart() * mySpeed;
     }
 
         protected:
@@ -185,6 +206,7 @@ class StTimer {
 
     double          myTimeInMicroSec; //!< cumulative elapsed time
     stTimeCounter_t myCounterStart;
+    double          mySpeed;          //!< speed factor
     bool            myIsPaused;       //!< pause flag
 
         protected:
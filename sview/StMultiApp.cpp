@@ -11,6 +11,7 @@
 #include "../StMoviePlayer/StMoviePlayer.h"
 #include "../StDiagnostics/StDiagnostics.h"
 
+#include <StAV/StAVVideoMuxer.h>
 #include <StStrings/stConsole.h>
 #include <StVersion.h>
 
@@ -50,7 +51,11 @@ static StString getAbout() {
         + "  --left=PATH          Specify source for left view\n"
           "  --right=PATH         Specify source for right view\n"
           "  --avlog=LEVEL        Specify log level for FFmpeg library (0: off, 1: on, 2: verbose)\n"
+          "  --startupTrace=FILE  Write startup phases timing into the file (into log when FILE is omitted)\n"
           "  --webuiCmdPort=PORT  Use http://localhost:PORT for remote control (see --invokeAction).\n"
+          "  --remuxList=FILE     Re-mux video files listed in FILE into MKV without opening window,\n"
+          "                       one job per line in format LEFT|RIGHT|OUTPUT (RIGHT and OUTPUT are optional)\n"
+          "  --remuxJobs=N        Number of simultaneous re-muxing jobs (number of CPUs by default)\n"
           "  --invokeAction=ACT   Invoke action on http://localhost:PORT.\n"
           "                       play - play/pause\n"
           "                       mute - mute/unmute audio\n"
@@ -65,6 +70,13 @@ static StString getAbout() {
     return anAboutString;
 }
 
+/**
+ * Print batch re-muxing message.
+ */
+static void printRemuxMessage(const StCString& theMessage) {
+    st::cout << StString(theMessage) << stostream_text("\n");
+}
+
 StHandle<StApplication> StMultiApp::getInstance(const StHandle<StResourceManager>& theResMgr,
                                                 const StHandle<StOpenInfo>&        theInfo) {
     StHandle<StOpenInfo> anInfo = theInfo;
@@ -145,6 +157,24 @@ StHandle<StApplication> StMultiApp::getInstance(const StHandle<StResourceManager
         return NULL;
     }
 
+    // headless batch re-muxing
+    StArgument anArgRemuxList = anArgs["remuxList"];
+    if(anArgRemuxList.isValid()) {
+        StArgument anArgRemuxJobs = anArgs["remuxJobs"];
+        const int  aNbJobs        = anArgRemuxJobs.isValid() ? ::atoi(anArgRemuxJobs.getValue().toCString()) : 0;
+        stAV::init();
+        StAVVideoMuxerBatch aBatch;
+        aBatch.signals.onMessage = printRemuxMessage;
+        if(!aBatch.loadList(anArgRemuxList.getValue())) {
+            st::cout << stostream_text("Unable to read re-muxing list '") << anArgRemuxList.getValue() << stostream_text("'\n");
+            return NULL;
+        }
+
+        const size_t aNbDone = aBatch.perform(aNbJobs);
+        st::cout << stostream_text("Re-muxed ") << aNbDone << stostream_text(" of ") << aBatch.getJobs().size() << stostream_text(" files\n");
+        return NULL;
+    }
+
     // select application
     const StString ARGUMENT_DRAWER = "in";
     StArgument anArgDrawer = anArgs[ARGUMENT_DRAWER];